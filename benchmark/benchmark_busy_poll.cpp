@@ -0,0 +1,145 @@
+/**
+ * @file benchmark_busy_poll.cpp
+ * @brief Banc d'essai de la latence entre le réseau et le gestionnaire selon le mode d'exécution de l'io_context
+ *
+ * Un serveur websocket local (sans TLS, sur la boucle locale) envoie des trames horodatées à intervalle régulier. Un client lit ces trames sur
+ * l'io_context d'un ServiceContext et mesure, pour chaque trame, le délai entre l'horodatage d'envoi et l'exécution du gestionnaire de lecture
+ * (médiane, p99, p99.9) :
+ * - avec le mode bloquant (io_context::run)
+ * - avec le mode d'attente active (poll pendant le budget de rotation, puis run_one)
+ * - avec le mode d'attente active et SO_BUSY_POLL sur le socket (Linux uniquement)
+ *
+ * Usage : benchmark_busy_poll [nombre de trames] [intervalle en microsecondes] [budget de rotation en microsecondes]
+ */
+
+#include "boost/asio.hpp"
+#include "boost/asio/ssl.hpp"
+#include "boost/beast/core.hpp"
+#include "boost/beast/websocket.hpp"
+#include "../include/ccapi_cpp/service/ccapi_service_context.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+using tcp = boost::asio::ip::tcp;
+
+namespace {
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Lit les trames en boucle et enregistre la latence de chacune jusqu'à numFrame trames
+ */
+class Reader : public std::enable_shared_from_this<Reader> {
+ public:
+    Reader(websocket::stream<beast::tcp_stream>& stream, size_t numFrame, ServiceContext& serviceContext)
+        : stream(stream), numFrame(numFrame), serviceContext(serviceContext) {
+        this->latencyList.reserve(numFrame);
+    }
+    void read() { this->stream.async_read(this->buffer, beast::bind_front_handler(&Reader::onRead, this->shared_from_this())); }
+    void onRead(beast::error_code ec, size_t) {
+        long long now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        if (ec) {
+            std::cerr << "read error: " << ec.message() << std::endl;
+            this->serviceContext.stop();
+            return;
+        }
+        long long sentAt;
+        std::memcpy(&sentAt, static_cast<const char*>(this->buffer.data().data()), sizeof(sentAt));
+        this->latencyList.push_back(now - sentAt);
+        this->buffer.consume(this->buffer.size());
+        if (this->latencyList.size() == this->numFrame) {
+            this->serviceContext.stop();
+            return;
+        }
+        this->read();
+    }
+    std::vector<long long> latencyList;
+
+ private:
+    websocket::stream<beast::tcp_stream>& stream;
+    beast::flat_buffer buffer;
+    size_t numFrame;
+    ServiceContext& serviceContext;
+};
+
+/**
+ * @brief Accepte une connexion websocket et envoie numFrame trames horodatées, une toutes les intervalMicroseconds microsecondes
+ */
+void serve(tcp::acceptor& acceptor, size_t numFrame, long intervalMicroseconds) {
+    boost::asio::io_context ioContext;
+    tcp::socket socket(ioContext);
+    acceptor.accept(socket);
+    socket.set_option(tcp::no_delay(true));
+    websocket::stream<tcp::socket> stream(std::move(socket));
+    stream.accept();
+    stream.binary(true);
+    auto next = Clock::now();
+    for (size_t i = 0; i < numFrame; ++i) {
+        next += std::chrono::microseconds(intervalMicroseconds);
+        while (Clock::now() < next) {
+        }
+        long long sentAt = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        char frame[64] = {};
+        std::memcpy(frame, &sentAt, sizeof(sentAt));
+        stream.write(boost::asio::buffer(frame, sizeof(frame)));
+    }
+}
+
+void run(const std::string& name, size_t numFrame, long intervalMicroseconds, long busyPollSpinMicroseconds, int socketBusyPollMicroseconds) {
+    boost::asio::io_context acceptorIoContext;
+    tcp::acceptor acceptor(acceptorIoContext, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0));
+    unsigned short port = acceptor.local_endpoint().port();
+    std::thread serverThread([&] { serve(acceptor, numFrame, intervalMicroseconds); });
+    ServiceContext serviceContext(1, {}, busyPollSpinMicroseconds);
+    websocket::stream<beast::tcp_stream> stream(*serviceContext.ioContextPtr);
+    beast::get_lowest_layer(stream).connect(tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), port));
+    beast::get_lowest_layer(stream).socket().set_option(tcp::no_delay(true));
+    if (socketBusyPollMicroseconds > 0) {
+#ifdef SO_BUSY_POLL
+        beast::error_code ec;
+        beast::get_lowest_layer(stream).socket().set_option(boost::asio::detail::socket_option::integer<SOL_SOCKET, SO_BUSY_POLL>(socketBusyPollMicroseconds),
+                                                            ec);
+        if (ec) {
+            std::cout << name << ": SO_BUSY_POLL unavailable (" << ec.message() << ")" << std::endl;
+        }
+#else
+        std::cout << name << ": SO_BUSY_POLL unavailable" << std::endl;
+#endif
+    }
+    stream.handshake("127.0.0.1:" + std::to_string(port), "/");
+    auto readerPtr = std::make_shared<Reader>(stream, numFrame, serviceContext);
+    readerPtr->read();
+    serviceContext.start();
+    serverThread.join();
+    std::vector<long long>& latencyList = readerPtr->latencyList;
+    if (latencyList.empty()) {
+        std::cout << name << ": no frame received" << std::endl;
+        return;
+    }
+    std::sort(latencyList.begin(), latencyList.end());
+    auto percentile = [&latencyList](double p) { return latencyList[std::min(latencyList.size() - 1, static_cast<size_t>(p * latencyList.size()))]; };
+    std::cout << name << ": " << latencyList.size() << " frames, latency median " << percentile(0.5) << " ns, p99 " << percentile(0.99) << " ns, p99.9 "
+              << percentile(0.999) << " ns" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t numFrame = argc > 1 ? std::stoul(argv[1]) : 100000;
+    long intervalMicroseconds = argc > 2 ? std::stol(argv[2]) : 20;
+    long busyPollSpinMicroseconds = argc > 3 ? std::stol(argv[3]) : 1000;
+    run("blocking run", numFrame, intervalMicroseconds, 0, 0);
+    run("busy poll", numFrame, intervalMicroseconds, busyPollSpinMicroseconds, 0);
+    run("busy poll + SO_BUSY_POLL", numFrame, intervalMicroseconds, busyPollSpinMicroseconds, 50);
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file benchmark_decimal.cpp
+ * @brief Banc d'essai comparant Decimal et FixedDecimal
+ *
+ * Mesure le coût par opération (ns/op) de :
+ * - L'analyse d'un prix depuis un tampon de caractères
+ * - La comparaison et l'utilisation comme clé de std::map
+ * - La conversion en chaîne et en double
+ */
+
+#include "../include/ccapi_cpp/ccapi_fixed_decimal.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+namespace {
+volatile size_t sink;
+
+/**
+ * @brief Exécute une fonction et affiche le temps moyen par opération
+ */
+template <typename F>
+void run(const std::string& name, size_t numOperation, F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << static_cast<double>(elapsed) / numOperation << " ns/op" << std::endl;
+}
+}  // namespace
+
+int main() {
+    const size_t numPrice = 1000;
+    const size_t numRound = 200;
+    std::vector<std::string> prices;
+    for (size_t i = 0; i < numPrice; ++i) {
+        prices.push_back(std::to_string(42000 + i / 10) + "." + std::to_string(i % 10) + "0");
+    }
+    const size_t numOperation = numPrice * numRound;
+    run("Decimal parse", numOperation, [&] {
+        for (size_t r = 0; r < numRound; ++r) {
+            for (const auto& x : prices) {
+                sink = Decimal(x).before;
+            }
+        }
+    });
+    run("FixedDecimal parse", numOperation, [&] {
+        FixedDecimal d;
+        for (size_t r = 0; r < numRound; ++r) {
+            for (const auto& x : prices) {
+                FixedDecimal::parse(x.data(), x.size(), d);
+                sink = d.getMantissa();
+            }
+        }
+    });
+    std::vector<Decimal> decimals;
+    std::vector<FixedDecimal> fixedDecimals;
+    for (const auto& x : prices) {
+        decimals.emplace_back(x);
+        fixedDecimals.emplace_back(x);
+    }
+    run("Decimal compare", numOperation, [&] {
+        size_t n = 0;
+        for (size_t r = 0; r < numRound; ++r) {
+            for (size_t i = 1; i < numPrice; ++i) {
+                n += decimals[i - 1] < decimals[i];
+            }
+        }
+        sink = n;
+    });
+    run("FixedDecimal compare", numOperation, [&] {
+        size_t n = 0;
+        for (size_t r = 0; r < numRound; ++r) {
+            for (size_t i = 1; i < numPrice; ++i) {
+                n += fixedDecimals[i - 1] < fixedDecimals[i];
+            }
+        }
+        sink = n;
+    });
+    run("Decimal map insert/find/erase", numOperation, [&] {
+        std::map<Decimal, std::string> book;
+        for (size_t r = 0; r < numRound; ++r) {
+            for (const auto& x : decimals) {
+                book[x] = "1";
+            }
+            for (const auto& x : decimals) {
+                book.erase(x);
+            }
+        }
+        sink = book.size();
+    });
+    run("FixedDecimal map insert/find/erase", numOperation, [&] {
+        std::map<FixedDecimal, std::string> book;
+        for (size_t r = 0; r < numRound; ++r) {
+            for (const auto& x : fixedDecimals) {
+                book[x] = "1";
+            }
+            for (const auto& x : fixedDecimals) {
+                book.erase(x);
+            }
+        }
+        sink = book.size();
+    });
+    run("Decimal toString", numOperation, [&] {
+        for (size_t r = 0; r < numRound; ++r) {
+            for (const auto& x : decimals) {
+                sink = x.toString().size();
+            }
+        }
+    });
+    run("FixedDecimal toChars", numOperation, [&] {
+        char buffer[FixedDecimal::MAX_STRING_LENGTH];
+        for (size_t r = 0; r < numRound; ++r) {
+            for (const auto& x : fixedDecimals) {
+                sink = x.toChars(buffer);
+            }
+        }
+    });
+    run("Decimal toDouble", numOperation, [&] {
+        double s = 0;
+        for (size_t r = 0; r < numRound; ++r) {
+            for (const auto& x : decimals) {
+                s += x.toDouble();
+            }
+        }
+        sink = static_cast<size_t>(s);
+    });
+    run("FixedDecimal toDouble", numOperation, [&] {
+        double s = 0;
+        for (size_t r = 0; r < numRound; ++r) {
+            for (const auto& x : fixedDecimals) {
+                s += x.toDouble();
+            }
+        }
+        sink = static_cast<size_t>(s);
+    });
+    return 0;
+}
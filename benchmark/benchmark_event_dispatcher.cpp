@@ -0,0 +1,130 @@
+/**
+ * @file benchmark_event_dispatcher.cpp
+ * @brief Banc d'essai du répartiteur d'événements à 1M événements/s
+ *
+ * Un producteur répartit des événements à un rythme cible de 1M/s puis au débit maximal et mesure :
+ * - le débit atteint
+ * - la latence entre dispatch et l'exécution du rappel (médiane, p99, p99.9)
+ *
+ * Pour :
+ * - l'implémentation précédente (std::function, std::queue, mutex et notify_all), recopiée ci-dessous
+ * - EventDispatcher avec la file protégée par mutex
+ * - EventDispatcher avec la file sans verrou
+ */
+
+#include "../include/ccapi_cpp/ccapi_event.h"
+#include "../include/ccapi_cpp/ccapi_event_dispatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+namespace {
+typedef std::chrono::steady_clock Clock;
+volatile size_t sink;
+
+/**
+ * @brief L'implémentation précédente d'EventDispatcher, sans journalisation
+ */
+class LegacyEventDispatcher {
+ public:
+    explicit LegacyEventDispatcher(int numDispatcherThreads = 1) {
+        for (int i = 0; i < numDispatcherThreads; i++) {
+            this->dispatcherThreads.push_back(std::thread(&LegacyEventDispatcher::dispatch_thread_handler, this));
+        }
+    }
+    void dispatch(const std::function<void()>& op) {
+        std::unique_lock<std::mutex> lock(this->lock);
+        this->queue.push(op);
+        lock.unlock();
+        this->cv.notify_all();
+    }
+    void stop() {
+        std::unique_lock<std::mutex> lock(this->lock);
+        this->quit = true;
+        lock.unlock();
+        this->cv.notify_all();
+        for (auto& dispatcherThread : this->dispatcherThreads) {
+            dispatcherThread.join();
+        }
+    }
+
+ private:
+    void dispatch_thread_handler() {
+        std::unique_lock<std::mutex> lock(this->lock);
+        do {
+            this->cv.wait(lock, [&] { return (this->queue.size() || this->quit); });
+            if (!this->quit && this->queue.size()) {
+                auto op = std::move(this->queue.front());
+                this->queue.pop();
+                lock.unlock();
+                op();
+                lock.lock();
+            }
+        } while (!this->quit);
+    }
+    std::vector<std::thread> dispatcherThreads;
+    std::mutex lock;
+    std::queue<std::function<void()> > queue;
+    std::condition_variable cv;
+    bool quit{};
+};
+
+/**
+ * @brief Répartit numEvent événements espacés de intervalNanoseconds et affiche le débit et la latence
+ */
+template <typename D>
+void benchmark(const std::string& name, D& dispatcher, size_t numEvent, long intervalNanoseconds) {
+    std::vector<long> latencyList(numEvent);
+    std::atomic<size_t> numRun{};
+    Message message;
+    message.setType(Message::Type::MARKET_DATA_EVENTS_TRADE);
+    message.setElementList({Element()});
+    auto start = Clock::now();
+    for (size_t i = 0; i < numEvent; ++i) {
+        auto scheduled = start + std::chrono::nanoseconds(intervalNanoseconds * i);
+        while (Clock::now() < scheduled) {
+        }
+        Event event;
+        event.setType(Event::Type::SUBSCRIPTION_DATA);
+        event.addMessages({message});
+        dispatcher.dispatch([&latencyList, &numRun, i, event = std::move(event), dispatched = Clock::now()] {
+            latencyList[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - dispatched).count();
+            sink = event.getMessageList().size();
+            ++numRun;
+        });
+    }
+    while (numRun.load() < numEvent) {
+        std::this_thread::yield();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    std::sort(latencyList.begin(), latencyList.end());
+    std::cout << name << ": " << numEvent * 1e3 / elapsed << " M events/s, latency median " << latencyList[numEvent / 2] << " ns, p99 "
+              << latencyList[numEvent * 99 / 100] << " ns, p99.9 " << latencyList[numEvent * 999 / 1000] << " ns" << std::endl;
+}
+
+template <typename D>
+void benchmarkRates(const std::string& name, D& dispatcher) {
+    benchmark(name + " at 1M events/s", dispatcher, 1000000, 1000);
+    benchmark(name + " at full speed", dispatcher, 1000000, 0);
+    dispatcher.stop();
+}
+}  // namespace
+
+int main() {
+    LegacyEventDispatcher legacyEventDispatcher;
+    benchmarkRates("previous implementation", legacyEventDispatcher);
+    EventDispatcher mutexEventDispatcher;
+    benchmarkRates("mutex queue", mutexEventDispatcher);
+    EventDispatcher lockFreeEventDispatcher(1, 1 << 16);
+    benchmarkRates("lock-free queue", lockFreeEventDispatcher);
+    return 0;
+}
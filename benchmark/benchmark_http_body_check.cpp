@@ -0,0 +1,84 @@
+/**
+ * @file benchmark_http_body_check.cpp
+ * @brief Banc d'essai de la détection d'erreur dans les corps de réponse HTTP
+ *
+ * Mesure le coût par corps (ns/op) de :
+ * - std::regex construite à chaque appel, comme auparavant
+ * - std::regex construite une seule fois
+ * - JsonScanner avec le prédicat déclaratif du service
+ *
+ * Pour des réponses réelles d'OKX, de KuCoin, de Kraken et de Huobi.
+ */
+
+#include "../include/ccapi_cpp/ccapi_json_scanner.h"
+#include <chrono>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace ccapi;
+
+namespace {
+volatile size_t sink;
+
+/**
+ * @brief Exécute une fonction et affiche le temps moyen par opération
+ */
+template <typename F>
+void run(const std::string& name, size_t numOperation, F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << static_cast<double>(elapsed) / numOperation << " ns/op" << std::endl;
+}
+
+/**
+ * @brief Compare les trois approches pour un corps et son prédicat de succès
+ */
+void benchmark(const std::string& name, const std::string& body, const char* pattern, const std::vector<JsonScanner::Condition>& successConditionList,
+               size_t numRound) {
+    run(name + " regex constructed per call", numRound, [&] {
+        for (size_t r = 0; r < numRound; ++r) {
+            sink = !std::regex_search(body, std::regex(pattern));
+        }
+    });
+    std::regex regex(pattern);
+    run(name + " regex constructed once", numRound, [&] {
+        for (size_t r = 0; r < numRound; ++r) {
+            sink = !std::regex_search(body, regex);
+        }
+    });
+    run(name + " JsonScanner", numRound, [&] {
+        for (size_t r = 0; r < numRound; ++r) {
+            sink = !JsonScanner::matchAny(body, successConditionList);
+        }
+    });
+}
+}  // namespace
+
+int main() {
+    benchmark("okx create order",
+              R"({"code":"0","data":[{"clOrdId":"oktswap6","ordId":"312269865356374016","tag":"","sCode":"0","sMsg":""}],"inTime":"1695190491421339",)"
+              R"("msg":"","outTime":"1695190491423240"})",
+              "\"code\":\\s*\"0\"", {JsonScanner::hasKeyValue("code", "\"0\"")}, 100000);
+    benchmark("okx rejected order", R"({"code":"1","data":[{"clOrdId":"","ordId":"","sCode":"51008","sMsg":"Order failed. Insufficient USDT balance",)"
+              R"("tag":""}],"inTime":"1695190491421339","msg":"","outTime":"1695190491423240"})",
+              "\"code\":\\s*\"0\"", {JsonScanner::hasKeyValue("code", "\"0\"")}, 100000);
+    benchmark("kucoin cancel order", R"({"code":"200000","data":{"cancelledOrderIds":["5bd6e9286d99522a52e458de"]}})", "\"code\":\\s*\"200000\"",
+              {JsonScanner::hasKeyValue("code", "\"200000\"")}, 100000);
+    benchmark("kraken balance",
+              R"({"error":[],"result":{"ZUSD":"171288.6158","ZEUR":"504861.8946","XXBT":"1011.1908877900","XETH":"818.5500000000",)"
+              R"("USDT":"500000.00000000","DAI":"9999.9999999999","DOT":"2.5000000000","ETH2.S":"198.3970800000","ETH2":"2.5885574330"}})",
+              "\"error\":\\s*\\[\\]", {JsonScanner::hasKeyValue("error", "[]")}, 100000);
+    std::string openOrders = R"({"status":"ok","data":[)";
+    for (int i = 0; i < 50; ++i) {
+        openOrders += std::string(i == 0 ? "" : ",") + R"({"symbol":"btcusdt","source":"api","price":")" + std::to_string(30000 + i) +
+                      R"(.000000000000000000","created-at":1565244793184,"amount":"0.010000000000000000","account-id":10000000,)"
+                      R"("filled-cash-amount":"0.0","client-order-id":"","filled-amount":"0.0","filled-fees":"0.0","id":)" + std::to_string(38477101630 + i) +
+                      R"(,"state":"submitted","type":"buy-limit"})";
+    }
+    openOrders += "]}";
+    benchmark("huobi 50 open orders", openOrders, "\"err-code\"", {JsonScanner::hasKey("err-code")}, 20000);
+    return 0;
+}
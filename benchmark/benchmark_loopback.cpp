@@ -0,0 +1,162 @@
+/**
+ * @file benchmark_loopback.cpp
+ * @brief Banc d'essai du débit de réception websocket sur la boucle locale selon le backend d'entrées-sorties
+ *
+ * Un serveur websocket local (sans TLS) envoie au plus vite des trames de données de marché sur plusieurs connexions. Le client les lit sur les
+ * io_context d'un ServiceContext, comme le fait Service, et mesure :
+ * - le débit atteint (trames/s et Mo/s)
+ * - les changements de contexte volontaires et involontaires du processus
+ *
+ * Le backend (epoll ou io_uring) est choisi à la compilation : construire une fois sans et une fois avec -DCCAPI_ENABLE_IO_URING=ON pour comparer.
+ * Pour compter les appels système par trame, lancer le banc d'essai sous `strace -f -c` ou `perf stat -e raw_syscalls:sys_enter`.
+ *
+ * Usage : benchmark_loopback [nombre de connexions] [trames par connexion] [nombre d'io_context]
+ */
+
+#include "boost/asio.hpp"
+#include "boost/asio/ssl.hpp"
+#include "boost/beast/core.hpp"
+#include "boost/beast/websocket.hpp"
+#include "../include/ccapi_cpp/service/ccapi_service_context.h"
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+using tcp = boost::asio::ip::tcp;
+
+namespace {
+typedef std::chrono::steady_clock Clock;
+const std::string frame =
+    R"({"arg":{"channel":"books5","instId":"BTC-USDT"},"data":[{"asks":[["42000.1","0.5","0","2"],["42000.2","1.2","0","3"]],)"
+    R"("bids":[["41999.9","0.8","0","1"],["41999.8","2.1","0","4"]],"instId":"BTC-USDT","ts":"1700000000123","seqId":123456789}]})";
+
+/**
+ * @brief Côté serveur d'une connexion : accepte la poignée de main puis écrit numFrame trames à la suite
+ */
+class ServerSession : public std::enable_shared_from_this<ServerSession> {
+ public:
+    ServerSession(tcp::socket&& socket, size_t numFrame) : stream(std::move(socket)), numFrame(numFrame) {}
+    void start() { this->stream.async_accept(beast::bind_front_handler(&ServerSession::onAccept, this->shared_from_this())); }
+    void onAccept(beast::error_code ec) { this->onWrite(ec, 0); }
+    void onWrite(beast::error_code ec, size_t) {
+        if (ec || this->numWritten++ == this->numFrame) {
+            return;
+        }
+        this->stream.async_write(boost::asio::buffer(frame), beast::bind_front_handler(&ServerSession::onWrite, this->shared_from_this()));
+    }
+
+ private:
+    websocket::stream<beast::tcp_stream> stream;
+    size_t numFrame;
+    size_t numWritten{};
+};
+
+// the sessions are kept in serverSessionPtrList so that no connection is closed before the client has read everything
+void accept(tcp::acceptor& acceptor, size_t numConnection, size_t numFrame, std::vector<std::shared_ptr<ServerSession>>& serverSessionPtrList) {
+    if (numConnection == 0) {
+        return;
+    }
+    acceptor.async_accept([&acceptor, numConnection, numFrame, &serverSessionPtrList](beast::error_code ec, tcp::socket socket) {
+        if (ec) {
+            return;
+        }
+        socket.set_option(tcp::no_delay(true));
+        serverSessionPtrList.push_back(std::make_shared<ServerSession>(std::move(socket), numFrame));
+        serverSessionPtrList.back()->start();
+        accept(acceptor, numConnection - 1, numFrame, serverSessionPtrList);
+    });
+}
+
+/**
+ * @brief Côté client d'une connexion : lit les trames et arrête le ServiceContext après la dernière trame attendue de toutes les connexions
+ */
+class ClientSession : public std::enable_shared_from_this<ClientSession> {
+ public:
+    ClientSession(boost::asio::io_context& ioContext, std::atomic<size_t>& numFrameLeft, ServiceContext& serviceContext)
+        : stream(ioContext), numFrameLeft(numFrameLeft), serviceContext(serviceContext) {}
+    void connect(unsigned short port) {
+        beast::get_lowest_layer(this->stream).connect(tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), port));
+        beast::get_lowest_layer(this->stream).socket().set_option(tcp::no_delay(true));
+        this->stream.handshake("127.0.0.1:" + std::to_string(port), "/");
+    }
+    void read() { this->stream.async_read(this->buffer, beast::bind_front_handler(&ClientSession::onRead, this->shared_from_this())); }
+    void onRead(beast::error_code ec, size_t n) {
+        if (ec) {
+            std::cerr << "read error: " << ec.message() << std::endl;
+            this->serviceContext.stop();
+            return;
+        }
+        this->numByte += n;
+        this->buffer.consume(n);
+        if (--this->numFrameLeft == 0) {
+            this->serviceContext.stop();
+            return;
+        }
+        this->read();
+    }
+    size_t numByte{};
+
+ private:
+    websocket::stream<beast::tcp_stream> stream;
+    beast::flat_buffer buffer;
+    std::atomic<size_t>& numFrameLeft;
+    ServiceContext& serviceContext;
+};
+
+long getNumContextSwitch() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t numConnection = argc > 1 ? std::stoul(argv[1]) : 8;
+    size_t numFramePerConnection = argc > 2 ? std::stoul(argv[2]) : 100000;
+    int numIoContext = argc > 3 ? std::stoi(argv[3]) : 1;
+    std::cout << "io backend: " << ServiceContext::getIoBackend() << ", io_uring supported: " << ServiceContext::isIoUringSupported() << std::endl;
+    boost::asio::io_context serverIoContext;
+    tcp::acceptor acceptor(serverIoContext, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0));
+    unsigned short port = acceptor.local_endpoint().port();
+    std::vector<std::shared_ptr<ServerSession>> serverSessionPtrList;
+    accept(acceptor, numConnection, numFramePerConnection, serverSessionPtrList);
+    std::thread serverThread([&serverIoContext] { serverIoContext.run(); });
+    ServiceContext serviceContext(numIoContext, {});
+    std::atomic<size_t> numFrameLeft{numConnection * numFramePerConnection};
+    std::vector<std::shared_ptr<ClientSession>> clientSessionPtrList;
+    for (size_t i = 0; i < numConnection; ++i) {
+        boost::asio::io_context& ioContext = *serviceContext.getServiceContextForService()->ioContextPtr;
+        clientSessionPtrList.push_back(std::make_shared<ClientSession>(ioContext, numFrameLeft, serviceContext));
+        clientSessionPtrList.back()->connect(port);
+    }
+    long numContextSwitch = getNumContextSwitch();
+    auto start = Clock::now();
+    for (auto& clientSessionPtr : clientSessionPtrList) {
+        clientSessionPtr->read();
+    }
+    serviceContext.start();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    numContextSwitch = getNumContextSwitch() - numContextSwitch;
+    serverThread.join();
+    size_t numFrame = numConnection * numFramePerConnection - numFrameLeft.load();
+    size_t numByte = 0;
+    for (const auto& clientSessionPtr : clientSessionPtrList) {
+        numByte += clientSessionPtr->numByte;
+    }
+    std::cout << numConnection << " connections, " << numIoContext << " io_contexts: " << numFrame << " frames in " << seconds << " s, "
+              << static_cast<long>(numFrame / seconds) << " frames/s, " << numByte / seconds / 1e6 << " MB/s, " << numContextSwitch << " context switches"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file benchmark_okx_parse.cpp
+ * @brief Banc d'essai de l'analyse des messages books-l2-tbt d'OKX
+ *
+ * Mesure le coût par message (ns/op) de :
+ * - L'analyse avec copie (std::string + Parse + GetString), comme auparavant
+ * - L'analyse en place (tampon réutilisé + ParseInsitu + string_view)
+ * - L'analyse en place dans une arène réinitialisée à chaque message
+ *
+ * Pour un instantané de 400 niveaux et pour une mise à jour typique.
+ */
+
+#include "../include/ccapi_cpp/ccapi_util_private.h"
+#include "rapidjson/document.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace ccapi;
+namespace rj = rapidjson;
+
+namespace {
+volatile size_t sink;
+
+/**
+ * @brief Exécute une fonction et affiche le temps moyen par opération
+ */
+template <typename F>
+void run(const std::string& name, size_t numOperation, F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << static_cast<double>(elapsed) / numOperation << " ns/op" << std::endl;
+}
+
+/**
+ * @brief Construit un message books-l2-tbt réaliste avec le nombre de niveaux donné de chaque côté
+ */
+std::string makeMessage(const std::string& action, int numLevel) {
+    std::string bids;
+    std::string asks;
+    for (int i = 0; i < numLevel; ++i) {
+        std::string separator = i == 0 ? "" : ",";
+        bids += separator + "[\"" + std::to_string(41999 - i) + "." + std::to_string(i % 10) + "0\",\"" + std::to_string(i % 7) + ".00" +
+                std::to_string(100 + i) + "\",\"0\",\"" + std::to_string(1 + i % 5) + "\"]";
+        asks += separator + "[\"" + std::to_string(42000 + i) + "." + std::to_string(i % 10) + "0\",\"" + std::to_string(i % 3) + ".1" +
+                std::to_string(200 + i) + "0\",\"0\",\"" + std::to_string(1 + i % 4) + "\"]";
+    }
+    return "{\"arg\":{\"channel\":\"books-l2-tbt\",\"instId\":\"BTC-USDT\"},\"action\":\"" + action + "\",\"data\":[{\"asks\":[" + asks + "],\"bids\":[" +
+           bids + "],\"ts\":\"1700000000123\",\"checksum\":-855196043,\"prevSeqId\":123456788,\"seqId\":123456789}]}";
+}
+
+/**
+ * @brief Extrait les niveaux de la même manière que MarketDataServiceOkx::processTextMessage
+ */
+template <typename ToString>
+size_t extract(const rj::Value& document, ToString toString) {
+    size_t n = 0;
+    for (const auto& datum : document["data"].GetArray()) {
+        for (const char* side : {"bids", "asks"}) {
+            for (const auto& x : datum[side].GetArray()) {
+                std::string price = toString(x[0]);
+                std::string size = toString(x[1]);
+                n += price.size() + size.size();
+            }
+        }
+    }
+    return n;
+}
+
+void benchmark(const std::string& name, const std::string& message, size_t numRound) {
+    std::vector<char> frame(message.begin(), message.end());
+    run(name + " copy + Parse", numRound, [&] {
+        for (size_t r = 0; r < numRound; ++r) {
+            std::string textMessage(frame.data(), frame.size());
+            rj::Document document;
+            document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+            sink = extract(document, [](const rj::Value& value) { return UtilString::normalizeDecimalString(value.GetString()); });
+        }
+    });
+    std::string insituParseBuffer;
+    run(name + " reused buffer + ParseInsitu", numRound, [&] {
+        for (size_t r = 0; r < numRound; ++r) {
+            insituParseBuffer.assign(frame.data(), frame.size());
+            rj::Document document;
+            document.ParseInsitu<rj::kParseNumbersAsStringsFlag>(&insituParseBuffer[0]);
+            sink = extract(document, [](const rj::Value& value) {
+                return UtilString::normalizeDecimalString(std::string_view(value.GetString(), value.GetStringLength()));
+            });
+        }
+    });
+    std::vector<char> jsonParseArenaBuffer(1 << 20);
+    rj::MemoryPoolAllocator<> jsonParseArena(jsonParseArenaBuffer.data(), jsonParseArenaBuffer.size());
+    run(name + " reused buffer + ParseInsitu + arena", numRound, [&] {
+        for (size_t r = 0; r < numRound; ++r) {
+            insituParseBuffer.assign(frame.data(), frame.size());
+            jsonParseArena.Clear();
+            rj::GenericDocument<rj::UTF8<>, rj::MemoryPoolAllocator<>, rj::MemoryPoolAllocator<>> document(&jsonParseArena, 1 << 14, &jsonParseArena);
+            document.ParseInsitu<rj::kParseNumbersAsStringsFlag>(&insituParseBuffer[0]);
+            sink = extract(document, [](const rj::Value& value) {
+                return UtilString::normalizeDecimalString(std::string_view(value.GetString(), value.GetStringLength()));
+            });
+        }
+    });
+}
+}  // namespace
+
+int main() {
+    benchmark("snapshot 400 levels", makeMessage("snapshot", 400), 2000);
+    benchmark("update 5 levels", makeMessage("update", 5), 200000);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file benchmark_queue.cpp
+ * @brief Banc d'essai de la file d'événements sous contention
+ *
+ * Mesure le coût par événement (ns/op) du transfert de 1 à 8 producteurs vers un consommateur qui vide la file par removeAll, pour :
+ * - la file protégée par mutex
+ * - la file sans verrou
+ */
+
+#include "../include/ccapi_cpp/ccapi_event.h"
+#include "../include/ccapi_cpp/ccapi_queue.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+namespace {
+volatile size_t sink;
+
+/**
+ * @brief Exécute une fonction et affiche le temps moyen par opération
+ */
+template <typename F>
+void run(const std::string& name, size_t numOperation, F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << static_cast<double>(elapsed) / numOperation << " ns/op" << std::endl;
+}
+
+/**
+ * @brief Fait pousser numPerProducer événements par chaque producteur pendant que le thread courant les consomme
+ */
+void benchmark(const std::string& name, Queue<Event>& queue, int numProducer, size_t numPerProducer) {
+    run(name + " " + std::to_string(numProducer) + " producer(s)", numProducer * numPerProducer, [&] {
+        std::vector<std::thread> producerList;
+        for (int p = 0; p < numProducer; ++p) {
+            producerList.emplace_back([&queue, numPerProducer] {
+                Message message;
+                message.setType(Message::Type::MARKET_DATA_EVENTS_TRADE);
+                for (size_t i = 0; i < numPerProducer; ++i) {
+                    Event event;
+                    event.setType(Event::Type::SUBSCRIPTION_DATA);
+                    event.addMessages({message});
+                    queue.pushBack(std::move(event));
+                }
+            });
+        }
+        std::vector<Event> eventList;
+        size_t numReceived = 0;
+        while (numReceived < numProducer * numPerProducer) {
+            eventList.clear();
+            queue.removeAll(eventList);
+            numReceived += eventList.size();
+        }
+        for (auto& producer : producerList) {
+            producer.join();
+        }
+        sink = numReceived;
+    });
+}
+}  // namespace
+
+int main() {
+    const size_t maxSize = 1 << 16;
+    const size_t numPerProducer = 1000000;
+    for (int numProducer : {1, 2, 4, 8}) {
+        Queue<Event> mutexQueue(maxSize, QueueOverflowPolicy::BLOCK);
+        benchmark("mutex", mutexQueue, numProducer, numPerProducer);
+        Queue<Event> lockFreeQueue(maxSize, QueueOverflowPolicy::BLOCK, true);
+        benchmark("lock-free", lockFreeQueue, numProducer, numPerProducer);
+    }
+    return 0;
+}
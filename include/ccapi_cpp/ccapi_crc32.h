@@ -0,0 +1,171 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_CRC32_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_CRC32_H_
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "ccapi_cpp/ccapi_macro.h"
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CCAPI_CRC32_PCLMUL
+#include <immintrin.h>
+#endif
+namespace ccapi {
+/**
+ * This class provides a streaming CRC-32 with the IEEE 802.3 polynomial (the one used by zlib and by UtilAlgorithm::crc), so that a checksum can be computed
+ * over text fed piece by piece instead of over a string built for that purpose. Small pieces are gathered into an inline buffer which is handed to a block
+ * kernel once full or when the value is read. The portable kernel is slicing-by-8, i.e. 8 bytes per step through 8 lookup tables generated at compile
+ * time. On x86 CPUs reporting PCLMULQDQ and SSE4.1 at runtime, blocks of at least 64 bytes are folded with carry-less multiplications instead.
+ */
+class Crc32 CCAPI_FINAL {
+ public:
+  static constexpr size_t BUFFER_SIZE = 256;
+  void update(char c) {
+    if (this->bufferSize == BUFFER_SIZE) {
+      this->flush();
+    }
+    this->buffer[this->bufferSize++] = static_cast<unsigned char>(c);
+  }
+  void update(const char* data, size_t size) {
+    // an empty std::string_view can have a null data(), which memcpy does not accept even for a size of 0
+    if (size == 0) {
+      return;
+    }
+    if (this->bufferSize + size > BUFFER_SIZE) {
+      this->flush();
+      if (size >= BUFFER_SIZE) {
+        this->state = updateBlock(this->state, reinterpret_cast<const unsigned char*>(data), size);
+        return;
+      }
+    }
+    std::memcpy(this->buffer + this->bufferSize, data, size);
+    this->bufferSize += size;
+  }
+  void update(std::string_view data) { this->update(data.data(), data.size()); }
+  uint32_t getValue() const { return ~updateBlock(this->state, this->buffer, this->bufferSize); }
+  void reset() {
+    this->state = 0xFFFFFFFFu;
+    this->bufferSize = 0;
+  }
+  static uint32_t calculate(std::string_view data) { return ~updateBlock(0xFFFFFFFFu, reinterpret_cast<const unsigned char*>(data.data()), data.size()); }
+  // the kernels work on the bit-inverted state, i.e. on 0xFFFFFFFF initially and on ~crc to continue a checksum
+  static uint32_t updatePortable(uint32_t state, const unsigned char* data, size_t size) {
+    while (size >= 8) {
+      uint32_t low = state ^ (static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 | static_cast<uint32_t>(data[2]) << 16 |
+                              static_cast<uint32_t>(data[3]) << 24);
+      uint32_t high =
+          static_cast<uint32_t>(data[4]) | static_cast<uint32_t>(data[5]) << 8 | static_cast<uint32_t>(data[6]) << 16 | static_cast<uint32_t>(data[7]) << 24;
+      state = TABLE[7][low & 0xFF] ^ TABLE[6][(low >> 8) & 0xFF] ^ TABLE[5][(low >> 16) & 0xFF] ^ TABLE[4][low >> 24] ^ TABLE[3][high & 0xFF] ^
+              TABLE[2][(high >> 8) & 0xFF] ^ TABLE[1][(high >> 16) & 0xFF] ^ TABLE[0][high >> 24];
+      data += 8;
+      size -= 8;
+    }
+    while (size > 0) {
+      state = TABLE[0][(state ^ *data) & 0xFF] ^ (state >> 8);
+      ++data;
+      --size;
+    }
+    return state;
+  }
+#ifdef CCAPI_CRC32_PCLMUL
+  // "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel, 2009), size must be at least 64 and a multiple of 16
+  __attribute__((target("pclmul,sse4.1"))) static uint32_t updatePclmul(uint32_t state, const unsigned char* data, size_t size) {
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(state)));
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    data += 64;
+    size -= 64;
+    while (size >= 64) {
+      x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+      x2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x2, k, 0x11), _mm_clmulepi64_si128(x2, k, 0x00)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)));
+      x3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x3, k, 0x11), _mm_clmulepi64_si128(x3, k, 0x00)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)));
+      x4 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x4, k, 0x11), _mm_clmulepi64_si128(x4, k, 0x00)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)));
+      data += 64;
+      size -= 64;
+    }
+    // fold the 4 lanes and then every remaining block of 16 into 128 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x2);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x3);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x4);
+    while (size >= 16) {
+      x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+      data += 16;
+      size -= 16;
+    }
+    // fold 128 bits to 64 bits, then Barrett reduce to 32 bits
+    __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00), x2);
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+  }
+#endif
+  static bool isHardwareAccelerated() {
+#ifdef CCAPI_CRC32_PCLMUL
+    static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+    return supported;
+#else
+    return false;
+#endif
+  }
+  static uint32_t updateBlock(uint32_t state, const unsigned char* data, size_t size) {
+#ifdef CCAPI_CRC32_PCLMUL
+    if (size >= 64 && isHardwareAccelerated()) {
+      size_t sizeFolded = size & ~static_cast<size_t>(15);
+      state = updatePclmul(state, data, sizeFolded);
+      data += sizeFolded;
+      size -= sizeFolded;
+    }
+#endif
+    return updatePortable(state, data, size);
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  static constexpr std::array<std::array<uint32_t, 256>, 8> TABLE = [] {
+    std::array<std::array<uint32_t, 256>, 8> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; ++j) {
+        crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0);
+      }
+      table[0][i] = crc;
+    }
+    for (int k = 1; k < 8; ++k) {
+      for (int i = 0; i < 256; ++i) {
+        table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+      }
+    }
+    return table;
+  }();
+  void flush() {
+    this->state = updateBlock(this->state, this->buffer, this->bufferSize);
+    this->bufferSize = 0;
+  }
+  uint32_t state{0xFFFFFFFFu};
+  size_t bufferSize{};
+  unsigned char buffer[BUFFER_SIZE];
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_CRC32_H_
@@ -2,33 +2,74 @@
 #define INCLUDE_CCAPI_CPP_CCAPI_ELEMENT_H_
 #include <map>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
+#include "ccapi_cpp/ccapi_element_key.h"
 #include "ccapi_cpp/ccapi_util_private.h"
 namespace ccapi {
 /**
  * Element represents an item in a message. The value(s) in an Element can be queried in a number of ways. Use the getValue() functions to retrieve a single
- * value. Use the getNameValueMap() function (or getTagValueMap() function for FIX API) to retrieve all the values.
+ * value. Use the getNameValueMap() function (or getTagValueMap() function for FIX API) to retrieve all the values. The names listed in ElementKey are stored
+ * as small integer ids next to their values in a flat list, other names are kept as strings in a second flat list, and the map returned by getNameValueMap()
+ * is only built on its first call after a modification. That call is therefore not safe to make concurrently from several threads on the same Element.
  */
 class Element CCAPI_FINAL {
  public:
   explicit Element(bool isFix = false) : isFix(isFix) {}
-  void insert(const std::string& name, const std::string& value) { this->nameValueMap.insert(std::pair<std::string, std::string>(name, value)); }
+  // an existing value is not overwritten, the same as std::map::insert
+  void insert(std::string_view name, const std::string& value) {
+    int keyId = ElementKey::find(name);
+    if (keyId != ElementKey::NOT_FOUND) {
+      if (!this->findValue(keyId)) {
+        this->keyIdValueList.emplace_back(keyId, value);
+        this->isNameValueMapStale = true;
+      }
+    } else if (!this->findValue(name)) {
+      this->nameValueList.emplace_back(std::string(name), value);
+      this->isNameValueMapStale = true;
+    }
+  }
   void insert(int tag, const std::string& value) { this->tagValueMap.insert(std::pair<int, std::string>(tag, value)); }
-  void emplace(std::string& name, std::string& value) { this->nameValueMap.emplace(std::move(name), std::move(value)); }
+  void emplace(std::string_view name, std::string& value) {
+    int keyId = ElementKey::find(name);
+    if (keyId != ElementKey::NOT_FOUND) {
+      if (!this->findValue(keyId)) {
+        this->keyIdValueList.emplace_back(keyId, std::move(value));
+        this->isNameValueMapStale = true;
+      }
+    } else if (!this->findValue(name)) {
+      this->nameValueList.emplace_back(std::string(name), std::move(value));
+      this->isNameValueMapStale = true;
+    }
+  }
+  void emplace(std::string& name, std::string& value) {
+    int keyId = ElementKey::find(name);
+    if (keyId != ElementKey::NOT_FOUND) {
+      if (!this->findValue(keyId)) {
+        this->keyIdValueList.emplace_back(keyId, std::move(value));
+        this->isNameValueMapStale = true;
+      }
+    } else if (!this->findValue(name)) {
+      this->nameValueList.emplace_back(std::move(name), std::move(value));
+      this->isNameValueMapStale = true;
+    }
+  }
   void emplace(int tag, std::string& value) { this->tagValueMap.emplace(std::move(tag), std::move(value)); }
-  bool has(const std::string& name) const { return this->nameValueMap.find(name) != this->nameValueMap.end(); }
+  bool has(std::string_view name) const { return this->findValue(name) != nullptr; }
   bool has(int tag) const { return this->tagValueMap.find(tag) != this->tagValueMap.end(); }
-  std::string getValue(const std::string& name, const std::string valueDefault = "") const {
-    auto it = this->nameValueMap.find(name);
-    return it == this->nameValueMap.end() ? valueDefault : it->second;
+  std::string getValue(std::string_view name, const std::string valueDefault = "") const {
+    const std::string* value = this->findValue(name);
+    return value ? *value : valueDefault;
   }
   std::string getValue(int tag, const std::string valueDefault = "") const {
     auto it = this->tagValueMap.find(tag);
     return it == this->tagValueMap.end() ? valueDefault : it->second;
   }
   std::string toString() const {
-    std::string output =
-        isFix ? "Element [tagValueMap = " + ccapi::toString(tagValueMap) + "]" : "Element [nameValueMap = " + ccapi::toString(nameValueMap) + "]";
+    std::string output = isFix ? "Element [tagValueMap = " + ccapi::toString(tagValueMap) + "]"
+                               : "Element [nameValueMap = " + ccapi::toString(this->getNameValueMap()) + "]";
     return output;
   }
   std::string toStringPretty(const int space = 2, const int leftToIndent = 0, const bool indentFirstLine = true) const {
@@ -37,17 +78,52 @@ class Element CCAPI_FINAL {
     std::string output = isFix ? (indentFirstLine ? sl : "") + "Element [\n" + ss +
                                      "tagValueMap = " + ccapi::toStringPretty(tagValueMap, space, space + leftToIndent, false) + "\n" + sl + "]"
                                : (indentFirstLine ? sl : "") + "Element [\n" + ss +
-                                     "nameValueMap = " + ccapi::toStringPretty(nameValueMap, space, space + leftToIndent, false) + "\n" + sl + "]";
+                                     "nameValueMap = " + ccapi::toStringPretty(this->getNameValueMap(), space, space + leftToIndent, false) + "\n" + sl + "]";
     return output;
   }
-  const std::map<std::string, std::string>& getNameValueMap() const { return nameValueMap; }
+  const std::map<std::string, std::string>& getNameValueMap() const {
+    if (this->isNameValueMapStale) {
+      this->nameValueMap.clear();
+      for (const auto& x : this->keyIdValueList) {
+        this->nameValueMap.emplace(ElementKey::getName(x.first), x.second);
+      }
+      for (const auto& x : this->nameValueList) {
+        this->nameValueMap.emplace(x.first, x.second);
+      }
+      this->isNameValueMapStale = false;
+    }
+    return nameValueMap;
+  }
   const std::map<int, std::string>& getTagValueMap() const { return tagValueMap; }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  private:
 #endif
+  const std::string* findValue(int keyId) const {
+    for (const auto& x : this->keyIdValueList) {
+      if (x.first == keyId) {
+        return &x.second;
+      }
+    }
+    return nullptr;
+  }
+  const std::string* findValue(std::string_view name) const {
+    int keyId = ElementKey::find(name);
+    if (keyId != ElementKey::NOT_FOUND) {
+      return this->findValue(keyId);
+    }
+    for (const auto& x : this->nameValueList) {
+      if (x.first == name) {
+        return &x.second;
+      }
+    }
+    return nullptr;
+  }
   bool isFix;
-  std::map<std::string, std::string> nameValueMap;
+  std::vector<std::pair<int, std::string>> keyIdValueList;
+  std::vector<std::pair<std::string, std::string>> nameValueList;
+  mutable bool isNameValueMapStale{};
+  mutable std::map<std::string, std::string> nameValueMap;
   std::map<int, std::string> tagValueMap;
 };
 } /* namespace ccapi */
@@ -0,0 +1,115 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_ELEMENT_KEY_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_ELEMENT_KEY_H_
+#include <array>
+#include <string_view>
+
+#include "ccapi_cpp/ccapi_macro.h"
+// the names put into an Element by the services, each of them is interned as a small integer id, aliases such as CCAPI_EM_INSTRUMENT are left out
+#define CCAPI_ELEMENT_KEY_LIST(CCAPI_ELEMENT_KEY)                          \
+  CCAPI_ELEMENT_KEY(CCAPI_BEST_BID_N_PRICE)                                \
+  CCAPI_ELEMENT_KEY(CCAPI_BEST_BID_N_SIZE)                                 \
+  CCAPI_ELEMENT_KEY(CCAPI_BEST_ASK_N_PRICE)                                \
+  CCAPI_ELEMENT_KEY(CCAPI_BEST_ASK_N_SIZE)                                 \
+  CCAPI_ELEMENT_KEY(CCAPI_LAST_PRICE)                                      \
+  CCAPI_ELEMENT_KEY(CCAPI_LAST_SIZE)                                       \
+  CCAPI_ELEMENT_KEY(CCAPI_TRADE_ID)                                        \
+  CCAPI_ELEMENT_KEY(CCAPI_AGG_TRADE_ID)                                    \
+  CCAPI_ELEMENT_KEY(CCAPI_IS_BUYER_MAKER)                                  \
+  CCAPI_ELEMENT_KEY(CCAPI_SEQUENCE_NUMBER)                                 \
+  CCAPI_ELEMENT_KEY(CCAPI_OPEN_PRICE)                                      \
+  CCAPI_ELEMENT_KEY(CCAPI_HIGH_PRICE)                                      \
+  CCAPI_ELEMENT_KEY(CCAPI_LOW_PRICE)                                       \
+  CCAPI_ELEMENT_KEY(CCAPI_CLOSE_PRICE)                                     \
+  CCAPI_ELEMENT_KEY(CCAPI_VOLUME)                                          \
+  CCAPI_ELEMENT_KEY(CCAPI_QUOTE_VOLUME)                                    \
+  CCAPI_ELEMENT_KEY(CCAPI_IS_MAKER)                                        \
+  CCAPI_ELEMENT_KEY(CCAPI_INSTRUMENT)                                      \
+  CCAPI_ELEMENT_KEY(CCAPI_INSTRUMENT_STATUS)                               \
+  CCAPI_ELEMENT_KEY(CCAPI_BASE_ASSET)                                      \
+  CCAPI_ELEMENT_KEY(CCAPI_QUOTE_ASSET)                                     \
+  CCAPI_ELEMENT_KEY(CCAPI_MARGIN_ASSET)                                    \
+  CCAPI_ELEMENT_KEY(CCAPI_SETTLE_ASSET)                                    \
+  CCAPI_ELEMENT_KEY(CCAPI_UNDERLYING_SYMBOL)                               \
+  CCAPI_ELEMENT_KEY(CCAPI_ORDER_PRICE_INCREMENT)                           \
+  CCAPI_ELEMENT_KEY(CCAPI_ORDER_QUANTITY_INCREMENT)                        \
+  CCAPI_ELEMENT_KEY(CCAPI_ORDER_QUANTITY_MIN)                              \
+  CCAPI_ELEMENT_KEY(CCAPI_ORDER_QUANTITY_MAX)                              \
+  CCAPI_ELEMENT_KEY(CCAPI_ORDER_PRICE_TIMES_QUANTITY_MIN)                  \
+  CCAPI_ELEMENT_KEY(CCAPI_CONTRACT_SIZE)                                   \
+  CCAPI_ELEMENT_KEY(CCAPI_CONTRACT_MULTIPLIER)                             \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_ID)                                     \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_CLIENT_ORDER_ID)                              \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_SIDE)                                   \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_LIMIT_PRICE)                            \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_QUANTITY)                               \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_REMAINING_QUANTITY)                     \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_CUMULATIVE_FILLED_QUANTITY)             \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_CUMULATIVE_FILLED_PRICE_TIMES_QUANTITY) \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_STATUS)                                 \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_LAST_EXECUTED_PRICE)                    \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_LAST_EXECUTED_SIZE)                     \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_FEE_QUANTITY)                           \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ORDER_FEE_ASSET)                              \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ACCOUNT_ID)                                   \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ACCOUNT_TYPE)                                 \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_ASSET)                                        \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_QUANTITY_TOTAL)                               \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_QUANTITY_AVAILABLE_FOR_TRADING)               \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_QUANTITY_LIABILITY)                           \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_POSITION_SIDE)                                \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_POSITION_ENTRY_PRICE)                         \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_POSITION_LEVERAGE)                            \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_POSITION_COST)                                \
+  CCAPI_ELEMENT_KEY(CCAPI_EM_UNREALIZED_PNL)                               \
+  CCAPI_ELEMENT_KEY(CCAPI_CONNECTION_ID)                                   \
+  CCAPI_ELEMENT_KEY(CCAPI_CONNECTION_URL)                                  \
+  CCAPI_ELEMENT_KEY(CCAPI_REASON)                                          \
+  CCAPI_ELEMENT_KEY(CCAPI_ERROR_MESSAGE)                                   \
+  CCAPI_ELEMENT_KEY(CCAPI_INFO_MESSAGE)                                    \
+  CCAPI_ELEMENT_KEY(CCAPI_HTTP_STATUS_CODE)                                \
+  CCAPI_ELEMENT_KEY(CCAPI_HTTP_BODY)                                       \
+  CCAPI_ELEMENT_KEY(CCAPI_WEBSOCKET_MESSAGE_PAYLOAD)                       \
+  CCAPI_ELEMENT_KEY(CCAPI_LAST_UPDATED_TIME_SECONDS)
+#define CCAPI_ELEMENT_KEY_NAME(x) std::string_view(x),
+namespace ccapi {
+/**
+ * This class provides the compile-time table of the names which an Element stores as small integer ids instead of strings. The table is generated from the
+ * constants in ccapi_macro.h listed in CCAPI_ELEMENT_KEY_LIST, the id of a name being its position in that list. Since those constants can be redefined by
+ * the user, the table is sorted at compile time rather than relying on the order of the list, and a lookup is a binary search over string_views which can be
+ * evaluated by the compiler when the name is a literal.
+ */
+class ElementKey CCAPI_FINAL {
+ public:
+  static constexpr int NOT_FOUND = -1;
+  static constexpr std::string_view nameList[] = {CCAPI_ELEMENT_KEY_LIST(CCAPI_ELEMENT_KEY_NAME)};
+  static constexpr int size = static_cast<int>(sizeof(nameList) / sizeof(nameList[0]));
+  static constexpr std::array<int, size> sortedIdList = [] {
+    std::array<int, size> output{};
+    for (int i = 0; i < size; ++i) {
+      int j = i;
+      while (j > 0 && nameList[i] < nameList[output[j - 1]]) {
+        output[j] = output[j - 1];
+        --j;
+      }
+      output[j] = i;
+    }
+    return output;
+  }();
+  // the id of the given name, or NOT_FOUND if it isn't interned, the sort is stable so that the first of several keys with the same name wins
+  static constexpr int find(std::string_view name) {
+    int low = 0;
+    int high = size;
+    while (low < high) {
+      int middle = low + (high - low) / 2;
+      if (nameList[sortedIdList[middle]] < name) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low < size && nameList[sortedIdList[low]] == name ? sortedIdList[low] : NOT_FOUND;
+  }
+  static constexpr std::string_view getName(int id) { return nameList[id]; }
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_ELEMENT_KEY_H_
@@ -2,28 +2,98 @@
 #define INCLUDE_CCAPI_CPP_CCAPI_EVENT_DISPATCHER_H_
 #include <stddef.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "ccapi_cpp/ccapi_inline_task.h"
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_ring_buffer.h"
 #include "ccapi_cpp/ccapi_util_private.h"
 namespace ccapi {
 /**
  * Dispatches events from one or more Sessions through callbacks. EventDispatcher objects are optionally specified when Session objects are constructed. A
  * single EventDispatcher can be shared by multiple Session objects. The EventDispatcher provides an event-driven interface, generating callbacks from one or
  * more internal threads for one or more sessions.
+ *
+ * Operations are stored as move-only tasks which keep small captures (e.g. an Event) inline. By default they are handed to the dispatcher threads through a
+ * mutex-guarded queue. If lockFreeQueueSize is positive, they go through a lock-free RingBuffer of that size instead: a dispatcher thread drains up to
+ * CCAPI_EVENT_DISPATCHER_BATCH_SIZE tasks at a time, spins for a while when there are none, adapting how long to how often spinning paid off, and only then
+ * parks, so that dispatch only wakes one parked thread, and only if there is one. When a lock-free queue is full, dispatch waits for room, except on a
+ * dispatcher thread, which may be the only one able to make room, and once the dispatcher is stopping: the operation is then dropped with a warning.
+ *
+ * If isSharded is set, operations dispatched with a key are ordered per key while different keys run in parallel: each key is hashed to one of
+ * CCAPI_EVENT_DISPATCHER_NUM_SHARD_PER_THREAD shards per thread, each shard has its own lock-free queue, and a shard is drained by at most one thread at a
+ * time. Shard i is drained by thread i modulo numDispatcherThreads, and if enableWorkStealing is set, also by any thread that has nothing else to do.
+ * Operations dispatched without a key go to the first shard. A thread only counts the operations of a shard as work to do while no other thread is draining
+ * it, so that it spins down and parks rather than loop on them, and the thread that releases a shard with operations left wakes a parked thread up.
+ *
+ * Every queue has a lane per priority. A thread takes high-priority operations first, strictly if highPriorityWeight is not positive, otherwise it takes a
+ * waiting normal-priority operation after every highPriorityWeight high-priority ones. The order of a key is kept within each lane. If enableLaneMetrics is
+ * set, the time that operations spend queued is measured per lane: each thread counts the operations that it runs, and getLaneMetrics sums the threads up.
  */
 
 class EventDispatcher CCAPI_FINAL {
  public:
-  explicit EventDispatcher(const int numDispatcherThreads = 1) : numDispatcherThreads(numDispatcherThreads) {
+  typedef InlineTask<CCAPI_EVENT_DISPATCHER_TASK_INLINE_SIZE> Task;
+  enum class Priority {
+    HIGH,
+    NORMAL,
+  };
+  static std::string priorityToString(Priority priority) {
+    std::string output;
+    switch (priority) {
+      case Priority::HIGH:
+        output = "HIGH";
+        break;
+      case Priority::NORMAL:
+        output = "NORMAL";
+        break;
+      default:
+        CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
+    }
+    return output;
+  }
+  struct LaneMetrics {
+    size_t numTask{};
+    long long totalQueueDelayNanoseconds{};
+    long long maxQueueDelayNanoseconds{};
+    std::string toString() const {
+      long long averageQueueDelayNanoseconds = numTask > 0 ? totalQueueDelayNanoseconds / static_cast<long long>(numTask) : 0;
+      std::string output = "LaneMetrics [numTask = " + ccapi::toString(numTask) +
+                           ", averageQueueDelayNanoseconds = " + ccapi::toString(averageQueueDelayNanoseconds) +
+                           ", maxQueueDelayNanoseconds = " + ccapi::toString(maxQueueDelayNanoseconds) + "]";
+      return output;
+    }
+  };
+  explicit EventDispatcher(const int numDispatcherThreads = 1, const size_t lockFreeQueueSize = 0, const bool isSharded = false,
+                           const bool enableWorkStealing = false, const int highPriorityWeight = 8, const bool enableLaneMetrics = false)
+      : numDispatcherThreads(numDispatcherThreads),
+        enableWorkStealing(enableWorkStealing),
+        highPriorityWeight(highPriorityWeight),
+        enableLaneMetrics(enableLaneMetrics) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     CCAPI_LOGGER_TRACE("numDispatcherThreads = " + size_tToString(numDispatcherThreads));
+    if (enableLaneMetrics) {
+      this->laneMetricsCounterList.reset(new LaneMetricsCounter[this->numDispatcherThreads * 2]);
+    }
+    if (isSharded) {
+      for (size_t i = 0; i < this->numDispatcherThreads * CCAPI_EVENT_DISPATCHER_NUM_SHARD_PER_THREAD; ++i) {
+        this->shardList.emplace_back(new Shard(lockFreeQueueSize > 0 ? lockFreeQueueSize : CCAPI_EVENT_DISPATCHER_SHARD_QUEUE_SIZE));
+      }
+      for (size_t i = 0; i < this->numDispatcherThreads; ++i) {
+        this->workerList.emplace_back(new Worker());
+      }
+    } else if (lockFreeQueueSize > 0) {
+      this->lanesPtr.reset(new Lanes(lockFreeQueueSize));
+    }
     this->start();
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
@@ -31,16 +101,31 @@ class EventDispatcher CCAPI_FINAL {
     CCAPI_LOGGER_FUNCTION_ENTER;
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
-  void dispatch(const std::function<void()>& op) {
+  template <class F>
+  void dispatch(F&& op) {
+    this->dispatch(0, Priority::NORMAL, std::forward<F>(op));
+  }
+  template <class F>
+  void dispatch(const size_t key, F&& op) {
+    this->dispatch(key, Priority::NORMAL, std::forward<F>(op));
+  }
+  // operations with the same key and priority run in the order they were dispatched if the dispatcher is sharded
+  template <class F>
+  void dispatch(const size_t key, const Priority priority, F&& op) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     if (this->shouldContinue.load()) {
       CCAPI_LOGGER_TRACE("start to dispatch an operation");
-      std::unique_lock<std::mutex> lock(this->lock);
-      this->queue.push(op);
-      // Manual unlocking is done before notifying, to avoid waking up
-      // the waiting thread only to block again (see notify_one for details)
-      lock.unlock();
-      this->cv.notify_all();
+      if (this->enableLaneMetrics) {
+        Task task([op = std::forward<F>(op), dispatched = std::chrono::steady_clock::now(), laneIndex = toIndex(priority)]() mutable {
+          currentThreadLaneMetricsCounterList()[laneIndex].add(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - dispatched).count());
+          op();
+        });
+        this->push(key, priority, task);
+      } else {
+        Task task(std::forward<F>(op));
+        this->push(key, priority, task);
+      }
     } else {
       CCAPI_LOGGER_WARN("dispatching of events were paused");
     }
@@ -49,7 +134,13 @@ class EventDispatcher CCAPI_FINAL {
   void start() {
     this->shouldContinue = true;
     for (size_t i = 0; i < numDispatcherThreads; i++) {
-      this->dispatcherThreads.push_back(std::thread(&EventDispatcher::dispatch_thread_handler, this));
+      if (!this->shardList.empty()) {
+        this->dispatcherThreads.push_back(std::thread(&EventDispatcher::dispatch_thread_handler_sharded, this, i));
+      } else if (this->lanesPtr) {
+        this->dispatcherThreads.push_back(std::thread(&EventDispatcher::dispatch_thread_handler_lock_free, this, i));
+      } else {
+        this->dispatcherThreads.push_back(std::thread(&EventDispatcher::dispatch_thread_handler, this, i));
+      }
     }
   }
   void resume() { this->shouldContinue = true; }
@@ -59,25 +150,187 @@ class EventDispatcher CCAPI_FINAL {
     this->quit = true;
     lock.unlock();
     this->cv.notify_all();
+    for (auto& workerPtr : this->workerList) {
+      {
+        std::lock_guard<std::mutex> workerLock(workerPtr->lock);
+      }
+      workerPtr->cv.notify_all();
+    }
     for (auto& dispatcherThread : this->dispatcherThreads) {
       dispatcherThread.join();
     }
   }
+  // how many operations of a priority have run so far and how long they were queued, all zero unless enableLaneMetrics is set
+  LaneMetrics getLaneMetrics(const Priority priority) const {
+    LaneMetrics laneMetrics;
+    if (this->laneMetricsCounterList) {
+      for (size_t i = 0; i < this->numDispatcherThreads; ++i) {
+        const LaneMetricsCounter& laneMetricsCounter = this->laneMetricsCounterList[i * 2 + toIndex(priority)];
+        laneMetrics.numTask += laneMetricsCounter.numTask.load(std::memory_order_relaxed);
+        laneMetrics.totalQueueDelayNanoseconds += laneMetricsCounter.totalQueueDelayNanoseconds.load(std::memory_order_relaxed);
+        laneMetrics.maxQueueDelayNanoseconds =
+            std::max(laneMetrics.maxQueueDelayNanoseconds, laneMetricsCounter.maxQueueDelayNanoseconds.load(std::memory_order_relaxed));
+      }
+    }
+    return laneMetrics;
+  }
+  // how many operations have been dropped because their lock-free queue was full
+  size_t getNumDroppedTask() const { return this->numDroppedTask.load(std::memory_order_relaxed); }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  private:
 #endif
-  void dispatch_thread_handler() {
+  struct Lanes {
+    explicit Lanes(size_t queueSize) : highPriorityRingBuffer(queueSize), normalPriorityRingBuffer(queueSize) {}
+    RingBuffer<Task>& get(Priority priority) { return priority == Priority::HIGH ? this->highPriorityRingBuffer : this->normalPriorityRingBuffer; }
+    RingBuffer<Task> highPriorityRingBuffer;
+    RingBuffer<Task> normalPriorityRingBuffer;
+  };
+  struct Shard {
+    explicit Shard(size_t queueSize) : lanes(queueSize) {}
+    Lanes lanes;
+    // held by the thread draining the shard until it has run what it took out, which keeps the order of each key
+    alignas(CCAPI_CACHE_LINE_SIZE) std::atomic<bool> isClaimed{};
+  };
+  struct Worker {
+    // the number of operations queued in the shards owned by the thread
+    alignas(CCAPI_CACHE_LINE_SIZE) std::atomic<long> numPendingTask{};
+    std::atomic<int> numParkedThread{};
+    std::atomic<bool> isWakeUpRequested{};
+    std::mutex lock;
+    std::condition_variable cv;
+  };
+  // written only by the thread it belongs to, so that counting an operation takes plain stores rather than read-modify-writes
+  struct LaneMetricsCounter {
+    void add(long long queueDelayNanoseconds) {
+      this->numTask.store(this->numTask.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      this->totalQueueDelayNanoseconds.store(this->totalQueueDelayNanoseconds.load(std::memory_order_relaxed) + queueDelayNanoseconds,
+                                             std::memory_order_relaxed);
+      if (queueDelayNanoseconds > this->maxQueueDelayNanoseconds.load(std::memory_order_relaxed)) {
+        this->maxQueueDelayNanoseconds.store(queueDelayNanoseconds, std::memory_order_relaxed);
+      }
+    }
+    alignas(CCAPI_CACHE_LINE_SIZE) std::atomic<size_t> numTask{};
+    std::atomic<long long> totalQueueDelayNanoseconds{};
+    std::atomic<long long> maxQueueDelayNanoseconds{};
+  };
+  static constexpr size_t minNumSpin = 64;
+  static constexpr size_t maxNumSpin = 16384;
+  static size_t toIndex(Priority priority) { return priority == Priority::HIGH ? 0 : 1; }
+  // the dispatcher whose thread the caller runs on, if any
+  static const EventDispatcher*& currentThreadEventDispatcher() {
+    thread_local const EventDispatcher* eventDispatcher{};
+    return eventDispatcher;
+  }
+  // the lane metrics counters of the dispatcher thread the caller runs on, one per priority
+  static LaneMetricsCounter*& currentThreadLaneMetricsCounterList() {
+    thread_local LaneMetricsCounter* laneMetricsCounterList{};
+    return laneMetricsCounterList;
+  }
+  void setUpThread(const size_t threadIndex) {
+    currentThreadEventDispatcher() = this;
+    if (this->laneMetricsCounterList) {
+      currentThreadLaneMetricsCounterList() = &this->laneMetricsCounterList[threadIndex * 2];
+    }
+  }
+  void push(const size_t key, const Priority priority, Task& task) {
+    if (!this->shardList.empty()) {
+      size_t shardIndex = key % this->shardList.size();
+      if (!this->pushOrDrop(this->shardList[shardIndex]->lanes.get(priority), task)) {
+        return;
+      }
+      this->workerList[shardIndex % this->numDispatcherThreads]->numPendingTask.fetch_add(1);
+      this->wakeUpForShard(shardIndex);
+    } else if (this->lanesPtr) {
+      if (!this->pushOrDrop(this->lanesPtr->get(priority), task)) {
+        return;
+      }
+      this->numPendingTask.fetch_add(1);
+      // pairs with the increment of numParkedThread before a dispatcher thread checks numPendingTask for the last time
+      if (this->numParkedThread.load() > 0) {
+        {
+          std::lock_guard<std::mutex> lock(this->lock);
+        }
+        this->cv.notify_one();
+      }
+    } else {
+      std::unique_lock<std::mutex> lock(this->lock);
+      this->queueList[toIndex(priority)].push(std::move(task));
+      // Manual unlocking is done before notifying, to avoid waking up
+      // the waiting thread only to block again (see notify_one for details)
+      lock.unlock();
+      this->cv.notify_one();
+    }
+  }
+  bool pushOrDrop(RingBuffer<Task>& ringBuffer, Task& task) {
+    while (!ringBuffer.tryPush(std::move(task))) {
+      if (currentThreadEventDispatcher() == this || this->quit.load()) {
+        CCAPI_LOGGER_WARN("an operation was dropped since its queue is full");
+        this->numDroppedTask.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    return true;
+  }
+  static void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+  }
+  // whether the next operation should preferably be a high-priority one, given how many were taken in a row
+  bool shouldPreferHighPriority(const int numConsecutiveHighPriorityTask) const {
+    return this->highPriorityWeight <= 0 || numConsecutiveHighPriorityTask < this->highPriorityWeight;
+  }
+  bool tryPop(Lanes& lanes, Task& task, int& numConsecutiveHighPriorityTask) {
+    bool shouldPreferHigh = this->shouldPreferHighPriority(numConsecutiveHighPriorityTask);
+    if (shouldPreferHigh && lanes.highPriorityRingBuffer.tryPop(task)) {
+      ++numConsecutiveHighPriorityTask;
+      return true;
+    }
+    if (lanes.normalPriorityRingBuffer.tryPop(task)) {
+      numConsecutiveHighPriorityTask = 0;
+      return true;
+    }
+    if (!shouldPreferHigh && lanes.highPriorityRingBuffer.tryPop(task)) {
+      ++numConsecutiveHighPriorityTask;
+      return true;
+    }
+    return false;
+  }
+  // runs up to CCAPI_EVENT_DISPATCHER_BATCH_SIZE operations and returns how many, each is uncounted from numPendingTask as soon as it is taken out so that
+  // idle threads do not take the rest of the batch for work waiting to be picked up
+  size_t runBatch(Lanes& lanes, std::atomic<long>& numPendingTask, int& numConsecutiveHighPriorityTask) {
+    Task task;
+    size_t numTask = 0;
+    while (numTask < CCAPI_EVENT_DISPATCHER_BATCH_SIZE && this->tryPop(lanes, task, numConsecutiveHighPriorityTask)) {
+      numPendingTask.fetch_sub(1);
+      task();
+      task.reset();
+      ++numTask;
+    }
+    return numTask;
+  }
+  void dispatch_thread_handler(const size_t threadIndex) {
     CCAPI_LOGGER_FUNCTION_ENTER;
+    this->setUpThread(threadIndex);
+    int numConsecutiveHighPriorityTask = 0;
+    std::queue<Task>& highPriorityQueue = this->queueList[toIndex(Priority::HIGH)];
+    std::queue<Task>& normalPriorityQueue = this->queueList[toIndex(Priority::NORMAL)];
     std::unique_lock<std::mutex> lock(this->lock);
     do {
-      CCAPI_LOGGER_TRACE("predicate is " + size_tToString(this->queue.size()));
-      this->cv.wait(lock, [&] { return (this->queue.size() || this->quit); });
+      CCAPI_LOGGER_TRACE("predicate is " + size_tToString(highPriorityQueue.size() + normalPriorityQueue.size()));
+      this->cv.wait(lock, [&] { return (highPriorityQueue.size() || normalPriorityQueue.size() || this->quit); });
       CCAPI_LOGGER_TRACE("wait has exited");
-      CCAPI_LOGGER_TRACE("after wait, this->queue.size() = " + size_tToString(this->queue.size()));
-      if (!this->quit && this->queue.size()) {
-        auto op = std::move(this->queue.front());
-        this->queue.pop();
+      if (!this->quit && (highPriorityQueue.size() || normalPriorityQueue.size())) {
+        bool isHighPriority =
+            highPriorityQueue.size() && (normalPriorityQueue.empty() || this->shouldPreferHighPriority(numConsecutiveHighPriorityTask));
+        std::queue<Task>& queue = isHighPriority ? highPriorityQueue : normalPriorityQueue;
+        numConsecutiveHighPriorityTask = isHighPriority ? numConsecutiveHighPriorityTask + 1 : 0;
+        auto op = std::move(queue.front());
+        queue.pop();
         lock.unlock();
         op();
         lock.lock();
@@ -85,13 +338,153 @@ class EventDispatcher CCAPI_FINAL {
     } while (!this->quit);
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
+  void dispatch_thread_handler_lock_free(const size_t threadIndex) {
+    CCAPI_LOGGER_FUNCTION_ENTER;
+    this->setUpThread(threadIndex);
+    int numConsecutiveHighPriorityTask = 0;
+    size_t numSpin = minNumSpin;
+    while (!this->quit.load()) {
+      if (this->runBatch(*this->lanesPtr, this->numPendingTask, numConsecutiveHighPriorityTask) > 0) {
+        continue;
+      }
+      size_t i = 0;
+      while (i < numSpin && this->numPendingTask.load(std::memory_order_relaxed) <= 0 && !this->quit.load(std::memory_order_relaxed)) {
+        relax();
+        ++i;
+      }
+      if (i < numSpin) {
+        numSpin = std::min(numSpin * 2, maxNumSpin);
+        continue;
+      }
+      numSpin = std::max(numSpin / 2, minNumSpin);
+      std::unique_lock<std::mutex> lock(this->lock);
+      this->numParkedThread.fetch_add(1);
+      this->cv.wait(lock, [&] { return this->numPendingTask.load() > 0 || this->quit.load(); });
+      this->numParkedThread.fetch_sub(1);
+    }
+    CCAPI_LOGGER_FUNCTION_EXIT;
+  }
+  void wakeUp(Worker& worker) {
+    worker.isWakeUpRequested = true;
+    {
+      std::lock_guard<std::mutex> lock(worker.lock);
+    }
+    worker.cv.notify_one();
+  }
+  // wakes up a parked thread which may drain the shard: its owner, or if the owner is busy and work stealing is enabled, any other
+  void wakeUpForShard(const size_t shardIndex) {
+    Worker& worker = *this->workerList[shardIndex % this->numDispatcherThreads];
+    if (worker.numParkedThread.load() > 0) {
+      this->wakeUp(worker);
+    } else if (this->enableWorkStealing) {
+      for (auto& workerPtr : this->workerList) {
+        if (workerPtr->numParkedThread.load() > 0) {
+          this->wakeUp(*workerPtr);
+          break;
+        }
+      }
+    }
+  }
+  static bool hasTask(const Shard& shard) { return shard.lanes.highPriorityRingBuffer.size() > 0 || shard.lanes.normalPriorityRingBuffer.size() > 0; }
+  // runs what it takes out of the shard unless another thread is draining it
+  bool drainShard(const size_t shardIndex, int& numConsecutiveHighPriorityTask) {
+    Shard& shard = *this->shardList[shardIndex];
+    if (shard.isClaimed.load(std::memory_order_relaxed) || shard.isClaimed.exchange(true, std::memory_order_acquire)) {
+      return false;
+    }
+    size_t numTask = this->runBatch(shard.lanes, this->workerList[shardIndex % this->numDispatcherThreads]->numPendingTask, numConsecutiveHighPriorityTask);
+    // sequentially consistent, like the increment of numParkedThread before a parking thread checks the claim for the last time
+    shard.isClaimed.store(false);
+    // the threads which found the shard claimed may have parked, and this one may not come back to it if it was stealing
+    if (numTask > 0 && hasTask(shard)) {
+      this->wakeUpForShard(shardIndex);
+    }
+    return numTask > 0;
+  }
+  // whether a shard owned by the worker holds operations which no other thread is draining
+  bool hasUnclaimedTask(const size_t workerIndex) const {
+    if (this->workerList[workerIndex]->numPendingTask.load(std::memory_order_relaxed) <= 0) {
+      return false;
+    }
+    for (size_t i = workerIndex; i < this->shardList.size(); i += this->numDispatcherThreads) {
+      const Shard& shard = *this->shardList[i];
+      if (!shard.isClaimed.load() && hasTask(shard)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  bool hasRunnableTask(const size_t workerIndex) const {
+    if (this->hasUnclaimedTask(workerIndex)) {
+      return true;
+    }
+    if (this->enableWorkStealing) {
+      for (size_t i = 0; i < this->workerList.size(); ++i) {
+        if (i != workerIndex && this->hasUnclaimedTask(i)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+  void dispatch_thread_handler_sharded(const size_t workerIndex) {
+    CCAPI_LOGGER_FUNCTION_ENTER;
+    this->setUpThread(workerIndex);
+    Worker& worker = *this->workerList[workerIndex];
+    int numConsecutiveHighPriorityTask = 0;
+    size_t numSpin = minNumSpin;
+    while (!this->quit.load()) {
+      bool hasRun = false;
+      for (size_t i = workerIndex; i < this->shardList.size(); i += this->numDispatcherThreads) {
+        hasRun = this->drainShard(i, numConsecutiveHighPriorityTask) || hasRun;
+      }
+      if (!hasRun && this->enableWorkStealing) {
+        for (size_t i = 0; i < this->shardList.size(); ++i) {
+          if (i % this->numDispatcherThreads != workerIndex) {
+            hasRun = this->drainShard(i, numConsecutiveHighPriorityTask) || hasRun;
+          }
+        }
+      }
+      if (hasRun) {
+        continue;
+      }
+      size_t i = 0;
+      while (i < numSpin && !this->hasRunnableTask(workerIndex) && !this->quit.load(std::memory_order_relaxed)) {
+        relax();
+        ++i;
+      }
+      if (i < numSpin) {
+        numSpin = std::min(numSpin * 2, maxNumSpin);
+        continue;
+      }
+      numSpin = std::max(numSpin / 2, minNumSpin);
+      std::unique_lock<std::mutex> lock(worker.lock);
+      worker.numParkedThread.fetch_add(1);
+      worker.cv.wait(lock, [&] { return this->hasRunnableTask(workerIndex) || worker.isWakeUpRequested.load() || this->quit.load(); });
+      worker.numParkedThread.fetch_sub(1);
+      worker.isWakeUpRequested = false;
+    }
+    CCAPI_LOGGER_FUNCTION_EXIT;
+  }
   size_t numDispatcherThreads;
+  bool enableWorkStealing{};
+  int highPriorityWeight{};
+  bool enableLaneMetrics{};
   std::atomic<bool> shouldContinue{};
   std::vector<std::thread> dispatcherThreads;
   std::mutex lock;
-  std::queue<std::function<void()> > queue;
+  std::queue<Task> queueList[2];
   std::condition_variable cv;
-  bool quit{};
+  std::atomic<bool> quit{};
+  std::unique_ptr<Lanes> lanesPtr;
+  // signed since a task may be consumed before it is counted
+  std::atomic<long> numPendingTask{};
+  std::atomic<int> numParkedThread{};
+  std::atomic<size_t> numDroppedTask{};
+  std::vector<std::unique_ptr<Shard>> shardList;
+  std::vector<std::unique_ptr<Worker>> workerList;
+  // two per dispatcher thread, indexed by the thread index times 2 plus the index of the priority
+  std::unique_ptr<LaneMetricsCounter[]> laneMetricsCounterList;
 };
 } /* namespace ccapi */
 #endif  // INCLUDE_CCAPI_CPP_CCAPI_EVENT_DISPATCHER_H_
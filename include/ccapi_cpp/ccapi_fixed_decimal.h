@@ -0,0 +1,312 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_FIXED_DECIMAL_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_FIXED_DECIMAL_H_
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+
+#include "ccapi_cpp/ccapi_decimal.h"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * This class provides a fixed-point decimal number made of a signed 64-bit mantissa and a scale (the number of digits after the decimal point), i.e. its
+ * value is mantissa * 10^-scale. Unlike Decimal, parsing works directly on a character buffer (e.g. a JSON string value) without any heap allocation, and
+ * comparison and arithmetic are plain integer operations. It is therefore much cheaper to use as the key of an order book. Values that compare equal also
+ * hash equally regardless of their scale, e.g. "0.10" and "0.1".
+ */
+class FixedDecimal CCAPI_FINAL {
+ public:
+  static constexpr int MAX_SCALE = 18;
+  // large enough for a sign, 19 digits, a leading "0." and a decimal point
+  static constexpr size_t MAX_STRING_LENGTH = 24;
+  static constexpr int64_t POW10[MAX_SCALE + 1] = {1LL,
+                                                   10LL,
+                                                   100LL,
+                                                   1000LL,
+                                                   10000LL,
+                                                   100000LL,
+                                                   1000000LL,
+                                                   10000000LL,
+                                                   100000000LL,
+                                                   1000000000LL,
+                                                   10000000000LL,
+                                                   100000000000LL,
+                                                   1000000000000LL,
+                                                   10000000000000LL,
+                                                   100000000000000LL,
+                                                   1000000000000000LL,
+                                                   10000000000000000LL,
+                                                   100000000000000000LL,
+                                                   1000000000000000000LL};
+  static constexpr double POW10_DOUBLE[MAX_SCALE + 1] = {1e0, 1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                                         1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+  FixedDecimal() {}
+  FixedDecimal(int64_t mantissa, int scale) : mantissa(mantissa), scale(scale) {
+    if (scale < 0 || scale > MAX_SCALE) {
+      CCAPI_LOGGER_FATAL("FixedDecimal scale out of range: " + std::to_string(scale));
+    }
+  }
+  explicit FixedDecimal(const std::string& originalValue, bool keepTrailingZero = false) {
+    if (!parse(originalValue.data(), originalValue.size(), *this, keepTrailingZero)) {
+      CCAPI_LOGGER_FATAL("FixedDecimal cannot parse input value: " + originalValue);
+    }
+  }
+  explicit FixedDecimal(const Decimal& decimal) : FixedDecimal(decimal.toString(), true) {}
+  /**
+   * Parse a decimal number such as "-123.4500" or "1.5e-8" from [data, data + length). No heap allocation is performed. Return false if the input is not a
+   * number or does not fit into the mantissa/scale range, in which case output is left unchanged. Trailing zeros after the decimal point are dropped unless
+   * keepTrailingZero is true (the same convention as Decimal).
+   */
+  static bool parse(const char* data, size_t length, FixedDecimal& output, bool keepTrailingZero = false) {
+    const char* p = data;
+    const char* end = data + length;
+    if (p == end) {
+      return false;
+    }
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+      negative = *p == '-';
+      ++p;
+    }
+    uint64_t mantissa = 0;
+    int scale = 0;
+    int pendingZero = 0;
+    bool seenDot = false;
+    bool seenDigit = false;
+    for (; p != end; ++p) {
+      const char c = *p;
+      if (c >= '0' && c <= '9') {
+        seenDigit = true;
+        const int digit = c - '0';
+        if (seenDot) {
+          // defer zeros after the decimal point so that trailing ones never touch the mantissa
+          if (digit == 0) {
+            ++pendingZero;
+            continue;
+          }
+          if (!multiplyAdd(mantissa, pendingZero + 1, digit)) {
+            return false;
+          }
+          scale += pendingZero + 1;
+          pendingZero = 0;
+        } else if (!multiplyAdd(mantissa, 1, digit)) {
+          return false;
+        }
+      } else if (c == '.' && !seenDot) {
+        seenDot = true;
+      } else if ((c == 'e' || c == 'E') && seenDigit) {
+        break;
+      } else {
+        return false;
+      }
+    }
+    if (!seenDigit) {
+      return false;
+    }
+    if (keepTrailingZero && pendingZero > 0) {
+      if (multiplyAdd(mantissa, pendingZero, 0)) {
+        scale += pendingZero;
+      }
+    }
+    if (p != end) {
+      ++p;
+      bool exponentNegative = false;
+      if (p != end && (*p == '-' || *p == '+')) {
+        exponentNegative = *p == '-';
+        ++p;
+      }
+      if (p == end) {
+        return false;
+      }
+      int exponent = 0;
+      for (; p != end; ++p) {
+        if (*p < '0' || *p > '9' || exponent > 1000) {
+          return false;
+        }
+        exponent = exponent * 10 + (*p - '0');
+      }
+      scale += exponentNegative ? exponent : -exponent;
+      if (scale < 0) {
+        if (mantissa != 0 && !multiplyAdd(mantissa, -scale, 0)) {
+          return false;
+        }
+        scale = 0;
+      }
+      if (!keepTrailingZero) {
+        while (scale > 0 && mantissa % 10 == 0) {
+          mantissa /= 10;
+          --scale;
+        }
+      }
+    }
+    if (scale > MAX_SCALE) {
+      return false;
+    }
+    output.mantissa = negative ? -static_cast<int64_t>(mantissa) : static_cast<int64_t>(mantissa);
+    output.scale = scale;
+    return true;
+  }
+  /**
+   * Parse a decimal number directly into a given scale, e.g. the scale of an instrument's tick size. Return false if the input has non-zero digits beyond
+   * that scale or does not fit into the mantissa.
+   */
+  static bool parse(const char* data, size_t length, int scale, FixedDecimal& output) {
+    FixedDecimal parsed;
+    if (!parse(data, length, parsed)) {
+      return false;
+    }
+    return parsed.rescale(scale, output);
+  }
+  // return false if the value cannot be represented exactly with the requested scale
+  bool rescale(int newScale, FixedDecimal& output) const {
+    if (newScale < 0 || newScale > MAX_SCALE) {
+      return false;
+    }
+    if (newScale >= this->scale) {
+      const int64_t factor = POW10[newScale - this->scale];
+      if (this->mantissa > std::numeric_limits<int64_t>::max() / factor || this->mantissa < std::numeric_limits<int64_t>::min() / factor) {
+        return false;
+      }
+      output.mantissa = this->mantissa * factor;
+    } else {
+      const int64_t factor = POW10[this->scale - newScale];
+      if (this->mantissa % factor != 0) {
+        return false;
+      }
+      output.mantissa = this->mantissa / factor;
+    }
+    output.scale = newScale;
+    return true;
+  }
+  FixedDecimal rescale(int newScale) const {
+    FixedDecimal output;
+    if (!this->rescale(newScale, output)) {
+      CCAPI_LOGGER_FATAL("FixedDecimal cannot be rescaled exactly to scale " + std::to_string(newScale));
+    }
+    return output;
+  }
+  // drop trailing zeros after the decimal point
+  FixedDecimal normalize() const {
+    FixedDecimal output = *this;
+    while (output.scale > 0 && output.mantissa % 10 == 0) {
+      output.mantissa /= 10;
+      --output.scale;
+    }
+    return output;
+  }
+  /**
+   * Write the decimal representation into buffer, which must have room for at least MAX_STRING_LENGTH characters. Exactly 'scale' digits are written after
+   * the decimal point. Return the number of characters written. No terminating null character is appended.
+   */
+  size_t toChars(char* buffer) const {
+    char digits[MAX_STRING_LENGTH];
+    uint64_t magnitude = this->mantissa < 0 ? static_cast<uint64_t>(0) - static_cast<uint64_t>(this->mantissa) : static_cast<uint64_t>(this->mantissa);
+    int numDigit = 0;
+    do {
+      digits[numDigit++] = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    size_t n = 0;
+    if (this->mantissa < 0) {
+      buffer[n++] = '-';
+    }
+    if (numDigit <= this->scale) {
+      buffer[n++] = '0';
+      buffer[n++] = '.';
+      for (int i = numDigit; i < this->scale; ++i) {
+        buffer[n++] = '0';
+      }
+      while (numDigit > 0) {
+        buffer[n++] = digits[--numDigit];
+      }
+    } else {
+      while (numDigit > this->scale) {
+        buffer[n++] = digits[--numDigit];
+      }
+      if (this->scale > 0) {
+        buffer[n++] = '.';
+        while (numDigit > 0) {
+          buffer[n++] = digits[--numDigit];
+        }
+      }
+    }
+    return n;
+  }
+  std::string toString() const {
+    char buffer[MAX_STRING_LENGTH];
+    return std::string(buffer, this->toChars(buffer));
+  }
+  double toDouble() const { return static_cast<double>(this->mantissa) / POW10_DOUBLE[this->scale]; }
+  Decimal toDecimal() const { return Decimal(this->toString(), true); }
+  int64_t getMantissa() const { return mantissa; }
+  int getScale() const { return scale; }
+  bool isZero() const { return this->mantissa == 0; }
+  static int compare(const FixedDecimal& l, const FixedDecimal& r) {
+    if (l.scale == r.scale) {
+      return (l.mantissa > r.mantissa) - (l.mantissa < r.mantissa);
+    }
+    const int64_t li = l.mantissa / POW10[l.scale];
+    const int64_t ri = r.mantissa / POW10[r.scale];
+    if (li != ri) {
+      return li < ri ? -1 : 1;
+    }
+    // the fractional parts are below 10^scale in magnitude, so widening them to MAX_SCALE digits cannot overflow
+    const int64_t lf = (l.mantissa % POW10[l.scale]) * POW10[MAX_SCALE - l.scale];
+    const int64_t rf = (r.mantissa % POW10[r.scale]) * POW10[MAX_SCALE - r.scale];
+    return (lf > rf) - (lf < rf);
+  }
+  friend bool operator<(const FixedDecimal& l, const FixedDecimal& r) { return compare(l, r) < 0; }
+  friend bool operator>(const FixedDecimal& l, const FixedDecimal& r) { return compare(l, r) > 0; }
+  friend bool operator<=(const FixedDecimal& l, const FixedDecimal& r) { return compare(l, r) <= 0; }
+  friend bool operator>=(const FixedDecimal& l, const FixedDecimal& r) { return compare(l, r) >= 0; }
+  friend bool operator==(const FixedDecimal& l, const FixedDecimal& r) { return compare(l, r) == 0; }
+  friend bool operator!=(const FixedDecimal& l, const FixedDecimal& r) { return compare(l, r) != 0; }
+  FixedDecimal negate() const {
+    FixedDecimal o = *this;
+    o.mantissa = -o.mantissa;
+    return o;
+  }
+  FixedDecimal add(const FixedDecimal& x) const {
+    FixedDecimal l, r;
+    const int s = std::max(this->scale, x.scale);
+    if (!this->rescale(s, l) || !x.rescale(s, r) || (r.mantissa > 0 && l.mantissa > std::numeric_limits<int64_t>::max() - r.mantissa) ||
+        (r.mantissa < 0 && l.mantissa < std::numeric_limits<int64_t>::min() - r.mantissa)) {
+      CCAPI_LOGGER_FATAL("FixedDecimal overflow: " + this->toString() + " + " + x.toString());
+    }
+    l.mantissa += r.mantissa;
+    return l;
+  }
+  FixedDecimal subtract(const FixedDecimal& x) const { return this->add(x.negate()); }
+  size_t hash() const {
+    const FixedDecimal n = this->normalize();
+    return std::hash<int64_t>()(n.mantissa) ^ (static_cast<size_t>(n.scale) << 1);
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  // mantissa = mantissa * 10^numDigit + digit, keeping it within the range of int64_t
+  static bool multiplyAdd(uint64_t& mantissa, int numDigit, int digit) {
+    if (numDigit > MAX_SCALE) {
+      return mantissa == 0 && digit == 0;
+    }
+    const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    const uint64_t factor = static_cast<uint64_t>(POW10[numDigit]);
+    if (mantissa > (limit - digit) / factor) {
+      return false;
+    }
+    mantissa = mantissa * factor + digit;
+    return true;
+  }
+  int64_t mantissa{};
+  int scale{};
+};
+} /* namespace ccapi */
+namespace std {
+template <>
+struct hash<ccapi::FixedDecimal> {
+  size_t operator()(const ccapi::FixedDecimal& x) const { return x.hash(); }
+};
+} /* namespace std */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_FIXED_DECIMAL_H_
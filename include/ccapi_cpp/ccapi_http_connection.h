@@ -1,5 +1,6 @@
 #ifndef INCLUDE_CCAPI_CPP_CCAPI_HTTP_CONNECTION_H_
 #define INCLUDE_CCAPI_CPP_CCAPI_HTTP_CONNECTION_H_
+#include <functional>
 #include <string>
 
 #include "ccapi_cpp/ccapi_logger.h"
@@ -12,6 +13,13 @@ class HttpConnection CCAPI_FINAL {
  public:
   HttpConnection(std::string host, std::string port, std::shared_ptr<beast::ssl_stream<beast::tcp_stream> > streamPtr)
       : host(host), port(port), streamPtr(streamPtr) {}
+  HttpConnection(const HttpConnection&) = delete;
+  HttpConnection& operator=(const HttpConnection&) = delete;
+  ~HttpConnection() {
+    if (this->closeHandler) {
+      this->closeHandler();
+    }
+  }
   std::string toString() const {
     std::ostringstream oss;
     oss << streamPtr;
@@ -23,6 +31,7 @@ class HttpConnection CCAPI_FINAL {
   std::string port;
   std::shared_ptr<beast::ssl_stream<beast::tcp_stream> > streamPtr;
   TimePoint lastReceiveDataTp{std::chrono::seconds{0}};
+  std::function<void()> closeHandler;  // called when the connection is destroyed, e.g. to free its room in an HttpConnectionPool
 };
 } /* namespace ccapi */
 #endif  // INCLUDE_CCAPI_CPP_CCAPI_HTTP_CONNECTION_H_
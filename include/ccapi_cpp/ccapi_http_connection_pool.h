@@ -0,0 +1,243 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_HTTP_CONNECTION_POOL_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_HTTP_CONNECTION_POOL_H_
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_http_connection.h"
+#include "ccapi_cpp/ccapi_macro.h"
+namespace ccapi {
+/**
+ * This class keeps the http connections of a service to one host from one local ip address. At most maxNumConnection connections are live at a time, whether
+ * idle in the pool or with a request in flight, so that concurrent requests each get a connection of their own up to that limit. A request which finds no idle
+ * connection and no room for a new one waits for the next connection to be released or closed, unless it expires first. Each idle connection expires on its own
+ * once it has not received data for the keep-alive timeout, and the connections which have been idle for a while can be taken out to be probed so that they and
+ * their TLS sessions stay warm. Spare connections can be opened ahead of the requests so that a number of connected and handshaked ones are always idle, ready
+ * to be handed to the next requests. The pool is only used from the io_context thread of its service, except for the metrics, which can be read from any
+ * thread.
+ */
+class HttpConnectionPool CCAPI_FINAL {
+ public:
+  struct Metrics {
+    size_t numHit{};                       // requests sent on an idle connection of the pool
+    size_t numNewConnection{};             // connections opened, each with a TLS handshake
+    size_t numExpired{};                   // idle connections dropped for the keep-alive timeout
+    size_t numWait{};                      // requests which waited for a connection
+    size_t numWaitTimeout{};               // requests which gave up waiting for a connection
+    long long totalWaitNanoseconds{};
+    long long maxWaitNanoseconds{};
+    size_t numKeepAliveProbe{};
+    size_t numKeepAliveProbeFailure{};
+    size_t numSpareConnection{};  // connections opened ahead of the requests, counted in numNewConnection as well
+    std::string toString() const {
+      long long averageWaitNanoseconds = numWait > 0 ? totalWaitNanoseconds / static_cast<long long>(numWait) : 0;
+      std::string output = "HttpConnectionPool::Metrics [numHit = " + ccapi::toString(numHit) + ", numNewConnection = " + ccapi::toString(numNewConnection) +
+                           ", numExpired = " + ccapi::toString(numExpired) + ", numWait = " + ccapi::toString(numWait) +
+                           ", numWaitTimeout = " + ccapi::toString(numWaitTimeout) +
+                           ", averageWaitNanoseconds = " + ccapi::toString(averageWaitNanoseconds) +
+                           ", maxWaitNanoseconds = " + ccapi::toString(maxWaitNanoseconds) + ", numKeepAliveProbe = " + ccapi::toString(numKeepAliveProbe) +
+                           ", numKeepAliveProbeFailure = " + ccapi::toString(numKeepAliveProbeFailure) +
+                           ", numSpareConnection = " + ccapi::toString(numSpareConnection) + "]";
+      return output;
+    }
+  };
+  // can be shared by the pools of a service to aggregate their metrics
+  struct MetricsCounter {
+    void addWait(long long waitNanoseconds) {
+      this->numWait.fetch_add(1, std::memory_order_relaxed);
+      this->totalWaitNanoseconds.fetch_add(waitNanoseconds, std::memory_order_relaxed);
+      long long max = this->maxWaitNanoseconds.load(std::memory_order_relaxed);
+      while (waitNanoseconds > max && !this->maxWaitNanoseconds.compare_exchange_weak(max, waitNanoseconds, std::memory_order_relaxed)) {
+      }
+    }
+    Metrics getMetrics() const {
+      Metrics metrics;
+      metrics.numHit = this->numHit.load(std::memory_order_relaxed);
+      metrics.numNewConnection = this->numNewConnection.load(std::memory_order_relaxed);
+      metrics.numExpired = this->numExpired.load(std::memory_order_relaxed);
+      metrics.numWait = this->numWait.load(std::memory_order_relaxed);
+      metrics.numWaitTimeout = this->numWaitTimeout.load(std::memory_order_relaxed);
+      metrics.totalWaitNanoseconds = this->totalWaitNanoseconds.load(std::memory_order_relaxed);
+      metrics.maxWaitNanoseconds = this->maxWaitNanoseconds.load(std::memory_order_relaxed);
+      metrics.numKeepAliveProbe = this->numKeepAliveProbe.load(std::memory_order_relaxed);
+      metrics.numKeepAliveProbeFailure = this->numKeepAliveProbeFailure.load(std::memory_order_relaxed);
+      metrics.numSpareConnection = this->numSpareConnection.load(std::memory_order_relaxed);
+      return metrics;
+    }
+    std::atomic<size_t> numHit{};
+    std::atomic<size_t> numNewConnection{};
+    std::atomic<size_t> numExpired{};
+    std::atomic<size_t> numWait{};
+    std::atomic<size_t> numWaitTimeout{};
+    std::atomic<long long> totalWaitNanoseconds{};
+    std::atomic<long long> maxWaitNanoseconds{};
+    std::atomic<size_t> numKeepAliveProbe{};
+    std::atomic<size_t> numKeepAliveProbeFailure{};
+    std::atomic<size_t> numSpareConnection{};
+  };
+  // a waiting request is handed a released connection, or nullptr if a closed connection made room for it to open a new one
+  typedef std::function<void(std::shared_ptr<HttpConnection>)> Waiter;
+  explicit HttpConnectionPool(const size_t maxNumConnection = 0, const size_t maxNumIdleConnection = 0, const long keepAliveTimeoutSeconds = 10,
+                              std::shared_ptr<MetricsCounter> metricsCounterPtr = std::make_shared<MetricsCounter>())
+      : maxNumConnection(maxNumConnection),
+        maxNumIdleConnection(maxNumIdleConnection),
+        keepAliveTimeoutSeconds(keepAliveTimeoutSeconds),
+        metricsCounterPtr(std::move(metricsCounterPtr)) {}
+  // the most recently used idle connection which has not expired, or nullptr, expired ones are dropped on the way
+  std::shared_ptr<HttpConnection> acquire(const TimePoint& now) {
+    while (!this->idleList.empty()) {
+      std::shared_ptr<HttpConnection> httpConnectionPtr = std::move(this->idleList.back());
+      this->idleList.pop_back();
+      if (!this->isExpired(*httpConnectionPtr, now)) {
+        this->metricsCounterPtr->numHit.fetch_add(1, std::memory_order_relaxed);
+        return httpConnectionPtr;
+      }
+      this->metricsCounterPtr->numExpired.fetch_add(1, std::memory_order_relaxed);
+    }
+    return nullptr;
+  }
+  // true if there is room for a new connection, which then counts as live until onClose
+  bool tryReserve() {
+    if (this->maxNumConnection > 0 && this->numConnection >= this->maxNumConnection) {
+      return false;
+    }
+    ++this->numConnection;
+    this->metricsCounterPtr->numNewConnection.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  // returns an id to expire the waiter with
+  size_t wait(Waiter waiter) {
+    this->waiterList.push_back({++this->lastWaiterId, std::chrono::steady_clock::now(), std::move(waiter)});
+    return this->lastWaiterId;
+  }
+  // a waiting request has waited for too long and is to be failed, false if it is no longer waiting
+  bool expireWaiter(const size_t waiterId) {
+    auto it = std::find_if(this->waiterList.begin(), this->waiterList.end(), [waiterId](const WaitingRequest& x) { return x.id == waiterId; });
+    if (it == this->waiterList.end()) {
+      return false;
+    }
+    this->waiterList.erase(it);
+    this->metricsCounterPtr->numWaitTimeout.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  // a connection whose response has been fully received is handed to the oldest waiting request or kept idle
+  void release(std::shared_ptr<HttpConnection> httpConnectionPtr) {
+    if (!this->waiterList.empty()) {
+      this->popWaiter()(std::move(httpConnectionPtr));
+      return;
+    }
+    if (this->maxNumIdleConnection > 0 && this->idleList.size() >= this->maxNumIdleConnection) {
+      this->idleList.pop_front();
+    }
+    this->idleList.push_back(std::move(httpConnectionPtr));
+  }
+  // a connection counted by tryReserve has been destroyed, its room goes to the oldest waiting request
+  void onClose() {
+    if (this->numConnection > 0) {
+      --this->numConnection;
+    }
+    if (!this->waiterList.empty() && (this->maxNumConnection == 0 || this->numConnection < this->maxNumConnection)) {
+      this->popWaiter()(nullptr);
+    }
+  }
+  // the idle connections which have not received data for probeIntervalSeconds, taken out of the pool to be probed and then released
+  std::vector<std::shared_ptr<HttpConnection>> takeIdleToProbe(const TimePoint& now, const long probeIntervalSeconds) {
+    std::vector<std::shared_ptr<HttpConnection>> httpConnectionPtrList;
+    for (auto it = this->idleList.begin(); it != this->idleList.end();) {
+      if (std::chrono::duration_cast<std::chrono::seconds>(now - (*it)->lastReceiveDataTp).count() >= probeIntervalSeconds) {
+        httpConnectionPtrList.push_back(std::move(*it));
+        it = this->idleList.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    this->metricsCounterPtr->numKeepAliveProbe.fetch_add(httpConnectionPtrList.size(), std::memory_order_relaxed);
+    return httpConnectionPtrList;
+  }
+  // true if a spare connection is to be opened so that numSpare connections are idle once those being opened are ready, which then counts as live until
+  // onClose and as being opened until releaseSpare. The expired idle connections are dropped first, and those which expire within marginSeconds do not count,
+  // so that their replacements are ready before they expire.
+  bool tryReserveSpare(size_t numSpare, const TimePoint& now, const long marginSeconds = 0) {
+    if (this->maxNumIdleConnection > 0) {
+      numSpare = std::min(numSpare, this->maxNumIdleConnection);
+    }
+    this->dropExpired(now);
+    size_t numIdleConnection = 0;
+    for (const auto& x : this->idleList) {
+      if (!this->isExpired(*x, now, marginSeconds)) {
+        ++numIdleConnection;
+      }
+    }
+    if (numIdleConnection + this->numSpareBeingOpened >= numSpare || !this->tryReserve()) {
+      return false;
+    }
+    ++this->numSpareBeingOpened;
+    this->metricsCounterPtr->numSpareConnection.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  // a spare connection is ready, or nullptr if it failed to open
+  void releaseSpare(std::shared_ptr<HttpConnection> httpConnectionPtr) {
+    if (this->numSpareBeingOpened > 0) {
+      --this->numSpareBeingOpened;
+    }
+    if (httpConnectionPtr) {
+      this->release(std::move(httpConnectionPtr));
+    }
+  }
+  void onKeepAliveProbeFailure() { this->metricsCounterPtr->numKeepAliveProbeFailure.fetch_add(1, std::memory_order_relaxed); }
+  // e.g. once a connection of the pool turned out to be closed by the server, which has likely closed the other idle ones as well
+  void clearIdle() { this->idleList.clear(); }
+  // e.g. once the service is stopping, the requests still waiting are then never sent
+  void clearWaiters() { this->waiterList.clear(); }
+  size_t getNumConnection() const { return this->numConnection; }
+  size_t getNumIdleConnection() const { return this->idleList.size(); }
+  size_t getNumWaiter() const { return this->waiterList.size(); }
+  Metrics getMetrics() const { return this->metricsCounterPtr->getMetrics(); }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct WaitingRequest {
+    size_t id;
+    std::chrono::steady_clock::time_point waitStart;
+    Waiter waiter;
+  };
+  // true if httpConnection has expired, or will have within marginSeconds
+  bool isExpired(const HttpConnection& httpConnection, const TimePoint& now, const long marginSeconds = 0) const {
+    return std::chrono::duration_cast<std::chrono::seconds>(now - httpConnection.lastReceiveDataTp).count() >= this->keepAliveTimeoutSeconds - marginSeconds;
+  }
+  void dropExpired(const TimePoint& now) {
+    for (auto it = this->idleList.begin(); it != this->idleList.end();) {
+      if (this->isExpired(**it, now)) {
+        it = this->idleList.erase(it);
+        this->metricsCounterPtr->numExpired.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        ++it;
+      }
+    }
+  }
+  Waiter popWaiter() {
+    WaitingRequest waitingRequest = std::move(this->waiterList.front());
+    this->waiterList.pop_front();
+    this->metricsCounterPtr->addWait(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waitingRequest.waitStart).count());
+    return std::move(waitingRequest.waiter);
+  }
+  size_t maxNumConnection{};
+  size_t maxNumIdleConnection{};
+  long keepAliveTimeoutSeconds{};
+  std::shared_ptr<MetricsCounter> metricsCounterPtr;
+  // the most recently used at the back
+  std::deque<std::shared_ptr<HttpConnection>> idleList;
+  std::deque<WaitingRequest> waiterList;
+  size_t lastWaiterId{};
+  size_t numConnection{};
+  size_t numSpareBeingOpened{};
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_HTTP_CONNECTION_POOL_H_
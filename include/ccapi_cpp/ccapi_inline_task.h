@@ -0,0 +1,104 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_INLINE_TASK_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_INLINE_TASK_H_
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ccapi_cpp/ccapi_macro.h"
+namespace ccapi {
+/**
+ * This class is a move-only void() callable, like a std::function that does not need to copy its target. Targets of up to Capacity bytes that are nothrow
+ * movable are stored inline, so that wrapping e.g. a lambda capturing an Event by move does not allocate. Larger targets are moved to the heap.
+ */
+template <size_t Capacity>
+class InlineTask CCAPI_FINAL {
+ public:
+  InlineTask() = default;
+  template <class F, class = std::enable_if_t<!std::is_same<std::decay_t<F>, InlineTask>::value>>
+  InlineTask(F&& f) {
+    using Target = std::decay_t<F>;
+    if constexpr (isInline<Target>()) {
+      new (this->storage) Target(std::forward<F>(f));
+    } else {
+      new (this->storage) Target*(new Target(std::forward<F>(f)));
+    }
+    this->operations = &operationsFor<Target>;
+  }
+  InlineTask(InlineTask&& other) noexcept { this->moveFrom(other); }
+  InlineTask& operator=(InlineTask&& other) noexcept {
+    if (this != &other) {
+      this->reset();
+      this->moveFrom(other);
+    }
+    return *this;
+  }
+  InlineTask(const InlineTask&) = delete;
+  InlineTask& operator=(const InlineTask&) = delete;
+  ~InlineTask() { this->reset(); }
+  void operator()() { this->operations->invoke(this->storage); }
+  explicit operator bool() const { return this->operations != nullptr; }
+  void reset() {
+    if (this->operations) {
+      this->operations->destroy(this->storage);
+      this->operations = nullptr;
+    }
+  }
+  template <class F>
+  static constexpr bool isInline() {
+    return sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<F>::value;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct Operations {
+    void (*invoke)(void* storage);
+    // move-constructs the target into destination and destroys it in source
+    void (*relocate)(void* destination, void* source);
+    void (*destroy)(void* storage);
+  };
+  template <class F>
+  static F& target(void* storage) {
+    if constexpr (isInline<F>()) {
+      return *std::launder(reinterpret_cast<F*>(storage));
+    } else {
+      return **std::launder(reinterpret_cast<F**>(storage));
+    }
+  }
+  template <class F>
+  static void invoke(void* storage) {
+    target<F>(storage)();
+  }
+  template <class F>
+  static void relocate(void* destination, void* source) {
+    if constexpr (isInline<F>()) {
+      F* f = std::launder(reinterpret_cast<F*>(source));
+      new (destination) F(std::move(*f));
+      f->~F();
+    } else {
+      new (destination) F*(*std::launder(reinterpret_cast<F**>(source)));
+    }
+  }
+  template <class F>
+  static void destroy(void* storage) {
+    if constexpr (isInline<F>()) {
+      std::launder(reinterpret_cast<F*>(storage))->~F();
+    } else {
+      delete *std::launder(reinterpret_cast<F**>(storage));
+    }
+  }
+  template <class F>
+  static constexpr Operations operationsFor{&invoke<F>, &relocate<F>, &destroy<F>};
+  void moveFrom(InlineTask& other) {
+    if (other.operations) {
+      other.operations->relocate(this->storage, other.storage);
+      this->operations = other.operations;
+      other.operations = nullptr;
+    }
+  }
+  alignas(std::max_align_t) unsigned char storage[Capacity];
+  const Operations* operations{};
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_INLINE_TASK_H_
@@ -0,0 +1,235 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_JSON_RECORD_STREAM_BODY_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_JSON_RECORD_STREAM_BODY_H_
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "boost/beast/core.hpp"
+#include "boost/beast/http.hpp"
+#include "ccapi_cpp/ccapi_macro.h"
+namespace ccapi {
+/**
+ * This class splits a JSON text fed piece by piece, e.g. an HTTP body while it is being received, into the elements of the array which is the value of a
+ * given key of the top-level object, such as "data" in {"code":"0","msg":"","data":[{...},{...}]}. Each element is handed to the record handler as soon as it
+ * is complete, without a copy if it arrived within a single piece, and then forgotten. Everything else is kept as the envelope, where the array shows up empty,
+ * so that at any time memory is only held for the envelope and for one incomplete element.
+ */
+class JsonRecordSplitter CCAPI_FINAL {
+ public:
+  JsonRecordSplitter(std::string_view arrayKey, std::function<void(std::string_view)> recordHandler, std::string& envelope)
+      : arrayKey(arrayKey), recordHandler(std::move(recordHandler)), envelope(envelope) {}
+  void feed(const char* data, size_t size) {
+    // the current span of the envelope or of a record within data
+    size_t spanBegin = 0;
+    for (size_t i = 0; i < size; ++i) {
+      char c = data[i];
+      if (this->state == State::IN_RECORD && !this->isInString && this->depth == this->recordDepth && (c == ',' || c == ']' || isWhitespace(c))) {
+        // the end of a number or a literal
+        this->endRecord(data, spanBegin, i);
+        spanBegin = i;
+        this->state = State::BETWEEN_RECORDS;
+      }
+      if (this->state == State::BETWEEN_RECORDS) {
+        if (c == ',' || isWhitespace(c)) {
+          spanBegin = i + 1;
+          continue;
+        }
+        if (c == ']') {
+          --this->depth;
+          this->state = State::OUTSIDE;
+          continue;
+        }
+        this->state = State::IN_RECORD;
+        this->recordDepth = this->depth;
+      }
+      if (this->isInString) {
+        if (this->isEscaped) {
+          this->isEscaped = false;
+        } else if (c == '\\') {
+          this->isEscaped = true;
+        } else if (c == '"') {
+          this->isInString = false;
+          if (this->state == State::IN_RECORD && this->depth == this->recordDepth) {
+            this->endRecord(data, spanBegin, i + 1);
+            spanBegin = i + 1;
+            this->state = State::BETWEEN_RECORDS;
+          } else if (this->isReadingKey) {
+            this->isReadingKey = false;
+            this->hasKey = true;
+          }
+        } else if (this->isReadingKey && this->key.size() <= this->arrayKey.size()) {
+          this->key.push_back(c);
+        }
+        continue;
+      }
+      if (c == '"') {
+        this->isInString = true;
+        if (this->state == State::OUTSIDE && this->depth == 1) {
+          this->isReadingKey = true;
+          this->key.clear();
+        }
+        continue;
+      }
+      if (isWhitespace(c)) {
+        continue;
+      }
+      if (this->state == State::OUTSIDE) {
+        if (c == ':') {
+          this->isValueOfArrayKey = this->hasKey && this->key == this->arrayKey;
+          this->hasKey = false;
+          continue;
+        }
+        if (c == '[' && this->isValueOfArrayKey && this->depth == 1) {
+          ++this->depth;
+          this->envelope.append(data + spanBegin, i + 1 - spanBegin);
+          spanBegin = i + 1;
+          this->isValueOfArrayKey = false;
+          this->state = State::BETWEEN_RECORDS;
+          continue;
+        }
+        this->isValueOfArrayKey = false;
+        this->hasKey = false;
+      }
+      if (c == '{' || c == '[') {
+        ++this->depth;
+      } else if (c == '}' || c == ']') {
+        --this->depth;
+        if (this->state == State::IN_RECORD && this->depth == this->recordDepth) {
+          this->endRecord(data, spanBegin, i + 1);
+          spanBegin = i + 1;
+          this->state = State::BETWEEN_RECORDS;
+        }
+      }
+    }
+    if (this->state == State::IN_RECORD) {
+      this->recordBuffer.append(data + spanBegin, size - spanBegin);
+    } else {
+      this->envelope.append(data + spanBegin, size - spanBegin);
+    }
+  }
+  // a record left incomplete by a truncated text is moved to the envelope
+  void finish() {
+    this->envelope += this->recordBuffer;
+    this->recordBuffer.clear();
+  }
+  size_t getNumRecord() const { return this->numRecord; }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  enum class State {
+    OUTSIDE,
+    BETWEEN_RECORDS,
+    IN_RECORD,
+  };
+  static bool isWhitespace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+  void endRecord(const char* data, size_t begin, size_t end) {
+    if (this->recordBuffer.empty()) {
+      this->recordHandler(std::string_view(data + begin, end - begin));
+    } else {
+      this->recordBuffer.append(data + begin, end - begin);
+      this->recordHandler(this->recordBuffer);
+      this->recordBuffer.clear();
+    }
+    ++this->numRecord;
+  }
+  std::string arrayKey;
+  std::function<void(std::string_view)> recordHandler;
+  std::string& envelope;
+  std::string recordBuffer;
+  std::string key;
+  State state{State::OUTSIDE};
+  int depth{};
+  int recordDepth{};
+  bool isInString{};
+  bool isEscaped{};
+  bool isReadingKey{};
+  bool hasKey{};
+  bool isValueOfArrayKey{};
+  size_t numRecord{};
+};
+/**
+ * This class is a Boost Beast body for responses whose records are processed while they are being received. For a successful status the body is run through a
+ * JsonRecordSplitter and only the envelope is stored, otherwise the whole body is stored as the envelope, like http::string_body would. Since the status is
+ * unknown when the limit of the parser is checked, the parser is meant to have no body limit and storedBodyLimit is enforced here on stored bodies instead.
+ */
+struct JsonRecordStreamBody {
+  struct value_type {
+    std::string arrayKey;
+    std::function<void(std::string_view)> recordHandler;
+    std::string envelope;
+    size_t numRecord{};
+    std::uint64_t storedBodyLimit{8 * 1024 * 1024};  // the default body limit of a Boost Beast response parser
+  };
+  static std::uint64_t size(const value_type& body) { return body.envelope.size(); }
+  class reader {
+   public:
+    // a parser constructs its reader before the header is received
+    template <bool isRequest, class Fields>
+    reader(boost::beast::http::header<isRequest, Fields>& h, value_type& body) : body(body) {
+      if constexpr (!isRequest) {
+        this->isSuccessful = [&h] { return h.result_int() / 100 == 2; };
+      }
+    }
+    void init(const boost::optional<std::uint64_t>& contentLength, boost::beast::error_code& ec) {
+      if ((!this->isSuccessful || this->isSuccessful()) && !this->body.arrayKey.empty() && this->body.recordHandler) {
+        this->splitterPtr.reset(new JsonRecordSplitter(this->body.arrayKey, this->body.recordHandler, this->body.envelope));
+      } else if (contentLength && *contentLength > this->body.storedBodyLimit) {
+        ec = boost::beast::http::error::body_limit;
+        return;
+      }
+      ec = {};
+    }
+    template <class ConstBufferSequence>
+    std::size_t put(const ConstBufferSequence& buffers, boost::beast::error_code& ec) {
+      std::size_t n = 0;
+      for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); ++it) {
+        boost::asio::const_buffer buffer = *it;
+        if (this->splitterPtr) {
+          this->splitterPtr->feed(static_cast<const char*>(buffer.data()), buffer.size());
+        } else {
+          if (this->body.envelope.size() + buffer.size() > this->body.storedBodyLimit) {
+            ec = boost::beast::http::error::body_limit;
+            return n;
+          }
+          this->body.envelope.append(static_cast<const char*>(buffer.data()), buffer.size());
+        }
+        n += buffer.size();
+      }
+      ec = {};
+      return n;
+    }
+    void finish(boost::beast::error_code& ec) {
+      if (this->splitterPtr) {
+        this->splitterPtr->finish();
+        this->body.numRecord = this->splitterPtr->getNumRecord();
+      }
+      ec = {};
+    }
+
+   private:
+    value_type& body;
+    std::function<bool()> isSuccessful;
+    std::unique_ptr<JsonRecordSplitter> splitterPtr;
+  };
+  // writes the envelope, e.g. to log a response
+  class writer {
+   public:
+    using const_buffers_type = boost::asio::const_buffer;
+    template <bool isRequest, class Fields>
+    writer(const boost::beast::http::header<isRequest, Fields>&, const value_type& body) : body(body) {}
+    void init(boost::beast::error_code& ec) { ec = {}; }
+    boost::optional<std::pair<const_buffers_type, bool>> get(boost::beast::error_code& ec) {
+      ec = {};
+      return {{const_buffers_type(this->body.envelope.data(), this->body.envelope.size()), false}};
+    }
+
+   private:
+    const value_type& body;
+  };
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_JSON_RECORD_STREAM_BODY_H_
@@ -0,0 +1,104 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_JSON_SCANNER_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_JSON_SCANNER_H_
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_macro.h"
+namespace ccapi {
+/**
+ * This class checks conditions on the members of a JSON text without parsing it, e.g. to tell from an HTTP body whether a request succeeded. A condition
+ * names a key and optionally the raw text of its value, such as "\"0\"", "0" or "[]", and holds if a member with that key and value is found at any depth.
+ * The text is scanned once from left to right: each string is read as a token, and if it is followed by a colon it is a key which is compared with the
+ * conditions. Whitespace around the colon is allowed, and a value which isn't delimited by itself (a number, true, false or null) has to end where the
+ * condition's value ends.
+ */
+class JsonScanner CCAPI_FINAL {
+ public:
+  struct Condition {
+    std::string_view key;
+    std::string_view value;
+    bool shouldMatchValue{};
+  };
+  static constexpr Condition hasKey(std::string_view key) { return {key, {}, false}; }
+  static constexpr Condition hasKeyValue(std::string_view key, std::string_view value) { return {key, value, true}; }
+  // whether any of the conditions holds
+  static bool matchAny(std::string_view json, const std::vector<Condition>& conditionList) {
+    if (conditionList.empty()) {
+      return false;
+    }
+    const char* data = json.data();
+    size_t size = json.size();
+    size_t i = 0;
+    while (i < size) {
+      const void* quote = std::memchr(data + i, '"', size - i);
+      if (!quote) {
+        return false;
+      }
+      size_t keyBegin = static_cast<const char*>(quote) - data + 1;
+      size_t keyEnd = findStringEnd(json, keyBegin);
+      if (keyEnd == std::string_view::npos) {
+        return false;
+      }
+      i = skipWhitespace(json, keyEnd + 1);
+      if (i < size && data[i] == ':') {
+        std::string_view key = json.substr(keyBegin, keyEnd - keyBegin);
+        i = skipWhitespace(json, i + 1);
+        for (const auto& condition : conditionList) {
+          if (condition.key == key && (!condition.shouldMatchValue || matchValue(json, i, condition.value))) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  // the position of the quote closing the string which starts at begin, or npos
+  static size_t findStringEnd(std::string_view json, size_t begin) {
+    const char* data = json.data();
+    size_t size = json.size();
+    size_t i = begin;
+    while (i < size) {
+      const void* quote = std::memchr(data + i, '"', size - i);
+      if (!quote) {
+        return std::string_view::npos;
+      }
+      size_t end = static_cast<const char*>(quote) - data;
+      size_t numBackslash = 0;
+      while (end - numBackslash > begin && data[end - numBackslash - 1] == '\\') {
+        ++numBackslash;
+      }
+      if (numBackslash % 2 == 0) {
+        return end;
+      }
+      i = end + 1;
+    }
+    return std::string_view::npos;
+  }
+  static size_t skipWhitespace(std::string_view json, size_t i) {
+    while (i < json.size() && (json[i] == ' ' || json[i] == '\t' || json[i] == '\n' || json[i] == '\r')) {
+      ++i;
+    }
+    return i;
+  }
+  static bool matchValue(std::string_view json, size_t i, std::string_view value) {
+    if (json.compare(i, value.size(), value) != 0) {
+      return false;
+    }
+    if (value.empty() || value.back() == '"' || value.back() == ']' || value.back() == '}') {
+      return true;
+    }
+    size_t end = i + value.size();
+    if (end == json.size()) {
+      return true;
+    }
+    char c = json[end];
+    return c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_JSON_SCANNER_H_
@@ -12,6 +12,21 @@
 #ifndef CCAPI_PRINT_DOUBLE_PRECISION_DEFAULT
 #define CCAPI_PRINT_DOUBLE_PRECISION_DEFAULT 10
 #endif
+#ifndef CCAPI_CACHE_LINE_SIZE
+#define CCAPI_CACHE_LINE_SIZE 64
+#endif
+#ifndef CCAPI_EVENT_DISPATCHER_TASK_INLINE_SIZE
+#define CCAPI_EVENT_DISPATCHER_TASK_INLINE_SIZE 112
+#endif
+#ifndef CCAPI_EVENT_DISPATCHER_BATCH_SIZE
+#define CCAPI_EVENT_DISPATCHER_BATCH_SIZE 64
+#endif
+#ifndef CCAPI_EVENT_DISPATCHER_NUM_SHARD_PER_THREAD
+#define CCAPI_EVENT_DISPATCHER_NUM_SHARD_PER_THREAD 4
+#endif
+#ifndef CCAPI_EVENT_DISPATCHER_SHARD_QUEUE_SIZE
+#define CCAPI_EVENT_DISPATCHER_SHARD_QUEUE_SIZE 4096
+#endif
 #ifndef CCAPI_DOUBLE_ERROR_DEFAULT
 #define CCAPI_DOUBLE_ERROR_DEFAULT 1e-10
 #endif
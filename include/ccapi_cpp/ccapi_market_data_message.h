@@ -130,20 +130,42 @@ class MarketDataMessage CCAPI_FINAL {
   }
   typedef std::map<DataFieldType, std::string> TypeForDataPoint;
   typedef std::map<DataType, std::vector<std::map<DataFieldType, std::string> > > TypeForData;
+  // typed data points held in flat vectors, the generic map form above is kept for the exchanges which still produce it
+  struct Level {
+    std::string price;
+    std::string size;
+  };
+  // optional fields are left empty when the exchange does not provide them
+  struct Trade {
+    std::string price;
+    std::string size;
+    std::string tradeId;
+    std::string aggTradeId;
+    std::string sequenceNumber;
+    bool isBuyerMaker{};
+  };
+  struct Candlestick {
+    std::string openPrice;
+    std::string highPrice;
+    std::string lowPrice;
+    std::string closePrice;
+    std::string volume;
+    std::string quoteVolume;
+  };
   static std::string dataToString(const TypeForData& data) {
     std::string output1 = "{";
     auto size1 = data.size();
-    auto i1 = 0;
+    size_t i1 = 0;
     for (const auto& elem1 : data) {
       output1 += dataTypeToString(elem1.first);
       output1 += "=";
       std::string output2 = "[ ";
       auto size2 = elem1.second.size();
-      auto i2 = 0;
+      size_t i2 = 0;
       for (const auto& elem2 : elem1.second) {
         std::string output3 = "{";
         auto size3 = elem2.size();
-        auto i3 = 0;
+        size_t i3 = 0;
         for (const auto& elem3 : elem2) {
           output3 += dataFieldTypeToString(elem3.first);
           output3 += "=";
@@ -195,14 +217,108 @@ class MarketDataMessage CCAPI_FINAL {
   }
   std::string toString() const {
     std::string output = "MarketDataMessage [type = " + typeToString(type) + ", recapType = " + recapTypeToString(recapType) + ", tp = " + ccapi::toString(tp) +
-                         ", exchangeSubscriptionId = " + exchangeSubscriptionId + ", data = " + dataToString(data) + "]";
+                         ", exchangeSubscriptionId = " + exchangeSubscriptionId + ", exchangeSubscriptionKey = " + ccapi::toString(exchangeSubscriptionKey) +
+                         ", data = " + dataToString(this->getData()) + "]";
+    return output;
+  }
+  bool hasDepth() const { return !this->bidList.empty() || !this->askList.empty(); }
+  bool hasTrade() const { return !this->tradeList.empty(); }
+  bool hasCandlestick() const { return !this->candlestickList.empty(); }
+  /**
+   * Compatibility adaptor: move the data points held in the generic map form into the typed lists. The map form is left empty.
+   */
+  void convertDataToTypedList() {
+    for (auto& x : this->data) {
+      auto type = x.first;
+      for (auto& y : x.second) {
+        switch (type) {
+          case DataType::BID:
+          case DataType::ASK: {
+            Level level;
+            level.price = std::move(y.at(DataFieldType::PRICE));
+            level.size = std::move(y.at(DataFieldType::SIZE));
+            (type == DataType::BID ? this->bidList : this->askList).emplace_back(std::move(level));
+          } break;
+          case DataType::TRADE:
+          case DataType::AGG_TRADE: {
+            Trade trade;
+            trade.price = std::move(y.at(DataFieldType::PRICE));
+            trade.size = std::move(y.at(DataFieldType::SIZE));
+            trade.tradeId = std::move(y[DataFieldType::TRADE_ID]);
+            trade.aggTradeId = std::move(y[DataFieldType::AGG_TRADE_ID]);
+            trade.sequenceNumber = std::move(y[DataFieldType::SEQUENCE_NUMBER]);
+            trade.isBuyerMaker = y.at(DataFieldType::IS_BUYER_MAKER) == "1";
+            this->tradeList.emplace_back(std::move(trade));
+          } break;
+          case DataType::CANDLESTICK: {
+            Candlestick candlestick;
+            candlestick.openPrice = std::move(y.at(DataFieldType::OPEN_PRICE));
+            candlestick.highPrice = std::move(y.at(DataFieldType::HIGH_PRICE));
+            candlestick.lowPrice = std::move(y.at(DataFieldType::LOW_PRICE));
+            candlestick.closePrice = std::move(y.at(DataFieldType::CLOSE_PRICE));
+            candlestick.volume = std::move(y[DataFieldType::VOLUME]);
+            candlestick.quoteVolume = std::move(y[DataFieldType::QUOTE_VOLUME]);
+            this->candlestickList.emplace_back(std::move(candlestick));
+          } break;
+          default:
+            CCAPI_LOGGER_WARN("extra type " + dataTypeToString(type));
+        }
+      }
+    }
+    this->data.clear();
+  }
+  /**
+   * Compatibility adaptor: return the data points of both the typed lists and the generic map form in the generic map form.
+   */
+  TypeForData getData() const {
+    TypeForData output = this->data;
+    for (const auto& level : this->bidList) {
+      output[DataType::BID].push_back({{DataFieldType::PRICE, level.price}, {DataFieldType::SIZE, level.size}});
+    }
+    for (const auto& level : this->askList) {
+      output[DataType::ASK].push_back({{DataFieldType::PRICE, level.price}, {DataFieldType::SIZE, level.size}});
+    }
+    for (const auto& trade : this->tradeList) {
+      TypeForDataPoint dataPoint{
+          {DataFieldType::PRICE, trade.price}, {DataFieldType::SIZE, trade.size}, {DataFieldType::IS_BUYER_MAKER, trade.isBuyerMaker ? "1" : "0"}};
+      if (!trade.tradeId.empty()) {
+        dataPoint.emplace(DataFieldType::TRADE_ID, trade.tradeId);
+      }
+      if (!trade.aggTradeId.empty()) {
+        dataPoint.emplace(DataFieldType::AGG_TRADE_ID, trade.aggTradeId);
+      }
+      if (!trade.sequenceNumber.empty()) {
+        dataPoint.emplace(DataFieldType::SEQUENCE_NUMBER, trade.sequenceNumber);
+      }
+      output[this->type == Type::MARKET_DATA_EVENTS_AGG_TRADE ? DataType::AGG_TRADE : DataType::TRADE].emplace_back(std::move(dataPoint));
+    }
+    for (const auto& candlestick : this->candlestickList) {
+      TypeForDataPoint dataPoint{{DataFieldType::OPEN_PRICE, candlestick.openPrice},
+                                 {DataFieldType::HIGH_PRICE, candlestick.highPrice},
+                                 {DataFieldType::LOW_PRICE, candlestick.lowPrice},
+                                 {DataFieldType::CLOSE_PRICE, candlestick.closePrice}};
+      if (!candlestick.volume.empty()) {
+        dataPoint.emplace(DataFieldType::VOLUME, candlestick.volume);
+      }
+      if (!candlestick.quoteVolume.empty()) {
+        dataPoint.emplace(DataFieldType::QUOTE_VOLUME, candlestick.quoteVolume);
+      }
+      output[DataType::CANDLESTICK].emplace_back(std::move(dataPoint));
+    }
     return output;
   }
   Type type{Type::UNKNOWN};
   RecapType recapType{RecapType::UNKNOWN};
   TimePoint tp{std::chrono::seconds{0}};
   std::string exchangeSubscriptionId;
+  // set instead of exchangeSubscriptionId by the exchanges which register their subscriptions with
+  // MarketDataService::registerExchangeSubscriptionKey, -1 otherwise
+  int exchangeSubscriptionKey{-1};
   TypeForData data;
+  std::vector<Level> bidList;
+  std::vector<Level> askList;
+  std::vector<Trade> tradeList;
+  std::vector<Candlestick> candlestickList;
 };
 } /* namespace ccapi */
 #endif  // INCLUDE_CCAPI_CPP_CCAPI_MARKET_DATA_MESSAGE_H_
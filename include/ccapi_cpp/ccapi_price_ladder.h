@@ -0,0 +1,429 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_PRICE_LADDER_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_PRICE_LADDER_H_
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_decimal.h"
+#include "ccapi_cpp/ccapi_fixed_decimal.h"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * This class provides one side of an order book as a contiguous array of price levels indexed by tick, i.e. by price divided by the instrument's tick size. The
+ * array is a window of a fixed number of ticks around the touch: levels within the window are updated in place without any lookup, and the rarely touched
+ * levels deeper than the window are kept in a map. When the touch drifts too far away from where the window was placed, the window is recentered on it. If the
+ * tick size is not known, it is inferred from the prices received and refined whenever a price is not a multiple of it. Iteration order is the same as that of
+ * std::map<Decimal, std::string>, i.e. ascending price, so that it can be used wherever such a map is iterated. The levels therefore keep their price as a
+ * Decimal and their size as a std::string: a size update reuses the storage of its level, but a new level still constructs a Decimal.
+ */
+class PriceLadder CCAPI_FINAL {
+ public:
+  typedef Decimal key_type;
+  typedef std::pair<Decimal, std::string> value_type;
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef PriceLadder::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+    const_iterator() {}
+    reference operator*() const { return this->segment == Segment::WINDOW ? this->ladder->window[this->offset] : this->overflowIt->second; }
+    pointer operator->() const { return &**this; }
+    const_iterator& operator++() {
+      if (this->keyAscending) {
+        this->nextKeyAscending();
+      } else {
+        this->nextKeyDescending();
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator output = *this;
+      ++*this;
+      return output;
+    }
+    bool operator==(const const_iterator& x) const {
+      return this->segment == x.segment &&
+             (this->segment == Segment::END || (this->segment == Segment::WINDOW ? this->offset == x.offset : this->overflowIt == x.overflowIt));
+    }
+    bool operator!=(const const_iterator& x) const { return !(*this == x); }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+   private:
+#endif
+    friend class PriceLadder;
+    enum class Segment { WINDOW, OVERFLOW, END };
+    // keys grow away from the touch, so iterating in ascending key order starts at the best level
+    const_iterator(const PriceLadder* ladder, bool keyAscending) : ladder(ladder), keyAscending(keyAscending) {
+      if (keyAscending) {
+        if (ladder->windowCount > 0) {
+          this->segment = Segment::WINDOW;
+          this->offset = ladder->bestOffset;
+        } else {
+          this->segment = Segment::END;
+        }
+      } else {
+        if (!ladder->overflow.empty()) {
+          this->segment = Segment::OVERFLOW;
+          this->overflowIt = std::prev(ladder->overflow.end());
+        } else {
+          this->seekWindowDescending(ladder->window.size());
+        }
+      }
+    }
+    void nextKeyAscending() {
+      if (this->segment == Segment::WINDOW) {
+        for (size_t i = this->offset + 1; i < this->ladder->window.size(); ++i) {
+          if (!this->ladder->window[i].second.empty()) {
+            this->offset = i;
+            return;
+          }
+        }
+        if (this->ladder->overflow.empty()) {
+          this->segment = Segment::END;
+        } else {
+          this->segment = Segment::OVERFLOW;
+          this->overflowIt = this->ladder->overflow.begin();
+        }
+      } else if (this->segment == Segment::OVERFLOW) {
+        if (++this->overflowIt == this->ladder->overflow.end()) {
+          this->segment = Segment::END;
+        }
+      }
+    }
+    void nextKeyDescending() {
+      if (this->segment == Segment::OVERFLOW) {
+        if (this->overflowIt == this->ladder->overflow.begin()) {
+          this->seekWindowDescending(this->ladder->window.size());
+        } else {
+          --this->overflowIt;
+        }
+      } else if (this->segment == Segment::WINDOW) {
+        this->seekWindowDescending(this->offset);
+      }
+    }
+    void seekWindowDescending(size_t end) {
+      if (this->ladder->windowCount > 0) {
+        for (size_t i = end; i > this->ladder->bestOffset; --i) {
+          if (!this->ladder->window[i - 1].second.empty()) {
+            this->segment = Segment::WINDOW;
+            this->offset = i - 1;
+            return;
+          }
+        }
+      }
+      this->segment = Segment::END;
+    }
+    const PriceLadder* ladder{};
+    bool keyAscending{};
+    Segment segment{Segment::END};
+    size_t offset{};
+    std::map<int64_t, value_type>::const_iterator overflowIt;
+  };
+  typedef const_iterator iterator;
+  typedef const_iterator reverse_iterator;
+  typedef const_iterator const_reverse_iterator;
+  PriceLadder() {}
+  PriceLadder(bool isBid, size_t capacity, const std::string& tickSize = "") : isBid(isBid), window(std::max(capacity, static_cast<size_t>(2))) {
+    if (!tickSize.empty()) {
+      FixedDecimal fixedTickSize;
+      if (!FixedDecimal::parse(tickSize.data(), tickSize.size(), fixedTickSize) || fixedTickSize.getMantissa() <= 0) {
+        CCAPI_LOGGER_FATAL("PriceLadder invalid tick size: " + tickSize);
+      }
+      this->tickSize = fixedTickSize;
+    }
+  }
+  /**
+   * Apply a level update. A size equal to zero (with or without trailing zeros) removes the level. The price is kept in its original representation when
+   * keepTrailingZero is true, which is needed by exchanges that compute a checksum over the raw strings.
+   */
+  void update(const std::string& price, const std::string& size, bool keepTrailingZero = false) {
+    FixedDecimal fixedPrice;
+    if (!FixedDecimal::parse(price.data(), price.size(), fixedPrice)) {
+      CCAPI_LOGGER_FATAL("PriceLadder cannot parse price: " + price);
+    }
+    int64_t tick = 0;
+    if (!this->toTick(fixedPrice, tick) && (!this->regrid(fixedPrice.getScale()) || !this->toTick(fixedPrice, tick))) {
+      CCAPI_LOGGER_FATAL("PriceLadder price does not fit a tick grid: " + price);
+    }
+    int64_t key = this->isBid ? -tick : tick;
+    if (isZeroSize(size)) {
+      this->erase(key);
+    } else {
+      this->set(key, price, size, keepTrailingZero);
+    }
+  }
+  // keep only the best n levels
+  void keepBestN(size_t n) {
+    if (this->size() <= n) {
+      return;
+    }
+    size_t i = 0;
+    for (size_t offset = this->bestOffset; offset < this->window.size() && this->windowCount > 0; ++offset) {
+      auto& level = this->window[offset];
+      if (!level.second.empty()) {
+        if (i >= n) {
+          level.second.clear();
+          --this->windowCount;
+        }
+        ++i;
+      }
+    }
+    auto it = this->overflow.begin();
+    while (it != this->overflow.end() && i < n) {
+      ++it;
+      ++i;
+    }
+    this->overflow.erase(it, this->overflow.end());
+    if (this->windowCount == 0 && !this->overflow.empty()) {
+      this->recenter(this->overflow.begin()->first);
+    }
+  }
+  void clear() {
+    for (auto& level : this->window) {
+      level.second.clear();
+    }
+    this->windowCount = 0;
+    this->overflow.clear();
+  }
+  size_t size() const { return this->windowCount + this->overflow.size(); }
+  bool empty() const { return this->size() == 0; }
+  // ascending price, the same as std::map<Decimal, std::string>
+  const_iterator begin() const { return const_iterator(this, this->isBid ? false : true); }
+  const_iterator end() const { return const_iterator(); }
+  const_iterator rbegin() const { return const_iterator(this, this->isBid ? true : false); }
+  const_iterator rend() const { return const_iterator(); }
+  bool getIsBid() const { return isBid; }
+  size_t getCapacity() const { return window.size(); }
+  const FixedDecimal& getTickSize() const { return tickSize; }
+  std::string toString() const {
+    std::string output = "{";
+    for (auto it = this->begin(); it != this->end(); ++it) {
+      if (output.size() > 1) {
+        output += ", ";
+      }
+      output += it->first.toString() + "=" + it->second;
+    }
+    output += "}";
+    return output;
+  }
+  static bool isZeroSize(const std::string& size) {
+    for (char c : size) {
+      if (c != '0' && c != '.') {
+        return false;
+      }
+    }
+    return true;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  bool toTick(const FixedDecimal& price, int64_t& tick) {
+    if (this->tickSize.isZero()) {
+      this->tickSize = FixedDecimal(1, price.getScale());
+    }
+    return toTick(price, this->tickSize, tick);
+  }
+  static bool toTick(const FixedDecimal& price, const FixedDecimal& tickSize, int64_t& tick) {
+    FixedDecimal rescaled;
+    if (!price.rescale(tickSize.getScale(), rescaled) || rescaled.getMantissa() % tickSize.getMantissa() != 0) {
+      return false;
+    }
+    tick = rescaled.getMantissa() / tickSize.getMantissa();
+    return true;
+  }
+  // switch to a finer tick size that all the existing levels and a price with the given scale are multiples of, false and nothing changed if one of the
+  // existing levels would not fit an int64_t tick with that tick size
+  bool regrid(int scale) {
+    CCAPI_LOGGER_DEBUG("PriceLadder regrid from tick size " + this->tickSize.toString() + " to scale " + std::to_string(scale));
+    FixedDecimal newTickSize(1, std::max(scale, this->tickSize.getScale()));
+    // best level first, so that the window is anchored on it and the remaining levels are placed in order
+    std::vector<std::pair<int64_t, value_type>> levelList;
+    levelList.reserve(this->size());
+    for (auto it = const_iterator(this, true); it != const_iterator(); ++it) {
+      int64_t tick = 0;
+      if (!toTick(FixedDecimal(it->first.toString()), newTickSize, tick)) {
+        CCAPI_LOGGER_ERROR("PriceLadder cannot regrid level " + it->first.toString() + " to tick size " + newTickSize.toString());
+        return false;
+      }
+      levelList.emplace_back(this->isBid ? -tick : tick, *it);
+    }
+    this->clear();
+    this->tickSize = newTickSize;
+    for (auto& level : levelList) {
+      this->place(level.first, std::move(level.second));
+    }
+    return true;
+  }
+  void set(int64_t key, const std::string& price, const std::string& size, bool keepTrailingZero) {
+    if (this->windowCount == 0 || key < this->baseKey) {
+      if (this->windowCount == 0 && !this->overflow.empty() && key > this->overflow.begin()->first) {
+        this->recenter(this->overflow.begin()->first);
+      } else {
+        this->recenter(key);
+      }
+    }
+    if (key >= this->baseKey + static_cast<int64_t>(this->window.size())) {
+      auto it = this->overflow.find(key);
+      if (it == this->overflow.end()) {
+        this->overflow.emplace(key, value_type(Decimal(price, keepTrailingZero), size));
+      } else {
+        it->second.second = size;
+      }
+      return;
+    }
+    size_t offset = static_cast<size_t>(key - this->baseKey);
+    auto& level = this->window[offset];
+    if (level.second.empty()) {
+      level.first = Decimal(price, keepTrailingZero);
+      if (this->windowCount == 0 || offset < this->bestOffset) {
+        this->bestOffset = offset;
+      }
+      ++this->windowCount;
+    }
+    level.second = size;
+  }
+  void erase(int64_t key) {
+    if (this->windowCount == 0 || key < this->baseKey) {
+      return;
+    }
+    if (key >= this->baseKey + static_cast<int64_t>(this->window.size())) {
+      this->overflow.erase(key);
+      return;
+    }
+    size_t offset = static_cast<size_t>(key - this->baseKey);
+    auto& level = this->window[offset];
+    if (level.second.empty()) {
+      return;
+    }
+    level.second.clear();
+    --this->windowCount;
+    if (offset == this->bestOffset) {
+      if (this->windowCount > 0) {
+        while (this->window[this->bestOffset].second.empty()) {
+          ++this->bestOffset;
+        }
+        if (this->bestOffset > this->window.size() / 2) {
+          this->recenter(this->baseKey + static_cast<int64_t>(this->bestOffset));
+        }
+      } else if (!this->overflow.empty()) {
+        this->recenter(this->overflow.begin()->first);
+      }
+    }
+  }
+  // place a level known to be absent, without any recentering
+  void place(int64_t key, value_type&& level) {
+    if (this->windowCount == 0 && this->overflow.empty()) {
+      this->baseKey = key - static_cast<int64_t>(this->getHeadroom());
+    }
+    if (key < this->baseKey || key >= this->baseKey + static_cast<int64_t>(this->window.size())) {
+      this->overflow.emplace(key, std::move(level));
+      if (key < this->baseKey) {
+        this->recenter(this->overflow.begin()->first);
+      }
+      return;
+    }
+    size_t offset = static_cast<size_t>(key - this->baseKey);
+    this->window[offset] = std::move(level);
+    if (this->windowCount == 0 || offset < this->bestOffset) {
+      this->bestOffset = offset;
+    }
+    ++this->windowCount;
+  }
+  // move the window so that the given key sits at the headroom offset, spilling levels to or pulling them from the overflow map
+  void recenter(int64_t bestKey) {
+    const int64_t capacity = static_cast<int64_t>(this->window.size());
+    const int64_t newBaseKey = bestKey - static_cast<int64_t>(this->getHeadroom());
+    const int64_t delta = newBaseKey - this->baseKey;
+    if (delta == 0) {
+      return;
+    }
+    if (this->windowCount > 0) {
+      if (delta > 0) {
+        // levels shallower than the new window cannot exist because the new base is above the best level
+        if (delta < capacity) {
+          std::move(this->window.begin() + delta, this->window.end(), this->window.begin());
+          for (int64_t i = capacity - delta; i < capacity; ++i) {
+            this->window[i].second.clear();
+          }
+        } else {
+          this->clearWindow();
+        }
+      } else {
+        for (int64_t i = std::max(capacity + delta, static_cast<int64_t>(0)); i < capacity; ++i) {
+          auto& level = this->window[i];
+          if (!level.second.empty()) {
+            this->overflow.emplace(this->baseKey + i, std::move(level));
+            level.second.clear();
+          }
+        }
+        if (-delta < capacity) {
+          std::move_backward(this->window.begin(), this->window.end() + delta, this->window.end());
+          for (int64_t i = 0; i < -delta; ++i) {
+            this->window[i].second.clear();
+          }
+        } else {
+          this->clearWindow();
+        }
+      }
+    }
+    this->baseKey = newBaseKey;
+    this->windowCount = 0;
+    for (auto it = this->overflow.begin(); it != this->overflow.end() && it->first < newBaseKey + capacity;) {
+      if (it->first >= newBaseKey) {
+        this->window[it->first - newBaseKey] = std::move(it->second);
+      }
+      it = this->overflow.erase(it);
+    }
+    bool foundBest = false;
+    for (size_t i = 0; i < this->window.size(); ++i) {
+      if (!this->window[i].second.empty()) {
+        if (!foundBest) {
+          this->bestOffset = i;
+          foundBest = true;
+        }
+        ++this->windowCount;
+      }
+    }
+  }
+  void clearWindow() {
+    for (auto& level : this->window) {
+      level.second.clear();
+    }
+  }
+  // room left on the shallow side of the best level so that an improving touch usually stays within the window
+  size_t getHeadroom() const { return this->window.size() / 8; }
+  bool isBid{};
+  FixedDecimal tickSize;
+  std::vector<value_type> window;
+  int64_t baseKey{};
+  size_t bestOffset{};
+  size_t windowCount{};
+  std::map<int64_t, value_type> overflow;
+};
+inline std::string firstNToString(const PriceLadder& c, const size_t n) {
+  std::string output = "{";
+  size_t i = 0;
+  for (auto it = c.begin(); it != c.end() && i < n; ++it, ++i) {
+    output += (i > 0 ? ", " : "") + it->first.toString() + "=" + it->second;
+  }
+  output += "}";
+  return output;
+}
+inline std::string lastNToString(const PriceLadder& c, const size_t n) {
+  std::string output = "{";
+  size_t i = 0;
+  for (auto it = c.rbegin(); it != c.rend() && i < n; ++it, ++i) {
+    output += (i > 0 ? ", " : "") + it->first.toString() + "=" + it->second;
+  }
+  output += "}";
+  return output;
+}
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_PRICE_LADDER_H_
@@ -1,51 +1,104 @@
 #ifndef INCLUDE_CCAPI_CPP_CCAPI_QUEUE_H_
 #define INCLUDE_CCAPI_CPP_CCAPI_QUEUE_H_
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <vector>
 
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_ring_buffer.h"
 namespace ccapi {
 /**
- * This class represents a generic FIFO queue.
+ * What a bounded queue does with an element pushed while it is full.
+ */
+enum class QueueOverflowPolicy {
+  THROW,        // throw std::runtime_error with EXCEPTION_QUEUE_FULL
+  BLOCK,        // spin, yielding the thread, until the consumer has made room, or throw like THROW once the queue is stopped
+  DROP_OLDEST,  // discard the oldest element to make room
+};
+inline std::string queueOverflowPolicyToString(QueueOverflowPolicy queueOverflowPolicy) {
+  std::string output;
+  switch (queueOverflowPolicy) {
+    case QueueOverflowPolicy::THROW:
+      output = "THROW";
+      break;
+    case QueueOverflowPolicy::BLOCK:
+      output = "BLOCK";
+      break;
+    case QueueOverflowPolicy::DROP_OLDEST:
+      output = "DROP_OLDEST";
+      break;
+    default:
+      CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
+  }
+  return output;
+}
+/**
+ * This class represents a generic FIFO queue. By default it is a vector guarded by a mutex. If it is bounded and isLockFree is set, it is a lock-free
+ * RingBuffer instead, which any number of producers may push to while one consumer pops from it. The capacity of a lock-free queue is maxSize rounded up to a
+ * power of 2, and its size and emptiness are only exact when called by the consumer. The elements dropped from the front of the vector by DROP_OLDEST are only
+ * erased once maxSize of them have piled up, so that a push to a full queue stays amortized constant time. A producer held back by BLOCK busy-waits with
+ * std::this_thread::yield rather than sleeping on a condition variable, so BLOCK is meant for a consumer that keeps up and only falls behind briefly.
  */
 template <class T>
 class Queue {
  public:
   std::string EXCEPTION_QUEUE_FULL = "queue is full";
   std::string EXCEPTION_QUEUE_EMPTY = "queue is empty";
-  explicit Queue(const size_t maxSize = 0) : maxSize(maxSize) {}
-  void pushBack(const T& t) {
-#ifndef CCAPI_USE_SINGLE_THREAD
-    std::lock_guard<std::mutex> lock(this->m);
-#endif
-    if (this->maxSize <= 0 || this->queue.size() < this->maxSize) {
-      CCAPI_LOGGER_TRACE("this->queue.size() = " + size_tToString(this->queue.size()));
-      this->queue.push_back(t);
-    } else {
-      throw std::runtime_error(EXCEPTION_QUEUE_FULL);
+  explicit Queue(const size_t maxSize = 0, const QueueOverflowPolicy overflowPolicy = QueueOverflowPolicy::THROW, const bool isLockFree = false)
+      : maxSize(maxSize), overflowPolicy(overflowPolicy) {
+    if (isLockFree && maxSize > 0) {
+      this->ringBufferPtr.reset(new RingBuffer<T>(maxSize));
     }
   }
+  void pushBack(const T& t) { this->pushBack(T(t)); }
   void pushBack(T&& t) {
+    if (this->ringBufferPtr) {
+      while (!this->ringBufferPtr->tryPush(std::move(t))) {
+        this->onFull();
+      }
+      return;
+    }
 #ifndef CCAPI_USE_SINGLE_THREAD
-    std::lock_guard<std::mutex> lock(this->m);
+    std::unique_lock<std::mutex> lock(this->m);
 #endif
-    if (this->maxSize <= 0 || this->queue.size() < this->maxSize) {
-      CCAPI_LOGGER_TRACE("this->queue.size() = " + size_tToString(this->queue.size()));
-      this->queue.push_back(t);
-    } else {
-      throw std::runtime_error(EXCEPTION_QUEUE_FULL);
+    while (this->maxSize > 0 && this->queue.size() - this->queueHead >= this->maxSize) {
+      if (this->overflowPolicy == QueueOverflowPolicy::DROP_OLDEST) {
+        this->queue[this->queueHead++] = T();
+        if (this->queueHead >= this->maxSize) {
+          this->eraseDropped();
+        }
+      } else {
+#ifndef CCAPI_USE_SINGLE_THREAD
+        lock.unlock();
+#endif
+        this->onFull();
+#ifndef CCAPI_USE_SINGLE_THREAD
+        lock.lock();
+#endif
+      }
     }
+    CCAPI_LOGGER_TRACE("this->queue.size() = " + size_tToString(this->queue.size() - this->queueHead));
+    this->queue.push_back(std::move(t));
   }
   T popBack() {
 #ifndef CCAPI_USE_SINGLE_THREAD
     std::lock_guard<std::mutex> lock(this->m);
 #endif
-    if (this->queue.empty()) {
+    if (this->ringBufferPtr) {
+      // the newest element is only reachable after the older ones, which are kept in order for the next call
+      this->drainRingBuffer(this->queue);
+    }
+    if (this->queue.size() == this->queueHead) {
       throw std::runtime_error(EXCEPTION_QUEUE_EMPTY);
     } else {
       T t = std::move(this->queue.back());
       this->queue.pop_back();
+      if (this->queue.size() == this->queueHead) {
+        this->eraseDropped();
+      }
       return t;
     }
   }
@@ -53,14 +106,19 @@ class Queue {
 #ifndef CCAPI_USE_SINGLE_THREAD
     std::lock_guard<std::mutex> lock(this->m);
 #endif
+    this->eraseDropped();
     std::vector<T> p;
     std::swap(p, this->queue);
+    if (this->ringBufferPtr) {
+      this->drainRingBuffer(p);
+    }
     return p;
   }
   void removeAll(std::vector<T>& c) {
 #ifndef CCAPI_USE_SINGLE_THREAD
     std::lock_guard<std::mutex> lock(this->m);
 #endif
+    this->eraseDropped();
     if (c.empty()) {
       c = std::move(this->queue);
     } else {
@@ -68,28 +126,65 @@ class Queue {
       std::move(std::begin(this->queue), std::end(this->queue), std::back_inserter(c));
     }
     this->queue.clear();
+    if (this->ringBufferPtr) {
+      this->drainRingBuffer(c);
+    }
   }
   size_t size() const {
 #ifndef CCAPI_USE_SINGLE_THREAD
     std::lock_guard<std::mutex> lock(this->m);
 #endif
-    return this->queue.size();
-  }
-  bool empty() const {
-#ifndef CCAPI_USE_SINGLE_THREAD
-    std::lock_guard<std::mutex> lock(this->m);
-#endif
-    return this->queue.empty();
+    return this->queue.size() - this->queueHead + (this->ringBufferPtr ? this->ringBufferPtr->size() : 0);
   }
+  bool empty() const { return this->size() == 0; }
+  bool isLockFree() const { return !!this->ringBufferPtr; }
+  // wakes up the producers blocked on a full queue and makes the later ones throw instead of waiting, e.g. when the consumer is going away
+  void stop() { this->isStopped.store(true, std::memory_order_release); }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  private:
 #endif
+  // called without the mutex held
+  void onFull() {
+    switch (this->overflowPolicy) {
+      case QueueOverflowPolicy::BLOCK:
+#ifndef CCAPI_USE_SINGLE_THREAD
+        if (this->isStopped.load(std::memory_order_acquire)) {
+          throw std::runtime_error(EXCEPTION_QUEUE_FULL);
+        }
+        std::this_thread::yield();
+        break;
+#else
+        // no other thread could make room
+        throw std::runtime_error(EXCEPTION_QUEUE_FULL);
+#endif
+      case QueueOverflowPolicy::DROP_OLDEST:
+        this->ringBufferPtr->tryConsume([](T&&) {});
+        break;
+      default:
+        throw std::runtime_error(EXCEPTION_QUEUE_FULL);
+    }
+  }
+  // called with the mutex held
+  void eraseDropped() {
+    this->queue.erase(this->queue.begin(), this->queue.begin() + this->queueHead);
+    this->queueHead = 0;
+  }
+  void drainRingBuffer(std::vector<T>& c) {
+    c.reserve(c.size() + this->ringBufferPtr->size());
+    while (this->ringBufferPtr->tryConsume([&c](T&& t) { c.push_back(std::move(t)); })) {
+    }
+  }
+  // a lock-free queue only uses it for the elements that popBack had to take out of the ring buffer
   std::vector<T> queue;
+  size_t queueHead{};  // the number of elements at the front of queue which have been dropped by DROP_OLDEST
 #ifndef CCAPI_USE_SINGLE_THREAD
   mutable std::mutex m;
 #endif
   size_t maxSize{};
+  QueueOverflowPolicy overflowPolicy{QueueOverflowPolicy::THROW};
+  std::unique_ptr<RingBuffer<T>> ringBufferPtr;
+  std::atomic<bool> isStopped{};
 };
 } /* namespace ccapi */
 #endif  // INCLUDE_CCAPI_CPP_CCAPI_QUEUE_H_
@@ -0,0 +1,119 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_RING_BUFFER_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_RING_BUFFER_H_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "ccapi_cpp/ccapi_macro.h"
+namespace ccapi {
+/**
+ * This class is a bounded lock-free FIFO ring buffer (D. Vyukov's bounded MPMC queue). Each slot carries a sequence number telling producers and consumers
+ * whose turn it is, so that a push or a pop only contends on one position counter and one slot. The counters and the slots sit on separate cache lines. Pops
+ * are safe from several threads, which also lets a producer drop the oldest element to make room. The capacity is rounded up to a power of 2.
+ */
+template <class T>
+class RingBuffer CCAPI_FINAL {
+ public:
+  explicit RingBuffer(size_t capacity) {
+    size_t roundedCapacity = 1;
+    while (roundedCapacity < capacity) {
+      roundedCapacity <<= 1;
+    }
+    this->mask = roundedCapacity - 1;
+    this->slots.reset(new Slot[roundedCapacity]);
+    for (size_t i = 0; i < roundedCapacity; ++i) {
+      this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+  ~RingBuffer() {
+    size_t enqueued = this->enqueuePosition.value.load(std::memory_order_relaxed);
+    for (size_t position = this->dequeuePosition.value.load(std::memory_order_relaxed); position != enqueued; ++position) {
+      std::launder(reinterpret_cast<T*>(this->slots[position & this->mask].storage))->~T();
+    }
+  }
+  // false if full, in which case t is left untouched
+  bool tryPush(T&& t) {
+    Slot* slot;
+    size_t position = this->enqueuePosition.value.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &this->slots[position & this->mask];
+      auto difference = static_cast<std::intptr_t>(slot->sequence.load(std::memory_order_acquire)) - static_cast<std::intptr_t>(position);
+      if (difference == 0) {
+        if (this->enqueuePosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = this->enqueuePosition.value.load(std::memory_order_relaxed);
+      }
+    }
+    new (slot->storage) T(std::move(t));
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+  // false if empty, otherwise the oldest element is moved into t
+  bool tryPop(T& t) {
+    return this->tryConsume([&t](T&& element) { t = std::move(element); });
+  }
+  // false if empty, otherwise the oldest element is handed to f as an rvalue and then destroyed, the slot is released even if f throws so that the ring
+  // buffer is not left stuck on it, the element is then lost
+  template <class F>
+  bool tryConsume(F f) {
+    Slot* slot;
+    size_t position = this->dequeuePosition.value.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &this->slots[position & this->mask];
+      auto difference = static_cast<std::intptr_t>(slot->sequence.load(std::memory_order_acquire)) - static_cast<std::intptr_t>(position + 1);
+      if (difference == 0) {
+        if (this->dequeuePosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = this->dequeuePosition.value.load(std::memory_order_relaxed);
+      }
+    }
+    struct SlotReleaser {
+      ~SlotReleaser() {
+        element->~T();
+        slot->sequence.store(sequence, std::memory_order_release);
+      }
+      Slot* slot;
+      T* element;
+      size_t sequence;
+    } slotReleaser{slot, std::launder(reinterpret_cast<T*>(slot->storage)), position + this->mask + 1};
+    f(std::move(*slotReleaser.element));
+    return true;
+  }
+  size_t capacity() const { return this->mask + 1; }
+  // exact only while no other thread pushes or pops
+  size_t size() const {
+    size_t enqueued = this->enqueuePosition.value.load(std::memory_order_acquire);
+    size_t dequeued = this->dequeuePosition.value.load(std::memory_order_acquire);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct alignas(CCAPI_CACHE_LINE_SIZE) Slot {
+    std::atomic<size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+  struct alignas(CCAPI_CACHE_LINE_SIZE) Position {
+    std::atomic<size_t> value{};
+  };
+  Position enqueuePosition;
+  Position dequeuePosition;
+  std::unique_ptr<Slot[]> slots;
+  size_t mask{};
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_RING_BUFFER_H_
@@ -1,8 +1,10 @@
 #ifndef INCLUDE_CCAPI_CPP_CCAPI_SESSION_OPTIONS_H_
 #define INCLUDE_CCAPI_CPP_CCAPI_SESSION_OPTIONS_H_
 #include <string>
+#include <vector>
 
 #include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_queue.h"
 #include "ccapi_cpp/ccapi_util_private.h"
 namespace ccapi {
 /**
@@ -14,7 +16,12 @@ class SessionOptions CCAPI_FINAL {
   std::string toString() const {
     std::string output = "SessionOptions [enableCheckSequence = " + ccapi::toString(enableCheckSequence) +
                          ", enableCheckOrderBookChecksum = " + ccapi::toString(enableCheckOrderBookChecksum) +
+                         ", orderBookChecksumVerifyEveryNUpdates = " + ccapi::toString(orderBookChecksumVerifyEveryNUpdates) +
+                         ", orderBookChecksumVerifyIntervalMilliseconds = " + ccapi::toString(orderBookChecksumVerifyIntervalMilliseconds) +
+                         ", enableOrderBookChecksumVerifyAsync = " + ccapi::toString(enableOrderBookChecksumVerifyAsync) +
                          ", enableCheckOrderBookCrossed = " + ccapi::toString(enableCheckOrderBookCrossed) +
+                         ", enableOrderBookPriceLadder = " + ccapi::toString(enableOrderBookPriceLadder) +
+                         ", orderBookPriceLadderCapacity = " + ccapi::toString(orderBookPriceLadderCapacity) +
                          ", enableCheckPingPongWebsocketProtocolLevel = " + ccapi::toString(enableCheckPingPongWebsocketProtocolLevel) +
                          ", enableCheckPingPongWebsocketApplicationLevel = " + ccapi::toString(enableCheckPingPongWebsocketApplicationLevel) +
                          ", enableCheckHeartbeatFix = " + ccapi::toString(enableCheckHeartbeatFix) +
@@ -24,18 +31,42 @@ class SessionOptions CCAPI_FINAL {
                          ", pongWebsocketApplicationLevelTimeoutMilliseconds = " + ccapi::toString(pongWebsocketApplicationLevelTimeoutMilliseconds) +
                          ", heartbeatFixIntervalMilliseconds = " + ccapi::toString(heartbeatFixIntervalMilliseconds) +
                          ", heartbeatFixTimeoutMilliseconds = " + ccapi::toString(heartbeatFixTimeoutMilliseconds) +
-                         ", maxEventQueueSize = " + ccapi::toString(maxEventQueueSize) + ", httpMaxNumRetry = " + ccapi::toString(httpMaxNumRetry) +
+                         ", maxEventQueueSize = " + ccapi::toString(maxEventQueueSize) +
+                         ", eventQueueOverflowPolicy = " + queueOverflowPolicyToString(eventQueueOverflowPolicy) +
+                         ", enableLockFreeEventQueue = " + ccapi::toString(enableLockFreeEventQueue) +
+                         ", eventDispatcherLockFreeQueueSize = " + ccapi::toString(eventDispatcherLockFreeQueueSize) +
+                         ", numEventDispatcherThreads = " + ccapi::toString(numEventDispatcherThreads) +
+                         ", enableShardedEventDispatcher = " + ccapi::toString(enableShardedEventDispatcher) +
+                         ", enableEventDispatcherWorkStealing = " + ccapi::toString(enableEventDispatcherWorkStealing) +
+                         ", enableEventPriorityLanes = " + ccapi::toString(enableEventPriorityLanes) +
+                         ", eventDispatcherHighPriorityWeight = " + ccapi::toString(eventDispatcherHighPriorityWeight) +
+                         ", enableEventDispatcherLaneMetrics = " + ccapi::toString(enableEventDispatcherLaneMetrics) +
+                         ", numIoContextThreads = " + ccapi::toString(numIoContextThreads) +
+                         ", ioContextThreadCpuList = " + ccapi::toString(ioContextThreadCpuList) +
+                         ", ioContextBusyPollSpinMicroseconds = " + ccapi::toString(ioContextBusyPollSpinMicroseconds) +
+                         ", socketBusyPollMicroseconds = " + ccapi::toString(socketBusyPollMicroseconds) +
+                         ", httpMaxNumRetry = " + ccapi::toString(httpMaxNumRetry) +
                          ", httpMaxNumRedirect = " + ccapi::toString(httpMaxNumRedirect) +
                          ", httpRequestTimeoutMilliseconds = " + ccapi::toString(httpRequestTimeoutMilliseconds) +
                          ", httpConnectionPoolMaxSize = " + ccapi::toString(httpConnectionPoolMaxSize) +
+                         ", httpConnectionPoolMaxNumConnection = " + ccapi::toString(httpConnectionPoolMaxNumConnection) +
                          ", httpConnectionKeepAliveTimeoutSeconds = " + ccapi::toString(httpConnectionKeepAliveTimeoutSeconds) +
-                         ", enableOneHttpConnectionPerRequest = " + ccapi::toString(enableOneHttpConnectionPerRequest) + "]";
+                         ", httpConnectionKeepAliveProbeIntervalSeconds = " + ccapi::toString(httpConnectionKeepAliveProbeIntervalSeconds) +
+                         ", httpConnectionPoolNumSpareConnection = " + ccapi::toString(httpConnectionPoolNumSpareConnection) +
+                         ", enableTlsSessionResumption = " + ccapi::toString(enableTlsSessionResumption) +
+                         ", enableOneHttpConnectionPerRequest = " + ccapi::toString(enableOneHttpConnectionPerRequest) +
+                         ", enableStreamHttpResponseBody = " + ccapi::toString(enableStreamHttpResponseBody) + "]";
     return output;
   }
   // long warnLateEventMaxMilliseconds{};                      // used to print a warning log message if en event arrives late
   bool enableCheckSequence{};                               // used to check sequence number discontinuity
   bool enableCheckOrderBookChecksum{};                      // used to check order book checksum
+  int orderBookChecksumVerifyEveryNUpdates{1};              // used to verify the checksum on every Nth update of a book, 0 leaves it to the interval
+  long orderBookChecksumVerifyIntervalMilliseconds{};       // if positive, the checksum is also verified on the first update after this much time
+  bool enableOrderBookChecksumVerifyAsync{};                // used to verify the checksum on a worker thread against a copy of the levels it covers
   bool enableCheckOrderBookCrossed{true};                   // used to check order book cross, usually this should be set to true
+  bool enableOrderBookPriceLadder{};                        // used to keep websocket order books in tick-indexed price ladders instead of maps
+  int orderBookPriceLadderCapacity{1024};                   // number of ticks kept contiguously around the touch by each side of a price ladder
   bool enableCheckPingPongWebsocketProtocolLevel{true};     // used to check ping-pong health for exchange connections on websocket protocol level
   bool enableCheckPingPongWebsocketApplicationLevel{true};  // used to check ping-pong health for exchange connections on websocket application level
   bool enableCheckHeartbeatFix{true};                       // used to check heartbeat health for exchange connections on FIX
@@ -45,14 +76,36 @@ class SessionOptions CCAPI_FINAL {
   long pongWebsocketApplicationLevelTimeoutMilliseconds{30000};  // should be less than pingWebsocketApplicationLevelIntervalMilliseconds
   long heartbeatFixIntervalMilliseconds{60000};
   long heartbeatFixTimeoutMilliseconds{30000};  // should be less than heartbeatFixIntervalMilliseconds
-  int maxEventQueueSize{0};                     // if set to a positive integer, the event queue will throw an exception when overflown
+  int maxEventQueueSize{0};                     // if set to a positive integer, the event queue will apply eventQueueOverflowPolicy when overflown
+  QueueOverflowPolicy eventQueueOverflowPolicy{QueueOverflowPolicy::THROW};
+  bool enableLockFreeEventQueue{};  // if maxEventQueueSize is positive, make the event queue a lock-free ring buffer instead of a mutex-guarded vector, it
+                                    // has several producers since the io_context threads and the user threads (e.g. on an error in sendRequest) push to it
+  int eventDispatcherLockFreeQueueSize{};    // if positive, the internal event dispatcher hands events to its threads through a lock-free queue of this size
+  int numEventDispatcherThreads{1};          // number of threads of the internal event dispatcher, without sharding the order of events is then not kept
+  bool enableShardedEventDispatcher{};       // keep the order of the events of each correlation id while different ones are handled in parallel
+  bool enableEventDispatcherWorkStealing{};  // with a sharded event dispatcher, let idle threads handle the events of correlation ids owned by busy ones
+  bool enableEventPriorityLanes{};           // dispatch execution-management and status events ahead of market data, otherwise events are handled in order
+  int eventDispatcherHighPriorityWeight{8};  // with priority lanes, a waiting market data event is handled after every this many execution or status events,
+                                             // if not positive market data waits until there are none
+  bool enableEventDispatcherLaneMetrics{};   // measure how long the events of each priority wait in the internal event dispatcher, see getLaneMetrics
+  int numIoContextThreads{1};                // if the session creates its ServiceContext, run the services on this many io_contexts and threads
+  std::vector<int> ioContextThreadCpuList;   // if not empty, the i-th io_context thread is pinned to the i-th cpu of this list (linux only)
+  long ioContextBusyPollSpinMicroseconds{};  // if positive, io_context threads keep polling for this long after the last handler before they block
+  int socketBusyPollMicroseconds{};          // if positive, set SO_BUSY_POLL to this value on the websocket and http sockets (linux only)
   int httpMaxNumRetry{1};
   int httpMaxNumRedirect{1};
   long httpRequestTimeoutMilliseconds{10000};
-  int httpConnectionPoolMaxSize{1};  // used to set the maximal number of http connections to be kept in the pool (connections in the pool are idle)
+  int httpConnectionPoolMaxSize{1};          // used to set the maximal number of http connections to be kept in the pool (connections in the pool are idle)
+  int httpConnectionPoolMaxNumConnection{};  // if positive, at most this many connections per host are open at a time, further requests wait for one for up
+                                             // to httpRequestTimeoutMilliseconds, or fail at once if it is not positive
   long httpConnectionKeepAliveTimeoutSeconds{
       10};  // used to remove a http connection from the http connection pool if it has stayed idle for at least this amount of time
+  long httpConnectionKeepAliveProbeIntervalSeconds{};  // if positive, a connection idle for this long is sent a probe request to keep its TLS session warm
+  int httpConnectionPoolNumSpareConnection{};  // if positive, this many connections per host are kept connected and handshaked ahead of the requests, from
+                                               // the first request to the host on, those about to expire are replaced every half keep-alive timeout
+  bool enableTlsSessionResumption{true};       // new websocket and http connections resume the last TLS session of their host instead of a full handshake
   bool enableOneHttpConnectionPerRequest{};  // create a new http connection for each request
+  bool enableStreamHttpResponseBody{};       // process the records of large responses (e.g. instruments) while they are being received
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
   long websocketConnectTimeoutMilliseconds{10000};
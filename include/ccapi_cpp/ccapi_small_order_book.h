@@ -0,0 +1,160 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_SMALL_ORDER_BOOK_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_SMALL_ORDER_BOOK_H_
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "ccapi_cpp/ccapi_decimal.h"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * This class provides one side of a shallow order book as a fixed-capacity array of price levels stored inline and kept sorted from the best level to the
+ * worst. It is meant for channels on which every message replaces the whole book with a handful of levels: clearing it only resets a counter and refilling
+ * it reuses the storage of the previous levels, so that no heap allocation happens as long as prices and sizes fit in the small string buffer. When more
+ * levels than the capacity are received, the worst ones are dropped. Iteration order is the same as that of std::map<Decimal, std::string>, i.e. ascending
+ * price, so that it can be used wherever such a map is iterated.
+ */
+class SmallOrderBook CCAPI_FINAL {
+ public:
+  static constexpr size_t CAPACITY = 50;
+  typedef Decimal key_type;
+  typedef std::pair<Decimal, std::string> value_type;
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef SmallOrderBook::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+    const_iterator() {}
+    reference operator*() const { return this->book->levels[this->bestFirst ? this->index : this->book->count - 1 - this->index]; }
+    pointer operator->() const { return &**this; }
+    const_iterator& operator++() {
+      ++this->index;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator output = *this;
+      ++*this;
+      return output;
+    }
+    bool operator==(const const_iterator& x) const { return this->index == x.index; }
+    bool operator!=(const const_iterator& x) const { return !(*this == x); }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+   private:
+#endif
+    friend class SmallOrderBook;
+    const_iterator(const SmallOrderBook* book, bool bestFirst, size_t index) : book(book), bestFirst(bestFirst), index(index) {}
+    const SmallOrderBook* book{};
+    bool bestFirst{};
+    size_t index{};
+  };
+  typedef const_iterator iterator;
+  typedef const_iterator reverse_iterator;
+  typedef const_iterator const_reverse_iterator;
+  SmallOrderBook() {}
+  explicit SmallOrderBook(bool isBid) : isBid(isBid) {}
+  /**
+   * Apply a level update. A size equal to zero (with or without trailing zeros) removes the level. The price is kept in its original representation when
+   * keepTrailingZero is true, which is needed by exchanges that compute a checksum over the raw strings.
+   */
+  void update(const std::string& price, const std::string& size, bool keepTrailingZero = false) {
+    Decimal decimalPrice(price, keepTrailingZero);
+    size_t i = this->findPosition(decimalPrice);
+    bool found = i < this->count && !this->isBetter(decimalPrice, this->levels[i].first) && !this->isBetter(this->levels[i].first, decimalPrice);
+    if (isZeroSize(size)) {
+      if (found) {
+        std::move(this->levels.begin() + i + 1, this->levels.begin() + this->count, this->levels.begin() + i);
+        --this->count;
+      }
+      return;
+    }
+    if (found) {
+      this->levels[i].second.assign(size);
+      return;
+    }
+    if (this->count == CAPACITY) {
+      if (i == CAPACITY) {
+        return;
+      }
+      --this->count;
+    }
+    std::move_backward(this->levels.begin() + i, this->levels.begin() + this->count, this->levels.begin() + this->count + 1);
+    auto& level = this->levels[i];
+    level.first = std::move(decimalPrice);
+    level.second.assign(size);
+    ++this->count;
+  }
+  // keep only the best n levels
+  void keepBestN(size_t n) { this->count = std::min(this->count, n); }
+  // the storage of the levels is kept so that refilling does not allocate
+  void clear() { this->count = 0; }
+  size_t size() const { return this->count; }
+  bool empty() const { return this->count == 0; }
+  // ascending price, the same as std::map<Decimal, std::string>
+  const_iterator begin() const { return const_iterator(this, !this->isBid, 0); }
+  const_iterator end() const { return const_iterator(this, !this->isBid, this->count); }
+  const_iterator rbegin() const { return const_iterator(this, this->isBid, 0); }
+  const_iterator rend() const { return const_iterator(this, this->isBid, this->count); }
+  bool getIsBid() const { return isBid; }
+  std::string toString() const {
+    std::string output = "{";
+    for (auto it = this->begin(); it != this->end(); ++it) {
+      if (output.size() > 1) {
+        output += ", ";
+      }
+      output += it->first.toString() + "=" + it->second;
+    }
+    output += "}";
+    return output;
+  }
+  static bool isZeroSize(const std::string& size) {
+    for (char c : size) {
+      if (c != '0' && c != '.') {
+        return false;
+      }
+    }
+    return true;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  bool isBetter(const Decimal& x, const Decimal& y) const { return this->isBid ? y < x : x < y; }
+  // index of the first level which is not better than the given price, levels usually arrive best first so the tail is checked before searching
+  size_t findPosition(const Decimal& price) const {
+    if (this->count == 0 || this->isBetter(this->levels[this->count - 1].first, price)) {
+      return this->count;
+    }
+    return std::lower_bound(this->levels.begin(), this->levels.begin() + this->count, price,
+                            [this](const value_type& level, const Decimal& x) { return this->isBetter(level.first, x); }) -
+           this->levels.begin();
+  }
+  bool isBid{};
+  size_t count{};
+  std::array<value_type, CAPACITY> levels;
+};
+inline std::string firstNToString(const SmallOrderBook& c, const size_t n) {
+  std::string output = "{";
+  size_t i = 0;
+  for (auto it = c.begin(); it != c.end() && i < n; ++it, ++i) {
+    output += (i > 0 ? ", " : "") + it->first.toString() + "=" + it->second;
+  }
+  output += "}";
+  return output;
+}
+inline std::string lastNToString(const SmallOrderBook& c, const size_t n) {
+  std::string output = "{";
+  size_t i = 0;
+  for (auto it = c.rbegin(); it != c.rend() && i < n; ++it, ++i) {
+    output += (i > 0 ? ", " : "") + it->first.toString() + "=" + it->second;
+  }
+  output += "}";
+  return output;
+}
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_SMALL_ORDER_BOOK_H_
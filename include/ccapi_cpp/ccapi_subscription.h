@@ -1,6 +1,7 @@
 #ifndef INCLUDE_CCAPI_CPP_CCAPI_SUBSCRIPTION_H_
 #define INCLUDE_CCAPI_CPP_CCAPI_SUBSCRIPTION_H_
 #include <set>
+#include <stdexcept>
 #include <string>
 
 #include "ccapi_cpp/ccapi_logger.h"
@@ -13,6 +14,24 @@ namespace ccapi {
  */
 class Subscription CCAPI_FINAL {
  public:
+  // the market data options parsed once at construction, the services read these on their hot paths and the string option map is kept for display
+  struct TypedOptions {
+    int marketDepthMax{std::stoi(CCAPI_MARKET_DEPTH_MAX_DEFAULT)};
+    int conflateIntervalMilliseconds{std::stoi(CCAPI_CONFLATE_INTERVAL_MILLISECONDS_DEFAULT)};
+    int conflateGracePeriodMilliseconds{std::stoi(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS_DEFAULT)};
+    bool marketDepthReturnUpdate{std::string(CCAPI_MARKET_DEPTH_RETURN_UPDATE_DEFAULT) == CCAPI_MARKET_DEPTH_RETURN_UPDATE_ENABLE};
+    int fetchMarketDepthInitialSnapshotDelayMilliseconds{std::stoi(CCAPI_FETCH_MARKET_DEPTH_INITIAL_SNAPSHOT_DELAY_MILLISECONDS_DEFAULT)};
+    int candlestickIntervalSeconds{std::stoi(CCAPI_CANDLESTICK_INTERVAL_SECONDS_DEFAULT)};
+    bool shouldConflate() const { return conflateIntervalMilliseconds > 0; }
+    bool hasConflateGracePeriod() const { return conflateGracePeriodMilliseconds >= 0; }
+    std::string toString() const {
+      return "TypedOptions [marketDepthMax = " + ccapi::toString(marketDepthMax) + ", conflateIntervalMilliseconds = " +
+             ccapi::toString(conflateIntervalMilliseconds) + ", conflateGracePeriodMilliseconds = " + ccapi::toString(conflateGracePeriodMilliseconds) +
+             ", marketDepthReturnUpdate = " + ccapi::toString(marketDepthReturnUpdate) +
+             ", fetchMarketDepthInitialSnapshotDelayMilliseconds = " + ccapi::toString(fetchMarketDepthInitialSnapshotDelayMilliseconds) +
+             ", candlestickIntervalSeconds = " + ccapi::toString(candlestickIntervalSeconds) + "]";
+    }
+  };
   Subscription() {}
   Subscription(std::string exchange, std::string instrument, std::string field, std::string options = "", std::string correlationId = "",
                std::map<std::string, std::string> credential = {})
@@ -40,6 +59,7 @@ class Subscription CCAPI_FINAL {
         auto optionKeyValue = UtilString::split(option, "=");
         this->optionMap[optionKeyValue.at(0)] = optionKeyValue.at(1);
       }
+      this->typedOptions = parseTypedOptions(this->optionMap);
     }
     std::set<std::string> executionManagementSubscriptionFieldSet = {std::string(CCAPI_EM_ORDER_UPDATE), std::string(CCAPI_EM_PRIVATE_TRADE),
                                                                      std::string(CCAPI_EM_BALANCE_UPDATE), std::string(CCAPI_EM_POSITION_UPDATE)};
@@ -76,6 +96,7 @@ class Subscription CCAPI_FINAL {
   const std::string& getField() const { return field; }
   const std::string& getRawOptions() const { return rawOptions; }
   const std::map<std::string, std::string>& getOptionMap() const { return optionMap; }
+  const TypedOptions& getTypedOptions() const { return typedOptions; }
   const std::map<std::string, std::string>& getCredential() const { return credential; }
   const std::string& getServiceName() const { return serviceName; }
   const std::set<std::string>& getInstrumentSet() const { return instrumentSet; }
@@ -83,7 +104,7 @@ class Subscription CCAPI_FINAL {
   const std::string getSerializedOptions() const {
     std::string output;
     if (this->rawOptions.empty()) {
-      int i = 0;
+      size_t i = 0;
       for (const auto& option : this->optionMap) {
         output += option.first;
         output += "=";
@@ -137,10 +158,36 @@ class Subscription CCAPI_FINAL {
     }
     return output;
   }
+  // throw std::invalid_argument if an option is not an integer or is out of range
+  static TypedOptions parseTypedOptions(const std::map<std::string, std::string>& optionMap) {
+    TypedOptions typedOptions;
+    typedOptions.marketDepthMax = parseIntegerOption(optionMap, CCAPI_MARKET_DEPTH_MAX, 1);
+    typedOptions.conflateIntervalMilliseconds = parseIntegerOption(optionMap, CCAPI_CONFLATE_INTERVAL_MILLISECONDS, 0);
+    typedOptions.conflateGracePeriodMilliseconds = parseIntegerOption(optionMap, CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS, -1);
+    typedOptions.marketDepthReturnUpdate = optionMap.at(CCAPI_MARKET_DEPTH_RETURN_UPDATE) == CCAPI_MARKET_DEPTH_RETURN_UPDATE_ENABLE;
+    typedOptions.fetchMarketDepthInitialSnapshotDelayMilliseconds =
+        parseIntegerOption(optionMap, CCAPI_FETCH_MARKET_DEPTH_INITIAL_SNAPSHOT_DELAY_MILLISECONDS, 0);
+    typedOptions.candlestickIntervalSeconds = parseIntegerOption(optionMap, CCAPI_CANDLESTICK_INTERVAL_SECONDS, 1);
+    return typedOptions;
+  }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  private:
 #endif
+  static int parseIntegerOption(const std::map<std::string, std::string>& optionMap, const std::string& key, int minValue) {
+    const auto& value = optionMap.at(key);
+    size_t numParsed = 0;
+    int output = 0;
+    try {
+      output = std::stoi(value, &numParsed);
+    } catch (const std::exception&) {
+      numParsed = 0;
+    }
+    if (numParsed == 0 || numParsed != value.size() || output < minValue) {
+      throw std::invalid_argument("invalid subscription option " + key + " = " + value);
+    }
+    return output;
+  }
   std::string exchange;
   std::string marginType;
   std::string instrumentType;
@@ -148,6 +195,7 @@ class Subscription CCAPI_FINAL {
   std::string field;
   std::string rawOptions;
   std::map<std::string, std::string> optionMap;
+  TypedOptions typedOptions;
   std::string correlationId;
   std::map<std::string, std::string> credential;
   std::string serviceName;
@@ -0,0 +1,128 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_TLS_SESSION_CACHE_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_TLS_SESSION_CACHE_H_
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+#include "openssl/ssl.h"
+namespace ccapi {
+/**
+ * This class keeps the latest TLS session of each host, keyed by the SNI hostname of the connection it was established on, so that a new connection to
+ * that host resumes it with an abbreviated handshake instead of doing a full one. Once installed on an SSL_CTX, OpenSSL hands it every new session of the
+ * client connections of that SSL_CTX, including the TLS 1.3 tickets which only arrive after the handshake. It can be used from several io_context threads.
+ */
+class TlsSessionCache CCAPI_FINAL {
+ public:
+  struct Metrics {
+    size_t numFullHandshake{};
+    size_t numResumedHandshake{};
+    size_t numSessionStored{};  // sessions, or TLS 1.3 tickets, received from the servers
+    std::string toString() const {
+      std::string output = "TlsSessionCache::Metrics [numFullHandshake = " + ccapi::toString(numFullHandshake) +
+                           ", numResumedHandshake = " + ccapi::toString(numResumedHandshake) +
+                           ", numSessionStored = " + ccapi::toString(numSessionStored) + "]";
+      return output;
+    }
+  };
+  TlsSessionCache() = default;
+  TlsSessionCache(const TlsSessionCache&) = delete;
+  TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+  ~TlsSessionCache() { this->clear(); }
+  // the cache has to be uninstalled before it is destroyed, since the connections of sslCtx can outlive it
+  void install(SSL_CTX* sslCtx) {
+    SSL_CTX_set_session_cache_mode(sslCtx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_set_ex_data(sslCtx, getExDataIndex(), this);
+    SSL_CTX_sess_set_new_cb(sslCtx, &TlsSessionCache::onNewSession);
+  }
+  void uninstall(SSL_CTX* sslCtx) {
+    SSL_CTX_sess_set_new_cb(sslCtx, nullptr);
+    SSL_CTX_set_ex_data(sslCtx, getExDataIndex(), nullptr);
+  }
+  // offers the session of host to ssl before its handshake, the server falls back to a full handshake if it does not accept it
+  bool apply(SSL* ssl, const std::string& host) {
+    std::lock_guard<std::mutex> lock(this->sessionByHostMapMutex);
+    auto it = this->sessionByHostMap.find(host);
+    if (it == this->sessionByHostMap.end() || !SSL_SESSION_is_resumable(it->second)) {
+      return false;
+    }
+    // a copy, since OpenSSL marks the session of a connection freed without a TLS shutdown as not resumable
+    SSL_SESSION* session = SSL_SESSION_dup(it->second);
+    if (!session) {
+      return false;
+    }
+    bool isSet = SSL_set_session(ssl, session) == 1;
+    SSL_SESSION_free(session);
+    return isSet;
+  }
+  // to be called once the handshake of ssl has succeeded
+  void onHandshake(SSL* ssl) {
+    if (SSL_session_reused(ssl)) {
+      this->numResumedHandshake.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      this->numFullHandshake.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  void erase(const std::string& host) {
+    std::lock_guard<std::mutex> lock(this->sessionByHostMapMutex);
+    auto it = this->sessionByHostMap.find(host);
+    if (it != this->sessionByHostMap.end()) {
+      SSL_SESSION_free(it->second);
+      this->sessionByHostMap.erase(it);
+    }
+  }
+  void clear() {
+    std::lock_guard<std::mutex> lock(this->sessionByHostMapMutex);
+    for (const auto& x : this->sessionByHostMap) {
+      SSL_SESSION_free(x.second);
+    }
+    this->sessionByHostMap.clear();
+  }
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(this->sessionByHostMapMutex);
+    return this->sessionByHostMap.size();
+  }
+  Metrics getMetrics() const {
+    Metrics metrics;
+    metrics.numFullHandshake = this->numFullHandshake.load(std::memory_order_relaxed);
+    metrics.numResumedHandshake = this->numResumedHandshake.load(std::memory_order_relaxed);
+    metrics.numSessionStored = this->numSessionStored.load(std::memory_order_relaxed);
+    return metrics;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  static int getExDataIndex() {
+    static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+  }
+  // a copy of session is kept, for the same reason as in apply, so OpenSSL keeps its reference to session
+  static int onNewSession(SSL* ssl, SSL_SESSION* session) {
+    auto* tlsSessionCachePtr = static_cast<TlsSessionCache*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), getExDataIndex()));
+    const char* host = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+    SSL_SESSION* sessionCopy = tlsSessionCachePtr && host ? SSL_SESSION_dup(session) : nullptr;
+    if (sessionCopy) {
+      tlsSessionCachePtr->put(host, sessionCopy);
+    }
+    return 0;
+  }
+  void put(const std::string& host, SSL_SESSION* session) {
+    std::lock_guard<std::mutex> lock(this->sessionByHostMapMutex);
+    SSL_SESSION*& existingSession = this->sessionByHostMap[host];
+    if (existingSession) {
+      SSL_SESSION_free(existingSession);
+    }
+    existingSession = session;
+    this->numSessionStored.fetch_add(1, std::memory_order_relaxed);
+  }
+  mutable std::mutex sessionByHostMapMutex;
+  std::map<std::string, SSL_SESSION*> sessionByHostMap;
+  std::atomic<size_t> numFullHandshake{};
+  std::atomic<size_t> numResumedHandshake{};
+  std::atomic<size_t> numSessionStored{};
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_TLS_SESSION_CACHE_H_
@@ -12,7 +12,7 @@ namespace ccapi {
 class Url CCAPI_FINAL {
  public:
   explicit Url(std::string urlStr) {
-    std::regex ex("^(.*:)//([A-Za-z0-9\\-\\.]+)(:[0-9]+)?(.*)$");
+    static const std::regex ex("^(.*:)//([A-Za-z0-9\\-\\.]+)(:[0-9]+)?(.*)$");
     std::cmatch what;
     if (std::regex_match(urlStr.c_str(), what, ex)) {
       this->protocol = std::string(what[1].first, what[1].second);
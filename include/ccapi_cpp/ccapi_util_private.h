@@ -7,8 +7,10 @@
 
 #include <algorithm>
 #include <array>
+#include <charconv>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
@@ -21,6 +23,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -71,6 +74,18 @@ class UtilString CCAPI_FINAL {
     };
     return s.replace(pos, toReplace.length(), replaceWith);
   }
+  static std::string replaceAllOccurrence(const std::string& s, const std::string& toReplace, const std::string& replaceWith) {
+    std::string output;
+    std::size_t begin = 0;
+    std::size_t pos;
+    while (!toReplace.empty() && (pos = s.find(toReplace, begin)) != std::string::npos) {
+      output.append(s, begin, pos - begin);
+      output += replaceWith;
+      begin = pos + toReplace.length();
+    }
+    output.append(s, begin, std::string::npos);
+    return output;
+  }
   static bool endsWith(const std::string& mainStr, const std::string& toMatch) {
     if (mainStr.size() >= toMatch.size() && mainStr.compare(mainStr.size() - toMatch.size(), toMatch.size(), toMatch) == 0) {
       return true;
@@ -249,6 +264,49 @@ class UtilString CCAPI_FINAL {
     }
     return str;
   }
+  // trims the view before copying it so that the result is built with a single allocation, if any
+  static std::string normalizeDecimalString(std::string_view original) { return std::string(normalizeDecimalStringView(original)); }
+  // the normalized decimal as a view into the original, without any allocation
+  static std::string_view normalizeDecimalStringView(std::string_view original) {
+    if (original.find('.') != std::string_view::npos) {
+      original.remove_suffix(original.size() - 1 - original.find_last_not_of('0'));
+      if (original.back() == '.') {
+        original.remove_suffix(1);
+      }
+    }
+    return original;
+  }
+  // writes the normalized decimal into a caller's buffer, whose capacity is reused
+  static void normalizeDecimalStringTo(std::string_view original, std::string& output) { output.assign(normalizeDecimalStringView(original)); }
+  // std::from_chars based replacement of std::stoi and std::stoll which throws likewise, but neither skips leading whitespace nor accepts a leading '+'
+  template <typename T>
+  static T parseInteger(std::string_view input) {
+    T value{};
+    auto result = std::from_chars(input.data(), input.data() + input.size(), value);
+    if (result.ec == std::errc::result_out_of_range) {
+      throw std::out_of_range("parseInteger: " + std::string(input));
+    }
+    if (result.ec != std::errc()) {
+      throw std::invalid_argument("parseInteger: " + std::string(input));
+    }
+    return value;
+  }
+  // the value of the 8 ASCII digits at data, converted all at once within a 64-bit word (SWAR), or -1 if any of them isn't a digit
+  static int64_t parseEightDigits(const char* data) {
+    uint64_t word;
+    std::memcpy(&word, data, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    if (((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) != 0x3333333333333333) {
+      return -1;
+    }
+    word -= 0x3030303030303030;
+    // pairs of digits, then groups of 4 digits, then the 8 digits
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) + (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+    return static_cast<int64_t>(static_cast<uint32_t>(word));
+  }
   static std::string leftPadTo(const std::string& str, const size_t padToLength, const char paddingChar) {
     std::string copy = str;
     if (padToLength > copy.size()) {
@@ -472,8 +530,69 @@ class UtilTime CCAPI_FINAL {
     return s.count();
   }
   static TimePoint makeTimePointFromMilliseconds(long long milliseconds) { return TimePoint(std::chrono::milliseconds(milliseconds)); }
+  static TimePoint makeTimePointFromMilliseconds(std::string_view milliseconds) { return makeTimePointFromMilliseconds(parseMilliseconds(milliseconds)); }
+  // millisecond timestamps have 13 digits: the last 8 are converted at once and the others one by one, and anything else goes through std::from_chars
+  static long long parseMilliseconds(std::string_view milliseconds) {
+    if (milliseconds.size() > 8 && milliseconds.size() <= 16) {
+      size_t numHighDigit = milliseconds.size() - 8;
+      long long high = 0;
+      size_t i = 0;
+      for (; i < numHighDigit && static_cast<unsigned>(milliseconds[i] - '0') <= 9; ++i) {
+        high = high * 10 + (milliseconds[i] - '0');
+      }
+      int64_t low = i == numHighDigit ? UtilString::parseEightDigits(milliseconds.data() + numHighDigit) : -1;
+      if (low >= 0) {
+        return high * 100000000 + low;
+      }
+    }
+    return UtilString::parseInteger<long long>(milliseconds);
+  }
   static TimePoint makeTimePointFromSeconds(long seconds) { return TimePoint(std::chrono::seconds(seconds)); }
 };
+/**
+ * This class formats time points like UtilTime::getISOTimestamp<T>, e.g. 2023-09-20T06:14:51.421Z for milliseconds, into a buffer of its own. The date and
+ * the time of day are only recomputed when the second changes, otherwise just the sub-second digits are rewritten, which suits the timestamps of
+ * consecutive requests. An instance must not be shared between threads.
+ */
+template <typename T = std::chrono::nanoseconds>
+class IsoTimestampFormatter CCAPI_FINAL {
+ public:
+  // the view is valid until the next call
+  std::string_view format(const TimePoint& tp) {
+    auto second = std::chrono::floor<std::chrono::seconds>(tp);
+    if (this->size == 0 || second != this->second) {
+      this->second = second;
+      std::string prefix = UtilTime::getISOTimestamp<std::chrono::seconds>(second);
+      prefix.pop_back();
+      std::memcpy(this->buffer, prefix.data(), prefix.size());
+      this->size = prefix.size();
+      if (NUM_FRACTIONAL_DIGIT > 0) {
+        this->buffer[this->size++] = '.';
+        this->size += NUM_FRACTIONAL_DIGIT;
+      }
+      this->buffer[this->size++] = 'Z';
+    }
+    if (NUM_FRACTIONAL_DIGIT > 0) {
+      auto fractionalSecond = std::chrono::duration_cast<T>(tp - second).count();
+      for (char* p = this->buffer + this->size - 2; p > this->buffer + this->size - 2 - NUM_FRACTIONAL_DIGIT; --p) {
+        *p = static_cast<char>('0' + fractionalSecond % 10);
+        fractionalSecond /= 10;
+      }
+    }
+    return std::string_view(this->buffer, this->size);
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  static constexpr int NUM_FRACTIONAL_DIGIT = std::is_same<T, std::chrono::nanoseconds>::value    ? 9
+                                              : std::is_same<T, std::chrono::microseconds>::value ? 6
+                                              : std::is_same<T, std::chrono::milliseconds>::value ? 3
+                                                                                                  : 0;
+  std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds> second;
+  char buffer[48];
+  size_t size{};
+};
 class UtilAlgorithm CCAPI_FINAL {
  public:
   enum class ShaVersion {
@@ -617,7 +736,11 @@ class UtilAlgorithm CCAPI_FINAL {
   }
   //  https://github.com/brianloveswords/base64url
   static std::string base64UrlFromBase64(const std::string& base64) {
-    return std::regex_replace(std::regex_replace(std::regex_replace(base64, std::regex("="), ""), std::regex("\\+"), "-"), std::regex("\\/"), "_");
+    std::string base64Url(base64);
+    base64Url.erase(std::remove(base64Url.begin(), base64Url.end(), '='), base64Url.end());
+    std::replace(base64Url.begin(), base64Url.end(), '+', '-');
+    std::replace(base64Url.begin(), base64Url.end(), '/', '_');
+    return base64Url;
   }
   static std::string base64FromBase64Url(const std::string& base64Url) {
     auto segmentLength = 4;
@@ -629,7 +752,9 @@ class UtilAlgorithm CCAPI_FINAL {
     auto padLength = segmentLength - diff;
     std::string paddedBase64Url(base64Url);
     paddedBase64Url += std::string(padLength, '=');
-    return std::regex_replace(std::regex_replace(paddedBase64Url, std::regex("\\-"), "+"), std::regex("_"), "/");
+    std::replace(paddedBase64Url.begin(), paddedBase64Url.end(), '-', '+');
+    std::replace(paddedBase64Url.begin(), paddedBase64Url.end(), '_', '/');
+    return paddedBase64Url;
   }
   static std::string base64UrlEncode(const std::string& in) { return base64UrlFromBase64(base64Encode(in)); }
   static std::string base64UrlDecode(const std::string& in) { return base64Decode(base64FromBase64Url(in)); }
@@ -763,8 +888,8 @@ template <typename T>
 reversion_wrapper<T> reverse(T&& iterable) {
   return {iterable};
 }
-template <typename K, typename V>
-bool firstNSame(const std::map<K, V>& c1, const std::map<K, V>& c2, size_t n) {
+template <typename C1, typename C2>
+bool firstNSame(const C1& c1, const C2& c2, size_t n) {
   if (c1.empty() || c2.empty()) {
     return c1.empty() && c2.empty();
   }
@@ -783,8 +908,8 @@ bool firstNSame(const std::map<K, V>& c1, const std::map<K, V>& c2, size_t n) {
   }
   return true;
 }
-template <typename K, typename V>
-bool lastNSame(const std::map<K, V>& c1, const std::map<K, V>& c2, size_t n) {
+template <typename C1, typename C2>
+bool lastNSame(const C1& c1, const C2& c2, size_t n) {
   if (c1.empty() || c2.empty()) {
     return c1.empty() && c2.empty();
   }
@@ -106,7 +106,7 @@ class ExecutionManagementService : public Service {
 #endif
   virtual std::vector<Message> convertTextMessageToMessageRest(const Request& request, const std::string& textMessage, const TimePoint& timeReceived) {
     CCAPI_LOGGER_DEBUG("textMessage = " + textMessage);
-    rj::Document document;
+    rj::Document document(&this->resetJsonParseArena());
     document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
     Message message;
     message.setTimeReceived(timeReceived);
@@ -9,6 +9,7 @@ class ExecutionManagementServiceBitgetBase : public ExecutionManagementService {
   ExecutionManagementServiceBitgetBase(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                                        ServiceContextPtr serviceContextPtr)
       : ExecutionManagementService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodySuccessConditionList = {JsonScanner::hasKeyValue("code", "\"00000\"")};
     this->hostHttpHeaderValueIgnorePort = true;
   }
   virtual ~ExecutionManagementServiceBitgetBase() {}
@@ -21,7 +22,6 @@ class ExecutionManagementServiceBitgetBase : public ExecutionManagementService {
 #else
   void pingOnApplicationLevel(std::shared_ptr<WsConnection> wsConnectionPtr, ErrorCode& ec) override { this->send(wsConnectionPtr, "ping", ec); }
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*\"00000\"")); }
   void signReqeustForRestGenericPrivateRequest(http::request<http::string_body>& req, const Request& request, std::string& methodString,
                                                std::string& headerString, std::string& path, std::string& queryString, std::string& body, const TimePoint& now,
                                                const std::map<std::string, std::string>& credential) override {
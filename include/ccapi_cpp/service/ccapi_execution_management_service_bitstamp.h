@@ -9,6 +9,7 @@ class ExecutionManagementServiceBitstamp : public ExecutionManagementService {
   ExecutionManagementServiceBitstamp(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                                      ServiceContextPtr serviceContextPtr)
       : ExecutionManagementService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodyErrorConditionList = {JsonScanner::hasKeyValue("status", "\"error\""), JsonScanner::hasKey("error")};
     this->exchangeName = CCAPI_EXCHANGE_NAME_BITSTAMP;
     this->baseUrlWs = sessionConfigs.getUrlWebsocketBase().at(this->exchangeName);
     this->baseUrlRest = sessionConfigs.getUrlRestBase().at(this->exchangeName);
@@ -53,10 +54,6 @@ class ExecutionManagementServiceBitstamp : public ExecutionManagementService {
     this->send(wsConnectionPtr, R"({"event": "bts:heartbeat"})", ec);
   }
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override {
-    return body.find(R"("status": "error")") != std::string::npos || body.find(R"("status":"error")") != std::string::npos ||
-           body.find(R"("error":)") != std::string::npos;
-  }
   void signReqeustForRestGenericPrivateRequest(http::request<http::string_body>& req, const Request& request, std::string& methodString,
                                                std::string& headerString, std::string& path, std::string& queryString, std::string& body, const TimePoint& now,
                                                const std::map<std::string, std::string>& credential) override {
@@ -125,7 +125,7 @@ class ExecutionManagementServiceCoinbase : public ExecutionManagementService {
         std::string id = param.find(CCAPI_EM_ORDER_ID) != param.end()          ? param.at(CCAPI_EM_ORDER_ID)
                          : param.find(CCAPI_EM_CLIENT_ORDER_ID) != param.end() ? "client:" + param.at(CCAPI_EM_CLIENT_ORDER_ID)
                                                                                : "";
-        auto target = std::regex_replace(this->cancelOrderTarget, std::regex("<id>"), id);
+        auto target = UtilString::replaceAllOccurrence(this->cancelOrderTarget, "<id>", id);
         if (!symbolId.empty()) {
           target += "?product_id=";
           target += symbolId;
@@ -139,7 +139,7 @@ class ExecutionManagementServiceCoinbase : public ExecutionManagementService {
         std::string id = param.find(CCAPI_EM_ORDER_ID) != param.end()          ? param.at(CCAPI_EM_ORDER_ID)
                          : param.find(CCAPI_EM_CLIENT_ORDER_ID) != param.end() ? "client:" + param.at(CCAPI_EM_CLIENT_ORDER_ID)
                                                                                : "";
-        auto target = std::regex_replace(this->getOrderTarget, std::regex("<id>"), id);
+        auto target = UtilString::replaceAllOccurrence(this->getOrderTarget, "<id>", id);
         req.target(target);
         this->signRequest(req, "", credential);
       } break;
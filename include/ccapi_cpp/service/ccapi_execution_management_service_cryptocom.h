@@ -395,13 +395,15 @@ class ExecutionManagementServiceCryptocom : public ExecutionManagementService {
       } else {
         const rj::Value& result = itResult->value;
         std::string exchangeSubscriptionId = result["subscription"].GetString();
+        static const std::regex orderUpdateRegex("user\\.order\\.(.+)");
+        static const std::regex privateTradeRegex("user\\.trade\\.(.+)");
         std::smatch match;
         std::string instrument;
         std::string field;
-        if (std::regex_search(exchangeSubscriptionId, match, std::regex("user\\.order\\.(.+)"))) {
+        if (std::regex_search(exchangeSubscriptionId, match, orderUpdateRegex)) {
           instrument = match[1].str();
           field = CCAPI_EM_ORDER_UPDATE;
-        } else if (std::regex_search(exchangeSubscriptionId, match, std::regex("user\\.trade\\.(.+)"))) {
+        } else if (std::regex_search(exchangeSubscriptionId, match, privateTradeRegex)) {
           instrument = match[1].str();
           field = CCAPI_EM_PRIVATE_TRADE;
         }
@@ -481,13 +481,15 @@ class ExecutionManagementServiceDeribit : public ExecutionManagementService {
         if (method == "subscription") {
           const rj::Value& params = document["params"];
           std::string exchangeSubscriptionId = params["channel"].GetString();
+          static const std::regex orderUpdateRegex("user\\.orders\\.(.+)\\.raw");
+          static const std::regex privateTradeRegex("user\\.trades\\.(.+)\\.raw");
           std::smatch match;
           std::string instrument;
           std::string field;
-          if (std::regex_search(exchangeSubscriptionId, match, std::regex("user\\.orders\\.(.+)\\.raw"))) {
+          if (std::regex_search(exchangeSubscriptionId, match, orderUpdateRegex)) {
             instrument = match[1].str();
             field = CCAPI_EM_ORDER_UPDATE;
-          } else if (std::regex_search(exchangeSubscriptionId, match, std::regex("user\\.trades\\.(.+)\\.raw"))) {
+          } else if (std::regex_search(exchangeSubscriptionId, match, privateTradeRegex)) {
             instrument = match[1].str();
             field = CCAPI_EM_PRIVATE_TRADE;
           }
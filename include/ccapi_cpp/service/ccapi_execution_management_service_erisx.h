@@ -10,6 +10,8 @@ class ExecutionManagementServiceErisx : public ExecutionManagementService {
   ExecutionManagementServiceErisx(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                                   ServiceContextPtr serviceContextPtr)
       : ExecutionManagementService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodyErrorConditionList = {JsonScanner::hasKeyValue("ordStatus", "\"REJECTED\""),
+                                        JsonScanner::hasKeyValue("message", "\"Rejected with reason NO RESTING ORDERS\"")};
     this->exchangeName = CCAPI_EXCHANGE_NAME_ERISX;
     this->baseUrlWs = sessionConfigs.getUrlWebsocketBase().at(this->exchangeName);
     this->baseUrlRest = sessionConfigs.getUrlRestBase().at(this->exchangeName);
@@ -43,10 +45,6 @@ class ExecutionManagementServiceErisx : public ExecutionManagementService {
 
  private:
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override {
-    return body.find("\"ordStatus\":\"REJECTED\"") != std::string::npos ||
-           body.find("\"message\":\"Rejected with reason NO RESTING ORDERS\"") != std::string::npos;
-  }
   void signRequest(http::request<http::string_body>& req, const TimePoint& now, const std::map<std::string, std::string>& credential) {
     auto apiSecret = mapGetWithDefault(credential, this->apiSecretName);
     rj::Document tokenPayloadDocument;
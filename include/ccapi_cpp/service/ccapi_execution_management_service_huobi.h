@@ -9,6 +9,7 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
   ExecutionManagementServiceHuobi(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                                   ServiceContextPtr serviceContextPtr)
       : ExecutionManagementServiceHuobiBase(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodyErrorConditionList = {JsonScanner::hasKey("err-code")};
     this->exchangeName = CCAPI_EXCHANGE_NAME_HUOBI;
     this->baseUrlWs = sessionConfigs.getUrlWebsocketBase().at(this->exchangeName) + "/ws/v2";
     this->baseUrlRest = sessionConfigs.getUrlRestBase().at(this->exchangeName);
@@ -45,7 +46,6 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
 
  private:
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return body.find("err-code") != std::string::npos; }
   void appendSymbolId(rj::Document& document, rj::Document::AllocatorType& allocator, const std::string& symbolId) {
     ExecutionManagementServiceHuobiBase::appendSymbolId(document, allocator, symbolId, "symbol");
   }
@@ -89,7 +89,7 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
                          : param.find(CCAPI_EM_CLIENT_ORDER_ID) != param.end() ? "client:" + param.at(CCAPI_EM_CLIENT_ORDER_ID)
                                                                                : "";
         auto target =
-            shouldUseOrderId ? std::regex_replace(this->cancelOrderTarget, std::regex("\\{order\\-id\\}"), id) : this->cancelOrderByClientOrderIdTarget;
+            shouldUseOrderId ? UtilString::replaceAllOccurrence(this->cancelOrderTarget, "{order-id}", id) : this->cancelOrderByClientOrderIdTarget;
         if (!shouldUseOrderId) {
           rj::Document document;
           document.SetObject();
@@ -114,7 +114,7 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
         std::string id = shouldUseOrderId                                      ? param.at(CCAPI_EM_ORDER_ID)
                          : param.find(CCAPI_EM_CLIENT_ORDER_ID) != param.end() ? param.at(CCAPI_EM_CLIENT_ORDER_ID)
                                                                                : "";
-        auto target = shouldUseOrderId ? std::regex_replace(this->getOrderTarget, std::regex("\\{order\\-id\\}"), id) : this->getOrderByClientOrderIdTarget;
+        auto target = shouldUseOrderId ? UtilString::replaceAllOccurrence(this->getOrderTarget, "{order-id}", id) : this->getOrderByClientOrderIdTarget;
         req.target(target);
         if (!shouldUseOrderId) {
           ExecutionManagementServiceHuobiBase::appendParam(queryParamMap, param,
@@ -165,7 +165,7 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
         req.method(http::verb::get);
         const std::map<std::string, std::string> param = request.getFirstParamWithDefault();
         auto accountId = mapGetWithDefault(param, std::string(CCAPI_EM_ACCOUNT_ID));
-        auto target = std::regex_replace(this->getAccountBalancesTarget, std::regex("\\{account\\-id\\}"), accountId);
+        auto target = UtilString::replaceAllOccurrence(this->getAccountBalancesTarget, "{account-id}", accountId);
         this->signRequest(req, target, queryParamMap, credential);
       } break;
       default:
@@ -10,6 +10,7 @@ class ExecutionManagementServiceHuobiDerivativesBase : public ExecutionManagemen
   ExecutionManagementServiceHuobiDerivativesBase(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions,
                                                  SessionConfigs sessionConfigs, ServiceContextPtr serviceContextPtr)
       : ExecutionManagementServiceHuobiBase(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodyErrorConditionList = {JsonScanner::hasKey("err_code")};
     this->isDerivatives = true;
     // this->convertNumberToStringInJsonRegex = std::regex("(\\[|,|\":)\\s?(-?\\d+\\.?\\d*[eE]?-?\\d*)");
     this->needDecompressWebsocketMessage = true;
@@ -28,7 +29,6 @@ class ExecutionManagementServiceHuobiDerivativesBase : public ExecutionManagemen
 
  protected:
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return body.find("err_code") != std::string::npos; }
   void appendSymbolId(rj::Document& document, rj::Document::AllocatorType& allocator, const std::string& symbolId) {
     ExecutionManagementServiceHuobiBase::appendSymbolId(document, allocator, symbolId, "contract_code");
   }
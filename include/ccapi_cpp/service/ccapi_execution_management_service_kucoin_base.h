@@ -8,13 +8,14 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
  public:
   ExecutionManagementServiceKucoinBase(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                                        ServiceContextPtr serviceContextPtr)
-      : ExecutionManagementService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {}
+      : ExecutionManagementService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodySuccessConditionList = {JsonScanner::hasKeyValue("code", "\"200000\"")};
+  }
   virtual ~ExecutionManagementServiceKucoinBase() {}
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  protected:
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*\"200000\"")); }
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
   void onOpen(wspp::connection_hdl hdl) override {
     WsConnection& wsConnection = this->getWsConnectionFromConnectionPtr(this->serviceContextPtr->tlsClientPtr->get_con_from_hdl(hdl));
@@ -240,8 +241,7 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
         std::string id = useOrderId                                            ? param.at(CCAPI_EM_ORDER_ID)
                          : param.find(CCAPI_EM_CLIENT_ORDER_ID) != param.end() ? "client-order/" + param.at(CCAPI_EM_CLIENT_ORDER_ID)
                                                                                : "";
-        auto target =
-            useOrderId ? std::regex_replace(this->cancelOrderTarget, std::regex("<id>"), id) : std::regex_replace("/api/v1/order/<id>", std::regex("<id>"), id);
+        auto target = UtilString::replaceAllOccurrence(useOrderId ? this->cancelOrderTarget : "/api/v1/order/<id>", "<id>", id);
         req.target(target);
         this->signRequest(req, "", credential);
       } break;
@@ -252,7 +252,7 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
         std::string id = useOrderId                                            ? param.at(CCAPI_EM_ORDER_ID)
                          : param.find(CCAPI_EM_CLIENT_ORDER_ID) != param.end() ? param.at(CCAPI_EM_CLIENT_ORDER_ID)
                                                                                : "";
-        auto target = std::regex_replace(useOrderId ? this->getOrderTarget : this->getOrderByClientOrderIdTarget, std::regex("<id>"), Url::urlEncode(id));
+        auto target = UtilString::replaceAllOccurrence(useOrderId ? this->getOrderTarget : this->getOrderByClientOrderIdTarget, "<id>", Url::urlEncode(id));
         req.target(target);
         this->signRequest(req, "", credential);
       } break;
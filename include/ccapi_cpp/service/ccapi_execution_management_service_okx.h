@@ -10,6 +10,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
   ExecutionManagementServiceOkx(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                                 ServiceContextPtr serviceContextPtr)
       : ExecutionManagementService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodySuccessConditionList = {JsonScanner::hasKeyValue("code", "\"0\"")};
     this->exchangeName = CCAPI_EXCHANGE_NAME_OKX;
     this->baseUrlWs = sessionConfigs.getUrlWebsocketBase().at(this->exchangeName) + CCAPI_OKX_PRIVATE_WS_PATH;
     this->baseUrlRest = sessionConfigs.getUrlRestBase().at(this->exchangeName);
@@ -33,6 +34,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
     this->apiPassphraseName = CCAPI_OKX_API_PASSPHRASE;
     this->apiXSimulatedTradingName = CCAPI_OKX_API_X_SIMULATED_TRADING;
     this->setupCredential({this->apiKeyName, this->apiSecretName, this->apiPassphraseName, this->apiXSimulatedTradingName});
+    this->httpKeepAliveProbeTarget = "/api/v5/public/time";
     this->createOrderTarget = "/api/v5/trade/order";
     this->cancelOrderTarget = "/api/v5/trade/cancel-order";
     this->getOrderTarget = "/api/v5/trade/order";
@@ -51,7 +53,6 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
 #else
   void pingOnApplicationLevel(std::shared_ptr<WsConnection> wsConnectionPtr, ErrorCode& ec) override { this->send(wsConnectionPtr, "ping", ec); }
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*\"0\"")); }
 
   void signReqeustForRestGenericPrivateRequest(http::request<http::string_body>& req, const Request& request, std::string& methodString,
                                                std::string& headerString, std::string& path, std::string& queryString, std::string& body, const TimePoint& now,
@@ -131,8 +132,10 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
     req.set(beast::http::field::content_type, "application/json");
     auto apiKey = mapGetWithDefault(credential, this->apiKeyName);
     req.set("OK-ACCESS-KEY", apiKey);
-    std::string timeStr = UtilTime::getISOTimestamp<std::chrono::milliseconds>(now);
-    req.set("OK-ACCESS-TIMESTAMP", timeStr);
+    // requests are converted on the user threads as well as on the io_context thread, hence a formatter per thread
+    thread_local IsoTimestampFormatter<std::chrono::milliseconds> isoTimestampFormatter;
+    auto timestamp = isoTimestampFormatter.format(now);
+    req.set("OK-ACCESS-TIMESTAMP", beast::string_view(timestamp.data(), timestamp.size()));
     auto apiPassphrase = mapGetWithDefault(credential, this->apiPassphraseName);
     req.set("OK-ACCESS-PASSPHRASE", apiPassphrase);
     auto apiXSimulatedTrading = mapGetWithDefault(credential, this->apiXSimulatedTradingName);
@@ -285,7 +288,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
     this->extractOrderInfoFromRequest(elementList, document);
   }
 
-  void extractOrderInfoFromRequest(std::vector<Element>& elementList, const rj::Document& document) {
+  void extractOrderInfoFromRequest(std::vector<Element>& elementList, const rj::Value& document) {
     const std::map<std::string, std::pair<std::string, JsonDataType>>& extractionFieldNameMap = {
         {CCAPI_EM_ORDER_ID, std::make_pair("ordId", JsonDataType::STRING)},
         {CCAPI_EM_CLIENT_ORDER_ID, std::make_pair("clOrdId", JsonDataType::STRING)},
@@ -396,13 +399,14 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
       const TimePoint& timeReceived) override {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
-    std::string textMessage(textMessageView);
+    std::string_view textMessage(textMessageView.data(), textMessageView.size());
 #endif
     if (textMessage != "pong") {
-      rj::Document document;
-      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+      auto& jsonParseArena = this->resetJsonParseArena();
+      ArenaDocument document(&jsonParseArena, CCAPI_JSON_PARSE_STACK_CAPACITY, &jsonParseArena);
+      document.ParseInsitu<rj::kParseNumbersAsStringsFlag>(this->copyToInsituParseBuffer(textMessage.data(), textMessage.size()));
       auto it = document.FindMember("event");
-      std::string eventStr = it != document.MemberEnd() ? it->value.GetString() : "";
+      std::string_view eventStr = it != document.MemberEnd() ? toStringView(it->value) : std::string_view();
       if (eventStr == "login") {
         rj::Document document;
         document.SetObject();
@@ -474,7 +478,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
     }
   }
 
-  Event createEvent(const Subscription& subscription, const std::string& textMessage, const rj::Document& document, const std::string& eventStr,
+  Event createEvent(const Subscription& subscription, std::string_view textMessage, const rj::Value& document, std::string_view eventStr,
                     const TimePoint& timeReceived) {
     Event event;
     std::vector<Message> messageList;
@@ -493,7 +497,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
         if (code != "0") {
           message.setType(Message::Type::RESPONSE_ERROR);
           Element element;
-          element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+          element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
           message.setElementList({element});
           message.setSecondaryCorrelationIdMap({
               {correlationId, document["id"].GetString()},
@@ -526,7 +530,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
                 Message message;
                 message.setTimeReceived(timeReceived);
                 message.setCorrelationIdList({subscription.getCorrelationId()});
-                message.setTime(UtilTime::makeTimePointFromMilliseconds(std::stoll(std::string(x["fillTime"].GetString()))));
+                message.setTime(UtilTime::makeTimePointFromMilliseconds(toStringView(x["fillTime"])));
                 message.setType(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE);
                 std::vector<Element> elementList;
                 Element element;
@@ -552,7 +556,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
               Message message;
               message.setTimeReceived(timeReceived);
               message.setCorrelationIdList({subscription.getCorrelationId()});
-              message.setTime(UtilTime::makeTimePointFromMilliseconds(std::stoll(std::string(x["uTime"].GetString()))));
+              message.setTime(UtilTime::makeTimePointFromMilliseconds(toStringView(x["uTime"])));
               message.setType(Message::Type::EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE);
               const std::map<std::string, std::pair<std::string, JsonDataType>>& extractionFieldNameMap = {
                   {CCAPI_EM_ORDER_ID, std::make_pair("ordId", JsonDataType::STRING)},
@@ -580,7 +584,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
             Message message;
             message.setTimeReceived(timeReceived);
             message.setCorrelationIdList({subscription.getCorrelationId()});
-            message.setTime(TimePoint(std::chrono::milliseconds(std::stoll(x["pTime"].GetString()))));
+            message.setTime(UtilTime::makeTimePointFromMilliseconds(toStringView(x["pTime"])));
             message.setType(Message::Type::EXECUTION_MANAGEMENT_EVENTS_BALANCE_UPDATE);
             std::vector<Element> elementList;
             for (const auto& y : x["balData"].GetArray()) {
@@ -597,7 +601,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
             Message message;
             message.setTimeReceived(timeReceived);
             message.setCorrelationIdList({subscription.getCorrelationId()});
-            message.setTime(TimePoint(std::chrono::milliseconds(std::stoll(x["uTime"].GetString()))));
+            message.setTime(UtilTime::makeTimePointFromMilliseconds(toStringView(x["uTime"])));
             message.setType(Message::Type::EXECUTION_MANAGEMENT_EVENTS_POSITION_UPDATE);
             std::vector<Element> elementList;
             Element element;
@@ -616,14 +620,14 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_STARTED);
       Element element;
-      element.insert(CCAPI_INFO_MESSAGE, textMessage);
+      element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     } else if (eventStr == "error") {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     }
@@ -1,13 +1,25 @@
 #ifndef INCLUDE_CCAPI_CPP_SERVICE_CCAPI_MARKET_DATA_SERVICE_H_
 #define INCLUDE_CCAPI_CPP_SERVICE_CCAPI_MARKET_DATA_SERVICE_H_
 #ifdef CCAPI_ENABLE_SERVICE_MARKET_DATA
+#include <charconv>
 #include <functional>
+#include <limits>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+#ifndef CCAPI_LEGACY_USE_WEBSOCKETPP
+#include "boost/asio/thread_pool.hpp"
+#endif
+#include "ccapi_cpp/ccapi_crc32.h"
 #include "ccapi_cpp/ccapi_hmac.h"
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_price_ladder.h"
+#include "ccapi_cpp/ccapi_small_order_book.h"
 #include "ccapi_cpp/ccapi_util_private.h"
 #include "ccapi_cpp/service/ccapi_service.h"
 namespace ccapi {
@@ -31,13 +43,26 @@ class MarketDataService : public Service {
         {Request::Operation::GET_INSTRUMENT, Message::Type::GET_INSTRUMENT},
         {Request::Operation::GET_INSTRUMENTS, Message::Type::GET_INSTRUMENTS},
     };
+#ifndef CCAPI_LEGACY_USE_WEBSOCKETPP
+    if (this->sessionOptions.enableCheckOrderBookChecksum && this->sessionOptions.enableOrderBookChecksumVerifyAsync) {
+      this->orderBookChecksumThreadPoolPtr.reset(new net::thread_pool(1));
+    }
+#endif
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
   virtual ~MarketDataService() {
-    for (const auto& x : this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap) {
+#ifndef CCAPI_LEGACY_USE_WEBSOCKETPP
+    if (this->orderBookChecksumThreadPoolPtr) {
+      this->orderBookChecksumThreadPoolPtr->stop();
+      this->orderBookChecksumThreadPoolPtr->join();
+    }
+#endif
+    for (const auto& x : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap) {
       for (const auto& y : x.second) {
         for (const auto& z : y.second) {
-          z.second->cancel();
+          if (z.second.conflateTimer) {
+            z.second.conflateTimer->cancel();
+          }
         }
       }
     }
@@ -166,6 +191,128 @@ class MarketDataService : public Service {
 #else
   typedef boost::system::error_code ErrorCode;
 #endif
+  // a level touched by updateOrderBook during the current update, with its size before the update or an empty string if it wasn't in the book
+  struct DirtyLevel {
+    Decimal price;
+    std::string previousSize;
+  };
+  // everything kept for one subscribed (connection, channel, symbol), so that a message resolves its state once instead of once per piece of state
+  struct SubscriptionState {
+    std::string channelId;
+    std::string symbolId;
+    std::string exchangeSubscriptionId;
+    int exchangeSubscriptionKey{-1};
+    std::string field;
+    std::map<std::string, std::string> optionMap;
+    Subscription::TypedOptions typedOptions;
+    int marketDepthSubscribedToExchange{};
+    std::vector<Subscription> subscriptionList;
+    std::vector<std::string> correlationIdList;
+    std::map<Decimal, std::string> snapshotBid;
+    std::map<Decimal, std::string> snapshotAsk;
+    std::unique_ptr<PriceLadder> snapshotBidPriceLadder;
+    std::unique_ptr<PriceLadder> snapshotAskPriceLadder;
+    std::unique_ptr<SmallOrderBook> snapshotBidSmallOrderBook;
+    std::unique_ptr<SmallOrderBook> snapshotAskSmallOrderBook;
+    std::map<Decimal, std::string> previousConflateSnapshotBid;
+    std::map<Decimal, std::string> previousConflateSnapshotAsk;
+    std::vector<DirtyLevel> dirtyBidLevelList;
+    std::vector<DirtyLevel> dirtyAskLevelList;
+    int numOrderBookUpdatesSinceChecksumVerified{};
+    TimePoint orderBookChecksumVerifiedTime{};
+    // bumped when the book is rebuilt from a snapshot or found incorrect, the asynchronous checksum verifications of the book before that are dropped
+    size_t orderBookGeneration{};
+    bool processedInitialSnapshot{};
+    bool processedInitialTrade{};
+    // for an exchange that does not acknowledge a subscription, set once its first message has been reported as the start of the subscription
+    bool subscriptionStarted{};
+    bool l2UpdateIsReplace{};
+    TimePoint previousConflateTime{};
+    TimerPtr conflateTimer;
+    std::string open;
+    Decimal high;
+    Decimal low;
+    std::string close;
+    std::string toString() const {
+      return "SubscriptionState [channelId = " + channelId + ", symbolId = " + symbolId + ", field = " + field + ", optionMap = " + ccapi::toString(optionMap) +
+             ", typedOptions = " + typedOptions.toString() + ", correlationIdList = " + ccapi::toString(correlationIdList) +
+             ", processedInitialSnapshot = " + ccapi::toString(processedInitialSnapshot) +
+             ", processedInitialTrade = " + ccapi::toString(processedInitialTrade) + "]";
+    }
+  };
+  SubscriptionState* findSubscriptionState(const std::string& connectionId, const std::string& channelId, const std::string& symbolId) {
+    auto it = this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(connectionId);
+    if (it == this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
+      return nullptr;
+    }
+    auto channelIt = it->second.find(channelId);
+    if (channelIt == it->second.end()) {
+      return nullptr;
+    }
+    auto symbolIt = channelIt->second.find(symbolId);
+    return symbolIt == channelIt->second.end() ? nullptr : &symbolIt->second;
+  }
+  SubscriptionState& getSubscriptionState(const std::string& connectionId, const std::string& exchangeSubscriptionId) {
+    auto& subscriptionStateByExchangeSubscriptionId = this->subscriptionStateByConnectionIdExchangeSubscriptionIdMap[connectionId];
+    auto it = subscriptionStateByExchangeSubscriptionId.find(exchangeSubscriptionId);
+    if (it != subscriptionStateByExchangeSubscriptionId.end()) {
+      return *it->second;
+    }
+    const auto& channelIdSymbolId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(connectionId).at(exchangeSubscriptionId);
+    auto& subscriptionState = this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(connectionId)
+                                  .at(channelIdSymbolId.at(CCAPI_CHANNEL_ID))
+                                  .at(channelIdSymbolId.at(CCAPI_SYMBOL_ID));
+    if (subscriptionState.exchangeSubscriptionId.empty()) {
+      subscriptionState.exchangeSubscriptionId = exchangeSubscriptionId;
+    }
+    // an exchange puts the key in MarketDataMessage::exchangeSubscriptionKey, so that processTextMessage does not look the state up again
+    this->assignExchangeSubscriptionKey(connectionId, subscriptionState);
+    subscriptionStateByExchangeSubscriptionId.emplace(exchangeSubscriptionId, &subscriptionState);
+    return subscriptionState;
+  }
+  SubscriptionState& getSubscriptionState(const std::string& connectionId, const MarketDataMessage& marketDataMessage) {
+    if (marketDataMessage.exchangeSubscriptionKey >= 0) {
+      return *this->subscriptionStateListByConnectionIdMap.at(connectionId).at(marketDataMessage.exchangeSubscriptionKey);
+    }
+    return this->getSubscriptionState(connectionId, marketDataMessage.exchangeSubscriptionId);
+  }
+  // assigns to the subscription a small integer, which the exchange looks up from the channel and the symbol of a message with findExchangeSubscriptionKey
+  // and puts in MarketDataMessage::exchangeSubscriptionKey, so that the state is then found by indexing a vector instead of by building and looking up
+  // exchangeSubscriptionId, channelId is the channel as named in the messages, i.e. without what is appended after '?'
+  int registerExchangeSubscriptionKey(const std::string& connectionId, std::string_view channelId, const std::string& exchangeSubscriptionId,
+                                      SubscriptionState& subscriptionState) {
+    subscriptionState.exchangeSubscriptionId = exchangeSubscriptionId;
+    this->assignExchangeSubscriptionKey(connectionId, subscriptionState);
+    // a colliding hash is left to the first subscription, the others fail the check in findExchangeSubscriptionKey and use exchangeSubscriptionId
+    this->exchangeSubscriptionKeyByHashByConnectionIdMap[connectionId].emplace(hashChannelIdSymbolId(channelId, subscriptionState.symbolId),
+                                                                               subscriptionState.exchangeSubscriptionKey);
+    return subscriptionState.exchangeSubscriptionKey;
+  }
+  void assignExchangeSubscriptionKey(const std::string& connectionId, SubscriptionState& subscriptionState) {
+    if (subscriptionState.exchangeSubscriptionKey < 0) {
+      auto& subscriptionStateList = this->subscriptionStateListByConnectionIdMap[connectionId];
+      subscriptionState.exchangeSubscriptionKey = static_cast<int>(subscriptionStateList.size());
+      subscriptionStateList.push_back(&subscriptionState);
+    }
+  }
+  // returns -1 if no subscription was registered for that channel and symbol
+  int findExchangeSubscriptionKey(const std::string& connectionId, std::string_view channelId, std::string_view symbolId) {
+    auto it = this->exchangeSubscriptionKeyByHashByConnectionIdMap.find(connectionId);
+    if (it == this->exchangeSubscriptionKeyByHashByConnectionIdMap.end()) {
+      return -1;
+    }
+    auto it2 = it->second.find(hashChannelIdSymbolId(channelId, symbolId));
+    if (it2 == it->second.end()) {
+      return -1;
+    }
+    const SubscriptionState& subscriptionState = *this->subscriptionStateListByConnectionIdMap.at(connectionId).at(it2->second);
+    std::string_view registeredChannelId(subscriptionState.channelId);
+    return subscriptionState.symbolId == symbolId && registeredChannelId.substr(0, registeredChannelId.find('?')) == channelId ? it2->second : -1;
+  }
+  static size_t hashChannelIdSymbolId(std::string_view channelId, std::string_view symbolId) {
+    size_t seed = std::hash<std::string_view>()(channelId);
+    return seed ^ (std::hash<std::string_view>()(symbolId) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+  }
   std::map<std::string, std::vector<Subscription>> groupSubscriptionListByInstrumentGroup(const std::vector<Subscription>& subscriptionList) {
     std::map<std::string, std::vector<Subscription>> groups;
     for (const auto& subscription : subscriptionList) {
@@ -196,13 +343,17 @@ class MarketDataService : public Service {
     CCAPI_LOGGER_TRACE("this->exchangeName = " + this->exchangeName);
     this->prepareSubscriptionDetail(channelId, symbolId, field, wsConnection, subscription, optionMap);
     CCAPI_LOGGER_TRACE("channelId = " + channelId);
-    this->correlationIdListByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].push_back(subscription.getCorrelationId());
-    this->subscriptionListByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].push_back(subscription);
-    this->fieldByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = field;
-    this->optionMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].insert(optionMap.begin(), optionMap.end());
-    CCAPI_LOGGER_TRACE("this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap = " +
-                       toString(this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap));
-    CCAPI_LOGGER_TRACE("this->correlationIdListByConnectionIdChannelSymbolIdMap = " + toString(this->correlationIdListByConnectionIdChannelIdSymbolIdMap));
+    auto& subscriptionState = this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
+    subscriptionState.channelId = channelId;
+    subscriptionState.symbolId = symbolId;
+    if (subscriptionState.subscriptionList.empty()) {
+      subscriptionState.typedOptions = subscription.getTypedOptions();
+    }
+    subscriptionState.correlationIdList.push_back(subscription.getCorrelationId());
+    subscriptionState.subscriptionList.push_back(subscription);
+    subscriptionState.field = field;
+    subscriptionState.optionMap.insert(optionMap.begin(), optionMap.end());
+    CCAPI_LOGGER_TRACE("subscriptionState = " + toString(subscriptionState));
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
@@ -211,6 +362,7 @@ class MarketDataService : public Service {
     CCAPI_LOGGER_TRACE("marketDataMessageList = " + toString(marketDataMessageList));
     event.setType(Event::Type::SUBSCRIPTION_DATA);
     for (auto& marketDataMessage : marketDataMessageList) {
+      marketDataMessage.convertDataToTypedList();
       if (marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_AGG_TRADE) {
@@ -222,34 +374,22 @@ class MarketDataService : public Service {
                             ", wsConnection = " + toString(wsConnection));
         }
 
-        std::string& exchangeSubscriptionId = marketDataMessage.exchangeSubscriptionId;
-        CCAPI_LOGGER_TRACE("this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap = " +
-                           toString(this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap));
-        std::string& channelId =
-            this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
-        std::string& symbolId =
-            this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
-        auto& field = this->fieldByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-        CCAPI_LOGGER_TRACE("this->optionMapByConnectionIdChannelIdSymbolIdMap = " + toString(this->optionMapByConnectionIdChannelIdSymbolIdMap));
         CCAPI_LOGGER_TRACE("wsConnection = " + toString(wsConnection));
-        CCAPI_LOGGER_TRACE("channelId = " + toString(channelId));
-        CCAPI_LOGGER_TRACE("symbolId = " + toString(symbolId));
-        auto& optionMap = this->optionMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-        CCAPI_LOGGER_TRACE("optionMap = " + toString(optionMap));
-        auto& correlationIdList = this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-        CCAPI_LOGGER_TRACE("correlationIdList = " + toString(correlationIdList));
-        if (marketDataMessage.data.find(MarketDataMessage::DataType::BID) != marketDataMessage.data.end() ||
-            marketDataMessage.data.find(MarketDataMessage::DataType::ASK) != marketDataMessage.data.end()) {
-          std::map<Decimal, std::string>& snapshotBid = this->snapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-          std::map<Decimal, std::string>& snapshotAsk = this->snapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-          if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] &&
-              marketDataMessage.recapType == MarketDataMessage::RecapType::NONE) {
-            this->processOrderBookUpdate(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field, optionMap,
-                                         correlationIdList, snapshotBid, snapshotAsk);
+        SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, marketDataMessage);
+        CCAPI_LOGGER_TRACE("subscriptionState = " + toString(subscriptionState));
+        const std::string& exchangeSubscriptionId = subscriptionState.exchangeSubscriptionId;
+        const std::string& symbolId = subscriptionState.symbolId;
+        if (marketDataMessage.hasDepth()) {
+          std::map<Decimal, std::string>& snapshotBid = subscriptionState.snapshotBid;
+          std::map<Decimal, std::string>& snapshotAsk = subscriptionState.snapshotAsk;
+          if (subscriptionState.processedInitialSnapshot && marketDataMessage.recapType == MarketDataMessage::RecapType::NONE) {
+            this->processOrderBookUpdate(wsConnection, subscriptionState, event, marketDataMessage.tp, timeReceived, marketDataMessage, snapshotBid,
+                                         snapshotAsk);
             if (this->sessionOptions.enableCheckOrderBookChecksum &&
                 this->orderBookChecksumByConnectionIdSymbolIdMap.find(wsConnection.id) != this->orderBookChecksumByConnectionIdSymbolIdMap.end() &&
                 this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).find(symbolId) !=
-                    this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).end()) {
+                    this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).end() &&
+                this->shouldVerifyOrderBookChecksum(subscriptionState, timeReceived)) {
               bool shouldProcessRemainingMessage = true;
               std::string receivedOrderBookChecksumStr = this->orderBookChecksumByConnectionIdSymbolIdMap[wsConnection.id][symbolId];
               if (!this->checkOrderBookChecksum(snapshotBid, snapshotAsk, receivedOrderBookChecksumStr, shouldProcessRemainingMessage)) {
@@ -273,17 +413,15 @@ class MarketDataService : public Service {
               }
             }
           } else if (marketDataMessage.recapType == MarketDataMessage::RecapType::SOLICITED) {
-            this->processOrderBookInitial(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field,
-                                          optionMap, correlationIdList, snapshotBid, snapshotAsk);
+            this->processOrderBookInitial(wsConnection, subscriptionState, event, marketDataMessage.tp, timeReceived, marketDataMessage, snapshotBid,
+                                          snapshotAsk);
           }
           CCAPI_LOGGER_TRACE("snapshotBid.size() = " + toString(snapshotBid.size()));
           CCAPI_LOGGER_TRACE("snapshotAsk.size() = " + toString(snapshotAsk.size()));
         }
-        if (marketDataMessage.data.find(MarketDataMessage::DataType::TRADE) != marketDataMessage.data.end() ||
-            marketDataMessage.data.find(MarketDataMessage::DataType::AGG_TRADE) != marketDataMessage.data.end()) {
+        if (marketDataMessage.hasTrade()) {
           bool isSolicited = marketDataMessage.recapType == MarketDataMessage::RecapType::SOLICITED;
-          this->processTrade(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field, optionMap,
-                             correlationIdList, isSolicited);
+          this->processTrade(wsConnection, subscriptionState, event, marketDataMessage.tp, timeReceived, marketDataMessage, isSolicited);
         }
       } else {
         CCAPI_LOGGER_WARN("websocket event type is unknown for " + toString(marketDataMessage));
@@ -360,34 +498,22 @@ class MarketDataService : public Service {
   }
   void clearStates(WsConnection& wsConnection) override {
     Service::clearStates(wsConnection);
-    this->fieldByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->optionMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->subscriptionListByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.erase(wsConnection.id);
-    this->snapshotBidByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->snapshotAskByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->processedInitialTradeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    if (this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.end()) {
-      for (const auto& x : this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+    this->subscriptionStateByConnectionIdExchangeSubscriptionIdMap.erase(wsConnection.id);
+    this->subscriptionStateListByConnectionIdMap.erase(wsConnection.id);
+    this->exchangeSubscriptionKeyByHashByConnectionIdMap.erase(wsConnection.id);
+    if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
+      for (const auto& x : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
         for (const auto& y : x.second) {
-          y.second->cancel();
+          if (y.second.conflateTimer) {
+            y.second.conflateTimer->cancel();
+          }
         }
       }
-      this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     }
-    this->openByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->highByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->lowByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->closeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->orderBookChecksumByConnectionIdSymbolIdMap.erase(wsConnection.id);
-    this->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.erase(wsConnection.id);
+    this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.erase(wsConnection.id);
     if (this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap.find(wsConnection.id) !=
         this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap.end()) {
       for (const auto& x : this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id)) {
@@ -467,6 +593,7 @@ class MarketDataService : public Service {
     WsConnection& wsConnection = *wsConnectionPtr;
     event.setType(Event::Type::SUBSCRIPTION_DATA);
     for (auto& marketDataMessage : marketDataMessageList) {
+      marketDataMessage.convertDataToTypedList();
       if (marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_AGG_TRADE ||
@@ -480,79 +607,39 @@ class MarketDataService : public Service {
         //                     ", wsConnection = " + toString(wsConnection));
         // }
 
-        std::string& exchangeSubscriptionId = marketDataMessage.exchangeSubscriptionId;
-        CCAPI_LOGGER_TRACE("this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap = " +
-                           toString(this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap));
-        CCAPI_LOGGER_TRACE("this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id) = " +
-                           toString(this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id)));
-        CCAPI_LOGGER_TRACE("exchangeSubscriptionId = " + exchangeSubscriptionId);
-        std::string& channelId =
-            this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
-        CCAPI_LOGGER_TRACE("channelId = " + toString(channelId));
-        std::string& symbolId =
-            this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
-        CCAPI_LOGGER_TRACE("symbolId = " + toString(symbolId));
-        CCAPI_LOGGER_TRACE("this->fieldByConnectionIdChannelIdSymbolIdMap = " + toString(this->fieldByConnectionIdChannelIdSymbolIdMap));
-        CCAPI_LOGGER_TRACE("this->fieldByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id) = " +
-                           toString(this->fieldByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)));
-        auto& field = this->fieldByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-        CCAPI_LOGGER_TRACE("this->optionMapByConnectionIdChannelIdSymbolIdMap = " + toString(this->optionMapByConnectionIdChannelIdSymbolIdMap));
         CCAPI_LOGGER_TRACE("wsConnection = " + toString(wsConnection));
-        auto& optionMap = this->optionMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-        CCAPI_LOGGER_TRACE("optionMap = " + toString(optionMap));
-        auto& correlationIdList = this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-        CCAPI_LOGGER_TRACE("correlationIdList = " + toString(correlationIdList));
-        if (marketDataMessage.data.find(MarketDataMessage::DataType::BID) != marketDataMessage.data.end() ||
-            marketDataMessage.data.find(MarketDataMessage::DataType::ASK) != marketDataMessage.data.end()) {
-          std::map<Decimal, std::string>& snapshotBid = this->snapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-          std::map<Decimal, std::string>& snapshotAsk = this->snapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-          if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] &&
-              marketDataMessage.recapType == MarketDataMessage::RecapType::NONE) {
-            this->processOrderBookUpdate(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field, optionMap,
-                                         correlationIdList, snapshotBid, snapshotAsk);
-            if (this->sessionOptions.enableCheckOrderBookChecksum &&
-                this->orderBookChecksumByConnectionIdSymbolIdMap.find(wsConnection.id) != this->orderBookChecksumByConnectionIdSymbolIdMap.end() &&
-                this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).find(symbolId) !=
-                    this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).end()) {
-              bool shouldProcessRemainingMessage = true;
-              std::string receivedOrderBookChecksumStr = this->orderBookChecksumByConnectionIdSymbolIdMap[wsConnection.id][symbolId];
-              if (!this->checkOrderBookChecksum(snapshotBid, snapshotAsk, receivedOrderBookChecksumStr, shouldProcessRemainingMessage)) {
-                CCAPI_LOGGER_ERROR("snapshotBid = " + toString(snapshotBid));
-                CCAPI_LOGGER_ERROR("snapshotAsk = " + toString(snapshotAsk));
-                this->onIncorrectStatesFound(wsConnectionPtr, textMessage, timeReceived, exchangeSubscriptionId, "order book incorrect checksum found");
-              }
-              if (!shouldProcessRemainingMessage) {
-                return;
-              }
-            }
-            if (this->sessionOptions.enableCheckOrderBookCrossed) {
-              bool shouldProcessRemainingMessage = true;
-              if (!this->checkOrderBookCrossed(snapshotBid, snapshotAsk, shouldProcessRemainingMessage)) {
-                CCAPI_LOGGER_ERROR("lastNToString(snapshotBid, 1) = " + lastNToString(snapshotBid, 1));
-                CCAPI_LOGGER_ERROR("firstNToString(snapshotAsk, 1) = " + firstNToString(snapshotAsk, 1));
-                this->onIncorrectStatesFound(wsConnectionPtr, textMessage, timeReceived, exchangeSubscriptionId, "order book crossed market found");
-              }
-              if (!shouldProcessRemainingMessage) {
-                return;
-              }
-            }
-          } else if (marketDataMessage.recapType == MarketDataMessage::RecapType::SOLICITED) {
-            this->processOrderBookInitial(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field,
-                                          optionMap, correlationIdList, snapshotBid, snapshotAsk);
+        SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, marketDataMessage);
+        CCAPI_LOGGER_TRACE("subscriptionState = " + toString(subscriptionState));
+        if (marketDataMessage.hasDepth()) {
+          bool shouldProcessRemainingMessage = true;
+          if (this->shouldUseSmallOrderBook(subscriptionState)) {
+            SmallOrderBook& snapshotBid = this->getSnapshotSmallOrderBook(true, subscriptionState);
+            SmallOrderBook& snapshotAsk = this->getSnapshotSmallOrderBook(false, subscriptionState);
+            shouldProcessRemainingMessage = this->processOrderBookMarketDataMessage(wsConnectionPtr, textMessage, timeReceived, event, marketDataMessage,
+                                                                                    subscriptionState, snapshotBid, snapshotAsk);
+          } else if (this->shouldUseOrderBookPriceLadder()) {
+            PriceLadder& snapshotBid = this->getSnapshotPriceLadder(true, subscriptionState);
+            PriceLadder& snapshotAsk = this->getSnapshotPriceLadder(false, subscriptionState);
+            shouldProcessRemainingMessage = this->processOrderBookMarketDataMessage(wsConnectionPtr, textMessage, timeReceived, event, marketDataMessage,
+                                                                                    subscriptionState, snapshotBid, snapshotAsk);
+          } else {
+            shouldProcessRemainingMessage =
+                this->processOrderBookMarketDataMessage(wsConnectionPtr, textMessage, timeReceived, event, marketDataMessage, subscriptionState,
+                                                        subscriptionState.snapshotBid, subscriptionState.snapshotAsk);
+          }
+          if (!shouldProcessRemainingMessage) {
+            return;
           }
-          CCAPI_LOGGER_TRACE("snapshotBid.size() = " + toString(snapshotBid.size()));
-          CCAPI_LOGGER_TRACE("snapshotAsk.size() = " + toString(snapshotAsk.size()));
         }
-        if (marketDataMessage.data.find(MarketDataMessage::DataType::TRADE) != marketDataMessage.data.end() ||
-            marketDataMessage.data.find(MarketDataMessage::DataType::AGG_TRADE) != marketDataMessage.data.end()) {
+        if (marketDataMessage.hasTrade()) {
           bool isSolicited = marketDataMessage.recapType == MarketDataMessage::RecapType::SOLICITED;
-          this->processTrade(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field, optionMap,
-                             correlationIdList, isSolicited);
+          this->processTrade(wsConnection, subscriptionState, event, marketDataMessage.tp, timeReceived, marketDataMessage, isSolicited);
         }
-        if (marketDataMessage.data.find(MarketDataMessage::DataType::CANDLESTICK) != marketDataMessage.data.end()) {
+        if (marketDataMessage.hasCandlestick()) {
           bool isSolicited = marketDataMessage.recapType == MarketDataMessage::RecapType::SOLICITED;
-          this->processExchangeProvidedCandlestick(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field,
-                                                   optionMap, correlationIdList, isSolicited);
+          this->processExchangeProvidedCandlestick(wsConnection, subscriptionState.channelId, subscriptionState.symbolId, event, marketDataMessage.tp,
+                                                   timeReceived, marketDataMessage, subscriptionState.field, subscriptionState.optionMap,
+                                                   subscriptionState.correlationIdList, isSolicited);
         }
       } else {
         CCAPI_LOGGER_WARN("websocket event type is unknown for " + toString(marketDataMessage));
@@ -588,6 +675,52 @@ class MarketDataService : public Service {
     this->onPongByMethod(PingPongMethod::WEBSOCKET_APPLICATION_LEVEL, wsConnectionPtr, timeReceived, false);
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
+  // return false if the remaining market data messages should not be processed
+  template <typename T>
+  bool processOrderBookMarketDataMessage(std::shared_ptr<WsConnection> wsConnectionPtr, boost::beast::string_view textMessage, const TimePoint& timeReceived,
+                                         Event& event, MarketDataMessage& marketDataMessage, SubscriptionState& subscriptionState, T& snapshotBid,
+                                         T& snapshotAsk) {
+    WsConnection& wsConnection = *wsConnectionPtr;
+    const std::string& exchangeSubscriptionId = subscriptionState.exchangeSubscriptionId;
+    const std::string& symbolId = subscriptionState.symbolId;
+    if (subscriptionState.processedInitialSnapshot && marketDataMessage.recapType == MarketDataMessage::RecapType::NONE) {
+      this->processOrderBookUpdate(wsConnection, subscriptionState, event, marketDataMessage.tp, timeReceived, marketDataMessage, snapshotBid, snapshotAsk);
+      if (this->sessionOptions.enableCheckOrderBookChecksum &&
+          this->orderBookChecksumByConnectionIdSymbolIdMap.find(wsConnection.id) != this->orderBookChecksumByConnectionIdSymbolIdMap.end() &&
+          this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).find(symbolId) !=
+              this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).end() &&
+          this->shouldVerifyOrderBookChecksum(subscriptionState, timeReceived)) {
+        bool shouldProcessRemainingMessage = true;
+        std::string receivedOrderBookChecksumStr = this->orderBookChecksumByConnectionIdSymbolIdMap[wsConnection.id][symbolId];
+        if (this->orderBookChecksumThreadPoolPtr && this->orderBookChecksumNumLevels > 0) {
+          this->verifyOrderBookChecksumAsync(wsConnectionPtr, timeReceived, subscriptionState, snapshotBid, snapshotAsk, receivedOrderBookChecksumStr);
+        } else if (!this->checkOrderBookChecksum(snapshotBid, snapshotAsk, receivedOrderBookChecksumStr, shouldProcessRemainingMessage)) {
+          CCAPI_LOGGER_ERROR("snapshotBid = " + toString(snapshotBid));
+          CCAPI_LOGGER_ERROR("snapshotAsk = " + toString(snapshotAsk));
+          this->onIncorrectStatesFound(wsConnectionPtr, textMessage, timeReceived, exchangeSubscriptionId, "order book incorrect checksum found");
+        }
+        if (!shouldProcessRemainingMessage) {
+          return false;
+        }
+      }
+      if (this->sessionOptions.enableCheckOrderBookCrossed) {
+        bool shouldProcessRemainingMessage = true;
+        if (!this->checkOrderBookCrossed(snapshotBid, snapshotAsk, shouldProcessRemainingMessage)) {
+          CCAPI_LOGGER_ERROR("lastNToString(snapshotBid, 1) = " + lastNToString(snapshotBid, 1));
+          CCAPI_LOGGER_ERROR("firstNToString(snapshotAsk, 1) = " + firstNToString(snapshotAsk, 1));
+          this->onIncorrectStatesFound(wsConnectionPtr, textMessage, timeReceived, exchangeSubscriptionId, "order book crossed market found");
+        }
+        if (!shouldProcessRemainingMessage) {
+          return false;
+        }
+      }
+    } else if (marketDataMessage.recapType == MarketDataMessage::RecapType::SOLICITED) {
+      this->processOrderBookInitial(wsConnection, subscriptionState, event, marketDataMessage.tp, timeReceived, marketDataMessage, snapshotBid, snapshotAsk);
+    }
+    CCAPI_LOGGER_TRACE("snapshotBid.size() = " + toString(snapshotBid.size()));
+    CCAPI_LOGGER_TRACE("snapshotAsk.size() = " + toString(snapshotAsk.size()));
+    return true;
+  }
   virtual void onIncorrectStatesFound(std::shared_ptr<WsConnection> wsConnectionPtr, boost::beast::string_view textMessageView, const TimePoint& timeReceived,
                                       const std::string& exchangeSubscriptionId, std::string const& reason) {
     std::string errorMessage = "incorrect states found: connection = " + toString(*wsConnectionPtr) + ", textMessage = " + std::string(textMessageView) +
@@ -604,7 +737,7 @@ class MarketDataService : public Service {
           this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnectionPtr->id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
       CCAPI_LOGGER_TRACE("channelId = " + toString(channelId));
       CCAPI_LOGGER_TRACE("symbolId = " + toString(symbolId));
-      auto& correlationIdList = this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnectionPtr->id).at(channelId).at(symbolId);
+      auto& correlationIdList = this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnectionPtr->id).at(channelId).at(symbolId).correlationIdList;
       CCAPI_LOGGER_TRACE("correlationIdList = " + toString(correlationIdList));
       this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::INCORRECT_STATE_FOUND, "shutdown", correlationIdList);
     }
@@ -640,34 +773,22 @@ class MarketDataService : public Service {
   void clearStates(std::shared_ptr<WsConnection> wsConnectionPtr) override {
     WsConnection& wsConnection = *wsConnectionPtr;
     Service::clearStates(wsConnectionPtr);
-    this->fieldByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->optionMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->subscriptionListByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.erase(wsConnection.id);
-    this->snapshotBidByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->snapshotAskByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->processedInitialTradeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    if (this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.end()) {
-      for (const auto& x : this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+    this->subscriptionStateByConnectionIdExchangeSubscriptionIdMap.erase(wsConnection.id);
+    this->subscriptionStateListByConnectionIdMap.erase(wsConnection.id);
+    this->exchangeSubscriptionKeyByHashByConnectionIdMap.erase(wsConnection.id);
+    if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
+      for (const auto& x : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
         for (const auto& y : x.second) {
-          y.second->cancel();
+          if (y.second.conflateTimer) {
+            y.second.conflateTimer->cancel();
+          }
         }
       }
-      this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     }
-    this->openByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->highByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->lowByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->closeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->orderBookChecksumByConnectionIdSymbolIdMap.erase(wsConnection.id);
-    this->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.erase(wsConnection.id);
+    this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.erase(wsConnection.id);
     if (this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap.find(wsConnection.id) !=
         this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap.end()) {
       for (const auto& x : this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id)) {
@@ -736,8 +857,13 @@ class MarketDataService : public Service {
     }
   }
 #endif
-  void updateOrderBook(std::map<Decimal, std::string>& snapshot, const Decimal& price, const std::string& size, bool sizeMayHaveTrailingZero = false) {
+  // size is taken by value so that a caller done with it can move it into the book
+  static void updateOrderBook(std::map<Decimal, std::string>& snapshot, const Decimal& price, std::string size, bool sizeMayHaveTrailingZero = false,
+                              std::vector<DirtyLevel>* dirtyLevelList = nullptr) {
     auto it = snapshot.find(price);
+    if (dirtyLevelList) {
+      dirtyLevelList->push_back({price, it == snapshot.end() ? std::string() : it->second});
+    }
     if (it == snapshot.end()) {
       if ((!sizeMayHaveTrailingZero && size != "0") ||
           (sizeMayHaveTrailingZero && ((size.find('.') != std::string::npos && UtilString::rtrim(UtilString::rtrim(size, "0"), ".") != "0") ||
@@ -754,12 +880,78 @@ class MarketDataService : public Service {
       }
     }
   }
-  void updateElementListWithInitialMarketDepth(const std::string& field, const std::map<std::string, std::string>& optionMap,
-                                               const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk,
-                                               std::vector<Element>& elementList) {
+  static void updateOrderBook(std::map<Decimal, std::string>& snapshot, const std::string& price, std::string size, bool keepTrailingZero = false,
+                              std::vector<DirtyLevel>* dirtyLevelList = nullptr) {
+    Decimal decimalPrice(price, keepTrailingZero);
+    updateOrderBook(snapshot, decimalPrice, std::move(size), keepTrailingZero, dirtyLevelList);
+  }
+  void updateOrderBook(PriceLadder& snapshot, const std::string& price, const std::string& size, bool keepTrailingZero = false) {
+    snapshot.update(price, size, keepTrailingZero);
+  }
+  void insertOrderBookInitial(std::map<Decimal, std::string>& snapshot, std::string& price, std::string& size, bool keepTrailingZero = false) {
+    Decimal decimalPrice(price, keepTrailingZero);
+    snapshot.emplace(std::move(decimalPrice), std::move(size));
+  }
+  void insertOrderBookInitial(PriceLadder& snapshot, const std::string& price, const std::string& size, bool keepTrailingZero = false) {
+    snapshot.update(price, size, keepTrailingZero);
+  }
+  void updateOrderBook(SmallOrderBook& snapshot, const std::string& price, const std::string& size, bool keepTrailingZero = false) {
+    snapshot.update(price, size, keepTrailingZero);
+  }
+  void insertOrderBookInitial(SmallOrderBook& snapshot, const std::string& price, const std::string& size, bool keepTrailingZero = false) {
+    snapshot.update(price, size, keepTrailingZero);
+  }
+  // only a book kept as std::map records the levels touched, the other books are diffed against a copy of their best levels. The sizes of levelList are
+  // moved into a std::map book.
+  template <typename T>
+  void updateOrderBook(T& snapshot, std::vector<MarketDataMessage::Level>& levelList, std::vector<DirtyLevel>* dirtyLevelList) {
+    for (auto& level : levelList) {
+      if constexpr (std::is_same<T, std::map<Decimal, std::string>>::value) {
+        this->updateOrderBook(snapshot, level.price, std::move(level.size), this->sessionOptions.enableCheckOrderBookChecksum, dirtyLevelList);
+      } else {
+        this->updateOrderBook(snapshot, level.price, level.size, this->sessionOptions.enableCheckOrderBookChecksum);
+      }
+    }
+  }
+  // price ladders are only wired into the websocket processing of boost beast
+  bool shouldUseOrderBookPriceLadder() const {
+#ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
+    return false;
+#else
+    return this->sessionOptions.enableOrderBookPriceLadder;
+#endif
+  }
+  // channels on which each message replaces a shallow book use a fixed-capacity book refilled in place
+  bool shouldUseSmallOrderBook(const SubscriptionState& subscriptionState) {
+#ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
+    return false;
+#else
+    return subscriptionState.l2UpdateIsReplace && subscriptionState.marketDepthSubscribedToExchange > 0 &&
+           subscriptionState.marketDepthSubscribedToExchange <= static_cast<int>(SmallOrderBook::CAPACITY);
+#endif
+  }
+  SmallOrderBook& getSnapshotSmallOrderBook(bool isBid, SubscriptionState& subscriptionState) {
+    auto& snapshot = isBid ? subscriptionState.snapshotBidSmallOrderBook : subscriptionState.snapshotAskSmallOrderBook;
+    if (!snapshot) {
+      snapshot.reset(new SmallOrderBook(isBid));
+    }
+    return *snapshot;
+  }
+  PriceLadder& getSnapshotPriceLadder(bool isBid, SubscriptionState& subscriptionState) {
+    auto& snapshot = isBid ? subscriptionState.snapshotBidPriceLadder : subscriptionState.snapshotAskPriceLadder;
+    if (!snapshot) {
+      // the tick size can be given as a subscription option, otherwise the price ladder infers it from the prices received
+      snapshot.reset(new PriceLadder(isBid, this->sessionOptions.orderBookPriceLadderCapacity,
+                                     mapGetWithDefault(subscriptionState.optionMap, std::string(CCAPI_ORDER_PRICE_INCREMENT))));
+    }
+    return *snapshot;
+  }
+  template <typename T>
+  void updateElementListWithInitialMarketDepth(const std::string& field, const Subscription::TypedOptions& typedOptions, const T& snapshotBid,
+                                               const T& snapshotAsk, std::vector<Element>& elementList) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     if (field == CCAPI_MARKET_DEPTH) {
-      int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+      int maxMarketDepth = typedOptions.marketDepthMax;
       int bidIndex = 0;
       for (auto iter = snapshotBid.rbegin(); iter != snapshotBid.rend(); iter++) {
         if (bidIndex < maxMarketDepth) {
@@ -795,18 +987,20 @@ class MarketDataService : public Service {
     }
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
-  void updateElementListWithOrderBookSnapshot(const std::string& field, int maxMarketDepth, const std::map<Decimal, std::string>& snapshotBid,
-                                              const std::map<Decimal, std::string>& snapshotAsk, std::vector<Element>& elementList) {
+  template <typename T>
+  void updateElementListWithOrderBookSnapshot(const std::string& field, int maxMarketDepth, const T& snapshotBid, const T& snapshotAsk,
+                                              std::vector<Element>& elementList) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     if (field == CCAPI_MARKET_DEPTH) {
       int bidIndex = 0;
       for (auto iter = snapshotBid.rbegin(); iter != snapshotBid.rend(); iter++) {
-        if (bidIndex < maxMarketDepth) {
-          Element element;
-          element.insert(CCAPI_BEST_BID_N_PRICE, iter->first.toString());
-          element.insert(CCAPI_BEST_BID_N_SIZE, iter->second);
-          elementList.emplace_back(std::move(element));
+        if (bidIndex >= maxMarketDepth) {
+          break;
         }
+        Element element;
+        element.insert(CCAPI_BEST_BID_N_PRICE, iter->first.toString());
+        element.insert(CCAPI_BEST_BID_N_SIZE, iter->second);
+        elementList.emplace_back(std::move(element));
         ++bidIndex;
       }
       if (snapshotBid.empty()) {
@@ -817,12 +1011,13 @@ class MarketDataService : public Service {
       }
       int askIndex = 0;
       for (auto iter = snapshotAsk.begin(); iter != snapshotAsk.end(); iter++) {
-        if (askIndex < maxMarketDepth) {
-          Element element;
-          element.insert(CCAPI_BEST_ASK_N_PRICE, iter->first.toString());
-          element.insert(CCAPI_BEST_ASK_N_SIZE, iter->second);
-          elementList.emplace_back(std::move(element));
+        if (askIndex >= maxMarketDepth) {
+          break;
         }
+        Element element;
+        element.insert(CCAPI_BEST_ASK_N_PRICE, iter->first.toString());
+        element.insert(CCAPI_BEST_ASK_N_SIZE, iter->second);
+        elementList.emplace_back(std::move(element));
         ++askIndex;
       }
       if (snapshotAsk.empty()) {
@@ -834,8 +1029,8 @@ class MarketDataService : public Service {
     }
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
-  std::map<Decimal, std::string> calculateMarketDepthUpdate(bool isBid, const std::map<Decimal, std::string>& c1, const std::map<Decimal, std::string>& c2,
-                                                            int maxMarketDepth) {
+  template <typename T>
+  static std::map<Decimal, std::string> calculateMarketDepthUpdate(bool isBid, const T& c1, const std::map<Decimal, std::string>& c2, int maxMarketDepth) {
     if (c1.empty()) {
       std::map<Decimal, std::string> output;
       for (const auto& x : c2) {
@@ -843,7 +1038,7 @@ class MarketDataService : public Service {
       }
       return output;
     } else if (c2.empty()) {
-      return c1;
+      return std::map<Decimal, std::string>(c1.begin(), c1.end());
     }
     if (isBid) {
       auto it1 = c1.rbegin();
@@ -919,34 +1114,95 @@ class MarketDataService : public Service {
       return output;
     }
   }
-  void updateElementListWithUpdateMarketDepth(const std::string& field, const std::map<std::string, std::string>& optionMap,
-                                              const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotBidPrevious,
-                                              const std::map<Decimal, std::string>& snapshotAsk, const std::map<Decimal, std::string>& snapshotAskPrevious,
-                                              std::vector<Element>& elementList, bool alwaysUpdate) {
+  // the worst of the best maxMarketDepth levels, returns false if the book has fewer levels so that all of them are among the best maxMarketDepth
+  static bool getMarketDepthBoundary(bool isBid, const std::map<Decimal, std::string>& snapshot, int maxMarketDepth, Decimal& boundary) {
+    if (snapshot.size() < static_cast<size_t>(maxMarketDepth)) {
+      return false;
+    }
+    boundary = isBid ? std::next(snapshot.rbegin(), maxMarketDepth - 1)->first : std::next(snapshot.begin(), maxMarketDepth - 1)->first;
+    return true;
+  }
+  // the same update as the overload above but computed from the levels touched by updateOrderBook instead of from a copy of the best levels taken before it:
+  // a level can only enter, leave or change size within the best maxMarketDepth if it was touched or if it lies between the boundaries before and after.
+  // As with the overload above, the whole book is the update of a book which was empty before.
+  static std::map<Decimal, std::string> calculateMarketDepthUpdate(bool isBid, const std::map<Decimal, std::string>& snapshot,
+                                                                   std::vector<DirtyLevel>& dirtyLevelList, bool wasEmpty, bool hasPreviousBoundary,
+                                                                   const Decimal& previousBoundary, int maxMarketDepth) {
+    if (wasEmpty) {
+      return snapshot;
+    }
+    std::map<Decimal, std::string> output;
+    // a level touched several times keeps the size it had before the first touch
+    std::stable_sort(dirtyLevelList.begin(), dirtyLevelList.end(), [](const DirtyLevel& l, const DirtyLevel& r) { return l.price < r.price; });
+    dirtyLevelList.erase(
+        std::unique(dirtyLevelList.begin(), dirtyLevelList.end(), [](const DirtyLevel& l, const DirtyLevel& r) { return l.price == r.price; }),
+        dirtyLevelList.end());
+    Decimal boundary;
+    bool hasBoundary = getMarketDepthBoundary(isBid, snapshot, maxMarketDepth, boundary);
+    auto isWithin = [isBid](const Decimal& price, bool hasBoundary, const Decimal& boundary) {
+      return !hasBoundary || (isBid ? price >= boundary : price <= boundary);
+    };
+    auto compare = [&](const Decimal& price, bool wasWithin, const std::string& previousSize, bool isWithinNow, const std::string& size) {
+      if (isWithinNow) {
+        if (!wasWithin || previousSize != size) {
+          output.emplace(price, size);
+        }
+      } else if (wasWithin) {
+        output.emplace(price, "0");
+      }
+    };
+    for (const auto& dirtyLevel : dirtyLevelList) {
+      auto it = snapshot.find(dirtyLevel.price);
+      bool wasWithin = !dirtyLevel.previousSize.empty() && isWithin(dirtyLevel.price, hasPreviousBoundary, previousBoundary);
+      bool isWithinNow = it != snapshot.end() && isWithin(dirtyLevel.price, hasBoundary, boundary);
+      compare(dirtyLevel.price, wasWithin, dirtyLevel.previousSize, isWithinNow, isWithinNow ? it->second : dirtyLevel.previousSize);
+    }
+    if (hasPreviousBoundary || hasBoundary) {
+      auto first = snapshot.begin();
+      auto last = snapshot.end();
+      if (hasPreviousBoundary && hasBoundary) {
+        first = snapshot.lower_bound(std::min(previousBoundary, boundary));
+        last = snapshot.upper_bound(std::max(previousBoundary, boundary));
+      } else if (isBid) {
+        last = snapshot.upper_bound(hasBoundary ? boundary : previousBoundary);
+      } else {
+        first = snapshot.lower_bound(hasBoundary ? boundary : previousBoundary);
+      }
+      for (auto it = first; it != last; ++it) {
+        auto dirtyIt = std::lower_bound(dirtyLevelList.begin(), dirtyLevelList.end(), it->first,
+                                        [](const DirtyLevel& dirtyLevel, const Decimal& price) { return dirtyLevel.price < price; });
+        if (dirtyIt != dirtyLevelList.end() && dirtyIt->price == it->first) {
+          continue;
+        }
+        compare(it->first, isWithin(it->first, hasPreviousBoundary, previousBoundary), it->second, isWithin(it->first, hasBoundary, boundary), it->second);
+      }
+    }
+    return output;
+  }
+  template <typename T>
+  void updateElementListWithUpdateMarketDepth(const std::string& field, const Subscription::TypedOptions& typedOptions, const T& snapshotBid,
+                                              const std::map<Decimal, std::string>& snapshotBidPrevious, const T& snapshotAsk,
+                                              const std::map<Decimal, std::string>& snapshotAskPrevious, std::vector<Element>& elementList, bool alwaysUpdate) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     if (field == CCAPI_MARKET_DEPTH) {
-      int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-      if (optionMap.at(CCAPI_MARKET_DEPTH_RETURN_UPDATE) == CCAPI_MARKET_DEPTH_RETURN_UPDATE_ENABLE) {
+      int maxMarketDepth = typedOptions.marketDepthMax;
+      if (typedOptions.marketDepthReturnUpdate) {
         CCAPI_LOGGER_TRACE("lastNSame = " + toString(lastNSame(snapshotBid, snapshotBidPrevious, maxMarketDepth)));
         CCAPI_LOGGER_TRACE("firstNSame = " + toString(firstNSame(snapshotAsk, snapshotAskPrevious, maxMarketDepth)));
         std::map<Decimal, std::string> snapshotBidUpdate = this->calculateMarketDepthUpdate(true, snapshotBid, snapshotBidPrevious, maxMarketDepth);
         for (auto& x : snapshotBidUpdate) {
           Element element;
-          std::string k1(CCAPI_BEST_BID_N_PRICE);
           std::string v1 = x.first.toString();
-          element.emplace(k1, v1);
-          std::string k2(CCAPI_BEST_BID_N_SIZE);
-          element.emplace(k2, x.second);
+          element.emplace(CCAPI_BEST_BID_N_PRICE, v1);
+          element.emplace(CCAPI_BEST_BID_N_SIZE, x.second);
           elementList.emplace_back(std::move(element));
         }
         std::map<Decimal, std::string> snapshotAskUpdate = this->calculateMarketDepthUpdate(false, snapshotAsk, snapshotAskPrevious, maxMarketDepth);
         for (auto& x : snapshotAskUpdate) {
           Element element;
-          std::string k1(CCAPI_BEST_ASK_N_PRICE);
           std::string v1 = x.first.toString();
-          element.emplace(k1, v1);
-          std::string k2(CCAPI_BEST_ASK_N_SIZE);
-          element.emplace(k2, x.second);
+          element.emplace(CCAPI_BEST_ASK_N_PRICE, v1);
+          element.emplace(CCAPI_BEST_ASK_N_SIZE, x.second);
           elementList.emplace_back(std::move(element));
         }
       } else {
@@ -992,116 +1248,100 @@ class MarketDataService : public Service {
     }
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
-  void updateElementListWithTrade(const std::string& field, MarketDataMessage::TypeForData& input, std::vector<Element>& elementList) {
+  // the counterpart of updateElementListWithUpdateMarketDepth for a book whose update within the best levels was already calculated
+  void updateElementListWithMarketDepthChange(const std::string& field, const Subscription::TypedOptions& typedOptions,
+                                              const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotBidUpdate,
+                                              const std::map<Decimal, std::string>& snapshotAsk, const std::map<Decimal, std::string>& snapshotAskUpdate,
+                                              std::vector<Element>& elementList) {
+    CCAPI_LOGGER_FUNCTION_ENTER;
+    if (field == CCAPI_MARKET_DEPTH) {
+      if (typedOptions.marketDepthReturnUpdate) {
+        for (const auto& x : snapshotBidUpdate) {
+          Element element;
+          element.insert(CCAPI_BEST_BID_N_PRICE, x.first.toString());
+          element.insert(CCAPI_BEST_BID_N_SIZE, x.second);
+          elementList.emplace_back(std::move(element));
+        }
+        for (const auto& x : snapshotAskUpdate) {
+          Element element;
+          element.insert(CCAPI_BEST_ASK_N_PRICE, x.first.toString());
+          element.insert(CCAPI_BEST_ASK_N_SIZE, x.second);
+          elementList.emplace_back(std::move(element));
+        }
+      } else if (!snapshotBidUpdate.empty() || !snapshotAskUpdate.empty()) {
+        this->updateElementListWithOrderBookSnapshot(field, typedOptions.marketDepthMax, snapshotBid, snapshotAsk, elementList);
+      }
+    }
+    CCAPI_LOGGER_FUNCTION_EXIT;
+  }
+  void updateElementListWithTrade(const std::string& field, MarketDataMessage& input, std::vector<Element>& elementList) {
     if (field == CCAPI_TRADE || field == CCAPI_AGG_TRADE) {
-      for (auto& x : input) {
-        auto& type = x.first;
-        auto& detail = x.second;
-        if (type == MarketDataMessage::DataType::TRADE || type == MarketDataMessage::DataType::AGG_TRADE) {
-          for (auto& y : detail) {
-            auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-            auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-            Element element;
-            std::string k1(CCAPI_LAST_PRICE);
-            std::string k2(CCAPI_LAST_SIZE);
-            element.emplace(k1, price);
-            element.emplace(k2, size);
-            {
-              auto it = y.find(MarketDataMessage::DataFieldType::TRADE_ID);
-              if (it != y.end()) {
-                std::string k3(CCAPI_TRADE_ID);
-                element.emplace(k3, it->second);
-              }
-            }
-            {
-              auto it = y.find(MarketDataMessage::DataFieldType::AGG_TRADE_ID);
-              if (it != y.end()) {
-                std::string k3(CCAPI_AGG_TRADE_ID);
-                element.emplace(k3, it->second);
-              }
-            }
-            std::string k4(CCAPI_IS_BUYER_MAKER);
-            element.emplace(k4, y.at(MarketDataMessage::DataFieldType::IS_BUYER_MAKER));
-            {
-              auto it = y.find(MarketDataMessage::DataFieldType::SEQUENCE_NUMBER);
-              if (it != y.end()) {
-                std::string k5(CCAPI_SEQUENCE_NUMBER);
-                element.emplace(k5, it->second);
-              }
-            }
-            elementList.emplace_back(std::move(element));
-          }
-        } else {
-          CCAPI_LOGGER_WARN("extra type " + MarketDataMessage::dataTypeToString(type));
+      for (auto& trade : input.tradeList) {
+        Element element;
+        element.emplace(CCAPI_LAST_PRICE, trade.price);
+        element.emplace(CCAPI_LAST_SIZE, trade.size);
+        if (!trade.tradeId.empty()) {
+          element.emplace(CCAPI_TRADE_ID, trade.tradeId);
+        }
+        if (!trade.aggTradeId.empty()) {
+          element.emplace(CCAPI_AGG_TRADE_ID, trade.aggTradeId);
+        }
+        element.insert(CCAPI_IS_BUYER_MAKER, trade.isBuyerMaker ? "1" : "0");
+        if (!trade.sequenceNumber.empty()) {
+          element.emplace(CCAPI_SEQUENCE_NUMBER, trade.sequenceNumber);
         }
+        elementList.emplace_back(std::move(element));
       }
     }
   }
-  void updateElementListWithExchangeProvidedCandlestick(const std::string& field, MarketDataMessage::TypeForData& input, std::vector<Element>& elementList) {
+  void updateElementListWithExchangeProvidedCandlestick(const std::string& field, MarketDataMessage& input, std::vector<Element>& elementList) {
     if (field == CCAPI_CANDLESTICK) {
-      for (auto& x : input) {
-        auto& type = x.first;
-        auto& detail = x.second;
-        if (type == MarketDataMessage::DataType::CANDLESTICK) {
-          for (auto& y : detail) {
-            auto& openPrice = y.at(MarketDataMessage::DataFieldType::OPEN_PRICE);
-            auto& highPrice = y.at(MarketDataMessage::DataFieldType::HIGH_PRICE);
-            auto& lowPrice = y.at(MarketDataMessage::DataFieldType::LOW_PRICE);
-            auto& closePrice = y.at(MarketDataMessage::DataFieldType::CLOSE_PRICE);
-            Element element;
-            std::string k1(CCAPI_OPEN_PRICE);
-            std::string k2(CCAPI_HIGH_PRICE);
-            std::string k3(CCAPI_LOW_PRICE);
-            std::string k4(CCAPI_CLOSE_PRICE);
-            element.emplace(k1, y.at(MarketDataMessage::DataFieldType::OPEN_PRICE));
-            element.emplace(k2, y.at(MarketDataMessage::DataFieldType::HIGH_PRICE));
-            element.emplace(k3, y.at(MarketDataMessage::DataFieldType::LOW_PRICE));
-            element.emplace(k4, y.at(MarketDataMessage::DataFieldType::CLOSE_PRICE));
-            {
-              auto it = y.find(MarketDataMessage::DataFieldType::VOLUME);
-              if (it != y.end()) {
-                std::string k(CCAPI_VOLUME);
-                element.emplace(k, it->second);
-              }
-            }
-            {
-              auto it = y.find(MarketDataMessage::DataFieldType::QUOTE_VOLUME);
-              if (it != y.end()) {
-                std::string k(CCAPI_QUOTE_VOLUME);
-                element.emplace(k, it->second);
-              }
-            }
-            elementList.emplace_back(std::move(element));
-          }
-        } else {
-          CCAPI_LOGGER_WARN("extra type " + MarketDataMessage::dataTypeToString(type));
+      for (auto& candlestick : input.candlestickList) {
+        Element element;
+        element.emplace(CCAPI_OPEN_PRICE, candlestick.openPrice);
+        element.emplace(CCAPI_HIGH_PRICE, candlestick.highPrice);
+        element.emplace(CCAPI_LOW_PRICE, candlestick.lowPrice);
+        element.emplace(CCAPI_CLOSE_PRICE, candlestick.closePrice);
+        if (!candlestick.volume.empty()) {
+          element.emplace(CCAPI_VOLUME, candlestick.volume);
         }
+        if (!candlestick.quoteVolume.empty()) {
+          element.emplace(CCAPI_QUOTE_VOLUME, candlestick.quoteVolume);
+        }
+        elementList.emplace_back(std::move(element));
       }
     }
   }
-  void updateElementListWithCalculatedCandlestick(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId,
-                                                  const std::string& field, std::vector<Element>& elementList) {
+  void updateElementListWithCalculatedCandlestick(SubscriptionState& subscriptionState, std::vector<Element>& elementList) {
+    const auto& field = subscriptionState.field;
     if (field == CCAPI_TRADE || field == CCAPI_AGG_TRADE) {
       Element element;
-      if (this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].empty()) {
+      if (subscriptionState.open.empty()) {
         element.insert(CCAPI_OPEN_PRICE, CCAPI_CANDLESTICK_EMPTY);
         element.insert(CCAPI_HIGH_PRICE, CCAPI_CANDLESTICK_EMPTY);
         element.insert(CCAPI_LOW_PRICE, CCAPI_CANDLESTICK_EMPTY);
         element.insert(CCAPI_CLOSE_PRICE, CCAPI_CANDLESTICK_EMPTY);
       } else {
-        element.insert(CCAPI_OPEN_PRICE, this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]);
-        element.insert(CCAPI_HIGH_PRICE, this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].toString());
-        element.insert(CCAPI_LOW_PRICE, this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].toString());
-        element.insert(CCAPI_CLOSE_PRICE, this->closeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]);
+        element.insert(CCAPI_OPEN_PRICE, subscriptionState.open);
+        element.insert(CCAPI_HIGH_PRICE, subscriptionState.high.toString());
+        element.insert(CCAPI_LOW_PRICE, subscriptionState.low.toString());
+        element.insert(CCAPI_CLOSE_PRICE, subscriptionState.close);
       }
       elementList.emplace_back(std::move(element));
-      this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = "";
-      this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = Decimal();
-      this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = Decimal();
-      this->closeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = "";
+      subscriptionState.open = "";
+      subscriptionState.high = Decimal();
+      subscriptionState.low = Decimal();
+      subscriptionState.close = "";
     }
   }
-  void copySnapshot(bool isBid, const std::map<Decimal, std::string>& original, std::map<Decimal, std::string>& copy, const int maxMarketDepth) {
+  // the start of the conflate interval containing tp
+  TimePoint getConflateTimePoint(const TimePoint& tp, const Subscription::TypedOptions& typedOptions) {
+    long long intervalMilliseconds = typedOptions.conflateIntervalMilliseconds;
+    return UtilTime::makeTimePointFromMilliseconds(std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count() / intervalMilliseconds *
+                                                   intervalMilliseconds);
+  }
+  template <typename T>
+  void copySnapshot(bool isBid, const T& original, std::map<Decimal, std::string>& copy, const int maxMarketDepth) {
     size_t nToCopy = std::min(original.size(), static_cast<size_t>(maxMarketDepth));
     if (isBid) {
       std::copy_n(original.rbegin(), nToCopy, std::inserter(copy, copy.end()));
@@ -1109,38 +1349,26 @@ class MarketDataService : public Service {
       std::copy_n(original.begin(), nToCopy, std::inserter(copy, copy.end()));
     }
   }
-  void processOrderBookInitial(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, Event& event, const TimePoint& tp,
-                               const TimePoint& timeReceived, MarketDataMessage::TypeForData& input, const std::string& field,
-                               const std::map<std::string, std::string>& optionMap, const std::vector<std::string>& correlationIdList,
-                               std::map<Decimal, std::string>& snapshotBid, std::map<Decimal, std::string>& snapshotAsk) {
+  template <typename T>
+  void processOrderBookInitial(const WsConnection& wsConnection, SubscriptionState& subscriptionState, Event& event, const TimePoint& tp,
+                               const TimePoint& timeReceived, MarketDataMessage& input, T& snapshotBid, T& snapshotAsk) {
+    const auto& field = subscriptionState.field;
+    const auto& typedOptions = subscriptionState.typedOptions;
+    const auto& correlationIdList = subscriptionState.correlationIdList;
     snapshotBid.clear();
     snapshotAsk.clear();
-    int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-    for (auto& x : input) {
-      auto& type = x.first;
-      auto& detail = x.second;
-      if (type == MarketDataMessage::DataType::BID) {
-        for (auto& y : detail) {
-          auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-          auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-          Decimal decimalPrice(price, this->sessionOptions.enableCheckOrderBookChecksum);
-          snapshotBid.emplace(std::move(decimalPrice), std::move(size));
-        }
-        CCAPI_LOGGER_TRACE("lastNToString(snapshotBid, " + toString(maxMarketDepth) + ") = " + lastNToString(snapshotBid, maxMarketDepth));
-      } else if (type == MarketDataMessage::DataType::ASK) {
-        for (auto& y : detail) {
-          auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-          auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-          Decimal decimalPrice(price, this->sessionOptions.enableCheckOrderBookChecksum);
-          snapshotAsk.emplace(std::move(decimalPrice), std::move(size));
-        }
-        CCAPI_LOGGER_TRACE("firstNToString(snapshotAsk, " + toString(maxMarketDepth) + ") = " + firstNToString(snapshotAsk, maxMarketDepth));
-      } else {
-        CCAPI_LOGGER_WARN("extra type " + MarketDataMessage::dataTypeToString(type));
-      }
+    ++subscriptionState.orderBookGeneration;
+    int maxMarketDepth = typedOptions.marketDepthMax;
+    for (auto& level : input.bidList) {
+      this->insertOrderBookInitial(snapshotBid, level.price, level.size, this->sessionOptions.enableCheckOrderBookChecksum);
+    }
+    CCAPI_LOGGER_TRACE("lastNToString(snapshotBid, " + toString(maxMarketDepth) + ") = " + lastNToString(snapshotBid, maxMarketDepth));
+    for (auto& level : input.askList) {
+      this->insertOrderBookInitial(snapshotAsk, level.price, level.size, this->sessionOptions.enableCheckOrderBookChecksum);
     }
+    CCAPI_LOGGER_TRACE("firstNToString(snapshotAsk, " + toString(maxMarketDepth) + ") = " + firstNToString(snapshotAsk, maxMarketDepth));
     std::vector<Element> elementList;
-    this->updateElementListWithInitialMarketDepth(field, optionMap, snapshotBid, snapshotAsk, elementList);
+    this->updateElementListWithInitialMarketDepth(field, typedOptions, snapshotBid, snapshotAsk, elementList);
     if (!elementList.empty()) {
       Message message;
       message.setTimeReceived(timeReceived);
@@ -1153,85 +1381,85 @@ class MarketDataService : public Service {
       event.addMessages(newMessageList);
       CCAPI_LOGGER_TRACE("event.getMessageList() = " + toString(event.getMessageList()));
     }
-    this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
-    bool shouldConflate = optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS) != CCAPI_CONFLATE_INTERVAL_MILLISECONDS_DEFAULT;
-    if (shouldConflate) {
-      this->copySnapshot(true, snapshotBid, this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId],
-                         maxMarketDepth);
-      this->copySnapshot(false, snapshotAsk, this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId],
-                         maxMarketDepth);
-      CCAPI_LOGGER_TRACE(
-          "this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at("
-          "symbolId) = " +
-          toString(this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)));
-      CCAPI_LOGGER_TRACE(
-          "this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at("
-          "symbolId) = " +
-          toString(this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)));
-      TimePoint previousConflateTp = UtilTime::makeTimePointFromMilliseconds(
-          std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count() / std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)) *
-          std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)));
-      this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = previousConflateTp;
-      if (optionMap.at(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS) != CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS_DEFAULT) {
-        auto interval = std::chrono::milliseconds(std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)));
-        auto gracePeriod = std::chrono::milliseconds(std::stoi(optionMap.at(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS)));
+    subscriptionState.processedInitialSnapshot = true;
+    if (typedOptions.shouldConflate()) {
+      this->copySnapshot(true, snapshotBid, subscriptionState.previousConflateSnapshotBid, maxMarketDepth);
+      this->copySnapshot(false, snapshotAsk, subscriptionState.previousConflateSnapshotAsk, maxMarketDepth);
+      CCAPI_LOGGER_TRACE("subscriptionState.previousConflateSnapshotBid = " + toString(subscriptionState.previousConflateSnapshotBid));
+      CCAPI_LOGGER_TRACE("subscriptionState.previousConflateSnapshotAsk = " + toString(subscriptionState.previousConflateSnapshotAsk));
+      TimePoint previousConflateTp = this->getConflateTimePoint(tp, typedOptions);
+      subscriptionState.previousConflateTime = previousConflateTp;
+      if (typedOptions.hasConflateGracePeriod()) {
+        auto interval = std::chrono::milliseconds(typedOptions.conflateIntervalMilliseconds);
+        auto gracePeriod = std::chrono::milliseconds(typedOptions.conflateGracePeriodMilliseconds);
         CCAPI_LOGGER_TRACE("about to set conflate timer");
-        this->setConflateTimer(previousConflateTp, interval, gracePeriod, wsConnection, channelId, symbolId, field, optionMap, correlationIdList);
+        this->setConflateTimer(previousConflateTp, interval, gracePeriod, wsConnection, subscriptionState);
       }
     }
   }
-  void processOrderBookUpdate(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, Event& event, const TimePoint& tp,
-                              const TimePoint& timeReceived, MarketDataMessage::TypeForData& input, const std::string& field,
-                              const std::map<std::string, std::string>& optionMap, const std::vector<std::string>& correlationIdList,
-                              std::map<Decimal, std::string>& snapshotBid, std::map<Decimal, std::string>& snapshotAsk) {
-    CCAPI_LOGGER_TRACE("input = " + MarketDataMessage::dataToString(input));
-    if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+  template <typename T>
+  void processOrderBookUpdate(const WsConnection& wsConnection, SubscriptionState& subscriptionState, Event& event, const TimePoint& tp,
+                              const TimePoint& timeReceived, MarketDataMessage& input, T& snapshotBid, T& snapshotAsk) {
+    const auto& field = subscriptionState.field;
+    const auto& typedOptions = subscriptionState.typedOptions;
+    const auto& correlationIdList = subscriptionState.correlationIdList;
+    CCAPI_LOGGER_TRACE("input = " + toString(input));
+    if (subscriptionState.processedInitialSnapshot) {
       std::vector<Message> messageList;
-      CCAPI_LOGGER_TRACE("optionMap = " + toString(optionMap));
-      int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+      CCAPI_LOGGER_TRACE("typedOptions = " + toString(typedOptions));
+      int maxMarketDepth = typedOptions.marketDepthMax;
+      bool shouldConflate = typedOptions.shouldConflate();
+      CCAPI_LOGGER_TRACE("shouldConflate = " + toString(shouldConflate));
+      TimePoint conflateTp = shouldConflate ? this->getConflateTimePoint(tp, typedOptions) : tp;
+      CCAPI_LOGGER_TRACE("conflateTp = " + toString(conflateTp));
+      bool intervalChanged = shouldConflate && conflateTp > subscriptionState.previousConflateTime;
+      CCAPI_LOGGER_TRACE("intervalChanged = " + toString(intervalChanged));
+      // the change within the best levels is derived from the levels touched unless the whole side is replaced or truncated, in which case, as well as for
+      // the end of a conflate interval which reports the book before this update, the best levels are copied before the update
+      bool shouldTrackDirtyLevels =
+          std::is_same<T, std::map<Decimal, std::string>>::value && !shouldConflate && !subscriptionState.l2UpdateIsReplace && !this->shouldAlignSnapshot;
+      bool shouldCopySnapshot = intervalChanged || (!shouldConflate && !shouldTrackDirtyLevels);
       std::map<Decimal, std::string> snapshotBidPrevious;
-      this->copySnapshot(true, snapshotBid, snapshotBidPrevious, maxMarketDepth);
       std::map<Decimal, std::string> snapshotAskPrevious;
-      this->copySnapshot(false, snapshotAsk, snapshotAskPrevious, maxMarketDepth);
+      if (shouldCopySnapshot) {
+        this->copySnapshot(true, snapshotBid, snapshotBidPrevious, maxMarketDepth);
+        this->copySnapshot(false, snapshotAsk, snapshotAskPrevious, maxMarketDepth);
+      }
+      std::vector<DirtyLevel>* dirtyBidLevelList = nullptr;
+      std::vector<DirtyLevel>* dirtyAskLevelList = nullptr;
+      Decimal previousBidBoundary;
+      Decimal previousAskBoundary;
+      bool hasPreviousBidBoundary{};
+      bool hasPreviousAskBoundary{};
+      bool wasBidEmpty = snapshotBid.empty();
+      bool wasAskEmpty = snapshotAsk.empty();
+      if constexpr (std::is_same<T, std::map<Decimal, std::string>>::value) {
+        if (shouldTrackDirtyLevels) {
+          dirtyBidLevelList = &subscriptionState.dirtyBidLevelList;
+          dirtyAskLevelList = &subscriptionState.dirtyAskLevelList;
+          dirtyBidLevelList->clear();
+          dirtyAskLevelList->clear();
+          hasPreviousBidBoundary = this->getMarketDepthBoundary(true, snapshotBid, maxMarketDepth, previousBidBoundary);
+          hasPreviousAskBoundary = this->getMarketDepthBoundary(false, snapshotAsk, maxMarketDepth, previousAskBoundary);
+        }
+      }
       CCAPI_LOGGER_TRACE("before updating orderbook");
       CCAPI_LOGGER_TRACE("lastNToString(snapshotBid, " + toString(maxMarketDepth) + ") = " + lastNToString(snapshotBid, maxMarketDepth));
       CCAPI_LOGGER_TRACE("firstNToString(snapshotAsk, " + toString(maxMarketDepth) + ") = " + firstNToString(snapshotAsk, maxMarketDepth));
-      if (this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+      if (subscriptionState.l2UpdateIsReplace) {
         CCAPI_LOGGER_TRACE("l2Update is replace");
-        if (input.find(MarketDataMessage::DataType::BID) != input.end()) {
+        if (!input.bidList.empty()) {
           snapshotBid.clear();
         }
-        if (input.find(MarketDataMessage::DataType::ASK) != input.end()) {
+        if (!input.askList.empty()) {
           snapshotAsk.clear();
         }
       }
-      for (auto& x : input) {
-        auto& type = x.first;
-        auto& detail = x.second;
-        if (type == MarketDataMessage::DataType::BID) {
-          for (auto& y : detail) {
-            auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-            auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-            Decimal decimalPrice(price, this->sessionOptions.enableCheckOrderBookChecksum);
-            this->updateOrderBook(snapshotBid, decimalPrice, size, this->sessionOptions.enableCheckOrderBookChecksum);
-          }
-        } else if (type == MarketDataMessage::DataType::ASK) {
-          for (auto& y : detail) {
-            auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-            auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-            Decimal decimalPrice(price, this->sessionOptions.enableCheckOrderBookChecksum);
-            this->updateOrderBook(snapshotAsk, decimalPrice, size, this->sessionOptions.enableCheckOrderBookChecksum);
-          }
-        } else {
-          CCAPI_LOGGER_WARN("extra type " + MarketDataMessage::dataTypeToString(type));
-        }
-      }
-      CCAPI_LOGGER_TRACE("this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap = " +
-                         toString(this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap));
+      this->updateOrderBook(snapshotBid, input.bidList, dirtyBidLevelList);
+      this->updateOrderBook(snapshotAsk, input.askList, dirtyAskLevelList);
+      CCAPI_LOGGER_TRACE("subscriptionState.marketDepthSubscribedToExchange = " + toString(subscriptionState.marketDepthSubscribedToExchange));
       if (this->shouldAlignSnapshot) {
-        int marketDepthSubscribedToExchange =
-            this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-        this->alignSnapshot(snapshotBid, snapshotAsk, marketDepthSubscribedToExchange);
+        this->alignSnapshot(snapshotBid, snapshotAsk, subscriptionState.marketDepthSubscribedToExchange);
       }
       CCAPI_LOGGER_TRACE("after updating orderbook");
       CCAPI_LOGGER_TRACE("lastNToString(snapshotBid, " + toString(maxMarketDepth) + ") = " + lastNToString(snapshotBid, maxMarketDepth));
@@ -1240,39 +1468,27 @@ class MarketDataService : public Service {
       CCAPI_LOGGER_TRACE("firstNToString(snapshotAskPrevious, " + toString(maxMarketDepth) + ") = " + firstNToString(snapshotAskPrevious, maxMarketDepth));
       CCAPI_LOGGER_TRACE("field = " + toString(field));
       CCAPI_LOGGER_TRACE("maxMarketDepth = " + toString(maxMarketDepth));
-      CCAPI_LOGGER_TRACE("optionMap = " + toString(optionMap));
-      bool shouldConflate = optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS) != CCAPI_CONFLATE_INTERVAL_MILLISECONDS_DEFAULT;
-      CCAPI_LOGGER_TRACE("shouldConflate = " + toString(shouldConflate));
-      TimePoint conflateTp =
-          shouldConflate ? UtilTime::makeTimePointFromMilliseconds(std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count() /
-                                                                   std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)) *
-                                                                   std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)))
-                         : tp;
-      CCAPI_LOGGER_TRACE("conflateTp = " + toString(conflateTp));
-      bool intervalChanged =
-          shouldConflate && conflateTp > this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-      CCAPI_LOGGER_TRACE("intervalChanged = " + toString(intervalChanged));
       if (!shouldConflate || intervalChanged) {
         std::vector<Element> elementList;
         if (shouldConflate && intervalChanged) {
-          const std::map<Decimal, std::string>& snapshotBidPreviousPrevious =
-              this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-          const std::map<Decimal, std::string>& snapshotAskPreviousPrevious =
-              this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-          this->updateElementListWithUpdateMarketDepth(field, optionMap, snapshotBidPrevious, snapshotBidPreviousPrevious, snapshotAskPrevious,
+          const std::map<Decimal, std::string>& snapshotBidPreviousPrevious = subscriptionState.previousConflateSnapshotBid;
+          const std::map<Decimal, std::string>& snapshotAskPreviousPrevious = subscriptionState.previousConflateSnapshotAsk;
+          this->updateElementListWithUpdateMarketDepth(field, typedOptions, snapshotBidPrevious, snapshotBidPreviousPrevious, snapshotAskPrevious,
                                                        snapshotAskPreviousPrevious, elementList, false);
-          this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = snapshotBidPrevious;
-          this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = snapshotAskPrevious;
-          CCAPI_LOGGER_TRACE(
-              "this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at("
-              "symbolId) = " +
-              toString(this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)));
-          CCAPI_LOGGER_TRACE(
-              "this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at("
-              "symbolId) = " +
-              toString(this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)));
+          subscriptionState.previousConflateSnapshotBid = snapshotBidPrevious;
+          subscriptionState.previousConflateSnapshotAsk = snapshotAskPrevious;
+          CCAPI_LOGGER_TRACE("subscriptionState.previousConflateSnapshotBid = " + toString(subscriptionState.previousConflateSnapshotBid));
+          CCAPI_LOGGER_TRACE("subscriptionState.previousConflateSnapshotAsk = " + toString(subscriptionState.previousConflateSnapshotAsk));
+        } else if (shouldTrackDirtyLevels) {
+          if constexpr (std::is_same<T, std::map<Decimal, std::string>>::value) {
+            std::map<Decimal, std::string> snapshotBidUpdate = this->calculateMarketDepthUpdate(true, snapshotBid, *dirtyBidLevelList, wasBidEmpty,
+                                                                                                hasPreviousBidBoundary, previousBidBoundary, maxMarketDepth);
+            std::map<Decimal, std::string> snapshotAskUpdate = this->calculateMarketDepthUpdate(false, snapshotAsk, *dirtyAskLevelList, wasAskEmpty,
+                                                                                                hasPreviousAskBoundary, previousAskBoundary, maxMarketDepth);
+            this->updateElementListWithMarketDepthChange(field, typedOptions, snapshotBid, snapshotBidUpdate, snapshotAsk, snapshotAskUpdate, elementList);
+          }
         } else {
-          this->updateElementListWithUpdateMarketDepth(field, optionMap, snapshotBid, snapshotBidPrevious, snapshotAsk, snapshotAskPrevious, elementList,
+          this->updateElementListWithUpdateMarketDepth(field, typedOptions, snapshotBid, snapshotBidPrevious, snapshotAsk, snapshotAskPrevious, elementList,
                                                        false);
         }
         CCAPI_LOGGER_TRACE("elementList = " + toString(elementList));
@@ -1281,9 +1497,8 @@ class MarketDataService : public Service {
           message.setTimeReceived(timeReceived);
           message.setType(Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
           message.setRecapType(Message::RecapType::NONE);
-          TimePoint time = shouldConflate ? this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) +
-                                                std::chrono::milliseconds(std::stoll(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)))
-                                          : conflateTp;
+          TimePoint time =
+              shouldConflate ? subscriptionState.previousConflateTime + std::chrono::milliseconds(typedOptions.conflateIntervalMilliseconds) : conflateTp;
           message.setTime(time);
           message.setElementList(elementList);
           message.setCorrelationIdList(correlationIdList);
@@ -1293,45 +1508,42 @@ class MarketDataService : public Service {
           event.addMessages(messageList);
         }
         if (shouldConflate) {
-          this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = conflateTp;
+          subscriptionState.previousConflateTime = conflateTp;
         }
       }
     }
   }
-  void processTrade(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, Event& event, const TimePoint& tp,
-                    const TimePoint& timeReceived, MarketDataMessage::TypeForData& input, const std::string& field,
-                    const std::map<std::string, std::string>& optionMap, const std::vector<std::string>& correlationIdList, bool isSolicited) {
-    CCAPI_LOGGER_TRACE("input = " + MarketDataMessage::dataToString(input));
-    CCAPI_LOGGER_TRACE("optionMap = " + toString(optionMap));
-    bool shouldConflate = optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS) != CCAPI_CONFLATE_INTERVAL_MILLISECONDS_DEFAULT;
+  void processTrade(const WsConnection& wsConnection, SubscriptionState& subscriptionState, Event& event, const TimePoint& tp, const TimePoint& timeReceived,
+                    MarketDataMessage& input, bool isSolicited) {
+    const auto& field = subscriptionState.field;
+    const auto& typedOptions = subscriptionState.typedOptions;
+    const auto& correlationIdList = subscriptionState.correlationIdList;
+    CCAPI_LOGGER_TRACE("input = " + toString(input));
+    CCAPI_LOGGER_TRACE("typedOptions = " + toString(typedOptions));
+    bool shouldConflate = typedOptions.shouldConflate();
     CCAPI_LOGGER_TRACE("shouldConflate = " + toString(shouldConflate));
-    TimePoint conflateTp = shouldConflate
-                               ? UtilTime::makeTimePointFromMilliseconds(std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count() /
-                                                                         std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)) *
-                                                                         std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)))
-                               : tp;
+    TimePoint conflateTp = shouldConflate ? this->getConflateTimePoint(tp, typedOptions) : tp;
     CCAPI_LOGGER_TRACE("conflateTp = " + toString(conflateTp));
-    if (!this->processedInitialTradeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+    if (!subscriptionState.processedInitialTrade) {
       if (shouldConflate) {
         TimePoint previousConflateTp = conflateTp;
-        this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = previousConflateTp;
-        if (optionMap.at(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS) != CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS_DEFAULT) {
-          auto interval = std::chrono::milliseconds(std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)));
-          auto gracePeriod = std::chrono::milliseconds(std::stoi(optionMap.at(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS)));
+        subscriptionState.previousConflateTime = previousConflateTp;
+        if (typedOptions.hasConflateGracePeriod()) {
+          auto interval = std::chrono::milliseconds(typedOptions.conflateIntervalMilliseconds);
+          auto gracePeriod = std::chrono::milliseconds(typedOptions.conflateGracePeriodMilliseconds);
           CCAPI_LOGGER_TRACE("about to set conflate timer");
-          this->setConflateTimer(previousConflateTp, interval, gracePeriod, wsConnection, channelId, symbolId, field, optionMap, correlationIdList);
+          this->setConflateTimer(previousConflateTp, interval, gracePeriod, wsConnection, subscriptionState);
         }
       }
-      this->processedInitialTradeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+      subscriptionState.processedInitialTrade = true;
     }
-    bool intervalChanged =
-        shouldConflate && conflateTp > this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+    bool intervalChanged = shouldConflate && conflateTp > subscriptionState.previousConflateTime;
     CCAPI_LOGGER_TRACE("intervalChanged = " + toString(intervalChanged));
     if (!shouldConflate || intervalChanged) {
       std::vector<Message> messageList;
       std::vector<Element> elementList;
       if (shouldConflate && intervalChanged) {
-        this->updateElementListWithCalculatedCandlestick(wsConnection, channelId, symbolId, field, elementList);
+        this->updateElementListWithCalculatedCandlestick(subscriptionState, elementList);
       } else {
         this->updateElementListWithTrade(field, input, elementList);
       }
@@ -1341,8 +1553,7 @@ class MarketDataService : public Service {
         message.setTimeReceived(timeReceived);
         message.setType(field == CCAPI_TRADE ? Message::Type::MARKET_DATA_EVENTS_TRADE : Message::Type::MARKET_DATA_EVENTS_AGG_TRADE);
         message.setRecapType(isSolicited ? Message::RecapType::SOLICITED : Message::RecapType::NONE);
-        TimePoint time =
-            shouldConflate ? this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) : conflateTp;
+        TimePoint time = shouldConflate ? subscriptionState.previousConflateTime : conflateTp;
         message.setTime(time);
         message.setElementList(elementList);
         message.setCorrelationIdList(correlationIdList);
@@ -1352,15 +1563,15 @@ class MarketDataService : public Service {
         event.addMessages(messageList);
       }
       if (shouldConflate) {
-        this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = conflateTp;
-        this->updateCalculatedCandlestick(wsConnection, channelId, symbolId, field, input);
+        subscriptionState.previousConflateTime = conflateTp;
+        this->updateCalculatedCandlestick(subscriptionState, input);
       }
     } else {
-      this->updateCalculatedCandlestick(wsConnection, channelId, symbolId, field, input);
+      this->updateCalculatedCandlestick(subscriptionState, input);
     }
   }
   void processExchangeProvidedCandlestick(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, Event& event,
-                                          const TimePoint& tp, const TimePoint& timeReceived, MarketDataMessage::TypeForData& input, const std::string& field,
+                                          const TimePoint& tp, const TimePoint& timeReceived, MarketDataMessage& input, const std::string& field,
                                           const std::map<std::string, std::string>& optionMap, const std::vector<std::string>& correlationIdList,
                                           bool isSolicited) {
     std::vector<Message> messageList;
@@ -1380,7 +1591,7 @@ class MarketDataService : public Service {
       event.addMessages(messageList);
     }
   }
-  void processExchangeProvidedCandlestick(Event& event, const TimePoint& tp, const TimePoint& timeReceived, MarketDataMessage::TypeForData& input,
+  void processExchangeProvidedCandlestick(Event& event, const TimePoint& tp, const TimePoint& timeReceived, MarketDataMessage& input,
                                           const std::vector<std::string>& correlationIdList, Message::Type messageType) {
     std::vector<Message> messageList;
     std::vector<Element> elementList;
@@ -1398,36 +1609,29 @@ class MarketDataService : public Service {
       event.addMessages(messageList);
     }
   }
-  void updateCalculatedCandlestick(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, const std::string& field,
-                                   const MarketDataMessage::TypeForData& input) {
+  void updateCalculatedCandlestick(SubscriptionState& subscriptionState, const MarketDataMessage& input) {
+    const auto& field = subscriptionState.field;
     if (field == CCAPI_TRADE || field == CCAPI_AGG_TRADE) {
-      for (const auto& x : input) {
-        auto type = x.first;
-        auto detail = x.second;
-        if (type == MarketDataMessage::DataType::TRADE || type == MarketDataMessage::DataType::AGG_TRADE) {
-          for (const auto& y : detail) {
-            auto price = y.at(MarketDataMessage::DataFieldType::PRICE);
-            if (this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].empty()) {
-              this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = price;
-              this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = Decimal(price);
-              this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = Decimal(price);
-            } else {
-              Decimal decimalPrice(price);
-              if (decimalPrice > this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
-                this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = decimalPrice;
-              }
-              if (decimalPrice < this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
-                this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = decimalPrice;
-              }
-            }
-            this->closeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = price;
-          }
+      for (const auto& trade : input.tradeList) {
+        const auto& price = trade.price;
+        if (subscriptionState.open.empty()) {
+          subscriptionState.open = price;
+          subscriptionState.high = Decimal(price);
+          subscriptionState.low = Decimal(price);
         } else {
-          CCAPI_LOGGER_WARN("extra type " + MarketDataMessage::dataTypeToString(type));
+          Decimal decimalPrice(price);
+          if (decimalPrice > subscriptionState.high) {
+            subscriptionState.high = decimalPrice;
+          }
+          if (decimalPrice < subscriptionState.low) {
+            subscriptionState.low = decimalPrice;
+          }
         }
+        subscriptionState.close = price;
       }
     }
   }
+
   virtual void alignSnapshot(std::map<Decimal, std::string>& snapshotBid, std::map<Decimal, std::string>& snapshotAsk, int marketDepthSubscribedToExchange) {
     CCAPI_LOGGER_TRACE("snapshotBid.size() = " + toString(snapshotBid.size()));
     if (snapshotBid.size() > marketDepthSubscribedToExchange) {
@@ -1440,8 +1644,97 @@ class MarketDataService : public Service {
     }
     CCAPI_LOGGER_TRACE("snapshotAsk.size() = " + toString(snapshotAsk.size()));
   }
+  virtual void alignSnapshot(PriceLadder& snapshotBid, PriceLadder& snapshotAsk, int marketDepthSubscribedToExchange) {
+    snapshotBid.keepBestN(marketDepthSubscribedToExchange);
+    snapshotAsk.keepBestN(marketDepthSubscribedToExchange);
+  }
+  virtual void alignSnapshot(SmallOrderBook& snapshotBid, SmallOrderBook& snapshotAsk, int marketDepthSubscribedToExchange) {
+    snapshotBid.keepBestN(marketDepthSubscribedToExchange);
+    snapshotAsk.keepBestN(marketDepthSubscribedToExchange);
+  }
   virtual bool checkOrderBookChecksum(const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk,
                                       const std::string& receivedOrderBookChecksumStr, bool& shouldProcessRemainingMessage) {
+    return this->verifyOrderBookChecksum(snapshotBid, snapshotAsk, receivedOrderBookChecksumStr, shouldProcessRemainingMessage);
+  }
+  virtual bool checkOrderBookChecksum(const PriceLadder& snapshotBid, const PriceLadder& snapshotAsk, const std::string& receivedOrderBookChecksumStr,
+                                      bool& shouldProcessRemainingMessage) {
+    return this->verifyOrderBookChecksum(snapshotBid, snapshotAsk, receivedOrderBookChecksumStr, shouldProcessRemainingMessage);
+  }
+  virtual bool checkOrderBookChecksum(const SmallOrderBook& snapshotBid, const SmallOrderBook& snapshotAsk, const std::string& receivedOrderBookChecksumStr,
+                                      bool& shouldProcessRemainingMessage) {
+    return this->verifyOrderBookChecksum(snapshotBid, snapshotAsk, receivedOrderBookChecksumStr, shouldProcessRemainingMessage);
+  }
+  // the verification policy of the session options: a corrupted book is detected within orderBookChecksumVerifyEveryNUpdates updates or, if set, within
+  // the first update after orderBookChecksumVerifyIntervalMilliseconds, every update is verified if neither is set
+  bool shouldVerifyOrderBookChecksum(SubscriptionState& subscriptionState, const TimePoint& timeReceived) {
+    int everyNUpdates = this->sessionOptions.orderBookChecksumVerifyEveryNUpdates;
+    long intervalMilliseconds = this->sessionOptions.orderBookChecksumVerifyIntervalMilliseconds;
+    ++subscriptionState.numOrderBookUpdatesSinceChecksumVerified;
+    if ((everyNUpdates <= 0 && intervalMilliseconds <= 0) ||
+        (everyNUpdates > 0 && subscriptionState.numOrderBookUpdatesSinceChecksumVerified >= everyNUpdates) ||
+        (intervalMilliseconds > 0 && timeReceived - subscriptionState.orderBookChecksumVerifiedTime >= std::chrono::milliseconds(intervalMilliseconds))) {
+      subscriptionState.numOrderBookUpdatesSinceChecksumVerified = 0;
+      subscriptionState.orderBookChecksumVerifiedTime = timeReceived;
+      return true;
+    }
+    return false;
+  }
+#ifndef CCAPI_LEGACY_USE_WEBSOCKETPP
+  // only the levels covered by the checksum are copied and verified on orderBookChecksumThreadPoolPtr, a mismatch is then handled back on the io thread
+  // unless the connection has gone or the book has been rebuilt or already found incorrect in the meantime, so that several verifications in flight for
+  // the same book report it once. The raw frame is not kept for it so the levels are logged instead.
+  template <typename T>
+  void verifyOrderBookChecksumAsync(std::shared_ptr<WsConnection> wsConnectionPtr, const TimePoint& timeReceived, const SubscriptionState& subscriptionState,
+                                    const T& snapshotBid, const T& snapshotAsk, const std::string& receivedOrderBookChecksumStr) {
+    size_t numLevels = static_cast<size_t>(this->orderBookChecksumNumLevels);
+    std::vector<std::pair<Decimal, std::string>> snapshotBidCopy;
+    const size_t numBidLevel = std::min(snapshotBid.size(), numLevels);
+    snapshotBidCopy.reserve(numBidLevel);
+    std::copy_n(snapshotBid.rbegin(), numBidLevel, std::back_inserter(snapshotBidCopy));
+    std::reverse(snapshotBidCopy.begin(), snapshotBidCopy.end());
+    std::vector<std::pair<Decimal, std::string>> snapshotAskCopy;
+    const size_t numAskLevel = std::min(snapshotAsk.size(), numLevels);
+    snapshotAskCopy.reserve(numAskLevel);
+    std::copy_n(snapshotAsk.begin(), numAskLevel, std::back_inserter(snapshotAskCopy));
+    net::post(*this->orderBookChecksumThreadPoolPtr,
+              [weakThat = std::weak_ptr<MarketDataService>(this->shared_from_base<MarketDataService>()), ioContextPtr = this->serviceContextPtr->ioContextPtr,
+               weakWsConnectionPtr = std::weak_ptr<WsConnection>(wsConnectionPtr), timeReceived, channelId = subscriptionState.channelId,
+               symbolId = subscriptionState.symbolId, exchangeSubscriptionId = subscriptionState.exchangeSubscriptionId,
+               orderBookGeneration = subscriptionState.orderBookGeneration, snapshotBidCopy = std::move(snapshotBidCopy),
+               snapshotAskCopy = std::move(snapshotAskCopy), receivedOrderBookChecksumStr, numLevels = this->orderBookChecksumNumLevels,
+               askSizePrefix = this->orderBookChecksumAskSizePrefix]() {
+                std::string calculatedOrderBookChecksumStr = calculateOrderBookCrc32(snapshotBidCopy, snapshotAskCopy, numLevels, askSizePrefix);
+                if (calculatedOrderBookChecksumStr == receivedOrderBookChecksumStr) {
+                  return;
+                }
+                std::string verifiedLevels = "snapshotBid = " + toString(snapshotBidCopy) + ", snapshotAsk = " + toString(snapshotAskCopy);
+                net::post(*ioContextPtr, [weakThat, weakWsConnectionPtr, timeReceived, channelId, symbolId, exchangeSubscriptionId, orderBookGeneration,
+                                          calculatedOrderBookChecksumStr, receivedOrderBookChecksumStr, verifiedLevels = std::move(verifiedLevels)]() {
+                  auto that = weakThat.lock();
+                  auto wsConnectionPtr = weakWsConnectionPtr.lock();
+                  if (!that || !wsConnectionPtr) {
+                    return;
+                  }
+                  auto it = that->wsConnectionByIdMap.find(wsConnectionPtr->id);
+                  if (it == that->wsConnectionByIdMap.end() || it->second != wsConnectionPtr) {
+                    return;
+                  }
+                  SubscriptionState* subscriptionStatePtr = that->findSubscriptionState(wsConnectionPtr->id, channelId, symbolId);
+                  if (!subscriptionStatePtr || subscriptionStatePtr->orderBookGeneration != orderBookGeneration) {
+                    return;
+                  }
+                  ++subscriptionStatePtr->orderBookGeneration;
+                  CCAPI_LOGGER_ERROR("calculatedOrderBookChecksumStr = " + calculatedOrderBookChecksumStr);
+                  CCAPI_LOGGER_ERROR("receivedOrderBookChecksumStr = " + receivedOrderBookChecksumStr);
+                  CCAPI_LOGGER_ERROR(verifiedLevels);
+                  that->onIncorrectStatesFound(wsConnectionPtr, "", timeReceived, exchangeSubscriptionId, "order book incorrect checksum found");
+                });
+              });
+  }
+#endif
+  template <typename T>
+  bool verifyOrderBookChecksum(const T& snapshotBid, const T& snapshotAsk, const std::string& receivedOrderBookChecksumStr,
+                               bool& shouldProcessRemainingMessage) {
     if (this->sessionOptions.enableCheckOrderBookChecksum) {
       std::string calculatedOrderBookChecksumStr = this->calculateOrderBookChecksum(snapshotBid, snapshotAsk);
       if (!calculatedOrderBookChecksumStr.empty() && calculatedOrderBookChecksumStr != receivedOrderBookChecksumStr) {
@@ -1460,6 +1753,16 @@ class MarketDataService : public Service {
   }
   virtual bool checkOrderBookCrossed(const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk,
                                      bool& shouldProcessRemainingMessage) {
+    return this->verifyOrderBookNotCrossed(snapshotBid, snapshotAsk, shouldProcessRemainingMessage);
+  }
+  virtual bool checkOrderBookCrossed(const PriceLadder& snapshotBid, const PriceLadder& snapshotAsk, bool& shouldProcessRemainingMessage) {
+    return this->verifyOrderBookNotCrossed(snapshotBid, snapshotAsk, shouldProcessRemainingMessage);
+  }
+  virtual bool checkOrderBookCrossed(const SmallOrderBook& snapshotBid, const SmallOrderBook& snapshotAsk, bool& shouldProcessRemainingMessage) {
+    return this->verifyOrderBookNotCrossed(snapshotBid, snapshotAsk, shouldProcessRemainingMessage);
+  }
+  template <typename T>
+  bool verifyOrderBookNotCrossed(const T& snapshotBid, const T& snapshotAsk, bool& shouldProcessRemainingMessage) {
     if (this->sessionOptions.enableCheckOrderBookCrossed) {
       auto i1 = snapshotBid.rbegin();
       auto i2 = snapshotAsk.begin();
@@ -1495,16 +1798,11 @@ class MarketDataService : public Service {
     }
   }
   void setConflateTimer(const TimePoint& previousConflateTp, const std::chrono::milliseconds& interval, const std::chrono::milliseconds& gracePeriod,
-                        const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, const std::string& field,
-                        const std::map<std::string, std::string>& optionMap, const std::vector<std::string>& correlationIdList) {
+                        const WsConnection& wsConnection, SubscriptionState& subscriptionState) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     if (wsConnection.status == WsConnection::Status::OPEN) {
-      if (this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.end() &&
-          this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id].find(channelId) !=
-              this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id].end() &&
-          this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId].find(symbolId) !=
-              this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId].end()) {
-        this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]->cancel();
+      if (subscriptionState.conflateTimer) {
+        subscriptionState.conflateTimer->cancel();
       }
       long waitMilliseconds =
           std::chrono::duration_cast<std::chrono::milliseconds>(previousConflateTp + interval + gracePeriod - std::chrono::system_clock::now()).count();
@@ -1515,8 +1813,11 @@ class MarketDataService : public Service {
       }
       if (waitMilliseconds > 0) {
         TimerPtr timerPtr(new boost::asio::steady_timer(*this->serviceContextPtr->ioContextPtr, std::chrono::milliseconds(waitMilliseconds)));
+        // the state is looked up again when the timer fires since the connection's states might have been cleared in the meantime
+        const std::string& channelId = subscriptionState.channelId;
+        const std::string& symbolId = subscriptionState.symbolId;
         timerPtr->async_wait(
-            [wsConnection, channelId, symbolId, field, optionMap, correlationIdList, previousConflateTp, interval, gracePeriod, this](ErrorCode const& ec) {
+            [wsConnection, channelId, symbolId, previousConflateTp, interval, gracePeriod, this](ErrorCode const& ec) {
               if (this->wsConnectionByIdMap.find(wsConnection.id) != this->wsConnectionByIdMap.end()) {
                 if (ec) {
                   CCAPI_LOGGER_ERROR("wsConnection = " + toString(wsConnection) + ", conflate timer error: " + ec.message());
@@ -1529,21 +1830,39 @@ class MarketDataService : public Service {
                       this->wsConnectionByIdMap.at(wsConnection.id)->status == WsConnection::Status::OPEN
 #endif
                   ) {
+                    auto it = this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id);
+                    if (it == this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end() || it->second.find(channelId) == it->second.end() ||
+                        it->second.at(channelId).find(symbolId) == it->second.at(channelId).end()) {
+                      return;
+                    }
+                    SubscriptionState& subscriptionState = it->second.at(channelId).at(symbolId);
+                    const auto& field = subscriptionState.field;
+                    const auto& typedOptions = subscriptionState.typedOptions;
                     auto conflateTp = previousConflateTp + interval;
-                    if (conflateTp > this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)) {
+                    if (conflateTp > subscriptionState.previousConflateTime) {
                       Event event;
                       event.setType(Event::Type::SUBSCRIPTION_DATA);
                       std::vector<Element> elementList;
                       if (field == CCAPI_MARKET_DEPTH) {
-                        std::map<Decimal, std::string>& snapshotBid = this->snapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-                        std::map<Decimal, std::string>& snapshotAsk = this->snapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-                        this->updateElementListWithUpdateMarketDepth(field, optionMap, snapshotBid, std::map<Decimal, std::string>(), snapshotAsk,
-                                                                     std::map<Decimal, std::string>(), elementList, true);
+                        if (this->shouldUseSmallOrderBook(subscriptionState)) {
+                          const SmallOrderBook& snapshotBid = this->getSnapshotSmallOrderBook(true, subscriptionState);
+                          const SmallOrderBook& snapshotAsk = this->getSnapshotSmallOrderBook(false, subscriptionState);
+                          this->updateElementListWithUpdateMarketDepth(field, typedOptions, snapshotBid, std::map<Decimal, std::string>(), snapshotAsk,
+                                                                       std::map<Decimal, std::string>(), elementList, true);
+                        } else if (this->shouldUseOrderBookPriceLadder()) {
+                          const PriceLadder& snapshotBid = this->getSnapshotPriceLadder(true, subscriptionState);
+                          const PriceLadder& snapshotAsk = this->getSnapshotPriceLadder(false, subscriptionState);
+                          this->updateElementListWithUpdateMarketDepth(field, typedOptions, snapshotBid, std::map<Decimal, std::string>(), snapshotAsk,
+                                                                       std::map<Decimal, std::string>(), elementList, true);
+                        } else {
+                          this->updateElementListWithUpdateMarketDepth(field, typedOptions, subscriptionState.snapshotBid, std::map<Decimal, std::string>(),
+                                                                       subscriptionState.snapshotAsk, std::map<Decimal, std::string>(), elementList, true);
+                        }
                       } else if (field == CCAPI_TRADE || field == CCAPI_AGG_TRADE) {
-                        this->updateElementListWithCalculatedCandlestick(wsConnection, channelId, symbolId, field, elementList);
+                        this->updateElementListWithCalculatedCandlestick(subscriptionState, elementList);
                       }
                       CCAPI_LOGGER_TRACE("elementList = " + toString(elementList));
-                      this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = conflateTp;
+                      subscriptionState.previousConflateTime = conflateTp;
                       std::vector<Message> messageList;
                       if (!elementList.empty()) {
                         Message message;
@@ -1552,7 +1871,7 @@ class MarketDataService : public Service {
                         message.setRecapType(Message::RecapType::NONE);
                         message.setTime(field == CCAPI_MARKET_DEPTH ? conflateTp : previousConflateTp);
                         message.setElementList(elementList);
-                        message.setCorrelationIdList(correlationIdList);
+                        message.setCorrelationIdList(subscriptionState.correlationIdList);
                         messageList.emplace_back(std::move(message));
                       }
                       if (!messageList.empty()) {
@@ -1565,12 +1884,12 @@ class MarketDataService : public Service {
                       conflateTp += interval;
                     }
                     CCAPI_LOGGER_TRACE("about to set conflate timer");
-                    this->setConflateTimer(conflateTp, interval, gracePeriod, wsConnection, channelId, symbolId, field, optionMap, correlationIdList);
+                    this->setConflateTimer(conflateTp, interval, gracePeriod, wsConnection, subscriptionState);
                   }
                 }
               }
             });
-        this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = timerPtr;
+        subscriptionState.conflateTimer = timerPtr;
       }
     }
     CCAPI_LOGGER_FUNCTION_EXIT;
@@ -1617,30 +1936,54 @@ class MarketDataService : public Service {
     }
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
+  void processSuccessfulStreamedTextMessageRest(int statusCode, const Request& request, const std::string& textMessage, StreamedResponse& streamedResponse,
+                                                const TimePoint& timeReceived, Queue<Event>* eventQueuePtr) override {
+    CCAPI_LOGGER_FUNCTION_ENTER;
+    if (this->doesHttpBodyContainError(textMessage)) {
+      this->processSuccessfulTextMessageRest(statusCode, request, textMessage, timeReceived, eventQueuePtr);
+      return;
+    }
+    Event event;
+    event.setType(Event::Type::RESPONSE);
+    if (request.getOperation() == Request::Operation::GET_INSTRUMENT || request.getOperation() == Request::Operation::GET_INSTRUMENTS) {
+      Message message;
+      message.setTimeReceived(timeReceived);
+      message.setType(this->requestOperationToMessageTypeMap.at(request.getOperation()));
+      message.setElementList(streamedResponse.elementList);
+      message.setCorrelationIdList({request.getCorrelationId()});
+      event.addMessage(message);
+    }
+    if (!streamedResponse.marketDataMessageList.empty()) {
+      this->processMarketDataMessageList(request, textMessage, timeReceived, event, streamedResponse.marketDataMessageList);
+    }
+    if (!event.getMessageList().empty()) {
+      this->eventHandler(event, eventQueuePtr);
+    }
+    CCAPI_LOGGER_FUNCTION_EXIT;
+  }
   void processMarketDataMessageList(const Request& request, const std::string& textMessage, const TimePoint& timeReceived, Event& event,
                                     std::vector<MarketDataMessage>& marketDataMessageList) {
     CCAPI_LOGGER_TRACE("marketDataMessageList = " + toString(marketDataMessageList));
     for (auto& marketDataMessage : marketDataMessageList) {
+      marketDataMessage.convertDataToTypedList();
       if (marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_AGG_TRADE ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK) {
         const std::vector<std::string>& correlationIdList = {request.getCorrelationId()};
         CCAPI_LOGGER_TRACE("correlationIdList = " + toString(correlationIdList));
-        if (marketDataMessage.data.find(MarketDataMessage::DataType::BID) != marketDataMessage.data.end() ||
-            marketDataMessage.data.find(MarketDataMessage::DataType::ASK) != marketDataMessage.data.end()) {
+        if (marketDataMessage.hasDepth()) {
           auto messageType = this->requestOperationToMessageTypeMap.at(request.getOperation());
           const auto& param = request.getFirstParamWithDefault();
           const auto& maxMarketDepthStr = mapGetWithDefault(param, std::string(CCAPI_MARKET_DEPTH_MAX));
           int maxMarketDepth = maxMarketDepthStr.empty() ? INT_MAX : std::stoi(maxMarketDepthStr);
-          this->processOrderBookSnapshot(event, marketDataMessage.tp, timeReceived, marketDataMessage.data, correlationIdList, messageType, maxMarketDepth);
-        } else if (marketDataMessage.data.find(MarketDataMessage::DataType::TRADE) != marketDataMessage.data.end() ||
-                   marketDataMessage.data.find(MarketDataMessage::DataType::AGG_TRADE) != marketDataMessage.data.end()) {
+          this->processOrderBookSnapshot(event, marketDataMessage.tp, timeReceived, marketDataMessage, correlationIdList, messageType, maxMarketDepth);
+        } else if (marketDataMessage.hasTrade()) {
           auto messageType = this->requestOperationToMessageTypeMap.at(request.getOperation());
-          this->processTrade(event, marketDataMessage.tp, timeReceived, marketDataMessage.data, correlationIdList, messageType);
-        } else if (marketDataMessage.data.find(MarketDataMessage::DataType::CANDLESTICK) != marketDataMessage.data.end()) {
+          this->processTrade(event, marketDataMessage.tp, timeReceived, marketDataMessage, correlationIdList, messageType);
+        } else if (marketDataMessage.hasCandlestick()) {
           auto messageType = this->requestOperationToMessageTypeMap.at(request.getOperation());
-          this->processExchangeProvidedCandlestick(event, marketDataMessage.tp, timeReceived, marketDataMessage.data, correlationIdList, messageType);
+          this->processExchangeProvidedCandlestick(event, marketDataMessage.tp, timeReceived, marketDataMessage, correlationIdList, messageType);
         }
       } else {
         CCAPI_LOGGER_WARN("market data event type is unknown!");
@@ -1648,7 +1991,7 @@ class MarketDataService : public Service {
     }
     CCAPI_LOGGER_TRACE("event type is " + event.typeToString(event.getType()));
   }
-  void processTrade(Event& event, const TimePoint& tp, const TimePoint& timeReceived, MarketDataMessage::TypeForData& input,
+  void processTrade(Event& event, const TimePoint& tp, const TimePoint& timeReceived, MarketDataMessage& input,
                     const std::vector<std::string>& correlationIdList, Message::Type messageType) {
     std::vector<Message> messageList;
     std::vector<Element> elementList;
@@ -1663,34 +2006,19 @@ class MarketDataService : public Service {
     messageList.emplace_back(std::move(message));
     event.addMessages(messageList);
   }
-  void processOrderBookSnapshot(Event& event, const TimePoint& tp, const TimePoint& timeReceived, MarketDataMessage::TypeForData& input,
+  void processOrderBookSnapshot(Event& event, const TimePoint& tp, const TimePoint& timeReceived, MarketDataMessage& input,
                                 const std::vector<std::string>& correlationIdList, Message::Type messageType, int maxMarketDepth) {
     std::vector<Message> messageList;
     std::vector<Element> elementList;
     std::map<Decimal, std::string> snapshotBid, snapshotAsk;
-    for (auto& x : input) {
-      auto& type = x.first;
-      auto& detail = x.second;
-      if (type == MarketDataMessage::DataType::BID) {
-        for (auto& y : detail) {
-          auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-          auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-          Decimal decimalPrice(price, this->sessionOptions.enableCheckOrderBookChecksum);
-          snapshotBid.emplace(std::move(decimalPrice), std::move(size));
-        }
-        CCAPI_LOGGER_TRACE("lastNToString(snapshotBid, " + toString(maxMarketDepth) + ") = " + lastNToString(snapshotBid, maxMarketDepth));
-      } else if (type == MarketDataMessage::DataType::ASK) {
-        for (auto& y : detail) {
-          auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-          auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-          Decimal decimalPrice(price, this->sessionOptions.enableCheckOrderBookChecksum);
-          snapshotAsk.emplace(std::move(decimalPrice), std::move(size));
-        }
-        CCAPI_LOGGER_TRACE("firstNToString(snapshotAsk, " + toString(maxMarketDepth) + ") = " + firstNToString(snapshotAsk, maxMarketDepth));
-      } else {
-        CCAPI_LOGGER_WARN("extra type " + MarketDataMessage::dataTypeToString(type));
-      }
+    for (auto& level : input.bidList) {
+      snapshotBid.emplace(Decimal(level.price, this->sessionOptions.enableCheckOrderBookChecksum), std::move(level.size));
     }
+    CCAPI_LOGGER_TRACE("lastNToString(snapshotBid, " + toString(maxMarketDepth) + ") = " + lastNToString(snapshotBid, maxMarketDepth));
+    for (auto& level : input.askList) {
+      snapshotAsk.emplace(Decimal(level.price, this->sessionOptions.enableCheckOrderBookChecksum), std::move(level.size));
+    }
+    CCAPI_LOGGER_TRACE("firstNToString(snapshotAsk, " + toString(maxMarketDepth) + ") = " + firstNToString(snapshotAsk, maxMarketDepth));
     this->updateElementListWithOrderBookSnapshot(CCAPI_MARKET_DEPTH, maxMarketDepth, snapshotBid, snapshotAsk, elementList);
     CCAPI_LOGGER_TRACE("elementList = " + toString(elementList));
     Message message;
@@ -1724,17 +2052,17 @@ class MarketDataService : public Service {
       req.prepare_payload();
     }
   }
-  void processOrderBookWithVersionId(int64_t versionId, const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId,
-                                     const std::string& exchangeSubscriptionId, const std::map<std::string, std::string>& optionMap,
-                                     std::vector<MarketDataMessage>& marketDataMessageList, const MarketDataMessage& marketDataMessage) {
-    if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+  void processOrderBookWithVersionId(int64_t versionId, const WsConnection& wsConnection, const SubscriptionState& subscriptionState,
+                                     const std::string& exchangeSubscriptionId, std::vector<MarketDataMessage>& marketDataMessageList,
+                                     const MarketDataMessage& marketDataMessage) {
+    if (subscriptionState.processedInitialSnapshot) {
       if (versionId > this->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId)) {
         marketDataMessageList.emplace_back(std::move(marketDataMessage));
         this->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId] = versionId;
       }
     } else {
-      if (this->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap[wsConnection.id][exchangeSubscriptionId].empty()) {
-        int delayMilliseconds = std::stoi(optionMap.at(CCAPI_FETCH_MARKET_DEPTH_INITIAL_SNAPSHOT_DELAY_MILLISECONDS));
+      if (this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap[wsConnection.id][exchangeSubscriptionId].empty()) {
+        int delayMilliseconds = subscriptionState.typedOptions.fetchMarketDepthInitialSnapshotDelayMilliseconds;
         if (delayMilliseconds > 0) {
           TimerPtr timerPtr(new boost::asio::steady_timer(*this->serviceContextPtr->ioContextPtr, std::chrono::milliseconds(delayMilliseconds)));
           timerPtr->async_wait([wsConnection, exchangeSubscriptionId, delayMilliseconds, that = this](ErrorCode const& ec) {
@@ -1750,8 +2078,10 @@ class MarketDataService : public Service {
           this->buildOrderBookInitial(wsConnection, exchangeSubscriptionId, delayMilliseconds);
         }
       }
-      this->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap[wsConnection.id][exchangeSubscriptionId][versionId] =
-          marketDataMessage.data;
+      MarketDataMessage& bufferedMarketDataMessage =
+          this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap[wsConnection.id][exchangeSubscriptionId][versionId];
+      bufferedMarketDataMessage = marketDataMessage;
+      bufferedMarketDataMessage.convertDataToTypedList();
     }
   }
   void buildOrderBookInitialOnFail(const WsConnection& wsConnection, const std::string& exchangeSubscriptionId, long delayMilliseconds) {
@@ -1770,6 +2100,41 @@ class MarketDataService : public Service {
       this->buildOrderBookInitial(wsConnection, exchangeSubscriptionId, thisDelayMilliseconds);
     }
   }
+  template <typename T>
+  void buildOrderBookInitialSnapshot(const WsConnection& wsConnection, const std::string& exchangeSubscriptionId, int64_t versionId,
+                                     const rj::Document& document, const Subscription::TypedOptions& typedOptions, T& snapshotBid, T& snapshotAsk,
+                                     std::vector<Element>& elementList) {
+    snapshotBid.clear();
+    snapshotAsk.clear();
+    MarketDataMessage input;
+    this->extractOrderBookInitialData(input.data, document);
+    input.convertDataToTypedList();
+    for (auto& level : input.bidList) {
+      this->insertOrderBookInitial(snapshotBid, level.price, level.size, this->sessionOptions.enableCheckOrderBookChecksum);
+    }
+    for (auto& level : input.askList) {
+      this->insertOrderBookInitial(snapshotAsk, level.price, level.size, this->sessionOptions.enableCheckOrderBookChecksum);
+    }
+    if (this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).find(exchangeSubscriptionId) !=
+        this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).end()) {
+      auto it =
+          this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).upper_bound(versionId);
+      while (it != this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).end()) {
+        const auto& bufferedMarketDataMessage = it->second;
+        for (const auto& level : bufferedMarketDataMessage.bidList) {
+          this->updateOrderBook(snapshotBid, level.price, level.size, this->sessionOptions.enableCheckOrderBookChecksum);
+        }
+        for (const auto& level : bufferedMarketDataMessage.askList) {
+          this->updateOrderBook(snapshotAsk, level.price, level.size, this->sessionOptions.enableCheckOrderBookChecksum);
+        }
+        this->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId] = it->first;
+        it++;
+      }
+      this->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).erase(exchangeSubscriptionId);
+    }
+    int maxMarketDepth = typedOptions.marketDepthMax;
+    this->updateElementListWithOrderBookSnapshot(CCAPI_MARKET_DEPTH, maxMarketDepth, snapshotBid, snapshotAsk, elementList);
+  }
   void buildOrderBookInitial(const WsConnection& wsConnection, const std::string& exchangeSubscriptionId, long delayMilliseconds) {
     auto now = UtilTime::now();
     http::request<http::string_body> req;
@@ -1795,106 +2160,22 @@ class MarketDataService : public Service {
               int64_t versionId;
               that->extractOrderBookInitialVersionId(versionId, document);
               if (versionId >=
-                  that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap[wsConnection.id][exchangeSubscriptionId].begin()->first) {
-                const auto& channelId =
-                    that->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID];
-                const auto& symbolId = that->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_SYMBOL_ID];
-                const auto& optionMap = that->optionMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
+                  that->marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap[wsConnection.id][exchangeSubscriptionId].begin()->first) {
+                SubscriptionState& subscriptionState = that->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
+                const auto& typedOptions = subscriptionState.typedOptions;
                 that->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId] = versionId;
-                const auto& correlationIdList = that->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-                std::map<Decimal, std::string>& snapshotBid = that->snapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-                std::map<Decimal, std::string>& snapshotAsk = that->snapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-                snapshotBid.clear();
-                snapshotAsk.clear();
-                MarketDataMessage::TypeForData input;
-                that->extractOrderBookInitialData(input, document);
-                for (const auto& x : input) {
-                  const auto& type = x.first;
-                  const auto& detail = x.second;
-                  if (type == MarketDataMessage::DataType::BID) {
-                    for (const auto& y : detail) {
-                      const auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-                      const auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-                      Decimal decimalPrice(price, that->sessionOptions.enableCheckOrderBookChecksum);
-                      snapshotBid.emplace(std::move(decimalPrice), std::move(size));
-                    }
-                  } else if (type == MarketDataMessage::DataType::ASK) {
-                    for (const auto& y : detail) {
-                      const auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-                      const auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-                      Decimal decimalPrice(price, that->sessionOptions.enableCheckOrderBookChecksum);
-                      snapshotAsk.emplace(std::move(decimalPrice), std::move(size));
-                    }
-                  }
-                }
-                if (that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).find(exchangeSubscriptionId) !=
-                    that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).end()) {
-                  auto it = that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id)
-                                .at(exchangeSubscriptionId)
-                                .upper_bound(versionId);
-                  while (
-                      it !=
-                      that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).end()) {
-                    const auto& input = it->second;
-                    for (const auto& x : input) {
-                      const auto& type = x.first;
-                      const auto& detail = x.second;
-                      if (type == MarketDataMessage::DataType::BID) {
-                        for (const auto& y : detail) {
-                          const auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-                          const auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-                          Decimal decimalPrice(price, that->sessionOptions.enableCheckOrderBookChecksum);
-                          that->updateOrderBook(snapshotBid, decimalPrice, size, that->sessionOptions.enableCheckOrderBookChecksum);
-                        }
-                      } else if (type == MarketDataMessage::DataType::ASK) {
-                        for (const auto& y : detail) {
-                          const auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
-                          const auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
-                          Decimal decimalPrice(price, that->sessionOptions.enableCheckOrderBookChecksum);
-                          that->updateOrderBook(snapshotAsk, decimalPrice, size, that->sessionOptions.enableCheckOrderBookChecksum);
-                        }
-                      }
-                    }
-                    that->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId] = it->first;
-                    it++;
-                  }
-                  that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).erase(exchangeSubscriptionId);
-                }
+                const auto& correlationIdList = subscriptionState.correlationIdList;
                 Event event;
                 event.setType(Event::Type::SUBSCRIPTION_DATA);
                 std::vector<Element> elementList;
-                int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-                int bidIndex = 0;
-                for (auto iter = snapshotBid.rbegin(); iter != snapshotBid.rend(); iter++) {
-                  if (bidIndex < maxMarketDepth) {
-                    Element element;
-                    element.insert(CCAPI_BEST_BID_N_PRICE, iter->first.toString());
-                    element.insert(CCAPI_BEST_BID_N_SIZE, iter->second);
-                    elementList.emplace_back(std::move(element));
-                  }
-                  ++bidIndex;
-                }
-                if (snapshotBid.empty()) {
-                  Element element;
-                  element.insert(CCAPI_BEST_BID_N_PRICE, CCAPI_BEST_BID_N_PRICE_EMPTY);
-                  element.insert(CCAPI_BEST_BID_N_SIZE, CCAPI_BEST_BID_N_SIZE_EMPTY);
-                  elementList.emplace_back(std::move(element));
-                }
-                int askIndex = 0;
-                for (auto iter = snapshotAsk.begin(); iter != snapshotAsk.end(); iter++) {
-                  if (askIndex < maxMarketDepth) {
-                    Element element;
-                    element.insert(CCAPI_BEST_ASK_N_PRICE, iter->first.toString());
-                    element.insert(CCAPI_BEST_ASK_N_SIZE, iter->second);
-                    elementList.emplace_back(std::move(element));
-                  }
-                  ++askIndex;
-                }
-                if (snapshotAsk.empty()) {
-                  Element element;
-                  element.insert(CCAPI_BEST_ASK_N_PRICE, CCAPI_BEST_ASK_N_PRICE_EMPTY);
-                  element.insert(CCAPI_BEST_ASK_N_SIZE, CCAPI_BEST_ASK_N_SIZE_EMPTY);
-                  elementList.emplace_back(std::move(element));
+                if (that->shouldUseOrderBookPriceLadder()) {
+                  PriceLadder& snapshotBid = that->getSnapshotPriceLadder(true, subscriptionState);
+                  PriceLadder& snapshotAsk = that->getSnapshotPriceLadder(false, subscriptionState);
+                  that->buildOrderBookInitialSnapshot(wsConnection, exchangeSubscriptionId, versionId, document, typedOptions, snapshotBid, snapshotAsk,
+                                                      elementList);
+                } else {
+                  that->buildOrderBookInitialSnapshot(wsConnection, exchangeSubscriptionId, versionId, document, typedOptions, subscriptionState.snapshotBid,
+                                                      subscriptionState.snapshotAsk, elementList);
                 }
                 std::vector<Message> messageList;
                 Message message;
@@ -1907,7 +2188,7 @@ class MarketDataService : public Service {
                 messageList.emplace_back(std::move(message));
                 event.addMessages(messageList);
                 that->eventHandler(event, nullptr);
-                that->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+                subscriptionState.processedInitialSnapshot = true;
               } else {
                 that->buildOrderBookInitialOnFail(wsConnection, exchangeSubscriptionId, delayMilliseconds);
                 // if (delayMilliseconds > 0) {
@@ -1965,8 +2246,67 @@ class MarketDataService : public Service {
                                   Event& event, std::vector<MarketDataMessage>& marketDataMessageList) {}
 #endif
   virtual std::string calculateOrderBookChecksum(const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk) {
+    if (this->orderBookChecksumNumLevels > 0) {
+      return calculateOrderBookCrc32(snapshotBid, snapshotAsk, this->orderBookChecksumNumLevels, this->orderBookChecksumAskSizePrefix);
+    }
     return {};
   }
+  // exchanges can override these to calculate the checksum on the price ladders or small order books directly instead of on a copy
+  virtual std::string calculateOrderBookChecksum(const PriceLadder& snapshotBid, const PriceLadder& snapshotAsk) {
+    if (this->orderBookChecksumNumLevels > 0) {
+      return calculateOrderBookCrc32(snapshotBid, snapshotAsk, this->orderBookChecksumNumLevels, this->orderBookChecksumAskSizePrefix);
+    }
+    return this->calculateOrderBookChecksum(std::map<Decimal, std::string>(snapshotBid.begin(), snapshotBid.end()),
+                                            std::map<Decimal, std::string>(snapshotAsk.begin(), snapshotAsk.end()));
+  }
+  virtual std::string calculateOrderBookChecksum(const SmallOrderBook& snapshotBid, const SmallOrderBook& snapshotAsk) {
+    if (this->orderBookChecksumNumLevels > 0) {
+      return calculateOrderBookCrc32(snapshotBid, snapshotAsk, this->orderBookChecksumNumLevels, this->orderBookChecksumAskSizePrefix);
+    }
+    return this->calculateOrderBookChecksum(std::map<Decimal, std::string>(snapshotBid.begin(), snapshotBid.end()),
+                                            std::map<Decimal, std::string>(snapshotAsk.begin(), snapshotAsk.end()));
+  }
+  // the CRC-32 of "bidPrice:bidSize:askPrice:askSize:..." over the best numLevels levels of each side, the checksum text of okx, bitget, bitfinex (which
+  // prefixes ask sizes with askSizePrefix) and ftx, streamed into the accumulator without building the string, it only reads its arguments so that it can
+  // also run on a worker thread
+  template <typename T>
+  static std::string calculateOrderBookCrc32(const T& snapshotBid, const T& snapshotAsk, int numLevels, std::string_view askSizePrefix = {}) {
+    Crc32 crc32;
+    bool isFirst = true;
+    auto updateWithLevel = [&crc32, &isFirst](const Decimal& price, std::string_view sizePrefix, const std::string& size) {
+      if (!isFirst) {
+        crc32.update(':');
+      }
+      isFirst = false;
+      if (!price.sign) {
+        crc32.update('-');
+      }
+      char buffer[std::numeric_limits<unsigned long long>::digits10 + 1];
+      crc32.update(buffer, std::to_chars(buffer, buffer + sizeof(buffer), price.before).ptr - buffer);
+      if (!price.frac.empty()) {
+        crc32.update('.');
+        crc32.update(price.frac);
+      }
+      crc32.update(':');
+      crc32.update(sizePrefix);
+      crc32.update(size);
+    };
+    int i = 0;
+    auto i1 = snapshotBid.rbegin();
+    auto i2 = snapshotAsk.begin();
+    while (i < numLevels && (i1 != snapshotBid.rend() || i2 != snapshotAsk.end())) {
+      if (i1 != snapshotBid.rend()) {
+        updateWithLevel(i1->first, {}, i1->second);
+        ++i1;
+      }
+      if (i2 != snapshotAsk.end()) {
+        updateWithLevel(i2->first, askSizePrefix, i2->second);
+        ++i2;
+      }
+      ++i;
+    }
+    return intToHex(static_cast<uint_fast32_t>(crc32.getValue()));
+  }
   virtual std::vector<std::string> createSendStringList(const WsConnection& wsConnection) { return {}; }
   virtual void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                          const Subscription& subscription, const std::map<std::string, std::string> optionMap) {}
@@ -1974,31 +2314,22 @@ class MarketDataService : public Service {
                                               const std::map<std::string, std::string>& credential) {}
   virtual void extractOrderBookInitialVersionId(int64_t& versionId, const rj::Document& document) {}
   virtual void extractOrderBookInitialData(MarketDataMessage::TypeForData& input, const rj::Document& document) {}
-  std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> fieldByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<std::string, std::string>>>> optionMapByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, int>>> marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::vector<Subscription>>>> subscriptionListByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::vector<std::string>>>> correlationIdListByConnectionIdChannelIdSymbolIdMap;
+  std::map<std::string, std::map<std::string, std::map<std::string, SubscriptionState>>> subscriptionStateByConnectionIdChannelIdSymbolIdMap;
+  // resolved lazily from channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap, the pointers stay valid until the connection's states are cleared
+  std::map<std::string, std::unordered_map<std::string, SubscriptionState*>> subscriptionStateByConnectionIdExchangeSubscriptionIdMap;
+  std::map<std::string, std::vector<SubscriptionState*>> subscriptionStateListByConnectionIdMap;
+  std::map<std::string, std::unordered_map<size_t, int>> exchangeSubscriptionKeyByHashByConnectionIdMap;
   std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<Decimal, std::string>>>> snapshotBidByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<Decimal, std::string>>>> snapshotAskByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<Decimal, std::string>>>>
-      previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<Decimal, std::string>>>>
-      previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, bool>>> processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, bool>>> processedInitialTradeByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, bool>>> l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, TimePoint>>> previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, TimerPtr>>> conflateTimerMapByConnectionIdChannelIdSymbolIdMap;
   std::map<std::string, std::map<std::string, std::string>> orderBookChecksumByConnectionIdSymbolIdMap;
+  // the number of levels of each side covered by the exchange's checksum, see calculateOrderBookCrc32, 0 if the exchange calculates it by itself
+  int orderBookChecksumNumLevels{};
+  std::string orderBookChecksumAskSizePrefix;
+#ifndef CCAPI_LEGACY_USE_WEBSOCKETPP
+  std::unique_ptr<net::thread_pool> orderBookChecksumThreadPoolPtr;
+#endif
   bool shouldAlignSnapshot{};
   std::map<std::string, std::map<std::string, Subscription::Status>> subscriptionStatusByInstrumentGroupInstrumentMap;
   std::map<std::string, std::string> instrumentGroupByWsConnectionIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> openByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, Decimal>>> highByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, Decimal>>> lowByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> closeByConnectionIdChannelIdSymbolIdMap;
   std::string getRecentTradesTarget;
   std::string getHistoricalTradesTarget;
   std::string getRecentCandlesticksTarget;
@@ -2010,8 +2341,7 @@ class MarketDataService : public Service {
   std::map<std::string, std::map<int, std::vector<std::string>>> exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap;
   // only needed for generic public subscription
   std::map<std::string, std::string> correlationIdByConnectionIdMap;
-  std::map<std::string, std::map<std::string, std::map<int64_t, MarketDataMessage::TypeForData>>>
-      marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap;
+  std::map<std::string, std::map<std::string, std::map<int64_t, MarketDataMessage>>> marketDataMessageBufferByConnectionIdExchangeSubscriptionIdVersionIdMap;
   std::map<std::string, std::map<std::string, int64_t>> orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap;
   std::map<std::string, std::map<std::string, TimerPtr>> fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap;
 };
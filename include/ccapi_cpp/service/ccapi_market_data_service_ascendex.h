@@ -9,6 +9,7 @@ class MarketDataServiceAscendex : public MarketDataService {
   MarketDataServiceAscendex(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                             ServiceContext* serviceContextPtr)
       : MarketDataService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodySuccessConditionList = {JsonScanner::hasKeyValue("code", "0")};
     this->exchangeName = CCAPI_EXCHANGE_NAME_ASCENDEX;
     this->baseUrlWs = sessionConfigs.getUrlWebsocketBase().at(this->exchangeName) + "/api/pro/v1/stream";
     this->baseUrlRest = sessionConfigs.getUrlRestBase().at(this->exchangeName);
@@ -36,16 +37,15 @@ class MarketDataServiceAscendex : public MarketDataService {
 
  private:
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return body.find(R"("code":0)") == std::string::npos; }
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
     if (field == CCAPI_MARKET_DEPTH) {
       if (marketDepthRequested == 1) {
         channelId = CCAPI_WEBSOCKET_ASCENDEX_CHANNEL_BBO;
       }
     } else if (field == CCAPI_CANDLESTICK) {
-      std::string interval = std::to_string(std::stoi(optionMap.at(CCAPI_CANDLESTICK_INTERVAL_SECONDS)) / 60);
+      std::string interval = std::to_string(subscription.getTypedOptions().candlestickIntervalSeconds / 60);
       channelId += ":" + interval;
     }
   }
@@ -56,16 +56,16 @@ class MarketDataServiceAscendex : public MarketDataService {
 #endif
   std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
         rj::Document document;
         document.SetObject();
         rj::Document::AllocatorType& allocator = document.GetAllocator();
         document.AddMember("op", rj::Value("sub").Move(), allocator);
-        std::string symbolId = subscriptionListBySymbolId.first;
+        std::string symbolId = subscriptionStateBySymbolId.first;
         if (channelId == CCAPI_WEBSOCKET_ASCENDEX_CHANNEL_BBO) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
         }
         std::string exchangeSubscriptionId = channelId + ":" + symbolId;
         this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
@@ -100,11 +100,12 @@ class MarketDataServiceAscendex : public MarketDataService {
       std::string channelId = m == "depth-snapshot" ? CCAPI_WEBSOCKET_ASCENDEX_CHANNEL_DEPTH : m;
       std::string symbolId = document["symbol"].GetString();
       std::string exchangeSubscriptionId = channelId + ":" + symbolId;
+      const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
       const rj::Value& data = document["data"];
       MarketDataMessage marketDataMessage;
       marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
       if (m == "bbo") {
-        if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+        if (subscriptionState.processedInitialSnapshot) {
           marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
         } else {
           marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
@@ -115,6 +116,7 @@ class MarketDataServiceAscendex : public MarketDataService {
         marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
       }
       marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+      marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
       marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(data["ts"].GetString())));
       if (m == "bbo") {
         {
@@ -148,12 +150,14 @@ class MarketDataServiceAscendex : public MarketDataService {
       std::string channelId = m;
       std::string symbolId = document["symbol"].GetString();
       std::string exchangeSubscriptionId = channelId + ":" + symbolId;
+      const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
       const rj::Value& data = document["data"];
       for (const auto& x : data.GetArray()) {
         MarketDataMessage marketDataMessage;
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
         marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
         marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+        marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
         marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(x["ts"].GetString())));
         MarketDataMessage::TypeForDataPoint dataPoint;
         dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(std::string(x["p"].GetString()))});
@@ -168,10 +172,12 @@ class MarketDataServiceAscendex : public MarketDataService {
       const rj::Value& data = document["data"];
       std::string symbolId = document["s"].GetString();
       std::string exchangeSubscriptionId = channelId + ":" + std::string(data["i"].GetString()) + ":" + symbolId;
+      const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
       MarketDataMessage marketDataMessage;
       marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK;
       marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
       marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+      marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
       marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(data["ts"].GetString())));
       MarketDataMessage::TypeForDataPoint dataPoint;
       dataPoint.insert({MarketDataMessage::DataFieldType::OPEN_PRICE, data["o"].GetString()});
@@ -201,13 +207,13 @@ class MarketDataServiceAscendex : public MarketDataService {
       Message message;
       message.setTimeReceived(timeReceived);
       std::vector<std::string> correlationIdList;
-      if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
-        if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-            this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-          if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-              this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+      if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
+        if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+            this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+          if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
             std::vector<std::string> correlationIdList_2 =
-                this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
             correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
           }
         }
@@ -35,8 +35,8 @@ class MarketDataServiceBinanceBase : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-    auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
+    auto conflateIntervalMilliseconds = subscription.getTypedOptions().conflateIntervalMilliseconds;
     if (field == CCAPI_MARKET_DEPTH) {
       if (marketDepthRequested == 1) {
         channelId = CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_BOOK_TICKER;
@@ -51,11 +51,12 @@ class MarketDataServiceBinanceBase : public MarketDataService {
         if (!updateSpeed.empty()) {
           channelId += "&UPDATE_SPEED=" + updateSpeed;
         }
-        this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
+        this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange =
+            marketDepthSubscribedToExchange;
       }
     } else if (field == CCAPI_CANDLESTICK) {
       std::string interval =
-          this->convertCandlestickIntervalSecondsToInterval(std::stoi(optionMap.at(CCAPI_CANDLESTICK_INTERVAL_SECONDS)), "s", "m", "h", "d", "w");
+          this->convertCandlestickIntervalSecondsToInterval(subscription.getTypedOptions().candlestickIntervalSeconds, "s", "m", "h", "d", "w");
       channelId = channelId + "_" + interval;
     }
   }
@@ -67,18 +68,18 @@ class MarketDataServiceBinanceBase : public MarketDataService {
     document.AddMember("method", rj::Value("SUBSCRIBE").Move(), allocator);
     rj::Value params(rj::kArrayType);
     std::vector<std::string> exchangeSubscriptionIdList;
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListByInstrument : subscriptionListByChannelIdSymbolId.second) {
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      for (const auto& subscriptionListByInstrument : subscriptionStateByChannelIdSymbolId.second) {
         auto symbolId = subscriptionListByInstrument.first;
         auto exchangeSubscriptionId = UtilString::toLower(subscriptionListByInstrument.first) + "@";
         if (channelId.rfind(CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_BOOK_TICKER, 0) == 0) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
           exchangeSubscriptionId += CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_BOOK_TICKER;
         } else if (channelId.rfind(CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_PARTIAL_BOOK_DEPTH, 0) == 0) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
           int marketDepthSubscribedToExchange =
-              this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).marketDepthSubscribedToExchange;
           exchangeSubscriptionId += std::string(CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_PARTIAL_BOOK_DEPTH) + std::to_string(marketDepthSubscribedToExchange);
           auto splitted = UtilString::split(channelId, "?");
           if (splitted.size() == 2) {
@@ -129,7 +130,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
       Message message;
       message.setTimeReceived(timeReceived);
       std::vector<std::string> correlationIdList;
-      if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+      if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
         int id = std::stoi(document["id"].GetString());
         if (this->exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap.find(wsConnection.id) !=
                 this->exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap.end() &&
@@ -138,12 +139,12 @@ class MarketDataServiceBinanceBase : public MarketDataService {
           for (const auto& exchangeSubscriptionId : this->exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap.at(wsConnection.id).at(id)) {
             std::string channelId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID];
             std::string symbolId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_SYMBOL_ID];
-            if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-                this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-              if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                  this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+            if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+                this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+              if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                  this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
                 std::vector<std::string> correlationIdList_2 =
-                    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                    this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
                 correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
               }
             }
@@ -160,17 +161,16 @@ class MarketDataServiceBinanceBase : public MarketDataService {
     } else if (document.IsObject() && document.HasMember("stream") && document.HasMember("data")) {
       MarketDataMessage marketDataMessage;
       std::string exchangeSubscriptionId = document["stream"].GetString();
-      std::string channelId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID];
-      std::string symbolId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_SYMBOL_ID];
-      auto optionMap = this->optionMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
+      const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
+      const std::string& channelId = subscriptionState.channelId;
+      const auto& typedOptions = subscriptionState.typedOptions;
       const rj::Value& data = document["data"];
       if (channelId == CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_BOOK_TICKER) {
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-        marketDataMessage.recapType = this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]
-                                          ? MarketDataMessage::RecapType::NONE
-                                          : MarketDataMessage::RecapType::SOLICITED;
+        marketDataMessage.recapType = subscriptionState.processedInitialSnapshot ? MarketDataMessage::RecapType::NONE : MarketDataMessage::RecapType::SOLICITED;
         marketDataMessage.tp = this->isDerivatives ? TimePoint(std::chrono::milliseconds(std::stoll(data["T"].GetString()))) : timeReceived;
         marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+        marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
         {
           MarketDataMessage::TypeForDataPoint dataPoint;
           dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(data["b"].GetString())});
@@ -186,14 +186,13 @@ class MarketDataServiceBinanceBase : public MarketDataService {
         marketDataMessageList.emplace_back(std::move(marketDataMessage));
       } else if (channelId.rfind(CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_PARTIAL_BOOK_DEPTH, 0) == 0) {
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-        marketDataMessage.recapType = this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]
-                                          ? MarketDataMessage::RecapType::NONE
-                                          : MarketDataMessage::RecapType::SOLICITED;
+        marketDataMessage.recapType = subscriptionState.processedInitialSnapshot ? MarketDataMessage::RecapType::NONE : MarketDataMessage::RecapType::SOLICITED;
         marketDataMessage.tp = this->isDerivatives ? TimePoint(std::chrono::milliseconds(std::stoll(data["T"].GetString()))) : timeReceived;
         marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+        marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
         const char* bidsName = this->isDerivatives ? "b" : "bids";
         int bidIndex = 0;
-        int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+        int maxMarketDepth = typedOptions.marketDepthMax;
         for (const auto& x : data[bidsName].GetArray()) {
           if (bidIndex >= maxMarketDepth) {
             break;
@@ -221,6 +220,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
         MarketDataMessage marketDataMessage;
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
         marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+        marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
         marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(std::stoll(data["T"].GetString()));
         marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
         MarketDataMessage::TypeForDataPoint dataPoint;
@@ -235,6 +235,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
         MarketDataMessage marketDataMessage;
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_AGG_TRADE;
         marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+        marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
         marketDataMessage.tp = time;
         marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
         MarketDataMessage::TypeForDataPoint dataPoint;
@@ -251,6 +252,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
         const rj::Value& k = data["k"];
         marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(k["t"].GetString())));
         marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+        marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
         MarketDataMessage::TypeForDataPoint dataPoint;
         dataPoint.insert({MarketDataMessage::DataFieldType::OPEN_PRICE, k["o"].GetString()});
         dataPoint.insert({MarketDataMessage::DataFieldType::HIGH_PRICE, k["h"].GetString()});
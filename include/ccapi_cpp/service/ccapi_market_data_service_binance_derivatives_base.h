@@ -18,8 +18,8 @@ class MarketDataServiceBinanceDerivativesBase : public MarketDataServiceBinanceB
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-    auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
+    auto conflateIntervalMilliseconds = subscription.getTypedOptions().conflateIntervalMilliseconds;
     if (field == CCAPI_MARKET_DEPTH) {
       int marketDepthSubscribedToExchange = 1;
       marketDepthSubscribedToExchange = this->calculateMarketDepthAllowedByExchange(marketDepthRequested, std::vector<int>({1, 5, 10, 20}));
@@ -36,11 +36,12 @@ class MarketDataServiceBinanceDerivativesBase : public MarketDataServiceBinanceB
         if (!updateSpeed.empty()) {
           channelId += "&UPDATE_SPEED=" + updateSpeed;
         }
-        this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
+        this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange =
+            marketDepthSubscribedToExchange;
       }
     } else if (field == CCAPI_CANDLESTICK) {
       std::string interval =
-          this->convertCandlestickIntervalSecondsToInterval(std::stoi(optionMap.at(CCAPI_CANDLESTICK_INTERVAL_SECONDS)), "s", "m", "h", "d", "w");
+          this->convertCandlestickIntervalSecondsToInterval(subscription.getTypedOptions().candlestickIntervalSeconds, "s", "m", "h", "d", "w");
       channelId = channelId + "_" + interval;
     }
   }
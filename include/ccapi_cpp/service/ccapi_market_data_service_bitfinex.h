@@ -9,6 +9,8 @@ class MarketDataServiceBitfinex : public MarketDataService {
   MarketDataServiceBitfinex(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                             ServiceContext* serviceContextPtr)
       : MarketDataService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->orderBookChecksumNumLevels = 25;
+    this->orderBookChecksumAskSizePrefix = "-";
     this->exchangeName = CCAPI_EXCHANGE_NAME_BITFINEX;
     this->baseUrlWs = std::string(CCAPI_BITFINEX_PUBLIC_URL_WS_BASE) + "/ws/2";
     this->baseUrlRest = CCAPI_BITFINEX_PUBLIC_URL_REST_BASE;
@@ -171,16 +173,17 @@ class MarketDataServiceBitfinex : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-    auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
+    auto conflateIntervalMilliseconds = subscription.getTypedOptions().conflateIntervalMilliseconds;
     if (field == CCAPI_MARKET_DEPTH) {
       int marketDepthSubscribedToExchange = 1;
       marketDepthSubscribedToExchange = this->calculateMarketDepthAllowedByExchange(marketDepthRequested, std::vector<int>({1, 25, 100, 250}));
       channelId += std::string("?") + CCAPI_MARKET_DEPTH_SUBSCRIBED_TO_EXCHANGE + "=" + std::to_string(marketDepthSubscribedToExchange);
-      this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
+      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange =
+          marketDepthSubscribedToExchange;
     } else if (field == CCAPI_CANDLESTICK) {
       std::string interval =
-          this->convertCandlestickIntervalSecondsToInterval(std::stoi(optionMap.at(CCAPI_CANDLESTICK_INTERVAL_SECONDS)), "", "m", "h", "D", "W");
+          this->convertCandlestickIntervalSecondsToInterval(subscription.getTypedOptions().candlestickIntervalSeconds, "", "m", "h", "D", "W");
       channelId = std::string(CCAPI_WEBSOCKET_BITFINEX_CHANNEL_CANDLES) + ":" + interval;
     }
   }
@@ -202,8 +205,9 @@ class MarketDataServiceBitfinex : public MarketDataService {
           }
         }
       } else {
-        auto channelId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
-        auto symbolId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
+        const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
+        const std::string& channelId = subscriptionState.channelId;
+        const std::string& symbolId = subscriptionState.symbolId;
         if (channelId.rfind(CCAPI_WEBSOCKET_BITFINEX_CHANNEL_BOOKS, 0) == 0 || channelId == CCAPI_WEBSOCKET_BITFINEX_CHANNEL_TRADES ||
             channelId.rfind(CCAPI_WEBSOCKET_BITFINEX_CHANNEL_CANDLES, 0) == 0) {
           std::string channel;
@@ -232,6 +236,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
                 MarketDataMessage marketDataMessage;
                 marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
                 marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+                marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
                 marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
                 marketDataMessage.tp = timeReceived;
                 for (const auto& x : content.GetArray()) {
@@ -263,6 +268,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
                   MarketDataMessage marketDataMessage;
                   marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
                   marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+                  marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
                   marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
                   std::string timestampInMilliseconds = x[1].GetString();
                   timestampInMilliseconds.insert(timestampInMilliseconds.size() - 3, ".");
@@ -281,6 +287,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
                   MarketDataMessage marketDataMessage;
                   marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK;
                   marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+                  marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
                   marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
                   std::string timestampInMilliseconds = x[0].GetString();
                   timestampInMilliseconds.insert(timestampInMilliseconds.size() - 3, ".");
@@ -301,6 +308,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
                 MarketDataMessage marketDataMessage;
                 marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK;
                 marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+                marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
                 marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
                 std::string timestampInMilliseconds = x[0].GetString();
                 timestampInMilliseconds.insert(timestampInMilliseconds.size() - 3, ".");
@@ -360,6 +368,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
                 MarketDataMessage marketDataMessage;
                 marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
                 marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+                marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
                 marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
                 std::string timestampInMilliseconds = x[1].GetString();
                 timestampInMilliseconds.insert(timestampInMilliseconds.size() - 3, ".");
@@ -393,6 +402,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
               timestampInMilliseconds.insert(timestampInMilliseconds.size() - 3, ".");
               marketDataMessage.tp = UtilTime::makeTimePoint(UtilTime::divide(timestampInMilliseconds));
               marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+              marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
               marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
               std::swap(marketDataMessage.data,
                         this->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId]);
@@ -405,8 +415,8 @@ class MarketDataServiceBitfinex : public MarketDataService {
       std::string eventStr = document["event"].GetString();
       if (eventStr == "conf") {
         std::vector<std::string> sendStringList;
-        for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-          auto channelId = subscriptionListByChannelIdSymbolId.first;
+        for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+          auto channelId = subscriptionStateByChannelIdSymbolId.first;
           if (channelId.rfind(CCAPI_WEBSOCKET_BITFINEX_CHANNEL_BOOKS, 0) == 0 || channelId == CCAPI_WEBSOCKET_BITFINEX_CHANNEL_TRADES ||
               channelId.rfind(CCAPI_WEBSOCKET_BITFINEX_CHANNEL_CANDLES, 0) == 0) {
             std::string channel;
@@ -417,13 +427,13 @@ class MarketDataServiceBitfinex : public MarketDataService {
             } else if (channelId.rfind(CCAPI_WEBSOCKET_BITFINEX_CHANNEL_CANDLES, 0) == 0) {
               channel = CCAPI_WEBSOCKET_BITFINEX_CHANNEL_CANDLES;
             }
-            for (auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
+            for (auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
               rj::Document document;
               document.SetObject();
               rj::Document::AllocatorType& allocator = document.GetAllocator();
               document.AddMember("event", rj::Value("subscribe").Move(), allocator);
               document.AddMember("channel", rj::Value(channel.c_str(), allocator).Move(), allocator);
-              auto symbolId = subscriptionListBySymbolId.first;
+              auto symbolId = subscriptionStateBySymbolId.first;
               if (channelId.rfind(CCAPI_WEBSOCKET_BITFINEX_CHANNEL_CANDLES, 0) == 0) {
                 auto splitted = UtilString::split(channelId, ':');
                 document.AddMember("key", rj::Value(("trade:" + splitted.at(1) + ":" + symbolId).c_str(), allocator).Move(), allocator);
@@ -433,14 +443,8 @@ class MarketDataServiceBitfinex : public MarketDataService {
               if (channel == CCAPI_WEBSOCKET_BITFINEX_CHANNEL_BOOKS) {
                 document.AddMember("prec", rj::Value("P0").Move(), allocator);
                 document.AddMember("freq", rj::Value("F0").Move(), allocator);
-                document.AddMember(
-                    "len",
-                    rj::Value(
-                        std::to_string(this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId))
-                            .c_str(),
-                        allocator)
-                        .Move(),
-                    allocator);
+                const auto& subscriptionState = this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                document.AddMember("len", rj::Value(std::to_string(subscriptionState.marketDepthSubscribedToExchange).c_str(), allocator).Move(), allocator);
               }
               rj::StringBuffer stringBuffer;
               rj::Writer<rj::StringBuffer> writer(stringBuffer);
@@ -484,14 +488,14 @@ class MarketDataServiceBitfinex : public MarketDataService {
         Message message;
         message.setTimeReceived(timeReceived);
         std::vector<std::string> correlationIdList;
-        if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-            this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
-          if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-              this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-            if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+        if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+            this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
+          if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+            if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
               std::vector<std::string> correlationIdList_2 =
-                  this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                  this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
               correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
             }
           }
@@ -506,28 +510,6 @@ class MarketDataServiceBitfinex : public MarketDataService {
       }
     }
   }
-  std::string calculateOrderBookChecksum(const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk) override {
-    auto i = 0;
-    auto i1 = snapshotBid.rbegin();
-    auto i2 = snapshotAsk.begin();
-    std::vector<std::string> csData;
-    while (i < 25 && (i1 != snapshotBid.rend() || i2 != snapshotAsk.end())) {
-      if (i1 != snapshotBid.rend()) {
-        csData.push_back(i1->first.toString());
-        csData.push_back(i1->second);
-        ++i1;
-      }
-      if (i2 != snapshotAsk.end()) {
-        csData.push_back(i2->first.toString());
-        csData.push_back("-" + i2->second);
-        ++i2;
-      }
-      ++i;
-    }
-    std::string csStr = UtilString::join(csData, ":");
-    uint_fast32_t csCalc = UtilAlgorithm::crc(csStr.begin(), csStr.end());
-    return intToHex(csCalc);
-  }
   void convertRequestForRest(http::request<http::string_body>& req, const Request& request, const TimePoint& now, const std::string& symbolId,
                              const std::map<std::string, std::string>& credential) override {
     switch (request.getOperation()) {
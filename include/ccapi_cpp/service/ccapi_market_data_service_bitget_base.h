@@ -9,6 +9,8 @@ class MarketDataServiceBitgetBase : public MarketDataService {
   MarketDataServiceBitgetBase(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                               ServiceContext* serviceContextPtr)
       : MarketDataService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodySuccessConditionList = {JsonScanner::hasKeyValue("code", "\"00000\"")};
+    this->orderBookChecksumNumLevels = 25;
     this->hostHttpHeaderValueIgnorePort = true;
   }
   virtual ~MarketDataServiceBitgetBase() {}
@@ -16,11 +18,10 @@ class MarketDataServiceBitgetBase : public MarketDataService {
 
  protected:
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*\"00000\"")); }
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-    auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
+    auto conflateIntervalMilliseconds = subscription.getTypedOptions().conflateIntervalMilliseconds;
     if (this->isDerivatives) this->instrumentType = subscription.getInstrumentType();
     if (field == CCAPI_MARKET_DEPTH) {
       if (conflateIntervalMilliseconds < 200 && this->isDerivatives) {
@@ -38,7 +39,7 @@ class MarketDataServiceBitgetBase : public MarketDataService {
       }
     } else if (field == CCAPI_CANDLESTICK) {
       std::string interval =
-          this->convertCandlestickIntervalSecondsToInterval(std::stoi(optionMap.at(CCAPI_CANDLESTICK_INTERVAL_SECONDS)), " ", "m", "H", "D", "W");
+          this->convertCandlestickIntervalSecondsToInterval(subscription.getTypedOptions().candlestickIntervalSeconds, " ", "m", "H", "D", "W");
       channelId = channelId + interval;
     }
   }
@@ -54,13 +55,13 @@ class MarketDataServiceBitgetBase : public MarketDataService {
     rj::Document::AllocatorType& allocator = document.GetAllocator();
     document.AddMember("op", rj::Value("subscribe").Move(), allocator);
     rj::Value args(rj::kArrayType);
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        std::string symbolId = subscriptionListBySymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        std::string symbolId = subscriptionStateBySymbolId.first;
         if (channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS1 || channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS5 ||
             channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS15) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
         }
         std::string exchangeSubscriptionId = UtilString::split(channelId, "?").at(0) + ":" + symbolId;
         rj::Value arg(rj::kObjectType);
@@ -81,28 +82,6 @@ class MarketDataServiceBitgetBase : public MarketDataService {
     sendStringList.push_back(sendString);
     return sendStringList;
   }
-  std::string calculateOrderBookChecksum(const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk) override {
-    auto i = 0;
-    auto i1 = snapshotBid.rbegin();
-    auto i2 = snapshotAsk.begin();
-    std::vector<std::string> csData;
-    while (i < 25 && (i1 != snapshotBid.rend() || i2 != snapshotAsk.end())) {
-      if (i1 != snapshotBid.rend()) {
-        csData.push_back(toString(i1->first));
-        csData.push_back(i1->second);
-        ++i1;
-      }
-      if (i2 != snapshotAsk.end()) {
-        csData.push_back(toString(i2->first));
-        csData.push_back(i2->second);
-        ++i2;
-      }
-      ++i;
-    }
-    std::string csStr = UtilString::join(csData, ":");
-    uint_fast32_t csCalc = UtilAlgorithm::crc(csStr.begin(), csStr.end());
-    return intToHex(csCalc);
-  }
   void processTextMessage(
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
       WsConnection& wsConnection, wspp::connection_hdl hdl, const std::string& textMessage
@@ -131,17 +110,17 @@ class MarketDataServiceBitgetBase : public MarketDataService {
           Message message;
           message.setTimeReceived(timeReceived);
           std::vector<std::string> correlationIdList;
-          if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-              this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+          if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
             const rj::Value& arg = document["arg"];
             std::string channelId = arg["channel"].GetString();
             std::string symbolId = arg["instId"].GetString();
-            if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-                this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-              if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                  this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+            if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+                this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+              if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                  this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
                 std::vector<std::string> correlationIdList_2 =
-                    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                    this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
                 correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
               }
             }
@@ -170,6 +149,7 @@ class MarketDataServiceBitgetBase : public MarketDataService {
         std::string channelId = arg["channel"].GetString();
         std::string symbolId = arg["instId"].GetString();
         std::string exchangeSubscriptionId = channelId + ":" + symbolId;
+        const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
         if (channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS || channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS1 ||
             channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS5 || channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS15) {
           std::string action = document["action"].GetString();
@@ -184,10 +164,11 @@ class MarketDataServiceBitgetBase : public MarketDataService {
             MarketDataMessage marketDataMessage;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum["ts"].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
             if (channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS1 || channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS5 ||
                 channelId == CCAPI_WEBSOCKET_BITGET_BASE_CHANNEL_BOOKS15) {
-              if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+              if (subscriptionState.processedInitialSnapshot) {
                 marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
               } else {
                 marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
@@ -228,6 +209,7 @@ class MarketDataServiceBitgetBase : public MarketDataService {
             marketDataMessage.recapType = recapType;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum["ts"].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             MarketDataMessage::TypeForDataPoint dataPoint;
             dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(datum["price"].GetString())});
             dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, UtilString::normalizeDecimalString(datum["size"].GetString())});
@@ -243,6 +225,7 @@ class MarketDataServiceBitgetBase : public MarketDataService {
             marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum[0].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             MarketDataMessage::TypeForDataPoint dataPoint;
             dataPoint.insert({MarketDataMessage::DataFieldType::OPEN_PRICE, datum[1].GetString()});
             dataPoint.insert({MarketDataMessage::DataFieldType::HIGH_PRICE, datum[2].GetString()});
@@ -9,6 +9,7 @@ class MarketDataServiceBitmart : public MarketDataService {
   MarketDataServiceBitmart(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                            ServiceContext* serviceContextPtr)
       : MarketDataService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodySuccessConditionList = {JsonScanner::hasKeyValue("code", "1000")};
     this->exchangeName = CCAPI_EXCHANGE_NAME_BITMART;
     this->baseUrlWs = sessionConfigs.getUrlWebsocketBase().at(this->exchangeName) + "/api?protocol=1.1";
     this->baseUrlRest = sessionConfigs.getUrlRestBase().at(this->exchangeName);
@@ -41,7 +42,7 @@ class MarketDataServiceBitmart : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
     if (field == CCAPI_MARKET_DEPTH) {
       if (marketDepthRequested <= 5) {
         channelId = CCAPI_WEBSOCKET_BITMART_CHANNEL_PUBLIC_DEPTH5;
@@ -54,19 +55,9 @@ class MarketDataServiceBitmart : public MarketDataService {
   }
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
   void pingOnApplicationLevel(wspp::connection_hdl hdl, ErrorCode& ec) override { this->send(hdl, "ping", wspp::frame::opcode::text, ec); }
-  void onClose(wspp::connection_hdl hdl) override {
-    WsConnection& wsConnection = this->getWsConnectionFromConnectionPtr(this->serviceContextPtr->tlsClientPtr->get_con_from_hdl(hdl));
-    this->subscriptionStartedByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    MarketDataService::onClose(hdl);
-  }
 #else
   void pingOnApplicationLevel(std::shared_ptr<WsConnection> wsConnectionPtr, ErrorCode& ec) override { this->send(wsConnectionPtr, "ping", ec); }
-  void onClose(std::shared_ptr<WsConnection> wsConnectionPtr, ErrorCode ec) override {
-    this->subscriptionStartedByConnectionIdChannelIdSymbolIdMap.erase(wsConnectionPtr->id);
-    MarketDataService::onClose(wsConnectionPtr, ec);
-  }
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*1000")); }
   std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
     rj::Document document;
@@ -74,13 +65,13 @@ class MarketDataServiceBitmart : public MarketDataService {
     rj::Document::AllocatorType& allocator = document.GetAllocator();
     document.AddMember("op", rj::Value("subscribe").Move(), allocator);
     rj::Value args(rj::kArrayType);
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        std::string symbolId = subscriptionListBySymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        std::string symbolId = subscriptionStateBySymbolId.first;
         if (channelId == CCAPI_WEBSOCKET_BITMART_CHANNEL_PUBLIC_DEPTH5 || channelId == CCAPI_WEBSOCKET_BITMART_CHANNEL_PUBLIC_DEPTH20 ||
             channelId == CCAPI_WEBSOCKET_BITMART_CHANNEL_PUBLIC_DEPTH50) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
         }
         std::string exchangeSubscriptionId = UtilString::split(channelId, "?").at(0) + ":" + symbolId;
         args.PushBack(rj::Value(exchangeSubscriptionId.c_str(), allocator).Move(), allocator);
@@ -118,10 +109,10 @@ class MarketDataServiceBitmart : public MarketDataService {
         std::string channelId = document["table"].GetString();
         std::string symbolId = document["data"][0]["symbol"].GetString();
         std::string exchangeSubscriptionId = channelId + ":" + symbolId;
-        if (!this->subscriptionStartedByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
-          const auto& subscriptionList = this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+        SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
+        if (!subscriptionState.subscriptionStarted) {
           std::vector<std::string> correlationIdList;
-          for (const auto& subscription : subscriptionList) {
+          for (const auto& subscription : subscriptionState.subscriptionList) {
             correlationIdList.push_back(subscription.getCorrelationId());
           }
           Event event;
@@ -144,8 +135,9 @@ class MarketDataServiceBitmart : public MarketDataService {
             MarketDataMessage marketDataMessage;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum["ms_t"].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-            if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+            if (subscriptionState.processedInitialSnapshot) {
               marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
             } else {
               marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
@@ -166,7 +158,7 @@ class MarketDataServiceBitmart : public MarketDataService {
           }
         } else if (channelId == CCAPI_WEBSOCKET_BITMART_CHANNEL_TRADE) {
           MarketDataMessage::RecapType recapType = MarketDataMessage::RecapType::NONE;
-          if (!this->subscriptionStartedByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+          if (!subscriptionState.subscriptionStarted) {
             recapType = MarketDataMessage::RecapType::SOLICITED;
           }
           for (const auto& datum : document["data"].GetArray()) {
@@ -175,6 +167,7 @@ class MarketDataServiceBitmart : public MarketDataService {
             marketDataMessage.recapType = recapType;
             marketDataMessage.tp = TimePoint(std::chrono::seconds(std::stoll(datum["s_t"].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             MarketDataMessage::TypeForDataPoint dataPoint;
             dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(datum["price"].GetString())});
             dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, UtilString::normalizeDecimalString(datum["size"].GetString())});
@@ -183,9 +176,7 @@ class MarketDataServiceBitmart : public MarketDataService {
             marketDataMessageList.emplace_back(std::move(marketDataMessage));
           }
         }
-        if (!this->subscriptionStartedByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
-          this->subscriptionStartedByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
-        }
+        subscriptionState.subscriptionStarted = true;
       } else {
         std::string eventStr = document["event"].GetString();
         const auto& splitted = UtilString::split(eventStr, ':');
@@ -200,7 +191,8 @@ class MarketDataServiceBitmart : public MarketDataService {
           message.setElementList({element});
           const auto& channelId = splitted.at(1);
           const auto& symbolId = splitted.at(2);
-          const auto& subscriptionList = this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+          const auto& subscriptionList =
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).subscriptionList;
           std::vector<std::string> correlationIdList;
           for (const auto& subscription : subscriptionList) {
             correlationIdList.push_back(subscription.getCorrelationId());
@@ -339,7 +331,6 @@ class MarketDataServiceBitmart : public MarketDataService {
     return sendStringList;
   }
   std::string apiMemo;
-  std::map<std::string, std::map<std::string, std::map<std::string, bool>>> subscriptionStartedByConnectionIdChannelIdSymbolIdMap;
 };
 } /* namespace ccapi */
 #endif
@@ -39,9 +39,9 @@ class MarketDataServiceBitmex : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
     if (field == CCAPI_MARKET_DEPTH) {
-      if (optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS) == CCAPI_CONFLATE_INTERVAL_MILLISECONDS_DEFAULT) {
+      if (!subscription.getTypedOptions().shouldConflate()) {
         channelId = CCAPI_WEBSOCKET_BITMEX_CHANNEL_ORDER_BOOK_L2;
       } else {
         if (marketDepthRequested == 1) {
@@ -75,12 +75,12 @@ class MarketDataServiceBitmex : public MarketDataService {
     rj::Document::AllocatorType& allocator = document.GetAllocator();
     document.AddMember("op", rj::Value("subscribe").Move(), allocator);
     rj::Value args(rj::kArrayType);
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        std::string symbolId = subscriptionListBySymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        std::string symbolId = subscriptionStateBySymbolId.first;
         if (channelId == CCAPI_WEBSOCKET_BITMEX_CHANNEL_QUOTE || channelId == CCAPI_WEBSOCKET_BITMEX_CHANNEL_ORDER_BOOK_10) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
         }
         std::string exchangeSubscriptionId = channelId + ":" + symbolId;
         this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
@@ -240,18 +240,18 @@ class MarketDataServiceBitmex : public MarketDataService {
         Message message;
         message.setTimeReceived(timeReceived);
         std::vector<std::string> correlationIdList;
-        if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-            this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+        if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+            this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
           for (const auto& x : document["request"]["args"].GetArray()) {
             auto splitted = UtilString::split(x.GetString(), ":");
             std::string channelId = splitted.at(0);
             std::string symbolId = splitted.at(1);
-            if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-                this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-              if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                  this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+            if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+                this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+              if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                  this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
                 std::vector<std::string> correlationIdList_2 =
-                    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                    this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
                 correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
               }
             }
@@ -43,12 +43,12 @@ class MarketDataServiceCoinbase : public MarketDataService {
     rj::Document::AllocatorType& allocator = document.GetAllocator();
     document.AddMember("type", rj::Value("subscribe").Move(), allocator);
     rj::Value channels(rj::kArrayType);
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
       rj::Value channel(rj::kObjectType);
       rj::Value symbolIds(rj::kArrayType);
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        std::string symbolId = subscriptionListBySymbolId.first;
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        std::string symbolId = subscriptionStateBySymbolId.first;
         symbolIds.PushBack(rj::Value(symbolId.c_str(), allocator).Move(), allocator);
         std::string exchangeSubscriptionId = channelId + "|" + symbolId;
         this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
@@ -60,8 +60,8 @@ class MarketDataServiceCoinbase : public MarketDataService {
       rj::Value heartbeatChannel(rj::kObjectType);
       heartbeatChannel.AddMember("name", rj::Value("heartbeat").Move(), allocator);
       rj::Value heartbeatSymbolIds(rj::kArrayType);
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        heartbeatSymbolIds.PushBack(rj::Value(subscriptionListBySymbolId.first.c_str(), allocator).Move(), allocator);
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        heartbeatSymbolIds.PushBack(rj::Value(subscriptionStateBySymbolId.first.c_str(), allocator).Move(), allocator);
       }
       heartbeatChannel.AddMember("product_ids", heartbeatSymbolIds, allocator);
       channels.PushBack(heartbeatChannel, allocator);
@@ -155,17 +155,17 @@ class MarketDataServiceCoinbase : public MarketDataService {
       Message message;
       message.setTimeReceived(timeReceived);
       std::vector<std::string> correlationIdList;
-      if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+      if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
         for (const auto& x : document["channels"].GetArray()) {
           std::string channelId = x["name"].GetString();
-          if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-              this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+          if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
             for (const auto& y : x["product_ids"].GetArray()) {
               std::string symbolId = y.GetString();
-              if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                  this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+              if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                  this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
                 std::vector<std::string> correlationIdList_2 =
-                    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                    this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
                 correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
               }
             }
@@ -38,12 +38,13 @@ class MarketDataServiceCryptocom : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
     if (field == CCAPI_MARKET_DEPTH) {
       int marketDepthSubscribedToExchange = 1;
       marketDepthSubscribedToExchange = this->calculateMarketDepthAllowedByExchange(marketDepthRequested, std::vector<int>({10, 150}));
       channelId = CCAPI_WEBSOCKET_CRYPTOCOM_CHANNEL_BOOK;
-      this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
+      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange =
+          marketDepthSubscribedToExchange;
     }
   }
   std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
@@ -56,18 +57,18 @@ class MarketDataServiceCryptocom : public MarketDataService {
     document.AddMember("id", rj::Value(requestId).Move(), allocator);
     document.AddMember("method", rj::Value("subscribe").Move(), allocator);
     rj::Value channels(rj::kArrayType);
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        std::string symbolId = subscriptionListBySymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        std::string symbolId = subscriptionStateBySymbolId.first;
         if (channelId == CCAPI_WEBSOCKET_CRYPTOCOM_CHANNEL_BOOK) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
         }
         std::string exchangeSubscriptionId(channelId);
         std::map<std::string, std::string> replaceMap;
         if (channelId == CCAPI_WEBSOCKET_CRYPTOCOM_CHANNEL_BOOK) {
           int marketDepthSubscribedToExchange =
-              this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).marketDepthSubscribedToExchange;
           replaceMap = {
               {"{instrument_name}", symbolId},
               {"{depth}", std::to_string(marketDepthSubscribedToExchange)},
@@ -121,24 +122,23 @@ class MarketDataServiceCryptocom : public MarketDataService {
       const rj::Value& result = document["result"];
       if (method == "subscribe") {
         std::string exchangeSubscriptionId = result["subscription"].GetString();
-        const std::string& channelId =
-            this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
-        const std::string& symbolId =
-            this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
+        const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
+        const std::string& channelId = subscriptionState.channelId;
         if (channelId == CCAPI_WEBSOCKET_CRYPTOCOM_CHANNEL_BOOK) {
           for (const auto& datum : result["data"].GetArray()) {
             MarketDataMessage marketDataMessage;
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum["t"].GetString())));
             marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
             if (channelId == CCAPI_WEBSOCKET_CRYPTOCOM_CHANNEL_BOOK) {
-              if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+              if (subscriptionState.processedInitialSnapshot) {
                 marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
               } else {
                 marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
               }
-              auto optionMap = this->optionMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-              int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+              const auto& typedOptions = subscriptionState.typedOptions;
+              int maxMarketDepth = typedOptions.marketDepthMax;
               int bidIndex = 0;
               for (const auto& x : datum["bids"].GetArray()) {
                 if (bidIndex >= maxMarketDepth) {
@@ -168,6 +168,7 @@ class MarketDataServiceCryptocom : public MarketDataService {
           for (const auto& x : result["data"].GetArray()) {
             MarketDataMessage marketDataMessage;
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
             marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(x["t"].GetString())));
@@ -202,8 +203,8 @@ class MarketDataServiceCryptocom : public MarketDataService {
           Message message;
           message.setTimeReceived(timeReceived);
           std::vector<std::string> correlationIdList;
-          if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-              this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+          if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
             for (const auto& subscription : wsConnection.subscriptionList) {
               correlationIdList.push_back(subscription.getCorrelationId());
             }
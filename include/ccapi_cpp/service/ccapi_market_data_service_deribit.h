@@ -92,7 +92,7 @@ class MarketDataServiceDeribit : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
     if (field == CCAPI_MARKET_DEPTH) {
       if (marketDepthRequested == 1) {
         channelId = CCAPI_WEBSOCKET_DERIBIT_CHANNEL_QUOTE;
@@ -100,7 +100,8 @@ class MarketDataServiceDeribit : public MarketDataService {
         int marketDepthSubscribedToExchange = 1;
         marketDepthSubscribedToExchange = this->calculateMarketDepthAllowedByExchange(marketDepthRequested, std::vector<int>({10, 20}));
         channelId = CCAPI_WEBSOCKET_DERIBIT_CHANNEL_BOOK;
-        this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
+        this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange =
+            marketDepthSubscribedToExchange;
       } else {
         channelId = CCAPI_WEBSOCKET_DERIBIT_CHANNEL_BOOK_TBT;
       }
@@ -118,12 +119,12 @@ class MarketDataServiceDeribit : public MarketDataService {
     document.AddMember("id", rj::Value(requestId).Move(), allocator);
     this->subscriptionJsonrpcIdSetByConnectionIdMap[wsConnection.id].insert(requestId);
     rj::Value channels(rj::kArrayType);
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        std::string symbolId = subscriptionListBySymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        std::string symbolId = subscriptionStateBySymbolId.first;
         if (channelId == CCAPI_WEBSOCKET_DERIBIT_CHANNEL_QUOTE || channelId == CCAPI_WEBSOCKET_DERIBIT_CHANNEL_BOOK) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
         }
         std::string exchangeSubscriptionId(channelId);
         std::map<std::string, std::string> replaceMap;
@@ -133,7 +134,7 @@ class MarketDataServiceDeribit : public MarketDataService {
           };
         } else if (channelId == CCAPI_WEBSOCKET_DERIBIT_CHANNEL_BOOK) {
           int marketDepthSubscribedToExchange =
-              this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).marketDepthSubscribedToExchange;
           replaceMap = {
               {"{instrument_name}", symbolId},
               {"{group}", "none"},
@@ -194,25 +195,24 @@ class MarketDataServiceDeribit : public MarketDataService {
       const rj::Value& params = document["params"];
       if (method == "subscription") {
         std::string exchangeSubscriptionId = params["channel"].GetString();
-        const std::string& channelId =
-            this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
-        const std::string& symbolId =
-            this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
+        const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
+        const std::string& channelId = subscriptionState.channelId;
         const rj::Value& data = params["data"];
         if (channelId == CCAPI_WEBSOCKET_DERIBIT_CHANNEL_BOOK || channelId == CCAPI_WEBSOCKET_DERIBIT_CHANNEL_QUOTE ||
             channelId == CCAPI_WEBSOCKET_DERIBIT_CHANNEL_BOOK_TBT) {
           MarketDataMessage marketDataMessage;
           marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+          marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
           marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(data["timestamp"].GetString())));
           marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
           if (channelId == CCAPI_WEBSOCKET_DERIBIT_CHANNEL_BOOK) {
-            if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+            if (subscriptionState.processedInitialSnapshot) {
               marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
             } else {
               marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
             }
-            auto optionMap = this->optionMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-            int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+            const auto& typedOptions = subscriptionState.typedOptions;
+            int maxMarketDepth = typedOptions.marketDepthMax;
             int bidIndex = 0;
             for (const auto& x : data["bids"].GetArray()) {
               if (bidIndex >= maxMarketDepth) {
@@ -236,7 +236,7 @@ class MarketDataServiceDeribit : public MarketDataService {
               ++askIndex;
             }
           } else if (channelId == CCAPI_WEBSOCKET_DERIBIT_CHANNEL_QUOTE) {
-            if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+            if (subscriptionState.processedInitialSnapshot) {
               marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
             } else {
               marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
@@ -278,6 +278,7 @@ class MarketDataServiceDeribit : public MarketDataService {
           for (const auto& x : data.GetArray()) {
             MarketDataMessage marketDataMessage;
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
             marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(x["timestamp"].GetString())));
@@ -337,20 +338,20 @@ class MarketDataServiceDeribit : public MarketDataService {
             Message message;
             message.setTimeReceived(timeReceived);
             std::vector<std::string> correlationIdList;
-            if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-                this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+            if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+                this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
               for (const auto& x : document["result"].GetArray()) {
                 std::string exchangeSubscriptionId = x.GetString();
                 const std::string& channelId =
                     this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
                 const std::string& symbolId =
                     this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
-                if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-                    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-                  if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                      this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+                if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+                    this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+                  if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
                     std::vector<std::string> correlationIdList_2 =
-                        this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                        this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
                     correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
                   }
                 }
@@ -20,12 +20,12 @@ class MarketDataServiceErisx : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
     if (field == CCAPI_MARKET_DEPTH) {
       if (marketDepthRequested <= 20) {
         channelId = std::string(CCAPI_WEBSOCKET_ERISX_CHANNEL_TOP_OF_BOOK_MARKET_DATA_SUBSCRIBE) + "?" + CCAPI_MARKET_DEPTH_SUBSCRIBED_TO_EXCHANGE + "=" +
                     std::to_string(marketDepthRequested);
-        this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthRequested;
+        this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange = marketDepthRequested;
       } else {
         channelId += "|" + field;
       }
@@ -35,10 +35,10 @@ class MarketDataServiceErisx : public MarketDataService {
   }
   std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        std::string symbolId = subscriptionListBySymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        std::string symbolId = subscriptionStateBySymbolId.first;
         std::string exchangeSubscriptionId = std::to_string(this->exchangeJsonPayloadIdByConnectionIdMap[wsConnection.id]);
         this->exchangeJsonPayloadIdByConnectionIdMap[wsConnection.id] += 1;
         this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
@@ -56,7 +56,7 @@ class MarketDataServiceErisx : public MarketDataService {
         } else if (channelId.rfind(CCAPI_WEBSOCKET_ERISX_CHANNEL_TOP_OF_BOOK_MARKET_DATA_SUBSCRIBE, 0) == 0) {
           document.AddMember("type", rj::Value(CCAPI_WEBSOCKET_ERISX_CHANNEL_TOP_OF_BOOK_MARKET_DATA_SUBSCRIBE).Move(), allocator);
           int marketDepthSubscribedToExchange =
-              this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).marketDepthSubscribedToExchange;
           document.AddMember("topOfBookDepth", rj::Value(marketDepthSubscribedToExchange).Move(), allocator);
         }
         rj::StringBuffer stringBuffer;
@@ -86,8 +86,7 @@ class MarketDataServiceErisx : public MarketDataService {
     std::string type = document["type"].GetString();
     if (type == "MarketDataIncrementalRefresh" || type == "MarketDataIncrementalRefreshTrade") {
       std::string exchangeSubscriptionId = document["correlation"].GetString();
-      auto channelId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
-      auto symbolId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
+      const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
       MarketDataMessage::RecapType recapType;
       if (std::string(document["marketDataID"].GetString()) == "0") {
         recapType = MarketDataMessage::RecapType::SOLICITED;
@@ -99,6 +98,7 @@ class MarketDataServiceErisx : public MarketDataService {
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
         marketDataMessage.recapType = recapType;
         marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+        marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
         marketDataMessage.tp = UtilTime::parse(UtilTime::convertFIXTimeToISO(std::string(document["transactTime"].GetString())));
         for (const auto& side : {"bids", "offers"}) {
           for (const auto& x : document[side].GetArray()) {
@@ -118,6 +118,7 @@ class MarketDataServiceErisx : public MarketDataService {
           marketDataMessage.tp = UtilTime::parse(UtilTime::convertFIXTimeToISO(std::string(x["transactTime"].GetString())));
           marketDataMessage.recapType = recapType;
           marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+          marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
           MarketDataMessage::TypeForDataPoint dataPoint;
           dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(std::string(x["price"].GetString()))});
           dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, UtilString::normalizeDecimalString(std::string(x["size"].GetString()))});
@@ -129,16 +130,16 @@ class MarketDataServiceErisx : public MarketDataService {
       }
     } else if (type == "TopOfBookMarketData") {
       std::string exchangeSubscriptionId = document["correlation"].GetString();
-      auto channelId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
-      auto symbolId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_SYMBOL_ID);
+      const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
       MarketDataMessage marketDataMessage;
       marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-      if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+      if (subscriptionState.processedInitialSnapshot) {
         marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
       } else {
         marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
       }
       marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+      marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
       std::string latestFIXTime;
       for (const auto& side : {"bids", "offers"}) {
         for (const auto& x : document[side].GetArray()) {
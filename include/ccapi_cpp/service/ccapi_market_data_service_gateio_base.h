@@ -31,8 +31,8 @@ class MarketDataServiceGateioBase : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-    auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
+    auto conflateIntervalMilliseconds = subscription.getTypedOptions().conflateIntervalMilliseconds;
     if (field == CCAPI_MARKET_DEPTH) {
       if (marketDepthRequested == 1) {
         channelId = this->websocketChannelBookTicker;
@@ -53,19 +53,20 @@ class MarketDataServiceGateioBase : public MarketDataService {
         if (!updateSpeed.empty()) {
           channelId += "&UPDATE_SPEED=" + updateSpeed;
         }
-        this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
+        this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange =
+            marketDepthSubscribedToExchange;
       }
     } else if (field == CCAPI_CANDLESTICK) {
       std::string interval =
-          this->convertCandlestickIntervalSecondsToInterval(std::stoi(optionMap.at(CCAPI_CANDLESTICK_INTERVAL_SECONDS)), "s", "m", "h", "d", "w");
+          this->convertCandlestickIntervalSecondsToInterval(subscription.getTypedOptions().candlestickIntervalSeconds, "s", "m", "h", "d", "w");
       channelId = this->websocketChannelCandlesticks + interval;
     }
   }
   std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
     auto now = UtilTime::now();
     std::vector<std::string> sendStringList;
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
       if (channelId == this->websocketChannelBookTicker || channelId == this->websocketChannelTrades ||
           channelId.rfind(this->websocketChannelCandlesticks, 0) == 0) {
         std::vector<std::string> exchangeSubscriptionIdList;
@@ -80,10 +81,10 @@ class MarketDataServiceGateioBase : public MarketDataService {
         }
         document.AddMember("channel", rj::Value(channel.c_str(), allocator).Move(), allocator);
         rj::Value payload(rj::kArrayType);
-        for (const auto& subscriptionListByInstrument : subscriptionListByChannelIdSymbolId.second) {
+        for (const auto& subscriptionListByInstrument : subscriptionStateByChannelIdSymbolId.second) {
           auto symbolId = subscriptionListByInstrument.first;
           if (channelId == this->websocketChannelBookTicker) {
-            this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+            this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
           }
           if (channelId.rfind(this->websocketChannelCandlesticks, 0) == 0) {
             payload.PushBack(rj::Value(std::string(channelId.substr(this->websocketChannelCandlesticks.length())).c_str(), allocator).Move(), allocator);
@@ -107,11 +108,11 @@ class MarketDataServiceGateioBase : public MarketDataService {
         std::string sendString = stringBuffer.GetString();
         sendStringList.push_back(sendString);
       } else if (channelId.rfind(this->websocketChannelOrderBook, 0) == 0) {
-        for (const auto& subscriptionListByInstrument : subscriptionListByChannelIdSymbolId.second) {
+        for (const auto& subscriptionListByInstrument : subscriptionStateByChannelIdSymbolId.second) {
           auto symbolId = subscriptionListByInstrument.first;
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
           int marketDepthSubscribedToExchange =
-              this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).marketDepthSubscribedToExchange;
           rj::Document document;
           document.SetObject();
           rj::Document::AllocatorType& allocator = document.GetAllocator();
@@ -173,8 +174,8 @@ class MarketDataServiceGateioBase : public MarketDataService {
       message.setTimeReceived(timeReceived);
       std::vector<std::string> correlationIdList;
       if (document.HasMember("id") && !document["id"].IsNull()) {
-        if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-            this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+        if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+            this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
           int id = std::stoi(document["id"].GetString());
           if (this->exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap.find(wsConnection.id) !=
                   this->exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap.end() &&
@@ -184,11 +185,11 @@ class MarketDataServiceGateioBase : public MarketDataService {
               auto splitted = UtilString::split(exchangeSubscriptionId, '|');
               std::string channelId = splitted.at(0);
               std::string symbolId = splitted.at(1);
-              const auto& it = this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).lower_bound(channelId);
-              if (it != this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+              const auto& it = this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).lower_bound(channelId);
+              if (it != this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
                 const std::string& k = it->first;
                 if (k.compare(0, channelId.size(), channelId) == 0) {
-                  std::vector<std::string> correlationIdList_2 = it->second.at(symbolId);
+                  std::vector<std::string> correlationIdList_2 = it->second.at(symbolId).correlationIdList;
                   correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
                 }
               }
@@ -224,19 +225,16 @@ class MarketDataServiceGateioBase : public MarketDataService {
             symbolId = it != result.MemberEnd() ? it->value.GetString() : (its != result.MemberEnd() ? its->value.GetString() : "");
           }
           MarketDataMessage marketDataMessage;
-          std::string exchangeSubscriptionId;
-          std::map<std::string, std::string> optionMap;
-          if (!symbolId.empty()) {
-            exchangeSubscriptionId = channelId + "|" + symbolId;
-            optionMap = (*this->optionMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).lower_bound("channelId")).second.at(symbolId);
-          }
+          std::string exchangeSubscriptionId = channelId + "|" + symbolId;
+          const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
+          const auto& typedOptions = subscriptionState.typedOptions;
           if (channel == this->websocketChannelBookTicker) {
             marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-            marketDataMessage.recapType = this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]
-                                              ? MarketDataMessage::RecapType::NONE
-                                              : MarketDataMessage::RecapType::SOLICITED;
+            marketDataMessage.recapType =
+                subscriptionState.processedInitialSnapshot ? MarketDataMessage::RecapType::NONE : MarketDataMessage::RecapType::SOLICITED;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(result["t"].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             {
               std::string p = result["b"].GetString();
               if (!p.empty()) {
@@ -258,13 +256,13 @@ class MarketDataServiceGateioBase : public MarketDataService {
             marketDataMessageList.emplace_back(std::move(marketDataMessage));
           } else if (channel == this->websocketChannelOrderBook) {
             marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-            marketDataMessage.recapType = this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]
-                                              ? MarketDataMessage::RecapType::NONE
-                                              : MarketDataMessage::RecapType::SOLICITED;
+            marketDataMessage.recapType =
+                subscriptionState.processedInitialSnapshot ? MarketDataMessage::RecapType::NONE : MarketDataMessage::RecapType::SOLICITED;
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(result["t"].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             int bidIndex = 0;
-            int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+            int maxMarketDepth = typedOptions.marketDepthMax;
             for (const auto& x : result["bids"].GetArray()) {
               if (bidIndex >= maxMarketDepth) {
                 break;
@@ -294,6 +292,7 @@ class MarketDataServiceGateioBase : public MarketDataService {
               MarketDataMessage marketDataMessage;
               marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
               marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+              marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
               marketDataMessage.tp = UtilTime::makeTimePointMilli(UtilTime::divideMilli(result["create_time_ms"].GetString()));
               marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
               MarketDataMessage::TypeForDataPoint dataPoint;
@@ -310,6 +309,7 @@ class MarketDataServiceGateioBase : public MarketDataService {
             marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
             marketDataMessage.tp = TimePoint(std::chrono::seconds(std::stoll(result["t"].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+            marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
             MarketDataMessage::TypeForDataPoint dataPoint;
             dataPoint.insert({MarketDataMessage::DataFieldType::OPEN_PRICE, result["o"].GetString()});
             dataPoint.insert({MarketDataMessage::DataFieldType::HIGH_PRICE, result["h"].GetString()});
@@ -9,6 +9,7 @@ class MarketDataServiceKraken : public MarketDataService {
   MarketDataServiceKraken(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                           ServiceContext* serviceContextPtr)
       : MarketDataService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodySuccessConditionList = {JsonScanner::hasKeyValue("error", "[]")};
     this->exchangeName = CCAPI_EXCHANGE_NAME_KRAKEN;
     this->baseUrlWs = sessionConfigs.getUrlWebsocketBase().at(this->exchangeName);
     this->baseUrlRest = sessionConfigs.getUrlRestBase().at(this->exchangeName);
@@ -48,31 +49,31 @@ class MarketDataServiceKraken : public MarketDataService {
     this->send(wsConnectionPtr, "{\"reqid\":" + std::to_string(UtilTime::getUnixTimestamp(now)) + ",\"event\":\"ping\"}", ec);
   }
 #endif
-  bool doesHttpBodyContainError(const std::string& body) override { return body.find(R"("error":[])") == std::string::npos; }
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-    auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
+    auto conflateIntervalMilliseconds = subscription.getTypedOptions().conflateIntervalMilliseconds;
     if (field == CCAPI_MARKET_DEPTH) {
       int marketDepthSubscribedToExchange = 1;
       marketDepthSubscribedToExchange = this->calculateMarketDepthAllowedByExchange(marketDepthRequested, std::vector<int>({10, 25, 100, 500, 1000}));
       channelId += std::string("?") + CCAPI_MARKET_DEPTH_SUBSCRIBED_TO_EXCHANGE + "=" + std::to_string(marketDepthSubscribedToExchange);
-      this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
+      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange =
+          marketDepthSubscribedToExchange;
     } else if (field == CCAPI_CANDLESTICK) {
-      std::string interval = std::to_string(std::stoi(optionMap.at(CCAPI_CANDLESTICK_INTERVAL_SECONDS)) / 60);
+      std::string interval = std::to_string(subscription.getTypedOptions().candlestickIntervalSeconds / 60);
       channelId += "-" + interval;
     }
   }
   std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
       if (channelId.rfind(CCAPI_WEBSOCKET_KRAKEN_CHANNEL_BOOK, 0) == 0) {
         std::map<int, std::vector<std::string> > symbolIdListByMarketDepthSubscribedToExchangeMap;
-        for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-          auto symbolId = subscriptionListBySymbolId.first;
+        for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+          auto symbolId = subscriptionStateBySymbolId.first;
           int marketDepthSubscribedToExchange =
-              this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).marketDepthSubscribedToExchange;
           std::string exchangeSubscriptionId =
               std::string(CCAPI_WEBSOCKET_KRAKEN_CHANNEL_BOOK) + "-" + std::to_string(marketDepthSubscribedToExchange) + "|" + symbolId;
           this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
@@ -107,8 +108,8 @@ class MarketDataServiceKraken : public MarketDataService {
         rj::Document::AllocatorType& allocator = document.GetAllocator();
         document.AddMember("event", rj::Value("subscribe").Move(), allocator);
         rj::Value instrument(rj::kArrayType);
-        for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-          auto symbolId = subscriptionListBySymbolId.first;
+        for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+          auto symbolId = subscriptionStateBySymbolId.first;
           std::string exchangeSubscriptionId = std::string(CCAPI_WEBSOCKET_KRAKEN_CHANNEL_TRADE) + "|" + symbolId;
           this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
           this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_SYMBOL_ID] = symbolId;
@@ -129,8 +130,8 @@ class MarketDataServiceKraken : public MarketDataService {
         rj::Document::AllocatorType& allocator = document.GetAllocator();
         document.AddMember("event", rj::Value("subscribe").Move(), allocator);
         rj::Value instrument(rj::kArrayType);
-        for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-          auto symbolId = subscriptionListBySymbolId.first;
+        for (const auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+          auto symbolId = subscriptionStateBySymbolId.first;
           std::string exchangeSubscriptionId = channelId + "|" + symbolId;
           this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
           this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_SYMBOL_ID] = symbolId;
@@ -173,7 +174,7 @@ class MarketDataServiceKraken : public MarketDataService {
       if (channelNameWithSuffix.rfind(CCAPI_WEBSOCKET_KRAKEN_CHANNEL_BOOK, 0) == 0) {
         auto symbolId = std::string(document[documentSize - 1].GetString());
         auto exchangeSubscriptionId = channelNameWithSuffix + "|" + symbolId;
-        auto channelId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
+        const SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
         const rj::Value& anonymous = document[1];
         if (anonymous.IsObject() && (anonymous.HasMember("b") || anonymous.HasMember("a"))) {
           rj::Value anonymous2(anonymous, allocator);
@@ -207,6 +208,7 @@ class MarketDataServiceKraken : public MarketDataService {
           MarketDataMessage marketDataMessage;
           marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
           marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+          marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
           marketDataMessage.tp = latestTp;
           marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
           if (anonymous2.HasMember("b")) {
@@ -230,6 +232,7 @@ class MarketDataServiceKraken : public MarketDataService {
           MarketDataMessage marketDataMessage;
           marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
           marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+          marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
           marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
           marketDataMessage.tp = timeReceived;
           for (const auto& x : anonymous["bs"].GetArray()) {
@@ -305,15 +308,15 @@ class MarketDataServiceKraken : public MarketDataService {
           }
           std::string symbolId = document["pair"].GetString();
           exchangeSubscriptionId += "|" + symbolId;
-          if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-              this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+          if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
             auto channelId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).at(CCAPI_CHANNEL_ID);
-            if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-                this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-              if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                  this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+            if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+                this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+              if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                  this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
                 std::vector<std::string> correlationIdList_2 =
-                    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                    this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
                 correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
               }
             }
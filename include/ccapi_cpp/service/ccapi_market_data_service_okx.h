@@ -9,6 +9,8 @@ class MarketDataServiceOkx : public MarketDataService {
   MarketDataServiceOkx(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                        ServiceContext* serviceContextPtr)
       : MarketDataService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->httpBodySuccessConditionList = {JsonScanner::hasKeyValue("code", "\"0\"")};
+    this->orderBookChecksumNumLevels = 25;
     this->exchangeName = CCAPI_EXCHANGE_NAME_OKX;
     this->baseUrlWs = sessionConfigs.getUrlWebsocketBase().at(this->exchangeName) + CCAPI_OKX_PUBLIC_WS_PATH;
     this->baseUrlRest = sessionConfigs.getUrlRestBase().at(this->exchangeName);
@@ -31,6 +33,7 @@ class MarketDataServiceOkx : public MarketDataService {
     this->apiSecretName = CCAPI_OKX_API_SECRET;
     this->apiPassphraseName = CCAPI_OKX_API_PASSPHRASE;
     this->setupCredential({this->apiKeyName, this->apiSecretName, this->apiPassphraseName});
+    this->httpKeepAliveProbeTarget = "/api/v5/public/time";
     this->getRecentTradesTarget = "/api/v5/market/trades";
     this->getHistoricalTradesTarget = "/api/v5/market/history-trades";
     this->getRecentCandlesticksTarget = "/api/v5/market/candles";
@@ -45,6 +48,56 @@ class MarketDataServiceOkx : public MarketDataService {
 
  private:
 #endif
+  enum class ChannelType {
+    UNKNOWN,
+    MARKET_DEPTH_SNAPSHOT,  // every message is a full book, without "action"
+    MARKET_DEPTH_SNAPSHOT_AND_UPDATE,
+    TRADE,
+    CANDLESTICK,
+  };
+  struct ChannelEntry {
+    std::string_view channelId;
+    ChannelType channelType;
+  };
+  static constexpr ChannelEntry channelEntryList[] = {
+      {CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH1_L2_TBT, ChannelType::MARKET_DEPTH_SNAPSHOT},
+      {CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH5, ChannelType::MARKET_DEPTH_SNAPSHOT},
+      {CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH400, ChannelType::MARKET_DEPTH_SNAPSHOT_AND_UPDATE},
+      {CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH50_L2_TBT, ChannelType::MARKET_DEPTH_SNAPSHOT_AND_UPDATE},
+      {CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH400_L2_TBT, ChannelType::MARKET_DEPTH_SNAPSHOT_AND_UPDATE},
+      {CCAPI_WEBSOCKET_OKX_CHANNEL_TRADE, ChannelType::TRADE},
+  };
+  // a perfect hash of the channels above, which the static_assert below checks at compile time since the channel names can be redefined
+  static constexpr size_t CHANNEL_HASH_TABLE_SIZE = 16;
+  static constexpr auto hashChannelId = [](std::string_view channelId) {
+    return channelId.empty() ? size_t{} : (channelId.size() * 3 + static_cast<unsigned char>(channelId.back())) % CHANNEL_HASH_TABLE_SIZE;
+  };
+  static constexpr std::array<ChannelEntry, CHANNEL_HASH_TABLE_SIZE> channelHashTable = [] {
+    std::array<ChannelEntry, CHANNEL_HASH_TABLE_SIZE> output{};
+    for (const auto& x : channelEntryList) {
+      output[hashChannelId(x.channelId)] = x;
+    }
+    return output;
+  }();
+  static_assert(
+      [] {
+        for (const auto& x : channelEntryList) {
+          if (channelHashTable[hashChannelId(x.channelId)].channelId != x.channelId) {
+            return false;
+          }
+        }
+        return true;
+      }(),
+      "OKX channel names collide in channelHashTable, hashChannelId needs to be adjusted");
+  // candlestick channels are named after their interval, e.g. candle1m, so they are matched by prefix
+  static constexpr ChannelType classifyChannelId(std::string_view channelId) {
+    const ChannelEntry& entry = channelHashTable[hashChannelId(channelId)];
+    if (entry.channelType != ChannelType::UNKNOWN && entry.channelId == channelId) {
+      return entry.channelType;
+    }
+    constexpr std::string_view candlestickPrefix = CCAPI_WEBSOCKET_OKX_CHANNEL_CANDLESTICK;
+    return channelId.substr(0, candlestickPrefix.size()) == candlestickPrefix ? ChannelType::CANDLESTICK : ChannelType::UNKNOWN;
+  }
   std::string getInstrumentGroup(const Subscription& subscription) override {
     std::string baseUrlWsGivenSubscription(this->baseUrlWs);
     if (subscription.getField() == CCAPI_CANDLESTICK) {
@@ -53,15 +106,16 @@ class MarketDataServiceOkx : public MarketDataService {
     return baseUrlWsGivenSubscription + "|" + subscription.getField() + "|" + subscription.getSerializedOptions() + "|" +
            subscription.getSerializedCredential();
   }
-  bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*\"0\"")); }
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
-    auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
+    auto conflateIntervalMilliseconds = subscription.getTypedOptions().conflateIntervalMilliseconds;
     if (field == CCAPI_MARKET_DEPTH) {
       if (conflateIntervalMilliseconds < 100) {
         if (marketDepthRequested == 1) {
           channelId = CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH1_L2_TBT;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange = 1;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
         } else if (marketDepthRequested <= 50) {
           channelId = CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH50_L2_TBT;
         } else {
@@ -70,13 +124,15 @@ class MarketDataServiceOkx : public MarketDataService {
       } else {
         if (marketDepthRequested <= 5) {
           channelId = CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH5;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange = 5;
+          this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].l2UpdateIsReplace = true;
         } else {
           channelId = CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH400;
         }
       }
     } else if (field == CCAPI_CANDLESTICK) {
       std::string interval =
-          this->convertCandlestickIntervalSecondsToInterval(std::stoi(optionMap.at(CCAPI_CANDLESTICK_INTERVAL_SECONDS)), "s", "m", "H", "D", "W");
+          this->convertCandlestickIntervalSecondsToInterval(subscription.getTypedOptions().candlestickIntervalSeconds, "s", "m", "H", "D", "W");
       channelId = CCAPI_WEBSOCKET_OKX_CHANNEL_CANDLESTICK + interval;
     }
   }
@@ -92,14 +148,13 @@ class MarketDataServiceOkx : public MarketDataService {
     rj::Document::AllocatorType& allocator = document.GetAllocator();
     document.AddMember("op", rj::Value("subscribe").Move(), allocator);
     rj::Value args(rj::kArrayType);
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
-      for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
-        std::string symbolId = subscriptionListBySymbolId.first;
-        if (channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH1_L2_TBT || channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH5) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
-        }
-        std::string exchangeSubscriptionId = UtilString::split(channelId, "?").at(0) + ":" + symbolId;
+    for (auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
+      std::string channelIdWithoutParameter = UtilString::split(channelId, "?").at(0);
+      for (auto& subscriptionStateBySymbolId : subscriptionStateByChannelIdSymbolId.second) {
+        std::string symbolId = subscriptionStateBySymbolId.first;
+        std::string exchangeSubscriptionId = channelIdWithoutParameter + ":" + symbolId;
+        this->registerExchangeSubscriptionKey(wsConnection.id, channelIdWithoutParameter, exchangeSubscriptionId, subscriptionStateBySymbolId.second);
         rj::Value arg(rj::kObjectType);
         arg.AddMember("channel", rj::Value(channelId.c_str(), allocator).Move(), allocator);
         arg.AddMember("instId", rj::Value(symbolId.c_str(), allocator).Move(), allocator);
@@ -116,28 +171,6 @@ class MarketDataServiceOkx : public MarketDataService {
     sendStringList.push_back(sendString);
     return sendStringList;
   }
-  std::string calculateOrderBookChecksum(const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk) override {
-    auto i = 0;
-    auto i1 = snapshotBid.rbegin();
-    auto i2 = snapshotAsk.begin();
-    std::vector<std::string> csData;
-    while (i < 25 && (i1 != snapshotBid.rend() || i2 != snapshotAsk.end())) {
-      if (i1 != snapshotBid.rend()) {
-        csData.push_back(toString(i1->first));
-        csData.push_back(i1->second);
-        ++i1;
-      }
-      if (i2 != snapshotAsk.end()) {
-        csData.push_back(toString(i2->first));
-        csData.push_back(i2->second);
-        ++i2;
-      }
-      ++i;
-    }
-    std::string csStr = UtilString::join(csData, ":");
-    uint_fast32_t csCalc = UtilAlgorithm::crc(csStr.begin(), csStr.end());
-    return intToHex(csCalc);
-  }
   void processTextMessage(
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
       WsConnection& wsConnection, wspp::connection_hdl hdl, const std::string& textMessage
@@ -149,13 +182,14 @@ class MarketDataServiceOkx : public MarketDataService {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    std::string_view textMessage(textMessageView.data(), textMessageView.size());
 #endif
     if (textMessage != "pong") {
-      rj::Document document;
-      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+      auto& jsonParseArena = this->resetJsonParseArena();
+      ArenaDocument document(&jsonParseArena, CCAPI_JSON_PARSE_STACK_CAPACITY, &jsonParseArena);
+      document.ParseInsitu<rj::kParseNumbersAsStringsFlag>(this->copyToInsituParseBuffer(textMessage.data(), textMessage.size()));
       auto it = document.FindMember("event");
-      std::string eventStr = it != document.MemberEnd() ? it->value.GetString() : "";
+      std::string_view eventStr = it != document.MemberEnd() ? toStringView(it->value) : std::string_view();
       if (eventStr == "login") {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
         this->startSubscribe(wsConnection);
@@ -165,9 +199,8 @@ class MarketDataServiceOkx : public MarketDataService {
       } else {
         if (document.IsObject() && document.HasMember("arg")) {
           const rj::Value& arg = document["arg"];
-          std::string channelId = arg["channel"].GetString();
-          std::string symbolId = arg["instId"].GetString();
-          std::string exchangeSubscriptionId = channelId + ":" + symbolId;
+          std::string_view channelId = toStringView(arg["channel"]);
+          std::string_view symbolId = toStringView(arg["instId"]);
           if (!eventStr.empty()) {
             if (eventStr == "subscribe") {
               event.setType(Event::Type::SUBSCRIPTION_STATUS);
@@ -175,17 +208,17 @@ class MarketDataServiceOkx : public MarketDataService {
               Message message;
               message.setTimeReceived(timeReceived);
               std::vector<std::string> correlationIdList;
-              if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-                  this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+              if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+                  this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
                 const rj::Value& arg = document["arg"];
                 std::string channelId = arg["channel"].GetString();
                 std::string symbolId = arg["instId"].GetString();
-                if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-                    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-                  if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                      this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+                if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+                    this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+                  if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
                     std::vector<std::string> correlationIdList_2 =
-                        this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                        this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
                     correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
                   }
                 }
@@ -193,7 +226,7 @@ class MarketDataServiceOkx : public MarketDataService {
               message.setCorrelationIdList(correlationIdList);
               message.setType(Message::Type::SUBSCRIPTION_STARTED);
               Element element;
-              element.insert(CCAPI_INFO_MESSAGE, textMessage);
+              element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
               message.setElementList({element});
               messageList.emplace_back(std::move(message));
               event.setMessageList(messageList);
@@ -204,32 +237,44 @@ class MarketDataServiceOkx : public MarketDataService {
               message.setTimeReceived(timeReceived);
               message.setType(Message::Type::SUBSCRIPTION_FAILURE);
               Element element;
-              element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+              element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
               message.setElementList({element});
               messageList.emplace_back(std::move(message));
               event.setMessageList(messageList);
             }
           } else {
-            if (channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH1_L2_TBT || channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH5 ||
-                channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH400 || channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH50_L2_TBT ||
-                channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH400_L2_TBT) {
-              std::string action = channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH1_L2_TBT || channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH5
-                                       ? ""
-                                       : document["action"].GetString();
+            ChannelType channelType = classifyChannelId(channelId);
+            int exchangeSubscriptionKey = this->findExchangeSubscriptionKey(wsConnection.id, channelId, symbolId);
+            std::string exchangeSubscriptionId;
+            if (exchangeSubscriptionKey < 0) {
+              exchangeSubscriptionId = std::string(channelId) + ":" + std::string(symbolId);
+            }
+            if (channelType == ChannelType::MARKET_DEPTH_SNAPSHOT || channelType == ChannelType::MARKET_DEPTH_SNAPSHOT_AND_UPDATE) {
+              std::string_view action;
+              bool processedInitialSnapshot = false;
+              if (channelType == ChannelType::MARKET_DEPTH_SNAPSHOT_AND_UPDATE) {
+                action = toStringView(document["action"]);
+              } else if (exchangeSubscriptionKey >= 0) {
+                const auto& subscriptionStateList = this->subscriptionStateListByConnectionIdMap.at(wsConnection.id);
+                processedInitialSnapshot = subscriptionStateList.at(exchangeSubscriptionKey)->processedInitialSnapshot;
+              } else {
+                processedInitialSnapshot = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId).processedInitialSnapshot;
+              }
               for (const auto& datum : document["data"].GetArray()) {
                 if (this->sessionOptions.enableCheckOrderBookChecksum) {
                   auto it = datum.FindMember("checksum");
                   if (it != datum.MemberEnd()) {
-                    this->orderBookChecksumByConnectionIdSymbolIdMap[wsConnection.id][symbolId] =
-                        intToHex(static_cast<uint_fast32_t>(static_cast<uint32_t>(std::stoi(it->value.GetString()))));
+                    this->orderBookChecksumByConnectionIdSymbolIdMap[wsConnection.id][std::string(symbolId)] =
+                        intToHex(static_cast<uint_fast32_t>(static_cast<uint32_t>(UtilString::parseInteger<int32_t>(toStringView(it->value)))));
                   }
                 }
                 MarketDataMessage marketDataMessage;
-                marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum["ts"].GetString())));
+                marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(toStringView(datum["ts"]));
                 marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+                marketDataMessage.exchangeSubscriptionKey = exchangeSubscriptionKey;
                 marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-                if (channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH1_L2_TBT || channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH5) {
-                  if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+                if (channelType == ChannelType::MARKET_DEPTH_SNAPSHOT) {
+                  if (processedInitialSnapshot) {
                     marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
                   } else {
                     marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
@@ -237,50 +282,52 @@ class MarketDataServiceOkx : public MarketDataService {
                 } else {
                   marketDataMessage.recapType = action == "update" ? MarketDataMessage::RecapType::NONE : MarketDataMessage::RecapType::SOLICITED;
                 }
-                for (const auto& x : datum["bids"].GetArray()) {
-                  MarketDataMessage::TypeForDataPoint dataPoint;
-                  dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(x[0].GetString())});
-                  dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, UtilString::normalizeDecimalString(x[1].GetString())});
-                  marketDataMessage.data[MarketDataMessage::DataType::BID].emplace_back(std::move(dataPoint));
+                const rj::Value& bids = datum["bids"];
+                marketDataMessage.bidList.reserve(bids.Size());
+                for (const auto& x : bids.GetArray()) {
+                  marketDataMessage.bidList.push_back(
+                      {UtilString::normalizeDecimalString(toStringView(x[0])), UtilString::normalizeDecimalString(toStringView(x[1]))});
                 }
-                for (const auto& x : datum["asks"].GetArray()) {
-                  MarketDataMessage::TypeForDataPoint dataPoint;
-                  dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(x[0].GetString())});
-                  dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, UtilString::normalizeDecimalString(x[1].GetString())});
-                  marketDataMessage.data[MarketDataMessage::DataType::ASK].emplace_back(std::move(dataPoint));
+                const rj::Value& asks = datum["asks"];
+                marketDataMessage.askList.reserve(asks.Size());
+                for (const auto& x : asks.GetArray()) {
+                  marketDataMessage.askList.push_back(
+                      {UtilString::normalizeDecimalString(toStringView(x[0])), UtilString::normalizeDecimalString(toStringView(x[1]))});
                 }
                 marketDataMessageList.emplace_back(std::move(marketDataMessage));
               }
-            } else if (channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_TRADE) {
+            } else if (channelType == ChannelType::TRADE) {
               for (const auto& datum : document["data"].GetArray()) {
                 MarketDataMessage marketDataMessage;
                 marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
                 marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
-                marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum["ts"].GetString())));
+                marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(toStringView(datum["ts"]));
                 marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
-                MarketDataMessage::TypeForDataPoint dataPoint;
-                dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(datum["px"].GetString())});
-                dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, UtilString::normalizeDecimalString(datum["sz"].GetString())});
-                dataPoint.insert({MarketDataMessage::DataFieldType::TRADE_ID, datum["tradeId"].GetString()});
-                dataPoint.insert({MarketDataMessage::DataFieldType::IS_BUYER_MAKER, std::string(datum["side"].GetString()) == "sell" ? "1" : "0"});
-                marketDataMessage.data[MarketDataMessage::DataType::TRADE].emplace_back(std::move(dataPoint));
+                marketDataMessage.exchangeSubscriptionKey = exchangeSubscriptionKey;
+                MarketDataMessage::Trade trade;
+                UtilString::normalizeDecimalStringTo(toStringView(datum["px"]), trade.price);
+                UtilString::normalizeDecimalStringTo(toStringView(datum["sz"]), trade.size);
+                trade.tradeId = toStringView(datum["tradeId"]);
+                trade.isBuyerMaker = toStringView(datum["side"]) == "sell";
+                marketDataMessage.tradeList.emplace_back(std::move(trade));
                 marketDataMessageList.emplace_back(std::move(marketDataMessage));
               }
-            } else if (channelId.rfind(CCAPI_WEBSOCKET_OKX_CHANNEL_CANDLESTICK, 0) == 0) {
+            } else if (channelType == ChannelType::CANDLESTICK) {
               for (const auto& datum : document["data"].GetArray()) {
                 MarketDataMessage marketDataMessage;
                 marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK;
                 marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
-                marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum[0].GetString())));
+                marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(toStringView(datum[0]));
                 marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
-                MarketDataMessage::TypeForDataPoint dataPoint;
-                dataPoint.insert({MarketDataMessage::DataFieldType::OPEN_PRICE, datum[1].GetString()});
-                dataPoint.insert({MarketDataMessage::DataFieldType::HIGH_PRICE, datum[2].GetString()});
-                dataPoint.insert({MarketDataMessage::DataFieldType::LOW_PRICE, datum[3].GetString()});
-                dataPoint.insert({MarketDataMessage::DataFieldType::CLOSE_PRICE, datum[4].GetString()});
-                dataPoint.insert({MarketDataMessage::DataFieldType::VOLUME, datum[5].GetString()});
-                dataPoint.insert({MarketDataMessage::DataFieldType::QUOTE_VOLUME, datum[7].GetString()});
-                marketDataMessage.data[MarketDataMessage::DataType::CANDLESTICK].emplace_back(std::move(dataPoint));
+                marketDataMessage.exchangeSubscriptionKey = exchangeSubscriptionKey;
+                MarketDataMessage::Candlestick candlestick;
+                candlestick.openPrice = toStringView(datum[1]);
+                candlestick.highPrice = toStringView(datum[2]);
+                candlestick.lowPrice = toStringView(datum[3]);
+                candlestick.closePrice = toStringView(datum[4]);
+                candlestick.volume = toStringView(datum[5]);
+                candlestick.quoteVolume = toStringView(datum[7]);
+                marketDataMessage.candlestickList.emplace_back(std::move(candlestick));
                 marketDataMessageList.emplace_back(std::move(marketDataMessage));
               }
             }
@@ -406,95 +453,112 @@ class MarketDataServiceOkx : public MarketDataService {
     element.insert(CCAPI_CONTRACT_SIZE, x["ctVal"].GetString());
     element.insert(CCAPI_CONTRACT_MULTIPLIER, x["ctMult"].GetString());
   }
-  void convertTextMessageToMarketDataMessage(const Request& request, const std::string& textMessage, const TimePoint& timeReceived, Event& event,
-                                             std::vector<MarketDataMessage>& marketDataMessageList) override {
-    rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+  // converts an element of the "data" array of a response, either while iterating over the parsed body or as a record of a streamed body
+  void convertRestDatum(const Request& request, const rj::Value& datum, std::vector<MarketDataMessage>& marketDataMessageList,
+                        std::vector<Element>& elementList) {
     switch (request.getOperation()) {
       case Request::Operation::GET_RECENT_TRADES:
       case Request::Operation::GET_HISTORICAL_TRADES: {
-        for (const auto& datum : document["data"].GetArray()) {
-          MarketDataMessage marketDataMessage;
-          marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
-          marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum["ts"].GetString())));
-          MarketDataMessage::TypeForDataPoint dataPoint;
-          dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(datum["px"].GetString())});
-          dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, UtilString::normalizeDecimalString(datum["sz"].GetString())});
-          dataPoint.insert({MarketDataMessage::DataFieldType::TRADE_ID, datum["tradeId"].GetString()});
-          dataPoint.insert({MarketDataMessage::DataFieldType::IS_BUYER_MAKER, std::string(datum["side"].GetString()) == "sell" ? "1" : "0"});
-          marketDataMessage.data[MarketDataMessage::DataType::TRADE].emplace_back(std::move(dataPoint));
-          marketDataMessageList.emplace_back(std::move(marketDataMessage));
-        }
+        MarketDataMessage marketDataMessage;
+        marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
+        marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(toStringView(datum["ts"]));
+        MarketDataMessage::Trade trade;
+        UtilString::normalizeDecimalStringTo(toStringView(datum["px"]), trade.price);
+        UtilString::normalizeDecimalStringTo(toStringView(datum["sz"]), trade.size);
+        trade.tradeId = datum["tradeId"].GetString();
+        trade.isBuyerMaker = toStringView(datum["side"]) == "sell";
+        marketDataMessage.tradeList.emplace_back(std::move(trade));
+        marketDataMessageList.emplace_back(std::move(marketDataMessage));
       } break;
       case Request::Operation::GET_RECENT_CANDLESTICKS:
       case Request::Operation::GET_HISTORICAL_CANDLESTICKS: {
-        for (const auto& x : document["data"].GetArray()) {
-          MarketDataMessage marketDataMessage;
-          marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK;
-          marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(std::stoll(x[0].GetString()));
-          MarketDataMessage::TypeForDataPoint dataPoint;
-          dataPoint.insert({MarketDataMessage::DataFieldType::OPEN_PRICE, x[1].GetString()});
-          dataPoint.insert({MarketDataMessage::DataFieldType::HIGH_PRICE, x[2].GetString()});
-          dataPoint.insert({MarketDataMessage::DataFieldType::LOW_PRICE, x[3].GetString()});
-          dataPoint.insert({MarketDataMessage::DataFieldType::CLOSE_PRICE, x[4].GetString()});
-          dataPoint.insert({MarketDataMessage::DataFieldType::VOLUME, x[5].GetString()});
-          dataPoint.insert({MarketDataMessage::DataFieldType::QUOTE_VOLUME, x[7].GetString()});
-          marketDataMessage.data[MarketDataMessage::DataType::CANDLESTICK].emplace_back(std::move(dataPoint));
-          marketDataMessageList.emplace_back(std::move(marketDataMessage));
-        }
+        MarketDataMessage marketDataMessage;
+        marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK;
+        marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(toStringView(datum[0]));
+        MarketDataMessage::Candlestick candlestick;
+        candlestick.openPrice = datum[1].GetString();
+        candlestick.highPrice = datum[2].GetString();
+        candlestick.lowPrice = datum[3].GetString();
+        candlestick.closePrice = datum[4].GetString();
+        candlestick.volume = datum[5].GetString();
+        candlestick.quoteVolume = datum[7].GetString();
+        marketDataMessage.candlestickList.emplace_back(std::move(candlestick));
+        marketDataMessageList.emplace_back(std::move(marketDataMessage));
       } break;
       case Request::Operation::GET_MARKET_DEPTH: {
         MarketDataMessage marketDataMessage;
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-        const rj::Value& data = document["data"][0];
-        marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(std::stoll(data["ts"].GetString()));
-        for (const auto& x : data["bids"].GetArray()) {
-          MarketDataMessage::TypeForDataPoint dataPoint;
-          dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, x[0].GetString()});
-          dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, x[1].GetString()});
-          marketDataMessage.data[MarketDataMessage::DataType::BID].emplace_back(std::move(dataPoint));
+        marketDataMessage.tp = UtilTime::makeTimePointFromMilliseconds(toStringView(datum["ts"]));
+        for (const auto& x : datum["bids"].GetArray()) {
+          marketDataMessage.bidList.push_back({x[0].GetString(), x[1].GetString()});
         }
-        for (const auto& x : data["asks"].GetArray()) {
-          MarketDataMessage::TypeForDataPoint dataPoint;
-          dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, x[0].GetString()});
-          dataPoint.insert({MarketDataMessage::DataFieldType::SIZE, x[1].GetString()});
-          marketDataMessage.data[MarketDataMessage::DataType::ASK].emplace_back(std::move(dataPoint));
+        for (const auto& x : datum["asks"].GetArray()) {
+          marketDataMessage.askList.push_back({x[0].GetString(), x[1].GetString()});
         }
         marketDataMessageList.emplace_back(std::move(marketDataMessage));
       } break;
       case Request::Operation::GET_INSTRUMENT: {
-        Message message;
-        message.setTimeReceived(timeReceived);
-        message.setType(this->requestOperationToMessageTypeMap.at(request.getOperation()));
-        for (const auto& x : document["data"].GetArray()) {
-          if (std::string(x["instId"].GetString()) == request.getInstrument()) {
-            Element element;
-            this->extractInstrumentInfo(element, x);
-            message.setElementList({element});
-            break;
-          }
+        if (toStringView(datum["instId"]) == request.getInstrument()) {
+          Element element;
+          this->extractInstrumentInfo(element, datum);
+          elementList.emplace_back(std::move(element));
         }
-        message.setCorrelationIdList({request.getCorrelationId()});
-        event.addMessages({message});
       } break;
       case Request::Operation::GET_INSTRUMENTS: {
-        Message message;
-        message.setTimeReceived(timeReceived);
-        message.setType(this->requestOperationToMessageTypeMap.at(request.getOperation()));
-        std::vector<Element> elementList;
-        for (const auto& x : document["data"].GetArray()) {
-          Element element;
-          this->extractInstrumentInfo(element, x);
-          elementList.push_back(element);
-        }
-        message.setElementList(elementList);
-        message.setCorrelationIdList({request.getCorrelationId()});
-        event.addMessages({message});
+        Element element;
+        this->extractInstrumentInfo(element, datum);
+        elementList.emplace_back(std::move(element));
       } break;
       default:
         CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
     }
   }
+  void convertTextMessageToMarketDataMessage(const Request& request, const std::string& textMessage, const TimePoint& timeReceived, Event& event,
+                                             std::vector<MarketDataMessage>& marketDataMessageList) override {
+    auto& jsonParseArena = this->resetJsonParseArena();
+    ArenaDocument document(&jsonParseArena, CCAPI_JSON_PARSE_STACK_CAPACITY, &jsonParseArena);
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    std::vector<Element> elementList;
+    if (request.getOperation() == Request::Operation::GET_MARKET_DEPTH) {
+      this->convertRestDatum(request, document["data"][0], marketDataMessageList, elementList);
+    } else {
+      for (const auto& datum : document["data"].GetArray()) {
+        this->convertRestDatum(request, datum, marketDataMessageList, elementList);
+      }
+    }
+    if (request.getOperation() == Request::Operation::GET_INSTRUMENT || request.getOperation() == Request::Operation::GET_INSTRUMENTS) {
+      Message message;
+      message.setTimeReceived(timeReceived);
+      message.setType(this->requestOperationToMessageTypeMap.at(request.getOperation()));
+      message.setElementList(elementList);
+      message.setCorrelationIdList({request.getCorrelationId()});
+      event.addMessage(message);
+    }
+  }
+  std::string getStreamedResponseBodyArrayKey(const Request& request) override {
+    switch (request.getOperation()) {
+      case Request::Operation::GET_RECENT_TRADES:
+      case Request::Operation::GET_HISTORICAL_TRADES:
+      case Request::Operation::GET_RECENT_CANDLESTICKS:
+      case Request::Operation::GET_HISTORICAL_CANDLESTICKS:
+      case Request::Operation::GET_INSTRUMENT:
+      case Request::Operation::GET_INSTRUMENTS:
+        return "data";
+      default:
+        return "";
+    }
+  }
+  void processStreamedResponseBodyRecord(const Request& request, std::string_view record, StreamedResponse& streamedResponse) override {
+    auto& jsonParseArena = this->resetJsonParseArena();
+    ArenaDocument document(&jsonParseArena, CCAPI_JSON_PARSE_STACK_CAPACITY, &jsonParseArena);
+    document.Parse<rj::kParseNumbersAsStringsFlag>(record.data(), record.size());
+    if (document.HasParseError()) {
+      streamedResponse.errorMessage = std::string("JSON parse error: ") + rj::GetParseError_En(document.GetParseError()) + " at offset " +
+                                      std::to_string(document.GetErrorOffset()) + " of record " + std::string(record);
+      return;
+    }
+    this->convertRestDatum(request, document, streamedResponse.marketDataMessageList, streamedResponse.elementList);
+  }
   std::vector<std::string> createSendStringListFromSubscriptionList(const WsConnection& wsConnection, const std::vector<Subscription>& subscriptionList,
                                                                     const TimePoint& now, const std::map<std::string, std::string>& credential) override {
     std::vector<std::string> sendStringList;
@@ -56,19 +56,20 @@ class MarketDataServiceWhitebit : public MarketDataService {
 #endif
   void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
-    auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+    auto marketDepthRequested = subscription.getTypedOptions().marketDepthMax;
     if (field == CCAPI_MARKET_DEPTH) {
       int marketDepthSubscribedToExchange = marketDepthRequested;
       // channelId += std::string("?") + CCAPI_MARKET_DEPTH_SUBSCRIBED_TO_EXCHANGE + "=" + std::to_string(marketDepthSubscribedToExchange);
-      this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
+      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].marketDepthSubscribedToExchange =
+          marketDepthSubscribedToExchange;
     }
   }
   std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
-    for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-      auto channelId = subscriptionListByChannelIdSymbolId.first;
+    for (const auto& subscriptionStateByChannelIdSymbolId : this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
+      auto channelId = subscriptionStateByChannelIdSymbolId.first;
       if (channelId == CCAPI_WEBSOCKET_WHITEBIT_CHANNEL_MARKET_DEPTH) {
-        for (const auto& subscriptionListByInstrument : subscriptionListByChannelIdSymbolId.second) {
+        for (const auto& subscriptionListByInstrument : subscriptionStateByChannelIdSymbolId.second) {
           auto symbolId = subscriptionListByInstrument.first;
           auto exchangeSubscriptionId = channelId + subscriptionListByInstrument.first;
           rj::Document document;
@@ -79,7 +80,7 @@ class MarketDataServiceWhitebit : public MarketDataService {
           rj::Value params(rj::kArrayType);
           params.PushBack(rj::Value(symbolId.c_str(), allocator).Move(), allocator);
           int marketDepthSubscribedToExchange =
-              this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).marketDepthSubscribedToExchange;
           params.PushBack(rj::Value(marketDepthSubscribedToExchange).Move(), allocator);
           params.PushBack(rj::Value("0").Move(), allocator);
           params.PushBack(rj::Value(true).Move(), allocator);
@@ -104,7 +105,7 @@ class MarketDataServiceWhitebit : public MarketDataService {
         document.AddMember("method", rj::Value("trades_subscribe").Move(), allocator);
         rj::Value params(rj::kArrayType);
         std::vector<std::string> exchangeSubscriptionIdList;
-        for (const auto& subscriptionListByInstrument : subscriptionListByChannelIdSymbolId.second) {
+        for (const auto& subscriptionListByInstrument : subscriptionStateByChannelIdSymbolId.second) {
           auto symbolId = subscriptionListByInstrument.first;
           params.PushBack(rj::Value(symbolId.c_str(), allocator).Move(), allocator);
           auto exchangeSubscriptionId = channelId + subscriptionListByInstrument.first;
@@ -177,19 +178,21 @@ class MarketDataServiceWhitebit : public MarketDataService {
       } else if (method == this->methodTradesUpdate) {
         std::string symbolId = params[0].GetString();
         const auto& exchangeSubscriptionId = std::string(CCAPI_WEBSOCKET_WHITEBIT_CHANNEL_MARKET_TRADES) + symbolId;
+        SubscriptionState& subscriptionState = this->getSubscriptionState(wsConnection.id, exchangeSubscriptionId);
         for (const auto& x : params[1].GetArray()) {
           MarketDataMessage marketDataMessage;
           marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE;
           marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
+          marketDataMessage.exchangeSubscriptionKey = subscriptionState.exchangeSubscriptionKey;
           auto timePair = UtilTime::divide(std::string(x["time"].GetString()));
           auto tp = TimePoint(std::chrono::duration<int64_t>(timePair.first));
           tp += std::chrono::nanoseconds(timePair.second);
           marketDataMessage.tp = tp;
-          if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][CCAPI_WEBSOCKET_WHITEBIT_CHANNEL_MARKET_TRADES][symbolId]) {
+          if (subscriptionState.processedInitialSnapshot) {
             marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
           } else {
             marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
-            this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][CCAPI_WEBSOCKET_WHITEBIT_CHANNEL_MARKET_TRADES][symbolId] = true;
+            subscriptionState.processedInitialSnapshot = true;
           }
           MarketDataMessage::TypeForDataPoint dataPoint;
           dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(std::string(x["price"].GetString()))});
@@ -213,8 +216,8 @@ class MarketDataServiceWhitebit : public MarketDataService {
           Message message;
           message.setTimeReceived(timeReceived);
           std::vector<std::string> correlationIdList;
-          if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
-              this->correlationIdListByConnectionIdChannelIdSymbolIdMap.end()) {
+          if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) !=
+              this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.end()) {
             if (this->exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap.find(wsConnection.id) !=
                     this->exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap.end() &&
                 this->exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap.at(wsConnection.id).find(id) !=
@@ -223,12 +226,12 @@ class MarketDataServiceWhitebit : public MarketDataService {
                 std::string channelId =
                     this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID];
                 std::string symbolId = this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_SYMBOL_ID];
-                if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
-                    this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
-                  if (this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
-                      this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
+                if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).find(channelId) !=
+                    this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).end()) {
+                  if (this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).find(symbolId) !=
+                      this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).end()) {
                     std::vector<std::string> correlationIdList_2 =
-                        this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+                        this->subscriptionStateByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId).correlationIdList;
                     correlationIdList.insert(correlationIdList.end(), correlationIdList_2.begin(), correlationIdList_2.end());
                   }
                 }
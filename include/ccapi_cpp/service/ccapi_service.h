@@ -16,7 +16,16 @@
 #ifndef CCAPI_WEBSOCKET_WRITE_BUFFER_SIZE
 #define CCAPI_WEBSOCKET_WRITE_BUFFER_SIZE 1 << 20
 #endif
+#ifndef CCAPI_JSON_PARSE_ARENA_SIZE
+#define CCAPI_JSON_PARSE_ARENA_SIZE (1 << 20)
+#endif
+#ifndef CCAPI_JSON_PARSE_STACK_CAPACITY
+#define CCAPI_JSON_PARSE_STACK_CAPACITY (1 << 14)
+#endif
+#include <exception>
+#include <limits>
 #include <regex>
+#include <string_view>
 
 #include "boost/asio/strand.hpp"
 #include "boost/beast/core.hpp"
@@ -28,6 +37,7 @@
 #include "ccapi_cpp/ccapi_macro.h"
 #include "ccapi_cpp/ccapi_market_data_message.h"
 #include "rapidjson/document.h"
+#include "rapidjson/error/en.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 // clang-format off
@@ -57,7 +67,10 @@
 
 #include "ccapi_cpp/ccapi_fix_connection.h"
 #include "ccapi_cpp/ccapi_http_connection.h"
+#include "ccapi_cpp/ccapi_http_connection_pool.h"
 #include "ccapi_cpp/ccapi_http_retry.h"
+#include "ccapi_cpp/ccapi_json_record_stream_body.h"
+#include "ccapi_cpp/ccapi_json_scanner.h"
 #include "ccapi_cpp/ccapi_queue.h"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_session_configs.h"
@@ -88,6 +101,14 @@ class Service : public std::enable_shared_from_this<Service> {
 #else
   typedef boost::system::error_code ErrorCode;  // a.k.a. beast::error_code
 #endif
+  // what the records of a streamed response body have been converted to, see getStreamedResponseBodyArrayKey
+  struct StreamedResponse {
+    std::vector<Element> elementList;
+    std::vector<MarketDataMessage> marketDataMessageList;
+    std::exception_ptr exceptionPtr;
+    // set by an exchange when a record is not valid, the response is then reported as a RESPONSE_ERROR with it and the remaining records are skipped
+    std::string errorMessage;
+  };
   enum class PingPongMethod {
     WEBSOCKET_PROTOCOL_LEVEL,
     WEBSOCKET_APPLICATION_LEVEL,
@@ -141,10 +162,31 @@ class Service : public std::enable_shared_from_this<Service> {
     for (const auto& x : this->connectRetryOnFailTimerByConnectionIdMap) {
       x.second->cancel();
     }
+    if (this->httpConnectionKeepAliveProbeTimerPtr) {
+      this->httpConnectionKeepAliveProbeTimerPtr->cancel();
+    }
+    if (this->httpSpareConnectionTimerPtr) {
+      this->httpSpareConnectionTimerPtr->cancel();
+    }
+  }
+  // the idle connections are dropped, those with a request in flight go back to the pool once their response is received
+  void purgeHttpConnectionPool() {
+    for (auto& x : this->httpConnectionPool) {
+      for (auto& y : x.second) {
+        y.second.clearIdle();
+      }
+    }
   }
-  void purgeHttpConnectionPool() { this->httpConnectionPool.clear(); }
-  void purgeHttpConnectionPool(const std::string& localIpAddress) { this->httpConnectionPool.erase(localIpAddress); }
-  void purgeHttpConnectionPool(const std::string& localIpAddress, const std::string& baseUrl) { this->httpConnectionPool[localIpAddress].erase(baseUrl); }
+  void purgeHttpConnectionPool(const std::string& localIpAddress) {
+    for (auto& x : this->httpConnectionPool[localIpAddress]) {
+      x.second.clearIdle();
+    }
+  }
+  void purgeHttpConnectionPool(const std::string& localIpAddress, const std::string& baseUrl) {
+    this->getHttpConnectionPool(localIpAddress, baseUrl).clearIdle();
+  }
+  // aggregated over the http connection pools of all hosts and local ip addresses, can be called from any thread
+  HttpConnectionPool::Metrics getHttpConnectionPoolMetrics() const { return this->httpConnectionPoolMetricsCounterPtr->getMetrics(); }
   void forceCloseWebsocketConnections() {
     for (const auto& x : this->wsConnectionByIdMap) {
       ErrorCode ec;
@@ -160,6 +202,17 @@ class Service : public std::enable_shared_from_this<Service> {
       x.second->cancel();
     }
     sendRequestDelayTimerByCorrelationIdMap.clear();
+    if (this->httpConnectionKeepAliveProbeTimerPtr) {
+      this->httpConnectionKeepAliveProbeTimerPtr->cancel();
+    }
+    if (this->httpSpareConnectionTimerPtr) {
+      this->httpSpareConnectionTimerPtr->cancel();
+    }
+    for (auto& x : this->httpConnectionPool) {
+      for (auto& y : x.second) {
+        y.second.clearWaiters();
+      }
+    }
     this->shouldContinue = false;
     for (const auto& x : this->wsConnectionByIdMap) {
       ErrorCode ec;
@@ -181,6 +234,13 @@ class Service : public std::enable_shared_from_this<Service> {
                                      const std::map<std::string, std::string>& credential) {}
   virtual void processSuccessfulTextMessageRest(int statusCode, const Request& request, const std::string& textMessage, const TimePoint& timeReceived,
                                                 Queue<Event>* eventQueuePtr) {}
+  // an exchange returns the key of the array of records, e.g. "data", for the requests whose responses are large enough to be processed record by record
+  // while they are being received, see JsonRecordSplitter
+  virtual std::string getStreamedResponseBodyArrayKey(const Request& request) { return ""; }
+  virtual void processStreamedResponseBodyRecord(const Request& request, std::string_view record, StreamedResponse& streamedResponse) {}
+  // textMessage is the body without its records
+  virtual void processSuccessfulStreamedTextMessageRest(int statusCode, const Request& request, const std::string& textMessage,
+                                                        StreamedResponse& streamedResponse, const TimePoint& timeReceived, Queue<Event>* eventQueuePtr) {}
   std::shared_ptr<std::future<void>> sendRequest(Request& request, const bool useFuture, const TimePoint& now, long delayMilliseconds,
                                                  Queue<Event>* eventQueuePtr) {
     CCAPI_LOGGER_FUNCTION_ENTER;
@@ -306,6 +366,8 @@ class Service : public std::enable_shared_from_this<Service> {
   typedef ServiceContext::TlsClient TlsClient;
 #endif
   typedef std::shared_ptr<net::steady_timer> TimerPtr;
+  // a document whose parsing stack is taken from the same arena as its values, see resetJsonParseArena
+  typedef rj::GenericDocument<rj::UTF8<>, rj::MemoryPoolAllocator<>, rj::MemoryPoolAllocator<>> ArenaDocument;
   void setHostRestFromUrlRest(std::string baseUrlRest) {
     auto hostPort = this->extractHostFromUrl(baseUrlRest);
     this->hostRest = hostPort.first;
@@ -412,6 +474,23 @@ class Service : public std::enable_shared_from_this<Service> {
         tcpNewResolverResults, beast::bind_front_handler(&Service::onConnect, shared_from_this(), httpConnectionPtr, req, errorHandler, responseHandler));
     CCAPI_LOGGER_TRACE("after async_connect");
   }
+  // with SO_BUSY_POLL a read on the socket polls the device queue for up to socketBusyPollMicroseconds instead of waiting for the interrupt (linux only)
+  template <class Socket>
+  void setSocketBusyPoll(Socket& socket) {
+    if (this->sessionOptions.socketBusyPollMicroseconds <= 0) {
+      return;
+    }
+#ifdef SO_BUSY_POLL
+    beast::error_code ec;
+    socket.set_option(boost::asio::detail::socket_option::integer<SOL_SOCKET, SO_BUSY_POLL>(this->sessionOptions.socketBusyPollMicroseconds), ec);
+    if (ec) {
+      // values above the net.core.busy_read sysctl need CAP_NET_ADMIN
+      CCAPI_LOGGER_WARN("failed to set SO_BUSY_POLL, error = " + ec.message());
+    }
+#else
+    CCAPI_LOGGER_WARN("SO_BUSY_POLL is only supported on linux");
+#endif
+  }
   void onConnect(std::shared_ptr<HttpConnection> httpConnectionPtr, http::request<http::string_body> req,
                  std::function<void(const beast::error_code&)> errorHandler, std::function<void(const http::response<http::string_body>&)> responseHandler,
                  beast::error_code ec, tcp::resolver::results_type::endpoint_type) {
@@ -426,6 +505,7 @@ class Service : public std::enable_shared_from_this<Service> {
     // #ifdef CCAPI_DISABLE_NAGLE_ALGORITHM
     beast::get_lowest_layer(stream).socket().set_option(tcp::no_delay(true));
     // #endif
+    this->setSocketBusyPoll(beast::get_lowest_layer(stream).socket());
     CCAPI_LOGGER_TRACE("before ssl async_handshake");
     stream.async_handshake(ssl::stream_base::client,
                            beast::bind_front_handler(&Service::onSslHandshake, shared_from_this(), httpConnectionPtr, req, errorHandler, responseHandler));
@@ -442,6 +522,7 @@ class Service : public std::enable_shared_from_this<Service> {
     }
     CCAPI_LOGGER_TRACE("ssl handshaked");
     beast::ssl_stream<beast::tcp_stream>& stream = *httpConnectionPtr->streamPtr;
+    this->serviceContextPtr->tlsSessionCachePtr->onHandshake(stream.native_handle());
     std::shared_ptr<http::request<http::string_body>> reqPtr(new http::request<http::string_body>(std::move(req)));
     CCAPI_LOGGER_TRACE("before async_write");
     http::async_write(stream, *reqPtr,
@@ -503,8 +584,15 @@ class Service : public std::enable_shared_from_this<Service> {
       CCAPI_LOGGER_DEBUG("error SSL_set_tlsext_host_name: " + ec.message());
       throw ec;
     }
+    this->resumeTlsSession(streamPtr->native_handle(), host);
     return streamPtr;
   }
+  // offers the last TLS session of host to a new connection, so that its handshake is an abbreviated one if the server still accepts the session
+  void resumeTlsSession(SSL* ssl, const std::string& host) {
+    if (this->sessionOptions.enableTlsSessionResumption && this->serviceContextPtr->tlsSessionCachePtr->apply(ssl, host)) {
+      CCAPI_LOGGER_TRACE("resume tls session for host " + host);
+    }
+  }
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
   std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>> createWsStream(net::io_context* iocPtr, net::ssl::context* ctxPtr) {
@@ -643,6 +731,7 @@ class Service : public std::enable_shared_from_this<Service> {
     // #ifdef CCAPI_DISABLE_NAGLE_ALGORITHM
     beast::get_lowest_layer(stream).socket().set_option(tcp::no_delay(true));
     // #endif
+    this->setSocketBusyPoll(beast::get_lowest_layer(stream).socket());
     CCAPI_LOGGER_TRACE("before ssl async_handshake");
     stream.async_handshake(ssl::stream_base::client,
                            beast::bind_front_handler(&Service::onSslHandshake_2, shared_from_this(), httpConnectionPtr, request, req, retry, eventQueuePtr));
@@ -657,6 +746,7 @@ class Service : public std::enable_shared_from_this<Service> {
       return;
     }
     CCAPI_LOGGER_TRACE("ssl handshaked");
+    this->serviceContextPtr->tlsSessionCachePtr->onHandshake(httpConnectionPtr->streamPtr->native_handle());
     this->startWrite_2(httpConnectionPtr, request, req, retry, eventQueuePtr);
   }
   void startWrite_2(std::shared_ptr<HttpConnection> httpConnectionPtr, Request request, http::request<http::string_body> req, HttpRetry retry,
@@ -678,7 +768,9 @@ class Service : public std::enable_shared_from_this<Service> {
     if (ec) {
       CCAPI_LOGGER_TRACE("fail");
       this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "write", {request.getCorrelationId()}, eventQueuePtr);
-      this->httpConnectionPool[request.getLocalIpAddress()][request.getBaseUrl()].clear();
+      if (!this->sessionOptions.enableOneHttpConnectionPerRequest) {
+        this->getHttpConnectionPool(request.getLocalIpAddress(), request.getBaseUrl()).clearIdle();
+      }
       auto now = UtilTime::now();
       auto req = this->convertRequest(request, now);
       retry.numRetry += 1;
@@ -687,17 +779,51 @@ class Service : public std::enable_shared_from_this<Service> {
     }
     CCAPI_LOGGER_TRACE("written");
     std::shared_ptr<beast::flat_buffer> bufferPtr(new beast::flat_buffer());
-    std::shared_ptr<http::response<http::string_body>> resPtr(new http::response<http::string_body>());
     beast::ssl_stream<beast::tcp_stream>& stream = *httpConnectionPtr->streamPtr;
+    std::string streamedResponseBodyArrayKey;
+    if (this->sessionOptions.enableStreamHttpResponseBody) {
+      streamedResponseBodyArrayKey = this->getStreamedResponseBodyArrayKey(request);
+    }
+    if (!streamedResponseBodyArrayKey.empty()) {
+      std::shared_ptr<StreamedResponse> streamedResponsePtr(new StreamedResponse());
+      std::shared_ptr<http::response_parser<JsonRecordStreamBody>> parserPtr(new http::response_parser<JsonRecordStreamBody>());
+      // only the envelope and one record are held in memory at a time for a successful response, the body enforces the default limit itself on any other
+      // response, since the parser checks its own limit before the status is known to the body
+      parserPtr->body_limit(std::numeric_limits<std::uint64_t>::max());
+      auto& body = parserPtr->get().body();
+      body.arrayKey = streamedResponseBodyArrayKey;
+      body.recordHandler = [this, request, streamedResponsePtr](std::string_view record) {
+        if (streamedResponsePtr->exceptionPtr || !streamedResponsePtr->errorMessage.empty()) {
+          return;
+        }
+        try {
+          this->processStreamedResponseBodyRecord(request, record, *streamedResponsePtr);
+        } catch (...) {
+          streamedResponsePtr->exceptionPtr = std::current_exception();
+        }
+      };
+      std::shared_ptr<http::response<JsonRecordStreamBody>> resPtr(parserPtr, &parserPtr->get());
+      CCAPI_LOGGER_TRACE("before async_read");
+      http::async_read(stream, *bufferPtr, *parserPtr,
+                       beast::bind_front_handler(&Service::onRead_2<JsonRecordStreamBody>, shared_from_this(), httpConnectionPtr, request, reqPtr, retry,
+                                                 bufferPtr, resPtr, streamedResponsePtr, eventQueuePtr));
+      CCAPI_LOGGER_TRACE("after async_read");
+      return;
+    }
+    std::shared_ptr<http::response<http::string_body>> resPtr(new http::response<http::string_body>());
     CCAPI_LOGGER_TRACE("before async_read");
-    http::async_read(
-        stream, *bufferPtr, *resPtr,
-        beast::bind_front_handler(&Service::onRead_2, shared_from_this(), httpConnectionPtr, request, reqPtr, retry, bufferPtr, resPtr, eventQueuePtr));
+    http::async_read(stream, *bufferPtr, *resPtr,
+                     beast::bind_front_handler(&Service::onRead_2<http::string_body>, shared_from_this(), httpConnectionPtr, request, reqPtr, retry, bufferPtr,
+                                               resPtr, std::shared_ptr<StreamedResponse>(), eventQueuePtr));
     CCAPI_LOGGER_TRACE("after async_read");
   }
+  static const std::string& getResponseBodyText(const std::string& body) { return body; }
+  static const std::string& getResponseBodyText(const JsonRecordStreamBody::value_type& body) { return body.envelope; }
+  // streamedResponsePtr is only set for a body whose records have been processed while it was being received
+  template <typename Body>
   void onRead_2(std::shared_ptr<HttpConnection> httpConnectionPtr, Request request, std::shared_ptr<http::request<http::string_body>> reqPtr, HttpRetry retry,
-                std::shared_ptr<beast::flat_buffer> bufferPtr, std::shared_ptr<http::response<http::string_body>> resPtr, Queue<Event>* eventQueuePtr,
-                beast::error_code ec, std::size_t bytes_transferred) {
+                std::shared_ptr<beast::flat_buffer> bufferPtr, std::shared_ptr<http::response<Body>> resPtr,
+                std::shared_ptr<StreamedResponse> streamedResponsePtr, Queue<Event>* eventQueuePtr, beast::error_code ec, std::size_t bytes_transferred) {
     CCAPI_LOGGER_TRACE("async_read callback start");
     CCAPI_LOGGER_TRACE("local endpoint has address " + beast::get_lowest_layer(*httpConnectionPtr->streamPtr).socket().local_endpoint().address().to_string());
     auto now = UtilTime::now();
@@ -705,25 +831,24 @@ class Service : public std::enable_shared_from_this<Service> {
     if (ec) {
       CCAPI_LOGGER_TRACE("fail");
       this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "read", {request.getCorrelationId()}, eventQueuePtr);
-      this->httpConnectionPool[request.getLocalIpAddress()][request.getBaseUrl()].clear();
+      if (!this->sessionOptions.enableOneHttpConnectionPerRequest) {
+        this->getHttpConnectionPool(request.getLocalIpAddress(), request.getBaseUrl()).clearIdle();
+      }
       auto now = UtilTime::now();
       auto req = this->convertRequest(request, now);
       retry.numRetry += 1;
       this->tryRequest(request, req, retry, eventQueuePtr);
       return;
     }
-    if (!this->sessionOptions.enableOneHttpConnectionPerRequest) {
+    // a connection the server is about to close is left to be destroyed, which makes room in the pool for a new one
+    if (!this->sessionOptions.enableOneHttpConnectionPerRequest && resPtr->keep_alive()) {
       httpConnectionPtr->lastReceiveDataTp = now;
       const auto& localIpAddress = request.getLocalIpAddress();
       const auto& requestBaseUrl = request.getBaseUrl();
-      if (this->sessionOptions.httpConnectionPoolMaxSize > 0 &&
-          this->httpConnectionPool[localIpAddress][requestBaseUrl].size() >= this->sessionOptions.httpConnectionPoolMaxSize) {
-        CCAPI_LOGGER_TRACE("httpConnectionPool is full for localIpAddress = " + localIpAddress + ", requestBaseUrl = " + toString(requestBaseUrl));
-        this->httpConnectionPool[localIpAddress][requestBaseUrl].pop_front();
-      }
-      this->httpConnectionPool[localIpAddress][requestBaseUrl].push_back(httpConnectionPtr);
-      CCAPI_LOGGER_TRACE("pushed back httpConnectionPtr " + toString(*httpConnectionPtr) + " to httpConnectionPool for localIpAddress = " + localIpAddress +
+      CCAPI_LOGGER_TRACE("release httpConnectionPtr " + toString(*httpConnectionPtr) + " to httpConnectionPool for localIpAddress = " + localIpAddress +
                          ", requestBaseUrl = " + toString(requestBaseUrl));
+      this->getHttpConnectionPool(localIpAddress, requestBaseUrl).release(httpConnectionPtr);
+      this->scheduleHttpConnectionKeepAliveProbe();
     }
 #if defined(CCAPI_ENABLE_LOG_DEBUG) || defined(CCAPI_ENABLE_LOG_TRACE)
     {
@@ -738,10 +863,21 @@ class Service : public std::enable_shared_from_this<Service> {
     }
 #endif
     int statusCode = resPtr->result_int();
-    std::string body = resPtr->body();
+    const std::string& body = getResponseBodyText(resPtr->body());
     try {
       if (statusCode / 100 == 2) {
-        this->processSuccessfulTextMessageRest(statusCode, request, body, now, eventQueuePtr);
+        if (streamedResponsePtr) {
+          if (streamedResponsePtr->exceptionPtr) {
+            std::rethrow_exception(streamedResponsePtr->exceptionPtr);
+          }
+          if (!streamedResponsePtr->errorMessage.empty()) {
+            this->onResponseError(request, statusCode, streamedResponsePtr->errorMessage, eventQueuePtr);
+          } else {
+            this->processSuccessfulStreamedTextMessageRest(statusCode, request, body, *streamedResponsePtr, now, eventQueuePtr);
+          }
+        } else {
+          this->processSuccessfulTextMessageRest(statusCode, request, body, now, eventQueuePtr);
+        }
       } else if (statusCode / 100 == 3) {
         if (resPtr->base().find("Location") != resPtr->base().end()) {
           Url url(resPtr->base()
@@ -795,7 +931,11 @@ class Service : public std::enable_shared_from_this<Service> {
       retry.promisePtr->set_value();
     }
   }
-  virtual bool doesHttpBodyContainError(const std::string& body) { return false; }
+  // an exchange declares how its response bodies report success or failure by filling httpBodySuccessConditionList or httpBodyErrorConditionList
+  virtual bool doesHttpBodyContainError(const std::string& body) {
+    return (!this->httpBodySuccessConditionList.empty() && !JsonScanner::matchAny(body, this->httpBodySuccessConditionList)) ||
+           JsonScanner::matchAny(body, this->httpBodyErrorConditionList);
+  }
   void tryRequest(const Request& request, http::request<http::string_body>& req, const HttpRetry& retry, Queue<Event>* eventQueuePtr) {
     CCAPI_LOGGER_FUNCTION_ENTER;
 #if defined(CCAPI_ENABLE_LOG_DEBUG) || defined(CCAPI_ENABLE_LOG_TRACE)
@@ -808,17 +948,71 @@ class Service : public std::enable_shared_from_this<Service> {
       try {
         const auto& localIpAddress = request.getLocalIpAddress();
         const auto& requestBaseUrl = request.getBaseUrl();
-        if (this->sessionOptions.enableOneHttpConnectionPerRequest || this->httpConnectionPool[localIpAddress][requestBaseUrl].empty() ||
-            std::chrono::duration_cast<std::chrono::seconds>(request.getTimeSent() -
-                                                             this->httpConnectionPool[localIpAddress][requestBaseUrl].back()->lastReceiveDataTp)
-                    .count() >= this->sessionOptions.httpConnectionKeepAliveTimeoutSeconds) {
-          this->httpConnectionPool[localIpAddress][requestBaseUrl].clear();
+        std::shared_ptr<HttpConnection> httpConnectionPtr;
+        bool isNewConnectionReserved = false;
+        if (!this->sessionOptions.enableOneHttpConnectionPerRequest) {
+          HttpConnectionPool& httpConnectionPool = this->getHttpConnectionPool(localIpAddress, requestBaseUrl);
+          httpConnectionPtr = httpConnectionPool.acquire(UtilTime::now());
+          if (!httpConnectionPtr) {
+            isNewConnectionReserved = httpConnectionPool.tryReserve();
+            if (!isNewConnectionReserved) {
+              // the wait counts against the request timeout, past which the request fails, without a timeout nothing would bound it
+              if (this->sessionOptions.httpRequestTimeoutMilliseconds <= 0) {
+                CCAPI_LOGGER_WARN("all http connections are busy for localIpAddress = " + localIpAddress + ", requestBaseUrl = " + toString(requestBaseUrl) +
+                                  " and httpRequestTimeoutMilliseconds is not positive");
+                this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, std::runtime_error("all http connections are busy"),
+                              {request.getCorrelationId()}, eventQueuePtr);
+                if (retry.promisePtr) {
+                  retry.promisePtr->set_value();
+                }
+                return;
+              }
+              CCAPI_LOGGER_DEBUG("all http connections are busy for localIpAddress = " + localIpAddress + ", requestBaseUrl = " + toString(requestBaseUrl) +
+                                 ", wait for one");
+              auto waitTimerPtr = std::make_shared<boost::asio::steady_timer>(*this->serviceContextPtr->ioContextPtr,
+                                                                              std::chrono::milliseconds(this->sessionOptions.httpRequestTimeoutMilliseconds));
+              // the pool belongs to the service, so the waiter must not keep the service alive
+              size_t waiterId = httpConnectionPool.wait([weakThis = this->weak_from_this(), request, req, retry, eventQueuePtr,
+                                                         waitTimerPtr](std::shared_ptr<HttpConnection> httpConnectionPtr) mutable {
+                waitTimerPtr->cancel();
+                auto that = weakThis.lock();
+                if (!that) {
+                  return;
+                }
+                if (httpConnectionPtr) {
+                  that->startWrite_2(httpConnectionPtr, request, req, retry, eventQueuePtr);
+                } else {
+                  that->tryRequest(request, req, retry, eventQueuePtr);
+                }
+              });
+              waitTimerPtr->async_wait([weakThis = this->weak_from_this(), localIpAddress, requestBaseUrl, waiterId, request, retry,
+                                        eventQueuePtr](const ErrorCode& ec) {
+                auto that = weakThis.lock();
+                if (ec || !that || !that->getHttpConnectionPool(localIpAddress, requestBaseUrl).expireWaiter(waiterId)) {
+                  return;
+                }
+                CCAPI_LOGGER_WARN("timed out waiting for an http connection for localIpAddress = " + localIpAddress +
+                                  ", requestBaseUrl = " + toString(requestBaseUrl));
+                that->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, std::runtime_error("timed out waiting for an http connection"),
+                              {request.getCorrelationId()}, eventQueuePtr);
+                if (retry.promisePtr) {
+                  retry.promisePtr->set_value();
+                }
+              });
+              return;
+            }
+          }
+        }
+        if (!httpConnectionPtr) {
           std::shared_ptr<beast::ssl_stream<beast::tcp_stream>> streamPtr(nullptr);
           try {
             streamPtr = this->createStream<beast::ssl_stream<beast::tcp_stream>>(this->serviceContextPtr->ioContextPtr, this->serviceContextPtr->sslContextPtr,
                                                                                  this->hostRest);
           } catch (const beast::error_code& ec) {
             CCAPI_LOGGER_TRACE("fail");
+            if (isNewConnectionReserved) {
+              this->getHttpConnectionPool(localIpAddress, requestBaseUrl).onClose();
+            }
             this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "create stream", {request.getCorrelationId()}, eventQueuePtr);
             return;
           }
@@ -830,17 +1024,21 @@ class Service : public std::enable_shared_from_this<Service> {
             host = request.getHost();
             port = request.getPort();
           }
-          std::shared_ptr<HttpConnection> httpConnectionPtr(new HttpConnection(host, port, streamPtr));
+          httpConnectionPtr.reset(new HttpConnection(host, port, streamPtr));
+          if (isNewConnectionReserved) {
+            httpConnectionPtr->closeHandler = this->makeHttpConnectionCloseHandler(localIpAddress, requestBaseUrl);
+          }
           CCAPI_LOGGER_WARN("about to perform request with new httpConnectionPtr " + toString(*httpConnectionPtr) + " for localIpAddress = " + localIpAddress +
                             ", requestBaseUrl = " + toString(requestBaseUrl));
           this->performRequestWithNewHttpConnection(httpConnectionPtr, request, req, retry, eventQueuePtr);
         } else {
-          std::shared_ptr<HttpConnection> httpConnectionPtr = this->httpConnectionPool[localIpAddress][requestBaseUrl].back();
-          this->httpConnectionPool[localIpAddress][requestBaseUrl].pop_back();
           CCAPI_LOGGER_TRACE("about to perform request with existing httpConnectionPtr " + toString(*httpConnectionPtr) +
                              " for localIpAddress = " + localIpAddress + ", requestBaseUrl = " + toString(requestBaseUrl));
           this->startWrite_2(httpConnectionPtr, request, req, retry, eventQueuePtr);
         }
+        if (!this->sessionOptions.enableOneHttpConnectionPerRequest) {
+          this->replenishSpareHttpConnections(localIpAddress, requestBaseUrl);
+        }
       } catch (const std::exception& e) {
         CCAPI_LOGGER_ERROR(std::string("e.what() = ") + e.what());
         this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, e, {request.getCorrelationId()}, eventQueuePtr);
@@ -856,6 +1054,207 @@ class Service : public std::enable_shared_from_this<Service> {
     }
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
+  HttpConnectionPool& getHttpConnectionPool(const std::string& localIpAddress, const std::string& baseUrl) {
+    auto& httpConnectionPoolByBaseUrlMap = this->httpConnectionPool[localIpAddress];
+    auto it = httpConnectionPoolByBaseUrlMap.find(baseUrl);
+    if (it == httpConnectionPoolByBaseUrlMap.end()) {
+      it = httpConnectionPoolByBaseUrlMap
+               .emplace(std::piecewise_construct, std::forward_as_tuple(baseUrl),
+                        std::forward_as_tuple(std::max(this->sessionOptions.httpConnectionPoolMaxNumConnection, 0),
+                                              std::max(this->sessionOptions.httpConnectionPoolMaxSize, 0),
+                                              this->sessionOptions.httpConnectionKeepAliveTimeoutSeconds, this->httpConnectionPoolMetricsCounterPtr))
+               .first;
+    }
+    return it->second;
+  }
+  // frees the room of a destroyed connection in its pool, later on the io_context since the connection can be destroyed while the pool is being modified
+  std::function<void()> makeHttpConnectionCloseHandler(const std::string& localIpAddress, const std::string& baseUrl) {
+    std::weak_ptr<Service> weakThis = this->weak_from_this();
+    auto ioContextPtr = this->serviceContextPtr->ioContextPtr;
+    return [weakThis, ioContextPtr, localIpAddress, baseUrl]() {
+      if (auto that = weakThis.lock()) {
+        boost::asio::post(*ioContextPtr, [that, localIpAddress, baseUrl]() { that->getHttpConnectionPool(localIpAddress, baseUrl).onClose(); });
+      }
+    };
+  }
+  void scheduleHttpConnectionKeepAliveProbe() {
+    if (this->sessionOptions.httpConnectionKeepAliveProbeIntervalSeconds <= 0 || this->httpConnectionKeepAliveProbeTimerPtr || !this->shouldContinue.load()) {
+      return;
+    }
+    this->httpConnectionKeepAliveProbeTimerPtr = std::make_shared<boost::asio::steady_timer>(
+        *this->serviceContextPtr->ioContextPtr, std::chrono::seconds(this->sessionOptions.httpConnectionKeepAliveProbeIntervalSeconds));
+    // a weak pointer so that the timer does not keep the service alive
+    std::weak_ptr<Service> weakThis = this->weak_from_this();
+    this->httpConnectionKeepAliveProbeTimerPtr->async_wait([weakThis](const ErrorCode& ec) {
+      auto that = weakThis.lock();
+      if (ec || !that) {
+        return;
+      }
+      that->httpConnectionKeepAliveProbeTimerPtr = nullptr;
+      that->probeHttpConnections();
+    });
+  }
+  // sends a probe request on each connection which has been idle for a probe interval, the timer is rescheduled while some connections are live
+  void probeHttpConnections() {
+    auto now = UtilTime::now();
+    bool hasConnection = false;
+    for (auto& x : this->httpConnectionPool) {
+      for (auto& y : x.second) {
+        for (const auto& httpConnectionPtr : y.second.takeIdleToProbe(now, this->sessionOptions.httpConnectionKeepAliveProbeIntervalSeconds)) {
+          this->startHttpConnectionKeepAliveProbe(httpConnectionPtr, x.first, y.first);
+        }
+        hasConnection = hasConnection || y.second.getNumConnection() > 0;
+      }
+    }
+    if (hasConnection) {
+      this->scheduleHttpConnectionKeepAliveProbe();
+    }
+  }
+  void startHttpConnectionKeepAliveProbe(std::shared_ptr<HttpConnection> httpConnectionPtr, const std::string& localIpAddress, const std::string& baseUrl) {
+    CCAPI_LOGGER_TRACE("keep-alive probe on httpConnectionPtr " + toString(*httpConnectionPtr));
+    beast::ssl_stream<beast::tcp_stream>& stream = *httpConnectionPtr->streamPtr;
+    if (this->sessionOptions.httpRequestTimeoutMilliseconds > 0) {
+      beast::get_lowest_layer(stream).expires_after(std::chrono::milliseconds(this->sessionOptions.httpRequestTimeoutMilliseconds));
+    }
+    std::shared_ptr<http::request<http::string_body>> reqPtr(new http::request<http::string_body>(http::verb::get, this->httpKeepAliveProbeTarget, 11));
+    reqPtr->keep_alive(true);
+    reqPtr->set(http::field::host, httpConnectionPtr->host);
+    reqPtr->set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+    http::async_write(stream, *reqPtr,
+                      [that = shared_from_this(), httpConnectionPtr, reqPtr, localIpAddress, baseUrl](const beast::error_code& ec, std::size_t) {
+                        if (ec) {
+                          CCAPI_LOGGER_DEBUG("keep-alive probe write error: " + ec.message());
+                          that->getHttpConnectionPool(localIpAddress, baseUrl).onKeepAliveProbeFailure();
+                          return;
+                        }
+                        std::shared_ptr<beast::flat_buffer> bufferPtr(new beast::flat_buffer());
+                        std::shared_ptr<http::response<http::string_body>> resPtr(new http::response<http::string_body>());
+                        http::async_read(*httpConnectionPtr->streamPtr, *bufferPtr, *resPtr,
+                                         [that, httpConnectionPtr, bufferPtr, resPtr, localIpAddress, baseUrl](const beast::error_code& ec, std::size_t) {
+                                           HttpConnectionPool& httpConnectionPool = that->getHttpConnectionPool(localIpAddress, baseUrl);
+                                           if (ec || !resPtr->keep_alive()) {
+                                             CCAPI_LOGGER_DEBUG("keep-alive probe failed: " + (ec ? ec.message() : std::string("closed by the server")));
+                                             httpConnectionPool.onKeepAliveProbeFailure();
+                                             return;
+                                           }
+                                           httpConnectionPtr->lastReceiveDataTp = UtilTime::now();
+                                           httpConnectionPool.release(httpConnectionPtr);
+                                         });
+                      });
+  }
+  // opens spare connections until httpConnectionPoolNumSpareConnection connections of the pool are idle, ready for the next requests, and keeps them so
+  void replenishSpareHttpConnections(const std::string& localIpAddress, const std::string& baseUrl) {
+    if (this->sessionOptions.httpConnectionPoolNumSpareConnection <= 0 || !this->shouldContinue.load()) {
+      return;
+    }
+    HttpConnectionPool& httpConnectionPool = this->getHttpConnectionPool(localIpAddress, baseUrl);
+    auto now = UtilTime::now();
+    // the spare connections are checked every half keep-alive timeout, so those which would expire before the next check are replaced ahead of time
+    while (httpConnectionPool.tryReserveSpare(this->sessionOptions.httpConnectionPoolNumSpareConnection, now,
+                                              this->sessionOptions.httpConnectionKeepAliveTimeoutSeconds / 2)) {
+      this->startSpareHttpConnection(localIpAddress, baseUrl);
+    }
+    this->scheduleSpareHttpConnectionReplenish();
+  }
+  // independent of the keep-alive probes, so that the spare connections which expire while no request is sent are replaced
+  void scheduleSpareHttpConnectionReplenish() {
+    if (this->httpSpareConnectionTimerPtr || !this->shouldContinue.load()) {
+      return;
+    }
+    this->httpSpareConnectionTimerPtr = std::make_shared<boost::asio::steady_timer>(
+        *this->serviceContextPtr->ioContextPtr, std::chrono::seconds(std::max(this->sessionOptions.httpConnectionKeepAliveTimeoutSeconds / 2, 1L)));
+    // a weak pointer so that the timer does not keep the service alive
+    std::weak_ptr<Service> weakThis = this->weak_from_this();
+    this->httpSpareConnectionTimerPtr->async_wait([weakThis](const ErrorCode& ec) {
+      auto that = weakThis.lock();
+      if (ec || !that) {
+        return;
+      }
+      that->httpSpareConnectionTimerPtr = nullptr;
+      for (const auto& x : that->httpConnectionPool) {
+        for (const auto& y : x.second) {
+          that->replenishSpareHttpConnections(x.first, y.first);
+        }
+      }
+    });
+  }
+  void startSpareHttpConnection(const std::string& localIpAddress, const std::string& baseUrl) {
+    std::pair<std::string, std::string> hostPort = baseUrl.empty() ? std::make_pair(this->hostRest, this->portRest) : this->extractHostFromUrl(baseUrl);
+    std::shared_ptr<beast::ssl_stream<beast::tcp_stream>> streamPtr(nullptr);
+    try {
+      streamPtr = this->createStream<beast::ssl_stream<beast::tcp_stream>>(this->serviceContextPtr->ioContextPtr, this->serviceContextPtr->sslContextPtr,
+                                                                           hostPort.first);
+    } catch (const beast::error_code& ec) {
+      CCAPI_LOGGER_WARN("spare http connection create stream error: " + ec.message());
+      HttpConnectionPool& httpConnectionPool = this->getHttpConnectionPool(localIpAddress, baseUrl);
+      httpConnectionPool.releaseSpare(nullptr);
+      httpConnectionPool.onClose();
+      return;
+    }
+    // from here on, a failure drops httpConnectionPtr, whose close handler frees its room in the pool
+    std::shared_ptr<HttpConnection> httpConnectionPtr(new HttpConnection(hostPort.first, hostPort.second, streamPtr));
+    httpConnectionPtr->closeHandler = this->makeHttpConnectionCloseHandler(localIpAddress, baseUrl);
+    CCAPI_LOGGER_DEBUG("about to open spare httpConnectionPtr " + toString(*httpConnectionPtr) + " for localIpAddress = " + localIpAddress +
+                       ", baseUrl = " + toString(baseUrl));
+    std::shared_ptr<tcp::resolver> newResolverPtr(new tcp::resolver(*this->serviceContextPtr->ioContextPtr));
+    newResolverPtr->async_resolve(
+        httpConnectionPtr->host, httpConnectionPtr->port,
+        [that = shared_from_this(), httpConnectionPtr, newResolverPtr, localIpAddress, baseUrl](const beast::error_code& ec,
+                                                                                                tcp::resolver::results_type tcpNewResolverResults) {
+          if (ec) {
+            that->onSpareHttpConnectionFail(localIpAddress, baseUrl, "DNS resolve", ec);
+            return;
+          }
+          that->connectSpareHttpConnection(httpConnectionPtr, localIpAddress, baseUrl, tcpNewResolverResults);
+        });
+  }
+  void connectSpareHttpConnection(std::shared_ptr<HttpConnection> httpConnectionPtr, const std::string& localIpAddress, const std::string& baseUrl,
+                                  tcp::resolver::results_type tcpNewResolverResults) {
+    beast::tcp_stream& tcpStream = beast::get_lowest_layer(*httpConnectionPtr->streamPtr);
+    if (this->sessionOptions.httpRequestTimeoutMilliseconds > 0) {
+      tcpStream.expires_after(std::chrono::milliseconds(this->sessionOptions.httpRequestTimeoutMilliseconds));
+    }
+    auto onConnect = [that = shared_from_this(), httpConnectionPtr, localIpAddress, baseUrl](const beast::error_code& ec) {
+      if (ec) {
+        that->onSpareHttpConnectionFail(localIpAddress, baseUrl, "connect", ec);
+        return;
+      }
+      beast::ssl_stream<beast::tcp_stream>& stream = *httpConnectionPtr->streamPtr;
+      beast::get_lowest_layer(stream).socket().set_option(tcp::no_delay(true));
+      that->setSocketBusyPoll(beast::get_lowest_layer(stream).socket());
+      stream.async_handshake(ssl::stream_base::client, [that, httpConnectionPtr, localIpAddress, baseUrl](const beast::error_code& ec) {
+        if (ec) {
+          that->onSpareHttpConnectionFail(localIpAddress, baseUrl, "ssl handshake", ec);
+          return;
+        }
+        that->serviceContextPtr->tlsSessionCachePtr->onHandshake(httpConnectionPtr->streamPtr->native_handle());
+        beast::get_lowest_layer(*httpConnectionPtr->streamPtr).expires_never();
+        httpConnectionPtr->lastReceiveDataTp = UtilTime::now();
+        CCAPI_LOGGER_DEBUG("spare httpConnectionPtr " + toString(*httpConnectionPtr) + " is ready");
+        that->getHttpConnectionPool(localIpAddress, baseUrl).releaseSpare(httpConnectionPtr);
+        that->scheduleHttpConnectionKeepAliveProbe();
+      });
+    };
+    if (localIpAddress.empty()) {
+      tcpStream.async_connect(tcpNewResolverResults, [onConnect](const beast::error_code& ec, const tcp::endpoint&) { onConnect(ec); });
+      return;
+    }
+    // connecting to a single endpoint keeps the socket, and therefore the local ip address it is bound to
+    ErrorCode ec;
+    tcpStream.socket().open(net::ip::tcp::v4(), ec);
+    if (!ec) {
+      tcpStream.socket().bind(tcp::endpoint(net::ip::address::from_string(localIpAddress), 0), ec);
+    }
+    if (ec || tcpNewResolverResults.empty()) {
+      this->onSpareHttpConnectionFail(localIpAddress, baseUrl, "socket bind", ec);
+      return;
+    }
+    tcpStream.async_connect(*tcpNewResolverResults.begin(), onConnect);
+  }
+  void onSpareHttpConnectionFail(const std::string& localIpAddress, const std::string& baseUrl, const std::string& what, const beast::error_code& ec) {
+    CCAPI_LOGGER_WARN("spare http connection " + what + " error: " + ec.message() + ", localIpAddress = " + localIpAddress + ", baseUrl = " + baseUrl);
+    this->getHttpConnectionPool(localIpAddress, baseUrl).releaseSpare(nullptr);
+  }
   http::request<http::string_body> convertRequest(const Request& request, const TimePoint& now) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     auto credential = request.getCredential();
@@ -1316,6 +1715,7 @@ class Service : public std::enable_shared_from_this<Service> {
       this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, ec, "set SNI Hostname", wsConnectionPtr->correlationIdList);
       return;
     }
+    this->resumeTlsSession(stream.next_layer().native_handle(), wsConnectionPtr->host);
     CCAPI_LOGGER_TRACE("before async_connect");
     beast::get_lowest_layer(stream).async_connect(tcpResolverResults, beast::bind_front_handler(&Service::onConnectWs, shared_from_this(), wsConnectionPtr));
     CCAPI_LOGGER_TRACE("after async_connect");
@@ -1334,6 +1734,7 @@ class Service : public std::enable_shared_from_this<Service> {
     CCAPI_LOGGER_TRACE("wsConnectionPtr->hostHttpHeaderValue = " + wsConnectionPtr->hostHttpHeaderValue);
     beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>& stream = *wsConnectionPtr->streamPtr;
     beast::get_lowest_layer(stream).socket().set_option(tcp::no_delay(true));
+    this->setSocketBusyPoll(beast::get_lowest_layer(stream).socket());
     CCAPI_LOGGER_TRACE("before ssl async_handshake");
     stream.next_layer().async_handshake(ssl::stream_base::client, beast::bind_front_handler(&Service::onSslHandshakeWs, shared_from_this(), wsConnectionPtr));
     CCAPI_LOGGER_TRACE("after ssl async_handshake");
@@ -1347,6 +1748,7 @@ class Service : public std::enable_shared_from_this<Service> {
     }
     CCAPI_LOGGER_TRACE("ssl handshaked");
     beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>& stream = *wsConnectionPtr->streamPtr;
+    this->serviceContextPtr->tlsSessionCachePtr->onHandshake(stream.next_layer().native_handle());
     beast::get_lowest_layer(stream).expires_never();
     beast::websocket::stream_base::timeout opt{std::chrono::milliseconds(this->sessionOptions.websocketConnectTimeoutMilliseconds),
                                                std::chrono::milliseconds(this->sessionOptions.pongWebsocketProtocolLevelTimeoutMilliseconds), true};
@@ -1800,6 +2202,25 @@ class Service : public std::enable_shared_from_this<Service> {
     }
     return std::to_string(std::stoll(input.substr(0, dotPosition)) * 1000 + std::stoll(UtilString::rightPadTo(input.substr(dotPosition + 1, 3), 3, '0')));
   }
+  // copies a websocket text message into a buffer reused across messages so that it can be parsed in situ without an allocation per message, the message
+  // itself is left intact because it is still reported on errors, the returned pointer stays valid until the next call
+  char* copyToInsituParseBuffer(const char* data, size_t size) {
+    this->insituParseBuffer.assign(data, size);
+    return &this->insituParseBuffer[0];
+  }
+  // empties the arena from which the documents parsed from received messages are allocated and returns it, the previous document created from it must
+  // already be destroyed, which holds since messages are processed one at a time on the io_context thread, nothing is freed to or taken from the heap
+  // unless a message outgrows CCAPI_JSON_PARSE_ARENA_SIZE, the arena is only allocated on the first call so that services which never parse into it do not
+  // pay for it
+  rj::MemoryPoolAllocator<>& resetJsonParseArena() {
+    if (!this->jsonParseArenaPtr) {
+      this->jsonParseArenaBuffer.reset(new char[CCAPI_JSON_PARSE_ARENA_SIZE]);
+      this->jsonParseArenaPtr.reset(new rj::MemoryPoolAllocator<>(this->jsonParseArenaBuffer.get(), CCAPI_JSON_PARSE_ARENA_SIZE));
+    }
+    this->jsonParseArenaPtr->Clear();
+    return *this->jsonParseArenaPtr;
+  }
+  static std::string_view toStringView(const rj::Value& value) { return std::string_view(value.GetString(), value.GetStringLength()); }
   virtual void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, boost::beast::string_view textMessage, const TimePoint& timeReceived) {}
 #endif
   bool hostHttpHeaderValueIgnorePort{};
@@ -1818,7 +2239,11 @@ class Service : public std::enable_shared_from_this<Service> {
   std::string hostWs;
   std::string portWs;
   // tcp::resolver::results_type tcpResolverResultsRest, tcpResolverResultsWs;
-  std::map<std::string, std::map<std::string, std::deque<std::shared_ptr<HttpConnection>>>> httpConnectionPool;
+  std::map<std::string, std::map<std::string, HttpConnectionPool>> httpConnectionPool;
+  std::shared_ptr<HttpConnectionPool::MetricsCounter> httpConnectionPoolMetricsCounterPtr{std::make_shared<HttpConnectionPool::MetricsCounter>()};
+  TimerPtr httpConnectionKeepAliveProbeTimerPtr{nullptr};
+  TimerPtr httpSpareConnectionTimerPtr{nullptr};
+  std::string httpKeepAliveProbeTarget{"/"};  // a cheap endpoint of the exchange for the keep-alive probes, a response with any status keeps the connection
   std::map<std::string, std::string> credentialDefault;
   std::map<std::string, TimerPtr> sendRequestDelayTimerByCorrelationIdMap;
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
@@ -1847,6 +2272,11 @@ class Service : public std::enable_shared_from_this<Service> {
   // std::regex convertNumberToStringInJsonRegex{"(\\[|,|\":)\\s?(-?\\d+\\.?\\d*)"};
   // std::string convertNumberToStringInJsonRewrite{"$1\"$2\""};
   bool needDecompressWebsocketMessage{};
+  std::string insituParseBuffer;
+  std::vector<JsonScanner::Condition> httpBodySuccessConditionList;  // if not empty, a body matching none of them contains an error
+  std::vector<JsonScanner::Condition> httpBodyErrorConditionList;    // a body matching any of them contains an error
+  std::unique_ptr<char[]> jsonParseArenaBuffer;
+  std::unique_ptr<rj::MemoryPoolAllocator<>> jsonParseArenaPtr;
 #if defined(CCAPI_ENABLE_SERVICE_MARKET_DATA) &&                                                                                                      \
         (defined(CCAPI_ENABLE_EXCHANGE_HUOBI) || defined(CCAPI_ENABLE_EXCHANGE_HUOBI_USDT_SWAP) || defined(CCAPI_ENABLE_EXCHANGE_HUOBI_COIN_SWAP)) || \
     defined(CCAPI_ENABLE_SERVICE_EXECUTION_MANAGEMENT) &&                                                                                             \
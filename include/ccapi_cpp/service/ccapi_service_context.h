@@ -1,7 +1,10 @@
 #ifndef INCLUDE_CCAPI_CPP_SERVICE_CCAPI_SERVICE_CONTEXT_H_
 #define INCLUDE_CCAPI_CPP_SERVICE_CCAPI_SERVICE_CONTEXT_H_
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
+#include <vector>
+
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_tls_session_cache.h"
 #include "websocketpp/client.hpp"
 #include "websocketpp/common/connection_hdl.hpp"
 #include "websocketpp/config/asio_client.hpp"
@@ -48,9 +51,13 @@ class ServiceContext CCAPI_FINAL {
     this->sslContextPtr->set_verify_mode(wspp::lib::asio::ssl::verify_none);
     // TODO(cryptochassis): verify ssl certificate to strengthen security
     // https://github.com/boostorg/asio/blob/develop/example/cpp03/ssl/client.cpp
+    this->tlsSessionCachePtr->install(this->sslContextPtr->native_handle());
   }
+  // only one io_service is supported, and it is always run with blocking waits
+  ServiceContext(const int numIoContext, const std::vector<int>& cpuList, const long busyPollSpinMicroseconds = 0) : ServiceContext() {}
   ServiceContext(const ServiceContext&) = delete;
   ServiceContext& operator=(const ServiceContext&) = delete;
+  ~ServiceContext() { this->tlsSessionCachePtr->uninstall(this->sslContextPtr->native_handle()); }
   void start() {
     CCAPI_LOGGER_INFO("about to start client asio io_service run loop");
     this->tlsClientPtr->start_perpetual();
@@ -62,17 +69,45 @@ class ServiceContext CCAPI_FINAL {
     this->tlsClientPtr->stop();
     this->tlsClientPtr->stop_perpetual();
   }
+  ServiceContext* getServiceContextForService() { return this; }
   IoContextPtr ioContextPtr{new IoContext()};
   TlsClientPtr tlsClientPtr{new TlsClient()};
   SslContextPtr sslContextPtr{new SslContext(SslContext::tls_client)};
+  std::shared_ptr<TlsSessionCache> tlsSessionCachePtr{std::make_shared<TlsSessionCache>()};
 };
 
 } /* namespace ccapi */
 #else
+#ifdef __linux__
+#include <pthread.h>
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_tls_session_cache.h"
 namespace ccapi {
 /**
- * Defines the service that the service depends on.
+ * Defines the service that the service depends on. It can also own numIoContext - 1 more io_contexts, each run by a thread of its own while start runs the
+ * first one. Each of these threads, including the one running start even with a single io_context, is optionally pinned to the matching CPU of cpuList.
+ * getServiceContextForService then hands out the io_contexts in turn, so that the services are spread over the threads while each service, with all its
+ * connections and timers, still runs on a single one. If busyPollSpinMicroseconds is positive, each io_context is run in a low latency mode: its thread keeps
+ * polling for ready handlers and only blocks in the reactor once no handler has been ready for that long, which saves the wakeup and the reschedule of the
+ * thread on a burst of inbound frames at the cost of a busy core. The io backend is chosen at build time: with BOOST_ASIO_HAS_IO_URING and
+ * BOOST_ASIO_DISABLE_EPOLL (the CMake option CCAPI_ENABLE_IO_URING) the sockets and timers of every io_context run on io_uring instead of epoll, and creating
+ * an io_context fails if the kernel does not support it. The TLS sessions of the client connections are kept per host in tlsSessionCachePtr, shared by all the
+ * io_contexts, so that reconnecting to a host resumes its last session.
  */
 class ServiceContext CCAPI_FINAL {
  public:
@@ -83,6 +118,7 @@ class ServiceContext CCAPI_FINAL {
   typedef boost::asio::ssl::context SslContext;
   typedef SslContext* SslContextPtr;
   ServiceContext() {
+    checkIoBackend();
     this->ioContextPtr = new boost::asio::io_context();
     this->executorWorkGuardPtr = new ExecutorWorkGuard(this->ioContextPtr->get_executor());
     this->sslContextPtr = new SslContext(SslContext::tls_client);
@@ -90,6 +126,7 @@ class ServiceContext CCAPI_FINAL {
     this->sslContextPtr->set_verify_mode(boost::asio::ssl::verify_none);
     // TODO(cryptochassis): verify ssl certificate to strengthen security
     // https://github.com/boostorg/asio/blob/develop/example/cpp03/ssl/client.cpp
+    this->tlsSessionCachePtr->install(this->sslContextPtr->native_handle());
   }
 #ifndef SWIG
   ServiceContext(IoContextPtr ioContextPtr) {
@@ -97,39 +134,201 @@ class ServiceContext CCAPI_FINAL {
     this->executorWorkGuardPtr = new ExecutorWorkGuard(this->ioContextPtr->get_executor());
     this->sslContextPtr = new SslContext(SslContext::tls_client);
     this->sslContextPtr->set_verify_mode(boost::asio::ssl::verify_none);
+    this->tlsSessionCachePtr->install(this->sslContextPtr->native_handle());
   }
   ServiceContext(SslContextPtr sslContextPtr) {
+    checkIoBackend();
     this->ioContextPtr = new boost::asio::io_context();
     this->executorWorkGuardPtr = new ExecutorWorkGuard(this->ioContextPtr->get_executor());
     this->sslContextPtr = sslContextPtr;
     this->sslContextPtr->set_verify_mode(boost::asio::ssl::verify_none);
+    this->tlsSessionCachePtr->install(this->sslContextPtr->native_handle());
   }
   ServiceContext(IoContextPtr ioContextPtr, SslContextPtr sslContextPtr) {
     this->ioContextPtr = ioContextPtr;
     this->executorWorkGuardPtr = new ExecutorWorkGuard(this->ioContextPtr->get_executor());
     this->sslContextPtr = sslContextPtr;
     this->sslContextPtr->set_verify_mode(boost::asio::ssl::verify_none);
+    this->tlsSessionCachePtr->install(this->sslContextPtr->native_handle());
   }
 #endif
+  ServiceContext(const int numIoContext, const std::vector<int>& cpuList, const long busyPollSpinMicroseconds = 0) : ServiceContext() {
+    this->cpuList = cpuList;
+    this->busyPollSpinMicroseconds = busyPollSpinMicroseconds;
+#ifdef CCAPI_USE_SINGLE_THREAD
+    // the event queue and the event handler are not guarded against being used from several io_context threads at once
+    if (numIoContext > 1) {
+      CCAPI_LOGGER_WARN("only one io_context is supported with CCAPI_USE_SINGLE_THREAD, numIoContext = " + std::to_string(numIoContext) + " is ignored");
+      return;
+    }
+#endif
+    for (int i = 1; i < numIoContext; ++i) {
+      this->serviceContextPtrList.emplace_back(new ServiceContext(new boost::asio::io_context(), this->sslContextPtr, this->tlsSessionCachePtr));
+      this->serviceContextPtrList.back()->busyPollSpinMicroseconds = busyPollSpinMicroseconds;
+    }
+  }
   ServiceContext(const ServiceContext&) = delete;
   ServiceContext& operator=(const ServiceContext&) = delete;
   virtual ~ServiceContext() {
+    for (auto& serviceContextPtr : this->serviceContextPtrList) {
+      serviceContextPtr->stop();
+    }
+    for (auto& thread : this->threadList) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
     delete this->executorWorkGuardPtr;
     delete this->ioContextPtr;
-    delete this->sslContextPtr;
+    if (this->isSslContextOwned) {
+      this->tlsSessionCachePtr->uninstall(this->sslContextPtr->native_handle());
+      delete this->sslContextPtr;
+    }
   }
+  // usually runs on a thread of its own while stop is called from another one, e.g. by Session, if stop comes first no thread is started and the run loop
+  // returns at once
   void start() {
+    {
+      std::lock_guard<std::mutex> lock(this->threadListLock);
+      if (this->isStopped) {
+        return;
+      }
+      for (size_t i = 0; i < this->serviceContextPtrList.size(); ++i) {
+        ServiceContext* serviceContextPtr = this->serviceContextPtrList[i].get();
+        this->threadList.emplace_back([serviceContextPtr] { serviceContextPtr->start(); });
+        this->pinToCpu(this->threadList.back().native_handle(), i + 1);
+      }
+    }
+#ifdef __linux__
+    this->pinToCpu(pthread_self(), 0);
+#endif
     CCAPI_LOGGER_INFO("about to start client asio io_context run loop");
-    this->ioContextPtr->run();
+    if (this->busyPollSpinMicroseconds > 0) {
+      this->runBusyPoll();
+    } else {
+      this->ioContextPtr->run();
+    }
     CCAPI_LOGGER_INFO("just exited client asio io_context run loop");
   }
   void stop() {
+    std::vector<std::thread> threadList;
+    {
+      std::lock_guard<std::mutex> lock(this->threadListLock);
+      this->isStopped = true;
+      std::swap(threadList, this->threadList);
+    }
+    for (auto& serviceContextPtr : this->serviceContextPtrList) {
+      serviceContextPtr->stop();
+    }
     this->executorWorkGuardPtr->reset();
     this->ioContextPtr->stop();
+    for (auto& thread : threadList) {
+      if (thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
+        thread.join();
+      }
+    }
+    // a thread which stops its own service context is joined by the destructor
+    std::lock_guard<std::mutex> lock(this->threadListLock);
+    for (auto& thread : threadList) {
+      if (thread.joinable()) {
+        this->threadList.push_back(std::move(thread));
+      }
+    }
+  }
+  // the next of the io_contexts, in turn
+  ServiceContext* getServiceContextForService() {
+    size_t index = this->nextServiceContextIndex++ % (this->serviceContextPtrList.size() + 1);
+    return index == 0 ? this : this->serviceContextPtrList[index - 1].get();
+  }
+  size_t getNumIoContext() const { return this->serviceContextPtrList.size() + 1; }
+  long getBusyPollSpinMicroseconds() const { return this->busyPollSpinMicroseconds; }
+  static std::string getIoBackend() {
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+    return "io_uring";
+#elif defined(BOOST_ASIO_HAS_EPOLL)
+    return "epoll";
+#elif defined(BOOST_ASIO_HAS_KQUEUE)
+    return "kqueue";
+#elif defined(BOOST_ASIO_HAS_IOCP)
+    return "iocp";
+#else
+    return "select";
+#endif
+  }
+  // whether the kernel lets this process set up an io_uring, which can be missing or disabled, e.g. by the kernel.io_uring_disabled sysctl or by seccomp
+  static bool isIoUringSupported() {
+#if defined(__linux__) && defined(__NR_io_uring_setup) && __has_include(<linux/io_uring.h>)
+    io_uring_params params{};
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, 1, &params));
+    if (fd < 0) {
+      return false;
+    }
+    close(fd);
+    return true;
+#else
+    return false;
+#endif
   }
   IoContextPtr ioContextPtr{nullptr};
   ExecutorWorkGuardPtr executorWorkGuardPtr{nullptr};
   SslContextPtr sslContextPtr{nullptr};
+  std::shared_ptr<TlsSessionCache> tlsSessionCachePtr{std::make_shared<TlsSessionCache>()};
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  // an additional io_context, which uses the SSL_CTX of its owner and the TLS session cache already installed on it
+  ServiceContext(IoContextPtr ioContextPtr, SslContextPtr sslContextPtr, std::shared_ptr<TlsSessionCache> tlsSessionCachePtr)
+      : tlsSessionCachePtr(std::move(tlsSessionCachePtr)) {
+    this->ioContextPtr = ioContextPtr;
+    this->executorWorkGuardPtr = new ExecutorWorkGuard(this->ioContextPtr->get_executor());
+    this->sslContextPtr = sslContextPtr;
+    this->isSslContextOwned = false;
+  }
+  static void checkIoBackend() {
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+    if (!isIoUringSupported()) {
+      CCAPI_LOGGER_FATAL("built with io_uring as the io backend, but the kernel does not let this process set up an io_uring");
+    }
+#endif
+  }
+  void runBusyPoll() {
+    const auto spinBudget = std::chrono::microseconds(this->busyPollSpinMicroseconds);
+    auto spinDeadline = std::chrono::steady_clock::now() + spinBudget;
+    while (!this->ioContextPtr->stopped()) {
+      if (this->ioContextPtr->poll() > 0) {
+        spinDeadline = std::chrono::steady_clock::now() + spinBudget;
+      } else if (std::chrono::steady_clock::now() >= spinDeadline) {
+        // nothing has been ready for the whole spin budget, block until the next handler
+        this->ioContextPtr->run_one();
+        spinDeadline = std::chrono::steady_clock::now() + spinBudget;
+      }
+    }
+  }
+  void pinToCpu(std::thread::native_handle_type handle, size_t index) {
+    if (index >= this->cpuList.size()) {
+      return;
+    }
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(this->cpuList[index], &cpuSet);
+    int error = pthread_setaffinity_np(handle, sizeof(cpu_set_t), &cpuSet);
+    if (error) {
+      CCAPI_LOGGER_WARN("failed to pin an io_context thread to cpu " + std::to_string(this->cpuList[index]) + ", error = " + std::to_string(error));
+    }
+#else
+    CCAPI_LOGGER_WARN("pinning io_context threads to cpus is only supported on linux");
+#endif
+  }
+  std::vector<std::unique_ptr<ServiceContext>> serviceContextPtrList;
+  std::vector<std::thread> threadList;
+  std::mutex threadListLock;  // start and stop are called from different threads
+  bool isStopped{};
+  std::vector<int> cpuList;
+  std::atomic<size_t> nextServiceContextIndex{};
+  long busyPollSpinMicroseconds{};
+  bool isSslContextOwned{true};
   // IoContextPtr ioContextPtr{new IoContext()};
   // ExecutorWorkGuardPtr executorWorkGuardPtr{new ExecutorWorkGuard(ioContextPtr->get_executor())};
   // SslContextPtr sslContextPtr{new SslContext(SslContext::tls_client)};
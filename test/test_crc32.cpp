@@ -0,0 +1,102 @@
+/**
+ * @file test_crc32.cpp
+ * @brief Tests unitaires pour le calcul incrémental du CRC-32
+ *
+ * Teste les fonctionnalités principales :
+ * - Valeurs de référence du polynôme IEEE 802.3
+ * - Équivalence entre un calcul en un seul bloc et un calcul par morceaux
+ * - Équivalence entre le noyau portable et le noyau matériel
+ */
+
+#include "../include/ccapi_cpp/ccapi_crc32.h"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace ccapi;
+
+/**
+ * @brief Vérifie les valeurs de référence
+ */
+void testKnownValue() {
+    assert(Crc32::calculate("") == 0);
+    assert(Crc32::calculate("123456789") == 0xCBF43926u);
+    assert(Crc32::calculate("The quick brown fox jumps over the lazy dog") == 0x414FA339u);
+    std::cout << "Test known value passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie que le découpage de l'entrée ne change pas le résultat
+ *
+ * Vérifie :
+ * - Des morceaux de tailles aléatoires, plus petits et plus grands que le tampon
+ * - L'ajout caractère par caractère et la réinitialisation
+ * - L'ajout d'une vue vide sans données
+ */
+void testStreaming() {
+    std::mt19937 rng(42);
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        std::string input(rng() % 2000, '\0');
+        for (auto& c : input) {
+            c = static_cast<char>(rng());
+        }
+        uint32_t expected = Crc32::calculate(input);
+        Crc32 crc32;
+        size_t i = 0;
+        while (i < input.size()) {
+            size_t size = std::min<size_t>(input.size() - i, rng() % 2 ? rng() % 16 : rng() % 600);
+            if (size == 1) {
+                crc32.update(input[i]);
+            } else {
+                crc32.update(input.data() + i, size);
+            }
+            i += size;
+        }
+        assert(crc32.getValue() == expected);
+        crc32.reset();
+        crc32.update(input);
+        crc32.update(std::string_view());
+        assert(crc32.getValue() == expected);
+    }
+    std::cout << "Test streaming passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie que le noyau matériel, s'il est disponible, donne le même résultat que le noyau portable
+ */
+void testHardwareKernel() {
+#ifdef CCAPI_CRC32_PCLMUL
+    if (Crc32::isHardwareAccelerated()) {
+        std::mt19937 rng(7);
+        for (size_t size = 64; size <= 1024; size += 16) {
+            std::string input(size, '\0');
+            for (auto& c : input) {
+                c = static_cast<char>(rng());
+            }
+            const auto* data = reinterpret_cast<const unsigned char*>(input.data());
+            uint32_t state = rng();
+            assert(Crc32::updatePclmul(state, data, size) == Crc32::updatePortable(state, data, size));
+        }
+    }
+#endif
+    std::cout << "Test hardware kernel passed!" << std::endl;
+}
+
+/**
+ * @brief Point d'entrée des tests
+ *
+ * @return 0 si tous les tests passent, 1 en cas d'erreur
+ */
+int main() {
+    try {
+        testKnownValue();
+        testStreaming();
+        testHardwareKernel();
+        std::cout << "All tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
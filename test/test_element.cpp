@@ -0,0 +1,96 @@
+/**
+ * @file test_element.cpp
+ * @brief Tests unitaires pour le stockage à plat des valeurs d'un Element
+ *
+ * Teste les fonctionnalités principales :
+ * - Table de clés internées évaluée à la compilation
+ * - Insertion et lecture des clés internées et non internées
+ * - Construction paresseuse de la map retournée par getNameValueMap()
+ */
+
+#include "../include/ccapi_cpp/ccapi_element.h"
+#include "../include/ccapi_cpp/ccapi_logger.h"
+#include <cassert>
+#include <iostream>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+static_assert(ElementKey::find(CCAPI_BEST_BID_N_PRICE) != ElementKey::NOT_FOUND, "la clé doit être internée");
+static_assert(ElementKey::getName(ElementKey::find(CCAPI_LAST_SIZE)) == CCAPI_LAST_SIZE, "la clé doit être retrouvée");
+static_assert(ElementKey::find("NOT_A_KEY") == ElementKey::NOT_FOUND, "une clé inconnue ne doit pas être trouvée");
+
+/**
+ * @brief Vérifie que chaque clé de la table est retrouvée avec son identifiant
+ */
+void testElementKey() {
+    for (int i = 0; i < ElementKey::size; ++i) {
+        assert(ElementKey::find(ElementKey::getName(i)) == i);
+    }
+    std::cout << "Test element key passed!" << std::endl;
+}
+
+/**
+ * @brief Teste l'insertion et la lecture des valeurs
+ *
+ * Vérifie :
+ * - Qu'une valeur existante n'est pas écrasée, comme avec std::map::insert
+ * - Que emplace déplace la valeur
+ * - Que les clés non internées sont conservées
+ */
+void testInsertAndGet() {
+    Element element;
+    element.insert(CCAPI_BEST_BID_N_PRICE, "100.5");
+    element.insert(CCAPI_BEST_BID_N_PRICE, "99");
+    std::string size = "2";
+    element.emplace(CCAPI_BEST_BID_N_SIZE, size);
+    assert(size.empty());
+    std::string name = "CUSTOM";
+    std::string value = "x";
+    element.emplace(name, value);
+    assert(element.has(std::string_view(CCAPI_BEST_BID_N_PRICE)) && element.has("CUSTOM") && !element.has(CCAPI_LAST_PRICE));
+    assert(element.getValue(CCAPI_BEST_BID_N_PRICE) == "100.5");
+    assert(element.getValue(std::string(CCAPI_BEST_BID_N_SIZE)) == "2");
+    assert(element.getValue(std::string_view("CUSTOM")) == "x");
+    assert(element.getValue(CCAPI_LAST_PRICE, "default") == "default");
+    std::cout << "Test insert and get passed!" << std::endl;
+}
+
+/**
+ * @brief Teste la map construite à la demande et sa mise à jour après une modification
+ */
+void testNameValueMap() {
+    Element element;
+    element.insert(CCAPI_LAST_PRICE, "1");
+    element.insert("OTHER", "2");
+    std::map<std::string, std::string> expected = {{CCAPI_LAST_PRICE, "1"}, {"OTHER", "2"}};
+    assert(element.getNameValueMap() == expected);
+    element.insert(CCAPI_LAST_SIZE, "3");
+    expected[CCAPI_LAST_SIZE] = "3";
+    assert(element.getNameValueMap() == expected);
+    Element copy = element;
+    assert(copy.getNameValueMap() == expected);
+    assert(element.toString() == "Element [nameValueMap = " + ccapi::toString(expected) + "]");
+    std::cout << "Test name value map passed!" << std::endl;
+}
+
+/**
+ * @brief Point d'entrée des tests
+ *
+ * @return 0 si tous les tests passent, 1 en cas d'erreur
+ */
+int main() {
+    try {
+        testElementKey();
+        testInsertAndGet();
+        testNameValueMap();
+        std::cout << "All tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,327 @@
+/**
+ * @file test_event_dispatcher.cpp
+ * @brief Tests unitaires pour les tâches à stockage intégré et le répartiteur d'événements
+ *
+ * Teste les fonctionnalités principales :
+ * - Stockage intégré ou sur le tas selon la taille de la cible, déplacement et destruction
+ * - Exécution de toutes les tâches, dans l'ordre avec un seul thread, avec la file protégée par mutex et la file sans verrou
+ * - Réveil d'un thread endormi et arrêt
+ * - Ordre par clé du mode partitionné, avec et sans vol de travail
+ * - Priorité stricte ou pondérée des voies et leurs métriques
+ * - File sans verrou pleine : abandon des tâches plutôt qu'un blocage
+ * - Threads inactifs qui s'endorment pendant qu'une tâche longue occupe une partition
+ */
+
+#include "../include/ccapi_cpp/ccapi_event_dispatcher.h"
+#include "../include/ccapi_cpp/ccapi_event.h"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Vérifie les tâches à stockage intégré
+ *
+ * Vérifie :
+ * - Une capture non copiable et une capture d'Event restent dans l'objet
+ * - Une grande capture passe par le tas et reste utilisable après déplacement
+ * - Chaque cible est détruite exactement une fois
+ */
+void testInlineTask() {
+    typedef EventDispatcher::Task Task;
+    auto counter = std::make_shared<int>(0);
+    std::unique_ptr<int> value(new int(41));
+    auto moveOnly = [value = std::move(value), counter] { *counter += *value + 1; };
+    static_assert(Task::isInline<decltype(moveOnly)>(), "une petite capture doit rester dans l'objet");
+    Task task(std::move(moveOnly));
+    Task moved(std::move(task));
+    assert(!task && moved);
+    moved();
+    assert(*counter == 42);
+    auto eventCapture = [e = Event()] { (void)e; };
+    static_assert(Task::isInline<decltype(eventCapture)>(), "la capture d'un Event doit rester dans l'objet");
+    std::array<char, 1000> large{};
+    large[999] = 1;
+    Task heapTask([large, counter] { *counter += large[999]; });
+    assert(counter.use_count() == 3);
+    Task other;
+    other = std::move(heapTask);
+    other();
+    assert(*counter == 43);
+    other.reset();
+    moved.reset();
+    assert(counter.use_count() == 1);
+    std::cout << "Test inline task passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie qu'un répartiteur exécute toutes les tâches, dans l'ordre s'il n'a qu'un thread
+ */
+void testDispatch(int numDispatcherThreads, size_t lockFreeQueueSize) {
+    EventDispatcher eventDispatcher(numDispatcherThreads, lockFreeQueueSize);
+    const int numTask = 100000;
+    std::atomic<int> numRun{};
+    std::atomic<bool> isInOrder{true};
+    int last = -1;
+    for (int i = 0; i < numTask; ++i) {
+        std::unique_ptr<int> value(new int(i));
+        eventDispatcher.dispatch([&, value = std::move(value)] {
+            if (numDispatcherThreads == 1) {
+                if (*value != last + 1) {
+                    isInOrder = false;
+                }
+                last = *value;
+            }
+            ++numRun;
+        });
+    }
+    while (numRun.load() < numTask) {
+        std::this_thread::yield();
+    }
+    assert(isInOrder);
+    // laisse les threads s'endormir avant de les réveiller
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    eventDispatcher.dispatch([&] { ++numRun; });
+    while (numRun.load() < numTask + 1) {
+        std::this_thread::yield();
+    }
+    eventDispatcher.pause();
+    eventDispatcher.dispatch([&] { ++numRun; });
+    eventDispatcher.stop();
+    assert(numRun.load() == numTask + 1);
+}
+
+void testEventDispatcher() {
+    for (size_t lockFreeQueueSize : {0, 16, 1024}) {
+        for (int numDispatcherThreads : {1, 3}) {
+            testDispatch(numDispatcherThreads, lockFreeQueueSize);
+        }
+    }
+    std::cout << "Test event dispatcher passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie le mode partitionné
+ *
+ * Vérifie :
+ * - Les tâches d'une même clé s'exécutent dans l'ordre de leur répartition, une à la fois
+ * - Sans vol de travail, chaque partition reste sur son thread, donc toutes les clés ne sont pas traitées par le même thread
+ * - Les tâches sans clé sont aussi exécutées
+ */
+void testSharded() {
+    for (bool enableWorkStealing : {false, true}) {
+        const int numDispatcherThreads = 3;
+        const size_t numKey = 12;
+        const int numTaskPerKey = 20000;
+        EventDispatcher eventDispatcher(numDispatcherThreads, 256, true, enableWorkStealing);
+        std::vector<int> lastList(numKey, -1);
+        std::vector<std::atomic<int>> numRunningList(numKey);
+        std::atomic<bool> isInOrder{true};
+        std::atomic<int> numRun{};
+        std::mutex threadIdLock;
+        std::set<std::thread::id> threadIdSet;
+        for (int i = 0; i < numTaskPerKey; ++i) {
+            for (size_t key = 0; key < numKey; ++key) {
+                eventDispatcher.dispatch(key, [&, key, i] {
+                    if (numRunningList[key]++ != 0 || lastList[key] != i - 1) {
+                        isInOrder = false;
+                    }
+                    lastList[key] = i;
+                    if (i == 0) {
+                        std::lock_guard<std::mutex> lock(threadIdLock);
+                        threadIdSet.insert(std::this_thread::get_id());
+                    }
+                    --numRunningList[key];
+                    ++numRun;
+                });
+            }
+        }
+        eventDispatcher.dispatch([&] { ++numRun; });
+        while (numRun.load() < static_cast<int>(numKey) * numTaskPerKey + 1) {
+            std::this_thread::yield();
+        }
+        eventDispatcher.stop();
+        assert(isInOrder);
+        if (!enableWorkStealing) {
+            assert(threadIdSet.size() == static_cast<size_t>(numDispatcherThreads));
+        }
+    }
+    std::cout << "Test sharded passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie l'ordre d'exécution des voies de priorité pour chaque mode
+ *
+ * Le thread est bloqué pendant que des tâches normales puis prioritaires sont mises en file, puis libéré.
+ * Vérifie :
+ * - En priorité stricte, toutes les tâches prioritaires passent avant les normales
+ * - Avec un poids de 2, une tâche normale passe après chaque paire de tâches prioritaires
+ * - Le nombre de tâches et le délai maximal en file de chaque voie
+ * - Sans mesure des voies, aucune tâche n'est comptée
+ */
+void testPriority() {
+    for (int highPriorityWeight : {0, 2}) {
+        for (size_t lockFreeQueueSize : {0, 64}) {
+            for (bool isSharded : {false, true}) {
+                if (isSharded && lockFreeQueueSize == 0) {
+                    continue;
+                }
+                EventDispatcher eventDispatcher(1, lockFreeQueueSize, isSharded, false, highPriorityWeight, true);
+                std::atomic<bool> isGateEntered{};
+                std::atomic<bool> isGateOpen{};
+                std::atomic<int> numRun{};
+                std::string order;
+                eventDispatcher.dispatch([&] {
+                    isGateEntered = true;
+                    while (!isGateOpen) {
+                        std::this_thread::yield();
+                    }
+                    ++numRun;
+                });
+                while (!isGateEntered) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < 6; ++i) {
+                    eventDispatcher.dispatch(0, EventDispatcher::Priority::NORMAL, [&] {
+                        order += "N";
+                        ++numRun;
+                    });
+                }
+                for (int i = 0; i < 6; ++i) {
+                    eventDispatcher.dispatch(0, EventDispatcher::Priority::HIGH, [&] {
+                        order += "H";
+                        ++numRun;
+                    });
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                isGateOpen = true;
+                while (numRun.load() < 13) {
+                    std::this_thread::yield();
+                }
+                eventDispatcher.stop();
+                assert(order == (highPriorityWeight == 0 ? "HHHHHHNNNNNN" : "HHNHHNHHNNNN"));
+                assert(eventDispatcher.getLaneMetrics(EventDispatcher::Priority::HIGH).numTask == 6);
+                assert(eventDispatcher.getLaneMetrics(EventDispatcher::Priority::NORMAL).numTask == 7);
+                assert(eventDispatcher.getLaneMetrics(EventDispatcher::Priority::NORMAL).maxQueueDelayNanoseconds >= 10000000);
+            }
+        }
+    }
+    EventDispatcher eventDispatcher;
+    std::atomic<bool> hasRun{};
+    eventDispatcher.dispatch([&] { hasRun = true; });
+    while (!hasRun) {
+        std::this_thread::yield();
+    }
+    eventDispatcher.stop();
+    assert(eventDispatcher.getLaneMetrics(EventDispatcher::Priority::NORMAL).numTask == 0);
+    std::cout << "Test priority passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie qu'une file sans verrou pleine ne bloque ni un thread du répartiteur ni l'arrêt
+ *
+ * Vérifie :
+ * - Une tâche qui remplit sa propre file voit les tâches en trop abandonnées au lieu de se bloquer
+ * - Un producteur qui attend de la place abandonne sa tâche une fois le répartiteur arrêté
+ */
+void testFullQueue() {
+    for (bool isSharded : {false, true}) {
+        EventDispatcher eventDispatcher(1, 4, isSharded);
+        std::atomic<int> numRun{};
+        eventDispatcher.dispatch([&] {
+            for (int i = 0; i < 10; ++i) {
+                eventDispatcher.dispatch([&] { ++numRun; });
+            }
+            ++numRun;
+        });
+        while (numRun.load() < 5) {
+            std::this_thread::yield();
+        }
+        assert(eventDispatcher.getNumDroppedTask() == 6);
+        std::atomic<bool> isGateEntered{};
+        std::atomic<bool> isGateOpen{};
+        eventDispatcher.dispatch([&] {
+            isGateEntered = true;
+            while (!isGateOpen) {
+                std::this_thread::yield();
+            }
+        });
+        while (!isGateEntered) {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < 4; ++i) {
+            eventDispatcher.dispatch([&] { ++numRun; });
+        }
+        std::thread producer([&] { eventDispatcher.dispatch([&] { ++numRun; }); });
+        std::thread stopper([&] { eventDispatcher.stop(); });
+        // laisse l'arrêt commencer pendant que le thread du répartiteur est encore occupé
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        isGateOpen = true;
+        stopper.join();
+        producer.join();
+        assert(eventDispatcher.getNumDroppedTask() == 7);
+    }
+    std::cout << "Test full queue passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie que les autres threads ne tournent pas à vide pendant qu'une tâche longue bloque des tâches en attente derrière elle
+ *
+ * Une tâche dort pendant 300 ms, suivie de tâches de la même clé. Le temps processeur consommé pendant ce temps doit rester faible, que les autres threads
+ * perdent la partition au profit du thread qui l'exécute (mode partitionné avec vol de travail) ou n'aient rien à prendre (file sans verrou).
+ */
+void testIdleWhileBusy() {
+    for (bool isSharded : {false, true}) {
+        EventDispatcher eventDispatcher(3, 64, isSharded, true);
+        std::atomic<bool> isStarted{};
+        std::atomic<int> numRun{};
+        eventDispatcher.dispatch(0, [&] {
+            isStarted = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            ++numRun;
+        });
+        while (!isStarted) {
+            std::this_thread::yield();
+        }
+        if (isSharded) {
+            for (int i = 0; i < 10; ++i) {
+                eventDispatcher.dispatch(0, [&] { ++numRun; });
+            }
+        }
+        std::clock_t cpuBegin = std::clock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        double cpuMilliseconds = 1000.0 * (std::clock() - cpuBegin) / CLOCKS_PER_SEC;
+        while (numRun.load() < (isSharded ? 11 : 1)) {
+            std::this_thread::yield();
+        }
+        eventDispatcher.stop();
+        assert(cpuMilliseconds < 100);
+    }
+    std::cout << "Test idle while busy passed!" << std::endl;
+}
+
+int main() {
+    testInlineTask();
+    testEventDispatcher();
+    testSharded();
+    testPriority();
+    testFullQueue();
+    testIdleWhileBusy();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
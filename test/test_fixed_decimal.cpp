@@ -0,0 +1,124 @@
+/**
+ * @file test_fixed_decimal.cpp
+ * @brief Tests unitaires pour le type décimal à virgule fixe FixedDecimal
+ *
+ * Teste les fonctionnalités principales :
+ * - Analyse sans allocation depuis un tampon de caractères
+ * - Conversion en chaîne et en double
+ * - Comparaison, arithmétique et interopérabilité avec Decimal
+ */
+
+#include "../include/ccapi_cpp/ccapi_fixed_decimal.h"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <unordered_set>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Teste l'analyse de nombres décimaux
+ *
+ * Vérifie :
+ * - Les signes, la partie fractionnaire et la notation scientifique
+ * - La suppression (ou non) des zéros finaux
+ * - Le rejet des entrées invalides ou hors limites
+ */
+void testParse() {
+    FixedDecimal x;
+    const char* text = "-123.4500";
+    assert(FixedDecimal::parse(text, std::strlen(text), x));
+    assert(x.getMantissa() == -12345 && x.getScale() == 2);
+    assert(FixedDecimal::parse(text, std::strlen(text), x, true));
+    assert(x.getMantissa() == -1234500 && x.getScale() == 4);
+    assert(FixedDecimal("1.5e-8").toString() == "0.000000015");
+    assert(FixedDecimal("2.5E3").toString() == "2500");
+    assert(FixedDecimal("0.0").toString() == "0");
+    assert(FixedDecimal(".5").toString() == "0.5");
+    assert(!FixedDecimal::parse("", 0, x));
+    assert(!FixedDecimal::parse("abc", 3, x));
+    assert(!FixedDecimal::parse("1.2.3", 5, x));
+    assert(!FixedDecimal::parse("1e", 2, x));
+    assert(!FixedDecimal::parse("99999999999999999999", 20, x));
+    assert(!FixedDecimal::parse("0.0000000000000000001", 21, x));
+    // seul le préfixe indiqué par la longueur est analysé
+    assert(FixedDecimal::parse("42.10\"}", 5, x) && x.toString() == "42.1");
+    std::cout << "Test parse passed!" << std::endl;
+}
+
+/**
+ * @brief Teste l'analyse directe à l'échelle d'un instrument
+ */
+void testParseWithScale() {
+    FixedDecimal x;
+    assert(FixedDecimal::parse("42000.1", 7, 2, x));
+    assert(x.getMantissa() == 4200010 && x.getScale() == 2);
+    assert(!FixedDecimal::parse("42000.123", 9, 2, x));
+    std::cout << "Test parse with scale passed!" << std::endl;
+}
+
+/**
+ * @brief Teste les conversions en chaîne et en double
+ */
+void testConversion() {
+    assert(FixedDecimal(-5, 3).toString() == "-0.005");
+    assert(FixedDecimal(123456, 0).toString() == "123456");
+    assert(FixedDecimal(0, 4).toString() == "0.0000");
+    assert(FixedDecimal(1234500, 4).toDouble() == 123.45);
+    char buffer[FixedDecimal::MAX_STRING_LENGTH];
+    size_t n = FixedDecimal(-4200010, 2).toChars(buffer);
+    assert(std::string(buffer, n) == "-42000.10");
+    assert(FixedDecimal(Decimal("0.0100")).toString() == "0.01");
+    assert(FixedDecimal("-7.25").toDecimal().toString() == "-7.25");
+    std::cout << "Test conversion passed!" << std::endl;
+}
+
+/**
+ * @brief Teste la comparaison, le hachage et l'arithmétique
+ *
+ * Vérifie :
+ * - L'ordre indépendant de l'échelle (utilisation comme clé de std::map)
+ * - L'égalité des hachages pour des valeurs égales
+ * - L'addition et la soustraction avec alignement des échelles
+ */
+void testCompareAndArithmetic() {
+    assert(FixedDecimal("0.1") == FixedDecimal("0.10", true));
+    assert(FixedDecimal("1.05") > FixedDecimal("1.0499999"));
+    assert(FixedDecimal("-1.5") < FixedDecimal("-1.25"));
+    assert(FixedDecimal("-0.5") < FixedDecimal("0.25"));
+    assert(FixedDecimal("3") >= FixedDecimal("2.999"));
+    std::map<FixedDecimal, int> book;
+    book[FixedDecimal("100.5")] = 1;
+    book[FixedDecimal("100.25")] = 2;
+    book[FixedDecimal("100.50", true)] = 3;
+    assert(book.size() == 2 && book.begin()->second == 2 && book.rbegin()->second == 3);
+    std::unordered_set<FixedDecimal> set{FixedDecimal("2.50", true), FixedDecimal("2.5")};
+    assert(set.size() == 1);
+    assert(FixedDecimal("1.25").add(FixedDecimal("0.005")).toString() == "1.255");
+    assert(FixedDecimal("1").subtract(FixedDecimal("1.5")).toString() == "-0.5");
+    std::cout << "Test compare and arithmetic passed!" << std::endl;
+}
+
+/**
+ * @brief Point d'entrée des tests
+ *
+ * @return 0 si tous les tests passent, 1 en cas d'erreur
+ */
+int main() {
+    try {
+        testParse();
+        testParseWithScale();
+        testConversion();
+        testCompareAndArithmetic();
+        std::cout << "All tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
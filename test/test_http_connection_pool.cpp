@@ -0,0 +1,274 @@
+/**
+ * @file test_http_connection_pool.cpp
+ * @brief Tests unitaires pour le pool de connexions HTTP
+ *
+ * Teste les fonctionnalités principales :
+ * - Réutilisation de la connexion inactive la plus récente et expiration de chaque connexion inactive
+ * - Limite du nombre de connexions ouvertes et attente des requêtes au-delà, abandonnée une fois expirée
+ * - Limite du nombre de connexions inactives conservées
+ * - Sélection des connexions à sonder pour les garder actives
+ * - Connexions de réserve ouvertes à l'avance, et remplacées avant leur expiration quand aucune requête n'est envoyée
+ * - Métriques
+ */
+
+#include "boost/beast/core.hpp"
+#include "boost/beast/ssl.hpp"
+#include "../include/ccapi_cpp/ccapi_http_connection_pool.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Crée une connexion sans flux dont la destruction libère sa place dans le pool, comme le fait Service
+ */
+std::shared_ptr<HttpConnection> makeHttpConnection(HttpConnectionPool& pool, const TimePoint& lastReceiveDataTp, int& numClosed) {
+    std::shared_ptr<HttpConnection> httpConnectionPtr(new HttpConnection("www.okx.com", "443", nullptr));
+    httpConnectionPtr->lastReceiveDataTp = lastReceiveDataTp;
+    httpConnectionPtr->closeHandler = [&pool, &numClosed] {
+        ++numClosed;
+        pool.onClose();
+    };
+    return httpConnectionPtr;
+}
+
+/**
+ * @brief Vérifie la réutilisation et l'expiration des connexions inactives
+ *
+ * Vérifie :
+ * - La connexion inactive la plus récente est réutilisée en premier
+ * - Une connexion expirée est abandonnée sans vider le reste du pool
+ */
+void testAcquire() {
+    HttpConnectionPool pool(0, 0, 10);
+    int numClosed = 0;
+    TimePoint now = UtilTime::now();
+    assert(!pool.acquire(now));
+    assert(pool.tryReserve() && pool.tryReserve());
+    auto first = makeHttpConnection(pool, now - std::chrono::seconds(1), numClosed);
+    auto second = makeHttpConnection(pool, now, numClosed);
+    HttpConnection* secondRawPtr = second.get();
+    pool.release(std::move(first));
+    pool.release(std::move(second));
+    assert(pool.getNumIdleConnection() == 2);
+    auto acquired = pool.acquire(now);
+    assert(acquired.get() == secondRawPtr);
+    pool.release(std::move(acquired));
+    acquired = pool.acquire(now + std::chrono::seconds(10));
+    assert(!acquired);
+    assert(numClosed == 2);
+    assert(pool.getNumConnection() == 0);
+    pool.tryReserve();
+    acquired = makeHttpConnection(pool, now + std::chrono::seconds(5), numClosed);
+    pool.release(std::move(acquired));
+    acquired = pool.acquire(now + std::chrono::seconds(14));
+    assert(acquired);
+    HttpConnectionPool::Metrics metrics = pool.getMetrics();
+    assert(metrics.numHit == 2);
+    assert(metrics.numExpired == 2);
+    assert(metrics.numNewConnection == 3);
+    std::cout << "Test acquire passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie la limite de connexions ouvertes et l'attente des requêtes
+ *
+ * Vérifie :
+ * - Au-delà de la limite, une requête attend la prochaine connexion libérée
+ * - La fermeture d'une connexion laisse la requête suivante en ouvrir une nouvelle
+ * - Les temps d'attente sont comptés
+ */
+void testWait() {
+    HttpConnectionPool pool(2, 0, 10);
+    int numClosed = 0;
+    TimePoint now = UtilTime::now();
+    assert(pool.tryReserve());
+    assert(pool.tryReserve());
+    assert(!pool.tryReserve());
+    auto first = makeHttpConnection(pool, now, numClosed);
+    auto second = makeHttpConnection(pool, now, numClosed);
+    std::vector<std::shared_ptr<HttpConnection>> handedList;
+    int numHandedNullptr = 0;
+    for (int i = 0; i < 2; ++i) {
+        pool.wait([&](std::shared_ptr<HttpConnection> httpConnectionPtr) {
+            if (httpConnectionPtr) {
+                handedList.push_back(httpConnectionPtr);
+            } else {
+                ++numHandedNullptr;
+                assert(pool.tryReserve());
+            }
+        });
+    }
+    assert(pool.getNumWaiter() == 2);
+    HttpConnection* firstRawPtr = first.get();
+    pool.release(std::move(first));
+    assert(handedList.size() == 1 && handedList.front().get() == firstRawPtr);
+    assert(pool.getNumIdleConnection() == 0);
+    second.reset();
+    assert(numClosed == 1);
+    assert(numHandedNullptr == 1);
+    assert(pool.getNumWaiter() == 0);
+    assert(pool.getNumConnection() == 2);
+    HttpConnectionPool::Metrics metrics = pool.getMetrics();
+    assert(metrics.numWait == 2);
+    assert(metrics.maxWaitNanoseconds >= 0 && metrics.totalWaitNanoseconds >= metrics.maxWaitNanoseconds);
+    std::cout << "Test wait passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie l'expiration d'une requête en attente
+ *
+ * Vérifie :
+ * - Une requête expirée quitte la file d'attente et n'est plus servie
+ * - Expirer une requête déjà servie ou déjà expirée n'a pas d'effet
+ */
+void testWaitTimeout() {
+    HttpConnectionPool pool(1, 0, 10);
+    int numClosed = 0;
+    TimePoint now = UtilTime::now();
+    assert(pool.tryReserve());
+    auto first = makeHttpConnection(pool, now, numClosed);
+    std::vector<int> servedList;
+    size_t expiredWaiterId = pool.wait([&servedList](std::shared_ptr<HttpConnection>) { servedList.push_back(0); });
+    size_t servedWaiterId = pool.wait([&servedList](std::shared_ptr<HttpConnection>) { servedList.push_back(1); });
+    assert(expiredWaiterId != servedWaiterId);
+    assert(pool.expireWaiter(expiredWaiterId));
+    assert(!pool.expireWaiter(expiredWaiterId));
+    assert(pool.getNumWaiter() == 1);
+    pool.release(std::move(first));
+    assert(servedList == std::vector<int>({1}));
+    assert(!pool.expireWaiter(servedWaiterId));
+    HttpConnectionPool::Metrics metrics = pool.getMetrics();
+    assert(metrics.numWait == 1);
+    assert(metrics.numWaitTimeout == 1);
+    std::cout << "Test wait timeout passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie la limite de connexions inactives, les sondes et les métriques partagées entre pools
+ */
+void testIdleAndProbe() {
+    auto metricsCounterPtr = std::make_shared<HttpConnectionPool::MetricsCounter>();
+    HttpConnectionPool pool(0, 2, 10, metricsCounterPtr);
+    HttpConnectionPool otherPool(0, 0, 10, metricsCounterPtr);
+    int numClosed = 0;
+    TimePoint now = UtilTime::now();
+    for (int i = 0; i < 3; ++i) {
+        pool.tryReserve();
+        pool.release(makeHttpConnection(pool, now - std::chrono::seconds(3 - i), numClosed));
+    }
+    assert(numClosed == 1);
+    assert(pool.getNumIdleConnection() == 2);
+    assert(pool.getNumConnection() == 2);
+    auto probeList = pool.takeIdleToProbe(now, 2);
+    assert(probeList.size() == 1);
+    assert(pool.getNumIdleConnection() == 1);
+    pool.onKeepAliveProbeFailure();
+    probeList.clear();
+    assert(numClosed == 2);
+    assert(pool.getNumConnection() == 1);
+    otherPool.tryReserve();
+    pool.clearIdle();
+    assert(numClosed == 3);
+    HttpConnectionPool::Metrics metrics = otherPool.getMetrics();
+    assert(metrics.numNewConnection == 4);
+    assert(metrics.numKeepAliveProbe == 1);
+    assert(metrics.numKeepAliveProbeFailure == 1);
+    assert(!metrics.toString().empty());
+    std::cout << "Test idle and probe passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie l'ouverture des connexions de réserve
+ *
+ * Vérifie :
+ * - Le nombre de connexions de réserve est borné par le nombre de connexions inactives conservées et par la limite de connexions ouvertes
+ * - Les connexions en cours d'ouverture comptent comme des connexions de réserve
+ * - Une connexion de réserve prête est remise directement à une requête en attente
+ */
+void testSpare() {
+    HttpConnectionPool pool(3, 2, 10);
+    int numClosed = 0;
+    TimePoint now = UtilTime::now();
+    assert(pool.tryReserveSpare(3, now));
+    assert(pool.tryReserveSpare(3, now));
+    assert(!pool.tryReserveSpare(3, now));
+    assert(pool.getNumConnection() == 2);
+    pool.releaseSpare(makeHttpConnection(pool, now, numClosed));
+    assert(pool.getNumIdleConnection() == 1);
+    assert(!pool.tryReserveSpare(2, now));
+    pool.releaseSpare(nullptr);
+    pool.onClose();
+    assert(pool.getNumConnection() == 1);
+    auto acquired = pool.acquire(now);
+    assert(acquired);
+    assert(pool.tryReserveSpare(2, now));
+    assert(pool.tryReserveSpare(2, now));
+    assert(!pool.tryReserve());
+    std::shared_ptr<HttpConnection> handed;
+    pool.wait([&handed](std::shared_ptr<HttpConnection> httpConnectionPtr) { handed = httpConnectionPtr; });
+    auto spare = makeHttpConnection(pool, now, numClosed);
+    HttpConnection* spareRawPtr = spare.get();
+    pool.releaseSpare(std::move(spare));
+    assert(handed.get() == spareRawPtr);
+    assert(pool.getNumIdleConnection() == 0);
+    HttpConnectionPool::Metrics metrics = pool.getMetrics();
+    assert(metrics.numSpareConnection == 4);
+    assert(metrics.numNewConnection == 4);
+    std::cout << "Test spare passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie le remplacement des connexions de réserve pendant une période sans requête
+ *
+ * Vérifie :
+ * - Une connexion de réserve qui expire avant la prochaine vérification ne compte plus, et sa remplaçante est ouverte pendant qu'elle reste utilisable
+ * - Une connexion de réserve expirée est abandonnée et ne bloque plus son remplacement
+ * - Après la période sans requête, la requête suivante obtient une connexion de réserve fraîche sans nouvelle poignée de main
+ */
+void testSpareAfterIdle() {
+    HttpConnectionPool pool(0, 1, 10);
+    int numClosed = 0;
+    TimePoint now = UtilTime::now();
+    assert(pool.tryReserveSpare(1, now, 5));
+    pool.releaseSpare(makeHttpConnection(pool, now, numClosed));
+    assert(!pool.tryReserveSpare(1, now + std::chrono::seconds(4), 5));
+    assert(pool.tryReserveSpare(1, now + std::chrono::seconds(5), 5));
+    assert(pool.getNumIdleConnection() == 1);
+    auto acquired = pool.acquire(now + std::chrono::seconds(5));
+    assert(acquired);
+    pool.release(std::move(acquired));
+    pool.releaseSpare(makeHttpConnection(pool, now + std::chrono::seconds(5), numClosed));
+    assert(numClosed == 1);
+    assert(pool.getNumIdleConnection() == 1);
+    assert(pool.tryReserveSpare(1, now + std::chrono::seconds(15), 0));
+    assert(numClosed == 2);
+    assert(pool.getNumIdleConnection() == 0);
+    pool.releaseSpare(makeHttpConnection(pool, now + std::chrono::seconds(15), numClosed));
+    size_t numNewConnection = pool.getMetrics().numNewConnection;
+    acquired = pool.acquire(now + std::chrono::seconds(20));
+    assert(acquired && acquired->lastReceiveDataTp == now + std::chrono::seconds(15));
+    HttpConnectionPool::Metrics metrics = pool.getMetrics();
+    assert(metrics.numNewConnection == numNewConnection);
+    assert(metrics.numSpareConnection == 3);
+    assert(metrics.numExpired == 1);
+    assert(metrics.numHit == 2);
+    std::cout << "Test spare after idle passed!" << std::endl;
+}
+
+int main() {
+    testAcquire();
+    testWait();
+    testWaitTimeout();
+    testIdleAndProbe();
+    testSpare();
+    testSpareAfterIdle();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
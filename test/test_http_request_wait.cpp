@@ -0,0 +1,111 @@
+/**
+ * @file test_http_request_wait.cpp
+ * @brief Tests unitaires pour l'attente d'une connexion HTTP par une requête quand toutes les connexions d'un hôte sont occupées
+ *
+ * Teste les fonctionnalités principales :
+ * - Sans délai d'expiration des requêtes, la requête échoue tout de suite au lieu d'attendre indéfiniment
+ * - Une requête en attente ne garde pas le service en vie
+ * - L'arrêt du service abandonne les requêtes en attente
+ */
+
+#define CCAPI_EXPOSE_INTERNAL
+#ifndef CCAPI_ENABLE_SERVICE_MARKET_DATA
+#define CCAPI_ENABLE_SERVICE_MARKET_DATA
+#endif
+#include "../include/ccapi_cpp/service/ccapi_market_data_service.h"
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Crée un service dont le pool de connexions n'en ouvre qu'une, déjà réservée, et qui retient les événements qu'il émet
+ */
+std::shared_ptr<MarketDataService> createService(ServiceContext& serviceContext, long httpRequestTimeoutMilliseconds, std::vector<Event>& eventList) {
+    SessionOptions sessionOptions;
+    sessionOptions.httpConnectionPoolMaxNumConnection = 1;
+    sessionOptions.httpRequestTimeoutMilliseconds = httpRequestTimeoutMilliseconds;
+    auto servicePtr = std::make_shared<MarketDataService>([&eventList](Event& event, Queue<Event>*) { eventList.push_back(event); }, sessionOptions,
+                                                          SessionConfigs(), &serviceContext);
+    bool isReserved = servicePtr->getHttpConnectionPool("", "").tryReserve();
+    assert(isReserved);
+    (void)isReserved;
+    return servicePtr;
+}
+
+/**
+ * @brief Envoie une requête pendant que la seule connexion est occupée
+ */
+void tryRequest(MarketDataService& service, const std::shared_ptr<std::promise<void>>& promisePtr) {
+    Request request(Request::Operation::GET_RECENT_TRADES, "okx", "BTC-USDT", "request");
+    http::request<http::string_body> req;
+    service.tryRequest(request, req, HttpRetry(0, 0, "", promisePtr), nullptr);
+}
+
+/**
+ * @brief Vérifie qu'une requête échoue tout de suite avec REQUEST_STATUS quand httpRequestTimeoutMilliseconds n'est pas positif
+ */
+void testFailFastWithoutTimeout() {
+    ServiceContext serviceContext;
+    std::vector<Event> eventList;
+    auto servicePtr = createService(serviceContext, 0, eventList);
+    auto promisePtr = std::make_shared<std::promise<void>>();
+    auto future = promisePtr->get_future();
+    tryRequest(*servicePtr, promisePtr);
+    assert(servicePtr->getHttpConnectionPool("", "").getNumWaiter() == 0);
+    assert(eventList.size() == 1);
+    assert(eventList[0].getType() == Event::Type::REQUEST_STATUS);
+    assert(eventList[0].getMessageList().at(0).getType() == Message::Type::REQUEST_FAILURE);
+    assert(eventList[0].getMessageList().at(0).getCorrelationIdList() == std::vector<std::string>({"request"}));
+    assert(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    std::cout << "Test fail fast without timeout passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie qu'un service dont une requête attend une connexion est libéré une fois que plus rien d'autre ne le référence
+ */
+void testWaiterDoesNotOwnService() {
+    ServiceContext serviceContext;
+    std::vector<Event> eventList;
+    auto servicePtr = createService(serviceContext, 10000, eventList);
+    tryRequest(*servicePtr, nullptr);
+    assert(servicePtr->getHttpConnectionPool("", "").getNumWaiter() == 1);
+    assert(eventList.empty());
+    std::weak_ptr<MarketDataService> weakServicePtr = servicePtr;
+    servicePtr.reset();
+    assert(weakServicePtr.expired());
+    std::cout << "Test waiter does not own service passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie que l'arrêt du service abandonne les requêtes en attente et que leur minuterie n'a ensuite plus d'effet
+ */
+void testStopClearsWaiters() {
+    ServiceContext serviceContext;
+    std::vector<Event> eventList;
+    auto servicePtr = createService(serviceContext, 1, eventList);
+    tryRequest(*servicePtr, nullptr);
+    tryRequest(*servicePtr, nullptr);
+    assert(servicePtr->getHttpConnectionPool("", "").getNumWaiter() == 2);
+    servicePtr->stop();
+    assert(servicePtr->getHttpConnectionPool("", "").getNumWaiter() == 0);
+    serviceContext.ioContextPtr->run_for(std::chrono::milliseconds(50));
+    assert(eventList.empty());
+    std::cout << "Test stop clears waiters passed!" << std::endl;
+}
+
+int main() {
+    testFailFastWithoutTimeout();
+    testWaiterDoesNotOwnService();
+    testStopClearsWaiters();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
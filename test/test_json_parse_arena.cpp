@@ -0,0 +1,108 @@
+/**
+ * @file test_json_parse_arena.cpp
+ * @brief Tests unitaires pour l'analyse en place des messages reçus avec l'arène de Service
+ *
+ * Teste les fonctionnalités principales :
+ * - Les macros de taille de l'arène et de la pile s'utilisent dans une expression arithmétique
+ * - Deux messages analysés l'un après l'autre dans le même tampon et la même arène : le second ne voit rien du premier
+ * - Le message reçu n'est pas modifié par l'analyse en place
+ */
+
+#define CCAPI_EXPOSE_INTERNAL
+#ifndef CCAPI_ENABLE_SERVICE_MARKET_DATA
+#define CCAPI_ENABLE_SERVICE_MARKET_DATA
+#endif
+#include "../include/ccapi_cpp/service/ccapi_market_data_service.h"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Service minimal qui donne accès au tampon et à l'arène d'analyse
+ */
+class ParsingService : public MarketDataService {
+ public:
+    ParsingService(ServiceContext* serviceContextPtr)
+        : MarketDataService([](Event&, Queue<Event>*) {}, SessionOptions(), SessionConfigs(), serviceContextPtr) {}
+};
+
+/**
+ * @brief Vérifie que les macros sont parenthésées
+ */
+void testMacros() {
+    static_assert(2 * CCAPI_JSON_PARSE_ARENA_SIZE == (2 << 20), "CCAPI_JSON_PARSE_ARENA_SIZE must be parenthesized");
+    static_assert(CCAPI_JSON_PARSE_STACK_CAPACITY / 2 == (1 << 13), "CCAPI_JSON_PARSE_STACK_CAPACITY must be parenthesized");
+    std::cout << "Test macros passed!" << std::endl;
+}
+
+/**
+ * @brief Analyse deux messages à la suite, le second plus court que le premier et sans ses clés
+ */
+void testTwoMessages(ParsingService& service) {
+    std::string first = R"({"arg":{"channel":"books","instId":"BTC-USDT"},"data":[{"asks":[["101.5","1"]],"checksum":"-123456"}]})";
+    std::string second = R"({"event":"pong"})";
+    {
+        auto& jsonParseArena = service.resetJsonParseArena();
+        Service::ArenaDocument document(&jsonParseArena, CCAPI_JSON_PARSE_STACK_CAPACITY, &jsonParseArena);
+        document.ParseInsitu<rj::kParseNumbersAsStringsFlag>(service.copyToInsituParseBuffer(first.data(), first.size()));
+        assert(!document.HasParseError());
+        assert(Service::toStringView(document["arg"]["instId"]) == "BTC-USDT");
+        assert(Service::toStringView(document["data"][0]["asks"][0][0]) == "101.5");
+        assert(jsonParseArena.Size() > 0);
+    }
+    {
+        auto& jsonParseArena = service.resetJsonParseArena();
+        assert(jsonParseArena.Size() == 0);
+        Service::ArenaDocument document(&jsonParseArena, CCAPI_JSON_PARSE_STACK_CAPACITY, &jsonParseArena);
+        char* buffer = service.copyToInsituParseBuffer(second.data(), second.size());
+        assert(buffer[second.size()] == '\0');
+        document.ParseInsitu<rj::kParseNumbersAsStringsFlag>(buffer);
+        assert(!document.HasParseError());
+        assert(document.IsObject());
+        assert(document.MemberCount() == 1);
+        assert(!document.HasMember("arg"));
+        assert(!document.HasMember("data"));
+        assert(Service::toStringView(document["event"]) == "pong");
+    }
+    assert(first == R"({"arg":{"channel":"books","instId":"BTC-USDT"},"data":[{"asks":[["101.5","1"]],"checksum":"-123456"}]})");
+    assert(second == R"({"event":"pong"})");
+    std::cout << "Test two messages passed!" << std::endl;
+}
+
+/**
+ * @brief Analyse un message tronqué après un message valide : l'erreur est signalée au lieu de lire la fin du message précédent
+ */
+void testTruncatedAfterLonger(ParsingService& service) {
+    std::string first = R"({"event":"subscribe","arg":{"channel":"books"}})";
+    std::string second = R"({"event":"sub)";
+    {
+        auto& jsonParseArena = service.resetJsonParseArena();
+        Service::ArenaDocument document(&jsonParseArena, CCAPI_JSON_PARSE_STACK_CAPACITY, &jsonParseArena);
+        document.ParseInsitu<rj::kParseNumbersAsStringsFlag>(service.copyToInsituParseBuffer(first.data(), first.size()));
+        assert(!document.HasParseError());
+    }
+    {
+        auto& jsonParseArena = service.resetJsonParseArena();
+        Service::ArenaDocument document(&jsonParseArena, CCAPI_JSON_PARSE_STACK_CAPACITY, &jsonParseArena);
+        document.ParseInsitu<rj::kParseNumbersAsStringsFlag>(service.copyToInsituParseBuffer(second.data(), second.size()));
+        assert(document.HasParseError());
+    }
+    std::cout << "Test truncated after longer passed!" << std::endl;
+}
+
+int main() {
+    ServiceContext serviceContext;
+    auto servicePtr = std::make_shared<ParsingService>(&serviceContext);
+    testMacros();
+    testTwoMessages(*servicePtr);
+    testTruncatedAfterLonger(*servicePtr);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
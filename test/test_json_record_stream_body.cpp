@@ -0,0 +1,199 @@
+/**
+ * @file test_json_record_stream_body.cpp
+ * @brief Tests unitaires pour le découpage en enregistrements des corps de réponse JSON reçus par morceaux
+ *
+ * Teste les fonctionnalités principales :
+ * - Extraction des éléments du tableau désigné par une clé et conservation de l'enveloppe
+ * - Indépendance du résultat vis-à-vis du découpage de l'entrée
+ * - Chaînes échappées, enregistrements scalaires et clés homonymes imbriquées
+ * - Corps Boost Beast selon le code de statut de la réponse
+ * - Limite de taille des corps conservés en entier
+ */
+
+#include "../include/ccapi_cpp/ccapi_json_record_stream_body.h"
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ccapi;
+namespace http = boost::beast::http;
+
+/**
+ * @brief Découpe un texte en morceaux de tailles aléatoires et renvoie les enregistrements et l'enveloppe
+ */
+std::pair<std::vector<std::string>, std::string> split(const std::string& text, const std::string& arrayKey, std::mt19937& rng, size_t maxPieceSize) {
+    std::vector<std::string> recordList;
+    std::string envelope;
+    JsonRecordSplitter splitter(arrayKey, [&](std::string_view record) { recordList.emplace_back(record); }, envelope);
+    size_t i = 0;
+    while (i < text.size()) {
+        size_t pieceSize = std::min<size_t>(text.size() - i, 1 + rng() % maxPieceSize);
+        splitter.feed(text.data() + i, pieceSize);
+        i += pieceSize;
+    }
+    splitter.finish();
+    assert(splitter.getNumRecord() == recordList.size());
+    return {recordList, envelope};
+}
+
+/**
+ * @brief Vérifie le découpage d'une réponse d'instruments d'OKX
+ */
+void testInstruments() {
+    std::string text = R"({"code":"0","msg":"","data":[)";
+    std::vector<std::string> expectedRecordList;
+    for (int i = 0; i < 200; ++i) {
+        expectedRecordList.push_back(R"({"instType":"SPOT","instId":"BTC-USDT-)" + std::to_string(i) +
+                                     R"(","baseCcy":"BTC","quoteCcy":"USDT","tickSz":"0.1","lotSz":"0.00000001","alias":"","listTime":"1606468572000"})");
+        text += (i == 0 ? "" : ",") + expectedRecordList.back();
+    }
+    text += "]}";
+    std::mt19937 rng(42);
+    for (size_t maxPieceSize : {1, 7, 100, 4096, 1 << 20}) {
+        auto result = split(text, "data", rng, maxPieceSize);
+        assert(result.first == expectedRecordList);
+        assert(result.second == R"({"code":"0","msg":"","data":[]})");
+    }
+    std::cout << "Test instruments passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie les cas particuliers de la syntaxe JSON
+ *
+ * Vérifie :
+ * - Des espaces autour des séparateurs et des enregistrements tableaux, chaînes, nombres et littéraux
+ * - Des guillemets et des crochets échappés dans les chaînes
+ * - Une clé homonyme imbriquée ou une valeur homonyme qui ne sont pas le tableau
+ */
+void testSyntax() {
+    std::mt19937 rng(42);
+    std::string text = "{ \"arg\" : {\"data\":[1,2]}, \"msg\":\"data\", \"data\" : [ [\"1700000000000\",\"42000.1\"] , \"a\\\"]b\" ,12.5,true , "
+                       "{\"x\":\"}\\\\\"} ] , \"code\" : \"0\" }";
+    std::vector<std::string> expectedRecordList = {"[\"1700000000000\",\"42000.1\"]", "\"a\\\"]b\"", "12.5", "true", "{\"x\":\"}\\\\\"}"};
+    for (size_t maxPieceSize : {1, 2, 3, 5, 1000}) {
+        for (int iteration = 0; iteration < 50; ++iteration) {
+            auto result = split(text, "data", rng, maxPieceSize);
+            assert(result.first == expectedRecordList);
+            assert(result.second == "{ \"arg\" : {\"data\":[1,2]}, \"msg\":\"data\", \"data\" : [] , \"code\" : \"0\" }");
+        }
+    }
+    auto result = split(R"({"code":"51001","msg":"Instrument ID does not exist","data":[]})", "data", rng, 3);
+    assert(result.first.empty());
+    assert(result.second == R"({"code":"51001","msg":"Instrument ID does not exist","data":[]})");
+    result = split(R"({"code":"0","data":[{"a":1},{"b")", "data", rng, 4);
+    assert(result.first.size() == 1);
+    assert(result.second == R"({"code":"0","data":[{"b")");
+    std::cout << "Test syntax passed!" << std::endl;
+}
+
+/**
+ * @brief Analyse une réponse HTTP complète avec le corps à enregistrements
+ */
+std::pair<std::vector<std::string>, std::string> parseResponse(const std::string& response) {
+    std::vector<std::string> recordList;
+    http::response_parser<JsonRecordStreamBody> parser;
+    parser.get().body().arrayKey = "data";
+    parser.get().body().recordHandler = [&](std::string_view record) { recordList.emplace_back(record); };
+    boost::beast::error_code ec;
+    size_t offset = 0;
+    while (!parser.is_done()) {
+        size_t n = parser.put(boost::asio::buffer(response.data() + offset, std::min<size_t>(response.size() - offset, 16)), ec);
+        assert(!ec || ec == http::error::need_more);
+        offset += n;
+        if (n == 0 && !ec) {
+            break;
+        }
+        if (ec == http::error::need_more) {
+            // the parser wants more bytes at once, like a read would provide
+            size_t m = parser.put(boost::asio::buffer(response.data() + offset, response.size() - offset), ec);
+            assert(!ec);
+            offset += m;
+        }
+    }
+    assert(parser.get().body().numRecord == recordList.size());
+    return {recordList, parser.get().body().envelope};
+}
+
+/**
+ * @brief Vérifie le corps Boost Beast pour une réponse réussie et pour une réponse en erreur
+ */
+void testBody() {
+    std::string body = R"({"code":"0","msg":"","data":[{"instId":"BTC-USDT"},{"instId":"ETH-USDT"}]})";
+    auto result = parseResponse("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body);
+    assert(result.first == std::vector<std::string>({R"({"instId":"BTC-USDT"})", R"({"instId":"ETH-USDT"})"}));
+    assert(result.second == R"({"code":"0","msg":"","data":[]})");
+    std::string chunked = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+    for (size_t i = 0; i < body.size(); i += 10) {
+        std::string piece = body.substr(i, 10);
+        char size[8];
+        snprintf(size, sizeof(size), "%zx", piece.size());
+        chunked += std::string(size) + "\r\n" + piece + "\r\n";
+    }
+    chunked += "0\r\n\r\n";
+    result = parseResponse(chunked);
+    assert(result.first.size() == 2);
+    assert(result.second == R"({"code":"0","msg":"","data":[]})");
+    result = parseResponse("HTTP/1.1 400 Bad Request\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body);
+    assert(result.first.empty());
+    assert(result.second == body);
+    std::cout << "Test body passed!" << std::endl;
+}
+
+/**
+ * @brief Analyse une réponse HTTP complète avec un analyseur sans limite propre, comme le fait Service, et renvoie l'erreur éventuelle
+ */
+boost::beast::error_code parseResponseWithStoredBodyLimit(const std::string& response, std::uint64_t storedBodyLimit, size_t& numRecord) {
+    http::response_parser<JsonRecordStreamBody> parser;
+    parser.body_limit(std::numeric_limits<std::uint64_t>::max());
+    parser.get().body().arrayKey = "data";
+    parser.get().body().recordHandler = [&](std::string_view) { ++numRecord; };
+    parser.get().body().storedBodyLimit = storedBodyLimit;
+    boost::beast::error_code ec;
+    size_t offset = 0;
+    while (!parser.is_done() && offset < response.size()) {
+        offset += parser.put(boost::asio::buffer(response.data() + offset, response.size() - offset), ec);
+        if (ec && ec != http::error::need_more) {
+            return ec;
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Vérifie que la limite ne s'applique qu'aux corps conservés en entier
+ *
+ * Vérifie :
+ * - Une réponse réussie découpée en enregistrements dépasse la limite sans erreur
+ * - Une réponse en erreur au-delà de la limite échoue, avec ou sans Content-Length
+ */
+void testStoredBodyLimit() {
+    std::string body = R"({"code":"0","msg":"","data":[)";
+    for (int i = 0; i < 100; ++i) {
+        body += std::string(i > 0 ? "," : "") + R"({"instId":"BTC-USDT"})";
+    }
+    body += "]}";
+    size_t numRecord = 0;
+    auto ec = parseResponseWithStoredBodyLimit("HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body, 256, numRecord);
+    assert(!ec);
+    assert(numRecord == 100);
+    ec = parseResponseWithStoredBodyLimit("HTTP/1.1 400 Bad Request\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body, 256, numRecord);
+    assert(ec == http::error::body_limit);
+    ec = parseResponseWithStoredBodyLimit("HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n" + body, 256, numRecord);
+    assert(ec == http::error::body_limit);
+    ec = parseResponseWithStoredBodyLimit("HTTP/1.1 400 Bad Request\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body, body.size(),
+                                          numRecord);
+    assert(!ec);
+    std::cout << "Test stored body limit passed!" << std::endl;
+}
+
+int main() {
+    testInstruments();
+    testSyntax();
+    testBody();
+    testStoredBodyLimit();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file test_json_scanner.cpp
+ * @brief Tests unitaires pour l'analyse des corps HTTP sans expression régulière
+ *
+ * Teste les fonctionnalités principales :
+ * - Conditions sur la présence d'une clé et sur la valeur brute d'une clé
+ * - Espaces autour des deux-points, chaînes échappées et bornes des valeurs
+ * - Remplacement de toutes les occurrences et conversions base64url
+ */
+
+#include "../include/ccapi_cpp/ccapi_json_scanner.h"
+#include "../include/ccapi_cpp/ccapi_util_private.h"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+using namespace ccapi;
+
+/**
+ * @brief Vérifie les prédicats de succès utilisés par les services
+ */
+void testSuccessCondition() {
+    std::vector<JsonScanner::Condition> okx = {JsonScanner::hasKeyValue("code", "\"0\"")};
+    assert(JsonScanner::matchAny(R"({"code":"0","data":[{"ordId":"312269865356374016"}],"msg":""})", okx));
+    assert(JsonScanner::matchAny("{\"code\" :\n \"0\",\"msg\":\"\"}", okx));
+    assert(!JsonScanner::matchAny(R"({"code":"51008","data":[],"msg":"Order placement failed due to insufficient balance"})", okx));
+    assert(!JsonScanner::matchAny(R"({"code":"01"})", okx));
+    std::vector<JsonScanner::Condition> bybit = {JsonScanner::hasKeyValue("retCode", "0")};
+    assert(JsonScanner::matchAny(R"({"retCode":0,"retMsg":"OK"})", bybit));
+    assert(JsonScanner::matchAny(R"({"retCode": 0})", bybit));
+    assert(!JsonScanner::matchAny(R"({"retCode":10001,"retMsg":"params error"})", bybit));
+    assert(!JsonScanner::matchAny(R"({"retCode":0.5})", bybit));
+    std::vector<JsonScanner::Condition> kraken = {JsonScanner::hasKeyValue("error", "[]")};
+    assert(JsonScanner::matchAny(R"({"error":[],"result":{"XXBTZUSD":{}}})", kraken));
+    assert(!JsonScanner::matchAny(R"({"error":["EQuery:Unknown asset pair"]})", kraken));
+    std::cout << "Test success condition passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie les prédicats d'erreur et le traitement des chaînes
+ *
+ * Vérifie :
+ * - Une clé présente à n'importe quelle profondeur
+ * - Une valeur égale au nom de la clé n'est pas une clé
+ * - Les guillemets échappés à l'intérieur d'une chaîne
+ */
+void testErrorCondition() {
+    std::vector<JsonScanner::Condition> huobi = {JsonScanner::hasKey("err-code")};
+    assert(JsonScanner::matchAny(R"({"status":"error","err-code":"order-limitorder-amount-min-error"})", huobi));
+    assert(JsonScanner::matchAny(R"({"data":{"err-code" : 1}})", huobi));
+    assert(!JsonScanner::matchAny(R"({"status":"ok","data":"err-code"})", huobi));
+    assert(!JsonScanner::matchAny(R"({"status":"ok","data":"\"err-code\":1"})", huobi));
+    std::vector<JsonScanner::Condition> bitstamp = {JsonScanner::hasKeyValue("status", "\"error\""), JsonScanner::hasKey("error")};
+    assert(JsonScanner::matchAny(R"({"status": "error", "reason": "Order not found"})", bitstamp));
+    assert(JsonScanner::matchAny(R"({"error":"Invalid nonce"})", bitstamp));
+    assert(!JsonScanner::matchAny(R"({"id":"1","status":"Open","reason":"error\\"})", bitstamp));
+    assert(!JsonScanner::matchAny("", bitstamp));
+    assert(!JsonScanner::matchAny(R"({"status":"err)", bitstamp));
+    assert(!JsonScanner::matchAny(R"({"error":1})", {}));
+    std::cout << "Test error condition passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie les fonctions de chaîne qui n'utilisent plus d'expression régulière
+ */
+void testUtilString() {
+    assert(UtilString::replaceAllOccurrence("/api/v1/orders/<id>", "<id>", "abc") == "/api/v1/orders/abc");
+    assert(UtilString::replaceAllOccurrence("<id>/<id>", "<id>", "x") == "x/x");
+    assert(UtilString::replaceAllOccurrence("/v1/order/orders/{order-id}", "{order-id}", "59378") == "/v1/order/orders/59378");
+    assert(UtilString::replaceAllOccurrence("abc", "", "x") == "abc");
+    assert(UtilAlgorithm::base64UrlFromBase64("a+b/c==") == "a-b_c");
+    assert(UtilAlgorithm::base64FromBase64Url("a-b_c") == "a+b/c===");
+    assert(UtilAlgorithm::base64UrlDecode(UtilAlgorithm::base64UrlEncode("\xfb\xff?>")) == "\xfb\xff?>");
+    std::cout << "Test util string passed!" << std::endl;
+}
+
+int main() {
+    testSuccessCondition();
+    testErrorCondition();
+    testUtilString();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
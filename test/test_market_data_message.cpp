@@ -0,0 +1,91 @@
+/**
+ * @file test_market_data_message.cpp
+ * @brief Tests unitaires pour la représentation typée de MarketDataMessage
+ *
+ * Teste les fonctionnalités principales :
+ * - Conversion de la forme générique (map) vers les listes typées
+ * - Conversion inverse utilisée pour l'affichage et la compatibilité
+ */
+
+#include "../include/ccapi_cpp/ccapi_market_data_message.h"
+#include <cassert>
+#include <iostream>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Teste la conversion d'un carnet d'ordres
+ */
+void testConvertDepth() {
+    MarketDataMessage marketDataMessage;
+    marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
+    marketDataMessage.data[MarketDataMessage::DataType::BID].push_back(
+        {{MarketDataMessage::DataFieldType::PRICE, "100.5"}, {MarketDataMessage::DataFieldType::SIZE, "2"}});
+    marketDataMessage.data[MarketDataMessage::DataType::ASK].push_back(
+        {{MarketDataMessage::DataFieldType::PRICE, "101"}, {MarketDataMessage::DataFieldType::SIZE, "3"}});
+    MarketDataMessage::TypeForData original = marketDataMessage.data;
+    marketDataMessage.convertDataToTypedList();
+    assert(marketDataMessage.data.empty());
+    assert(marketDataMessage.hasDepth() && !marketDataMessage.hasTrade() && !marketDataMessage.hasCandlestick());
+    assert(marketDataMessage.bidList.size() == 1 && marketDataMessage.bidList[0].price == "100.5" && marketDataMessage.bidList[0].size == "2");
+    assert(marketDataMessage.askList.size() == 1 && marketDataMessage.askList[0].price == "101" && marketDataMessage.askList[0].size == "3");
+    assert(marketDataMessage.getData() == original);
+    std::cout << "Test convert depth passed!" << std::endl;
+}
+
+/**
+ * @brief Teste la conversion des transactions et des chandeliers
+ *
+ * Vérifie :
+ * - Que les champs optionnels absents restent absents
+ * - Que le type AGG_TRADE est restitué d'après le type du message
+ */
+void testConvertTradeAndCandlestick() {
+    MarketDataMessage marketDataMessage;
+    marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_AGG_TRADE;
+    marketDataMessage.data[MarketDataMessage::DataType::AGG_TRADE].push_back({{MarketDataMessage::DataFieldType::PRICE, "42000.1"},
+                                                                             {MarketDataMessage::DataFieldType::SIZE, "0.5"},
+                                                                             {MarketDataMessage::DataFieldType::AGG_TRADE_ID, "7"},
+                                                                             {MarketDataMessage::DataFieldType::IS_BUYER_MAKER, "1"}});
+    MarketDataMessage::TypeForData original = marketDataMessage.data;
+    marketDataMessage.convertDataToTypedList();
+    assert(marketDataMessage.tradeList.size() == 1);
+    const auto& trade = marketDataMessage.tradeList[0];
+    assert(trade.price == "42000.1" && trade.aggTradeId == "7" && trade.tradeId.empty() && trade.isBuyerMaker);
+    assert(marketDataMessage.getData() == original);
+    MarketDataMessage candlestickMessage;
+    candlestickMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK;
+    MarketDataMessage::Candlestick candlestick;
+    candlestick.openPrice = "1";
+    candlestick.highPrice = "3";
+    candlestick.lowPrice = "0.5";
+    candlestick.closePrice = "2";
+    candlestick.volume = "10";
+    candlestickMessage.candlestickList.push_back(candlestick);
+    auto data = candlestickMessage.getData();
+    const auto& dataPoint = data.at(MarketDataMessage::DataType::CANDLESTICK).at(0);
+    assert(dataPoint.at(MarketDataMessage::DataFieldType::HIGH_PRICE) == "3");
+    assert(dataPoint.find(MarketDataMessage::DataFieldType::QUOTE_VOLUME) == dataPoint.end());
+    std::cout << "Test convert trade and candlestick passed!" << std::endl;
+}
+
+/**
+ * @brief Point d'entrée des tests
+ *
+ * @return 0 si tous les tests passent, 1 en cas d'erreur
+ */
+int main() {
+    try {
+        testConvertDepth();
+        testConvertTradeAndCandlestick();
+        std::cout << "All tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
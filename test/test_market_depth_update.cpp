@@ -0,0 +1,134 @@
+/**
+ * @file test_market_depth_update.cpp
+ * @brief Tests unitaires pour le calcul des mises à jour de profondeur de marché à partir des niveaux modifiés
+ *
+ * Compare le calcul à partir des niveaux modifiés à la comparaison complète avec une copie des meilleurs niveaux :
+ * - Carnet vide avant la mise à jour
+ * - Niveaux qui entrent dans les meilleurs niveaux ou en sortent quand le carnet est plus profond que la profondeur demandée
+ * - Mises à jour aléatoires
+ */
+
+#define CCAPI_EXPOSE_INTERNAL
+#ifndef CCAPI_ENABLE_SERVICE_MARKET_DATA
+#define CCAPI_ENABLE_SERVICE_MARKET_DATA
+#endif
+#include "../include/ccapi_cpp/service/ccapi_market_data_service.h"
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+typedef std::map<Decimal, std::string> Book;
+typedef std::vector<std::pair<std::string, std::string>> LevelList;
+
+/**
+ * @brief Copie les maxMarketDepth meilleurs niveaux d'un côté du carnet, comme le fait MarketDataService avant une mise à jour
+ */
+Book copyBest(bool isBid, const Book& book, int maxMarketDepth) {
+    Book output;
+    int i = 0;
+    if (isBid) {
+        for (auto it = book.rbegin(); it != book.rend() && i < maxMarketDepth; ++it, ++i) {
+            output.insert(*it);
+        }
+    } else {
+        for (auto it = book.begin(); it != book.end() && i < maxMarketDepth; ++it, ++i) {
+            output.insert(*it);
+        }
+    }
+    return output;
+}
+
+/**
+ * @brief Applique levelList à book et vérifie que les deux calculs de la mise à jour des meilleurs niveaux donnent le même résultat
+ *
+ * @return La mise à jour calculée
+ */
+Book applyAndCompare(bool isBid, Book& book, const LevelList& levelList, int maxMarketDepth) {
+    Book previous = copyBest(isBid, book, maxMarketDepth);
+    bool wasEmpty = book.empty();
+    Decimal previousBoundary;
+    bool hasPreviousBoundary = MarketDataService::getMarketDepthBoundary(isBid, book, maxMarketDepth, previousBoundary);
+    std::vector<MarketDataService::DirtyLevel> dirtyLevelList;
+    for (const auto& level : levelList) {
+        MarketDataService::updateOrderBook(book, level.first, level.second, false, &dirtyLevelList);
+    }
+    Book expected = MarketDataService::calculateMarketDepthUpdate(isBid, book, previous, maxMarketDepth);
+    Book actual =
+        MarketDataService::calculateMarketDepthUpdate(isBid, book, dirtyLevelList, wasEmpty, hasPreviousBoundary, previousBoundary, maxMarketDepth);
+    assert(actual == expected);
+    return actual;
+}
+
+/**
+ * @brief Vérifie la mise à jour d'un carnet vide avant la mise à jour : tout le carnet est renvoyé, même au-delà de la profondeur demandée
+ */
+void testEmptyPrevious() {
+    Book book;
+    Book update = applyAndCompare(true, book, {{"100", "1"}, {"99", "2"}, {"98", "3"}}, 2);
+    assert(update.size() == 3);
+    Book askBook;
+    update = applyAndCompare(false, askBook, {{"101", "1"}}, 2);
+    assert(update.size() == 1);
+    std::cout << "Test empty previous passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie les niveaux qui entrent dans les meilleurs niveaux ou en sortent quand le carnet est plus profond que la profondeur demandée
+ */
+void testDepthTruncation() {
+    Book book;
+    applyAndCompare(true, book, {{"100", "1"}, {"99", "2"}, {"98", "3"}, {"97", "4"}}, 2);
+    Book update = applyAndCompare(true, book, {{"100", "0"}}, 2);
+    assert(update == Book({{Decimal("100"), "0"}, {Decimal("98"), "3"}}));
+    update = applyAndCompare(true, book, {{"99.5", "5"}}, 2);
+    assert(update == Book({{Decimal("99.5"), "5"}, {Decimal("98"), "0"}}));
+    update = applyAndCompare(true, book, {{"97", "6"}}, 2);
+    assert(update.empty());
+    update = applyAndCompare(true, book, {{"99.5", "0"}, {"99", "0"}, {"96", "7"}}, 2);
+    assert(update == Book({{Decimal("99.5"), "0"}, {Decimal("99"), "0"}, {Decimal("98"), "3"}, {Decimal("97"), "6"}}));
+    update = applyAndCompare(true, book, {{"98", "0"}, {"97", "0"}, {"96", "0"}}, 2);
+    assert(update == Book({{Decimal("98"), "0"}, {Decimal("97"), "0"}}));
+    std::cout << "Test depth truncation passed!" << std::endl;
+}
+
+/**
+ * @brief Compare les deux calculs sur des mises à jour aléatoires, avec des niveaux modifiés plusieurs fois dans une même mise à jour
+ */
+void testRandom() {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> priceDistribution(90, 110);
+    std::uniform_int_distribution<int> sizeDistribution(0, 3);
+    std::uniform_int_distribution<int> numLevelDistribution(1, 6);
+    for (int maxMarketDepth : {1, 3, 10}) {
+        for (bool isBid : {true, false}) {
+            Book book;
+            for (int i = 0; i < 2000; ++i) {
+                LevelList levelList;
+                int numLevel = numLevelDistribution(generator);
+                for (int j = 0; j < numLevel; ++j) {
+                    levelList.emplace_back(std::to_string(priceDistribution(generator)), std::to_string(sizeDistribution(generator)));
+                }
+                applyAndCompare(isBid, book, levelList, maxMarketDepth);
+            }
+        }
+    }
+    std::cout << "Test random passed!" << std::endl;
+}
+
+int main() {
+    testEmptyPrevious();
+    testDepthTruncation();
+    testRandom();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file test_order_book_checksum_async.cpp
+ * @brief Tests unitaires pour la vérification asynchrone de la somme de contrôle du carnet d'ordres
+ *
+ * Teste les fonctionnalités principales :
+ * - Une somme de contrôle correcte n'est pas signalée
+ * - Plusieurs vérifications incorrectes en cours pour le même carnet ne le signalent qu'une fois
+ * - Les vérifications d'un carnet reconstruit entre-temps, ou d'une connexion fermée, sont abandonnées
+ */
+
+#define CCAPI_EXPOSE_INTERNAL
+#ifndef CCAPI_ENABLE_SERVICE_MARKET_DATA
+#define CCAPI_ENABLE_SERVICE_MARKET_DATA
+#endif
+#include "../include/ccapi_cpp/service/ccapi_market_data_service.h"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Service de données de marché qui compte les états incorrects signalés au lieu de fermer la connexion
+ */
+class CountingMarketDataService : public MarketDataService {
+ public:
+    CountingMarketDataService(SessionOptions sessionOptions, ServiceContext* serviceContextPtr)
+        : MarketDataService([](Event&, Queue<Event>*) {}, sessionOptions, SessionConfigs(), serviceContextPtr) {
+        this->orderBookChecksumNumLevels = 25;
+    }
+    void onIncorrectStatesFound(std::shared_ptr<WsConnection> wsConnectionPtr, boost::beast::string_view textMessageView, const TimePoint& timeReceived,
+                                const std::string& exchangeSubscriptionId, std::string const& reason) override {
+        ++this->numIncorrectStatesFound;
+    }
+    int numIncorrectStatesFound{};
+};
+
+/**
+ * @brief Attend que les vérifications déjà soumises soient terminées et que leurs résultats soient traités sur l'io_context
+ */
+void drain(CountingMarketDataService& service, ServiceContext& serviceContext) {
+    std::atomic<bool> isDrained{false};
+    auto ioContextPtr = serviceContext.ioContextPtr;
+    boost::asio::post(*service.orderBookChecksumThreadPoolPtr,
+                      [ioContextPtr, &isDrained]() { boost::asio::post(*ioContextPtr, [&isDrained]() { isDrained = true; }); });
+    while (!isDrained) {
+        serviceContext.ioContextPtr->restart();
+        serviceContext.ioContextPtr->run_one_for(std::chrono::milliseconds(100));
+    }
+    serviceContext.ioContextPtr->restart();
+    serviceContext.ioContextPtr->poll();
+}
+
+int main() {
+    ServiceContext serviceContext;
+    SessionOptions sessionOptions;
+    sessionOptions.enableCheckOrderBookChecksum = true;
+    sessionOptions.enableOrderBookChecksumVerifyAsync = true;
+    auto servicePtr = std::make_shared<CountingMarketDataService>(sessionOptions, &serviceContext);
+    CountingMarketDataService& service = *servicePtr;
+    assert(service.orderBookChecksumThreadPoolPtr);
+    auto wsConnectionPtr = std::make_shared<WsConnection>("wss://ws.okx.com:8443/ws/v5/public", "", std::vector<Subscription>(),
+                                                          std::map<std::string, std::string>(), nullptr);
+    service.wsConnectionByIdMap[wsConnectionPtr->id] = wsConnectionPtr;
+    auto& subscriptionState = service.subscriptionStateByConnectionIdChannelIdSymbolIdMap[wsConnectionPtr->id]["books"]["BTC-USDT"];
+    subscriptionState.channelId = "books";
+    subscriptionState.symbolId = "BTC-USDT";
+    subscriptionState.exchangeSubscriptionId = "books:BTC-USDT";
+    std::map<Decimal, std::string> snapshotBid{{Decimal("100", true), "1"}, {Decimal("99", true), "2"}};
+    std::map<Decimal, std::string> snapshotAsk{{Decimal("101", true), "3"}};
+    std::vector<std::pair<Decimal, std::string>> bidList(snapshotBid.begin(), snapshotBid.end());
+    std::vector<std::pair<Decimal, std::string>> askList(snapshotAsk.begin(), snapshotAsk.end());
+    std::string checksum = MarketDataService::calculateOrderBookCrc32(bidList, askList, 25, "");
+    std::string badChecksum = checksum == "1" ? "2" : "1";
+    TimePoint now = UtilTime::now();
+
+    service.verifyOrderBookChecksumAsync(wsConnectionPtr, now, subscriptionState, snapshotBid, snapshotAsk, checksum);
+    drain(service, serviceContext);
+    assert(service.numIncorrectStatesFound == 0);
+    std::cout << "Test correct checksum passed!" << std::endl;
+
+    for (int i = 0; i < 3; ++i) {
+        service.verifyOrderBookChecksumAsync(wsConnectionPtr, now, subscriptionState, snapshotBid, snapshotAsk, badChecksum);
+    }
+    drain(service, serviceContext);
+    assert(service.numIncorrectStatesFound == 1);
+    std::cout << "Test incorrect checksums reported once passed!" << std::endl;
+
+    service.verifyOrderBookChecksumAsync(wsConnectionPtr, now, subscriptionState, snapshotBid, snapshotAsk, badChecksum);
+    ++subscriptionState.orderBookGeneration;
+    drain(service, serviceContext);
+    assert(service.numIncorrectStatesFound == 1);
+    service.verifyOrderBookChecksumAsync(wsConnectionPtr, now, subscriptionState, snapshotBid, snapshotAsk, badChecksum);
+    drain(service, serviceContext);
+    assert(service.numIncorrectStatesFound == 2);
+    std::cout << "Test rebuilt book passed!" << std::endl;
+
+    service.verifyOrderBookChecksumAsync(wsConnectionPtr, now, subscriptionState, snapshotBid, snapshotAsk, badChecksum);
+    service.wsConnectionByIdMap.erase(wsConnectionPtr->id);
+    drain(service, serviceContext);
+    assert(service.numIncorrectStatesFound == 2);
+    std::cout << "Test closed connection passed!" << std::endl;
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
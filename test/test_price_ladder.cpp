@@ -0,0 +1,155 @@
+/**
+ * @file test_price_ladder.cpp
+ * @brief Tests unitaires pour le carnet d'ordres indexé par tick PriceLadder
+ *
+ * Teste les fonctionnalités principales :
+ * - Ordre d'itération identique à std::map<Decimal, std::string>
+ * - Recentrage de la fenêtre lorsque le meilleur prix dérive
+ * - Inférence et raffinement du pas de cotation
+ * - Rejet d'un prix qui ne tient pas dans la grille de ticks, sans modifier le carnet
+ */
+
+#include "../include/ccapi_cpp/ccapi_price_ladder.h"
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Applique une mise à jour de niveau à un carnet de référence std::map
+ */
+void updateReference(std::map<Decimal, std::string>& reference, const std::string& price, const std::string& size) {
+    if (PriceLadder::isZeroSize(size)) {
+        reference.erase(Decimal(price));
+    } else {
+        reference[Decimal(price)] = size;
+    }
+}
+
+/**
+ * @brief Vérifie que le carnet et la référence contiennent les mêmes niveaux dans le même ordre
+ */
+void assertSame(const PriceLadder& ladder, const std::map<Decimal, std::string>& reference) {
+    assert(ladder.size() == reference.size());
+    auto it = ladder.begin();
+    for (const auto& x : reference) {
+        assert(it != ladder.end());
+        assert(it->first == x.first && it->second == x.second);
+        ++it;
+    }
+    assert(it == ladder.end());
+    auto rit = ladder.rbegin();
+    for (auto x = reference.rbegin(); x != reference.rend(); ++x) {
+        assert(rit->first == x->first && rit->second == x->second);
+        ++rit;
+    }
+    assert(rit == ladder.rend());
+}
+
+/**
+ * @brief Teste les opérations de base sur un côté acheteur et vendeur
+ */
+void testBasic() {
+    PriceLadder bid(true, 16, "0.5");
+    bid.update("100", "1");
+    bid.update("99.5", "2");
+    bid.update("101", "3");
+    assert(bid.rbegin()->first == Decimal("101") && bid.rbegin()->second == "3");
+    assert(bid.begin()->first == Decimal("99.5"));
+    bid.update("101", "0.000");
+    assert(bid.size() == 2 && bid.rbegin()->first == Decimal("100"));
+    assert(bid.toString() == "{99.5=2, 100=1}");
+    assert(lastNToString(bid, 1) == "{100=1}");
+    PriceLadder ask(false, 16);
+    ask.update("0.0120", "5", true);
+    ask.update("0.0125", "6", true);
+    assert(ask.begin()->first.toString() == "0.0120");
+    assert(ask.getTickSize().toString() == "0.0001");
+    ask.keepBestN(1);
+    assert(ask.size() == 1 && ask.begin()->second == "5");
+    std::cout << "Test basic passed!" << std::endl;
+}
+
+/**
+ * @brief Compare le carnet à une référence std::map sur des mises à jour aléatoires
+ *
+ * Vérifie :
+ * - Les niveaux hors de la fenêtre (débordement)
+ * - Le recentrage lorsque le meilleur prix s'améliore ou se dégrade fortement
+ * - Le raffinement du pas de cotation sur un prix plus fin
+ */
+void testRandomAgainstMap() {
+    for (bool isBid : {true, false}) {
+        std::mt19937 generator(isBid ? 1 : 2);
+        PriceLadder ladder(isBid, 64);
+        std::map<Decimal, std::string> reference;
+        int center = 10000;
+        for (int i = 0; i < 20000; ++i) {
+            if (i % 1000 == 0) {
+                center += static_cast<int>(generator() % 400) - 200;
+            }
+            int tick = center + static_cast<int>(generator() % 200) - 100;
+            std::string price = std::to_string(tick / 10) + "." + std::to_string(tick % 10);
+            if (i == 10000) {
+                price += "5";
+            }
+            std::string size = generator() % 3 == 0 ? "0" : std::to_string(generator() % 100 + 1);
+            ladder.update(price, size);
+            updateReference(reference, price, size);
+            if (i % 97 == 0) {
+                assertSame(ladder, reference);
+            }
+        }
+        assertSame(ladder, reference);
+        ladder.keepBestN(10);
+        assert(ladder.size() == 10);
+        ladder.clear();
+        assert(ladder.empty() && ladder.begin() == ladder.end());
+    }
+    std::cout << "Test random against map passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie le rejet d'un prix dont le raffinement du pas de cotation déborderait un tick int64_t
+ */
+void testRegridOverflow() {
+    PriceLadder ladder(false, 16);
+    ladder.update("100000000000", "1");
+    bool isThrown = false;
+    try {
+        ladder.update("0.000000001", "2");
+    } catch (const std::runtime_error&) {
+        isThrown = true;
+    }
+    assert(isThrown);
+    assert(ladder.size() == 1);
+    assert(ladder.begin()->first == Decimal("100000000000") && ladder.begin()->second == "1");
+    assert(ladder.getTickSize().toString() == "1");
+    ladder.update("100000000001", "3");
+    assert(ladder.size() == 2);
+    std::cout << "Test regrid overflow passed!" << std::endl;
+}
+
+/**
+ * @brief Point d'entrée des tests
+ *
+ * @return 0 si tous les tests passent, 1 en cas d'erreur
+ */
+int main() {
+    try {
+        testBasic();
+        testRandomAgainstMap();
+        testRegridOverflow();
+        std::cout << "All tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,218 @@
+/**
+ * @file test_queue.cpp
+ * @brief Tests unitaires pour la file d'événements protégée par mutex et sa variante sans verrou
+ *
+ * Teste les fonctionnalités principales :
+ * - Ordre FIFO, popBack, purge et removeAll dans les deux variantes
+ * - Déplacement des éléments sans copie
+ * - Politiques de débordement : exception, blocage et suppression du plus ancien
+ * - Plusieurs producteurs et un consommateur concurrents
+ * - Un consommateur qui lève une exception ne bloque pas le tampon circulaire
+ */
+
+#include "../include/ccapi_cpp/ccapi_queue.h"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Vérifie les opérations de base d'une file
+ */
+void testBasic(Queue<std::string>& queue) {
+    for (int i = 0; i < 5; ++i) {
+        queue.pushBack(std::to_string(i));
+    }
+    assert(queue.size() == 5);
+    assert(queue.popBack() == "4");
+    std::vector<std::string> c = {"x"};
+    queue.removeAll(c);
+    assert(c == std::vector<std::string>({"x", "0", "1", "2", "3"}));
+    assert(queue.empty());
+    queue.pushBack("5");
+    queue.pushBack("6");
+    assert(queue.purge() == std::vector<std::string>({"5", "6"}));
+    bool thrown = false;
+    try {
+        queue.popBack();
+    } catch (const std::runtime_error& e) {
+        thrown = std::string(e.what()) == queue.EXCEPTION_QUEUE_EMPTY;
+    }
+    assert(thrown);
+}
+
+/**
+ * @brief Vérifie les deux variantes et le déplacement d'un élément non copiable
+ */
+void testFifo() {
+    Queue<std::string> queue;
+    testBasic(queue);
+    Queue<std::string> lockFreeQueue(8, QueueOverflowPolicy::THROW, true);
+    assert(lockFreeQueue.isLockFree());
+    testBasic(lockFreeQueue);
+    assert(!Queue<std::string>(0, QueueOverflowPolicy::THROW, true).isLockFree());
+    Queue<std::unique_ptr<int>> moveOnlyQueue(4, QueueOverflowPolicy::THROW, true);
+    moveOnlyQueue.pushBack(std::unique_ptr<int>(new int(42)));
+    assert(*moveOnlyQueue.purge().at(0) == 42);
+    std::string large(1000, 'a');
+    const char* data = large.data();
+    Queue<std::string> mutexQueue;
+    mutexQueue.pushBack(std::move(large));
+    assert(mutexQueue.purge().at(0).data() == data);
+    std::cout << "Test fifo passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie les politiques de débordement
+ *
+ * Vérifie :
+ * - L'exception EXCEPTION_QUEUE_FULL
+ * - La suppression des éléments les plus anciens
+ * - Le blocage d'un producteur jusqu'à ce que le consommateur libère de la place
+ * - L'exception levée à la place du blocage une fois la file arrêtée
+ */
+void testOverflow() {
+    for (bool isLockFree : {false, true}) {
+        Queue<int> throwQueue(4, QueueOverflowPolicy::THROW, isLockFree);
+        for (int i = 0; i < 4; ++i) {
+            throwQueue.pushBack(i);
+        }
+        bool thrown = false;
+        try {
+            throwQueue.pushBack(4);
+        } catch (const std::runtime_error& e) {
+            thrown = std::string(e.what()) == throwQueue.EXCEPTION_QUEUE_FULL;
+        }
+        assert(thrown);
+        Queue<int> dropQueue(4, QueueOverflowPolicy::DROP_OLDEST, isLockFree);
+        for (int i = 0; i < 10; ++i) {
+            dropQueue.pushBack(i);
+        }
+        assert(dropQueue.purge() == std::vector<int>({6, 7, 8, 9}));
+        if (!isLockFree) {
+            // popBack takes the elements of a lock-free queue out of its ring buffer, which then has room again
+            for (int i = 0; i < 7; ++i) {
+                dropQueue.pushBack(i);
+            }
+            assert(dropQueue.size() == 4);
+            assert(dropQueue.popBack() == 6);
+            dropQueue.pushBack(7);
+            dropQueue.pushBack(8);
+            std::vector<int> dropped;
+            dropQueue.removeAll(dropped);
+            assert(dropped == std::vector<int>({4, 5, 7, 8}));
+        }
+        Queue<int> blockQueue(4, QueueOverflowPolicy::BLOCK, isLockFree);
+        std::thread producer([&blockQueue] {
+            for (int i = 0; i < 1000; ++i) {
+                blockQueue.pushBack(i);
+            }
+        });
+        std::vector<int> c;
+        while (c.size() < 1000) {
+            blockQueue.removeAll(c);
+        }
+        producer.join();
+        for (int i = 0; i < 1000; ++i) {
+            assert(c[i] == i);
+        }
+        std::atomic<bool> stoppedThrown{};
+        std::thread blockedProducer([&blockQueue, &stoppedThrown] {
+            try {
+                for (int i = 0; i < 5; ++i) {
+                    blockQueue.pushBack(i);
+                }
+            } catch (const std::runtime_error& e) {
+                stoppedThrown = std::string(e.what()) == blockQueue.EXCEPTION_QUEUE_FULL;
+            }
+        });
+        blockQueue.stop();
+        blockedProducer.join();
+        assert(stoppedThrown);
+        assert(blockQueue.size() == 4);
+    }
+    std::cout << "Test overflow passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie qu'aucun élément n'est perdu ni dupliqué avec plusieurs producteurs et que l'ordre de chacun est conservé
+ */
+void testConcurrent() {
+    const int numProducer = 4;
+    const int numPerProducer = 100000;
+    for (int numThread : {1, numProducer}) {
+        Queue<int> queue(64, QueueOverflowPolicy::BLOCK, true);
+        std::vector<std::thread> producerList;
+        for (int p = 0; p < numThread; ++p) {
+            producerList.emplace_back([&queue, p] {
+                for (int i = 0; i < numPerProducer; ++i) {
+                    queue.pushBack(p * numPerProducer + i);
+                }
+            });
+        }
+        std::vector<int> lastList(numThread, -1);
+        size_t numReceived = 0;
+        std::vector<int> c;
+        while (numReceived < static_cast<size_t>(numThread) * numPerProducer) {
+            c.clear();
+            queue.removeAll(c);
+            for (int x : c) {
+                int p = x / numPerProducer;
+                assert(x % numPerProducer == lastList[p] + 1);
+                lastList[p] = x % numPerProducer;
+            }
+            numReceived += c.size();
+        }
+        for (auto& producer : producerList) {
+            producer.join();
+        }
+        assert(queue.empty());
+    }
+    std::cout << "Test concurrent passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie qu'une exception levée par le consommateur libère quand même l'emplacement : l'élément est perdu mais le tampon reste utilisable
+ */
+void testConsumeThrows() {
+    RingBuffer<std::string> ringBuffer(2);
+    assert(ringBuffer.tryPush(std::string("a")));
+    assert(ringBuffer.tryPush(std::string("b")));
+    bool thrown = false;
+    try {
+        ringBuffer.tryConsume([](std::string&&) { throw std::runtime_error("consumer failed"); });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(ringBuffer.size() == 1);
+    assert(ringBuffer.tryPush(std::string("c")));
+    std::string s;
+    assert(ringBuffer.tryPop(s) && s == "b");
+    assert(ringBuffer.tryPop(s) && s == "c");
+    assert(!ringBuffer.tryPop(s));
+    for (int i = 0; i < 4; ++i) {
+        assert(ringBuffer.tryPush(std::to_string(i)));
+        assert(ringBuffer.tryPop(s) && s == std::to_string(i));
+    }
+    std::cout << "Test consume throws passed!" << std::endl;
+}
+
+int main() {
+    testFifo();
+    testOverflow();
+    testConcurrent();
+    testConsumeThrows();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file test_service_context.cpp
+ * @brief Tests unitaires pour le contexte de service à plusieurs io_context
+ *
+ * Teste les fonctionnalités principales :
+ * - Attribution des io_context aux services à tour de rôle
+ * - Exécution de chaque io_context sur un thread qui lui est propre
+ * - Épinglage optionnel des threads et arrêt
+ * - Arrêt pendant ou avant le démarrage depuis un autre thread
+ * - Mode d'attente active avec repli sur une attente bloquante
+ * - Backend d'entrées-sorties et détection d'io_uring
+ */
+
+#include "boost/asio.hpp"
+#include "boost/asio/ssl.hpp"
+#include "../include/ccapi_cpp/service/ccapi_service_context.h"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Vérifie qu'un contexte à numIoContext io_context répartit les services sur autant de threads
+ */
+void testServiceContext(int numIoContext, const std::vector<int>& cpuList, long busyPollSpinMicroseconds = 0) {
+    ServiceContext serviceContext(numIoContext, cpuList, busyPollSpinMicroseconds);
+    assert(serviceContext.getNumIoContext() == static_cast<size_t>(numIoContext));
+    std::vector<ServiceContext*> serviceContextPtrList;
+    for (int i = 0; i < 2 * numIoContext; ++i) {
+        serviceContextPtrList.push_back(serviceContext.getServiceContextForService());
+    }
+    assert(serviceContextPtrList[0] == &serviceContext);
+    for (int i = 0; i < numIoContext; ++i) {
+        assert(serviceContextPtrList[i] == serviceContextPtrList[i + numIoContext]);
+        assert(serviceContextPtrList[i]->sslContextPtr == serviceContext.sslContextPtr);
+        assert(serviceContextPtrList[i]->tlsSessionCachePtr == serviceContext.tlsSessionCachePtr);
+    }
+    std::thread t([&serviceContext] { serviceContext.start(); });
+    std::mutex lock;
+    std::vector<std::set<std::thread::id>> threadIdSetList(numIoContext);
+    std::atomic<int> numRun{};
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < numIoContext; ++i) {
+            boost::asio::post(*serviceContextPtrList[i]->ioContextPtr, [&, i] {
+                std::lock_guard<std::mutex> guard(lock);
+                threadIdSetList[i].insert(std::this_thread::get_id());
+                ++numRun;
+            });
+        }
+    }
+    while (numRun.load() < 100 * numIoContext) {
+        std::this_thread::yield();
+    }
+    serviceContext.stop();
+    t.join();
+    std::set<std::thread::id> threadIdSet;
+    for (const auto& x : threadIdSetList) {
+        assert(x.size() == 1);
+        threadIdSet.insert(*x.begin());
+    }
+    assert(threadIdSet.size() == static_cast<size_t>(numIoContext));
+}
+
+/**
+ * @brief Vérifie qu'en mode d'attente active les minuteries échues après le budget de rotation sont exécutées, puis que l'arrêt est pris en compte
+ */
+void testBusyPoll() {
+    ServiceContext serviceContext(2, {}, 100);
+    assert(serviceContext.getBusyPollSpinMicroseconds() == 100);
+    std::thread t([&serviceContext] { serviceContext.start(); });
+    std::atomic<int> numFired{};
+    std::vector<std::unique_ptr<boost::asio::steady_timer>> timerPtrList;
+    for (int i = 0; i < 2; ++i) {
+        ServiceContext* serviceContextPtr = serviceContext.getServiceContextForService();
+        assert(serviceContextPtr->getBusyPollSpinMicroseconds() == 100);
+        timerPtrList.emplace_back(new boost::asio::steady_timer(*serviceContextPtr->ioContextPtr, std::chrono::milliseconds(20)));
+        timerPtrList.back()->async_wait([&numFired](const boost::system::error_code& ec) {
+            assert(!ec);
+            ++numFired;
+        });
+    }
+    while (numFired.load() < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    serviceContext.stop();
+    t.join();
+}
+
+/**
+ * @brief Vérifie que le thread qui exécute start est épinglé au premier cpu de la liste, y compris avec un seul io_context
+ */
+void testPinSingleIoContext() {
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    assert(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0);
+    int cpu = 0;
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+        if (CPU_ISSET(i, &cpuSet)) {
+            cpu = i;
+        }
+    }
+    ServiceContext serviceContext(1, {cpu});
+    std::thread t([&serviceContext] { serviceContext.start(); });
+    std::atomic<bool> isPinned{};
+    std::atomic<bool> isDone{};
+    boost::asio::post(*serviceContext.ioContextPtr, [&] {
+        cpu_set_t ioCpuSet;
+        CPU_ZERO(&ioCpuSet);
+        pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &ioCpuSet);
+        isPinned = CPU_COUNT(&ioCpuSet) == 1 && CPU_ISSET(cpu, &ioCpuSet);
+        isDone = true;
+    });
+    while (!isDone.load()) {
+        std::this_thread::yield();
+    }
+    serviceContext.stop();
+    t.join();
+    assert(isPinned);
+#endif
+}
+
+/**
+ * @brief Vérifie que le backend io_uring n'est choisi que si le noyau le prend en charge
+ */
+void testIoBackend() {
+    std::string ioBackend = ServiceContext::getIoBackend();
+    bool isIoUringSupported = ServiceContext::isIoUringSupported();
+    std::cout << "io backend: " << ioBackend << ", io_uring supported: " << isIoUringSupported << std::endl;
+    assert(ioBackend != "io_uring" || isIoUringSupported);
+#ifdef __linux__
+    assert(ioBackend == "epoll" || ioBackend == "io_uring");
+#endif
+}
+
+/**
+ * @brief Vérifie qu'un arrêt appelé pendant que start crée les threads des io_context, ou avant, les arrête tous sans course sur la liste des threads
+ */
+void testStopWhileStarting() {
+    for (int round = 0; round < 200; ++round) {
+        ServiceContext serviceContext(4, {});
+        std::thread t([&serviceContext] { serviceContext.start(); });
+        serviceContext.stop();
+        t.join();
+    }
+    ServiceContext serviceContext(4, {});
+    serviceContext.stop();
+    serviceContext.start();
+    std::cout << "Test stop while starting passed!" << std::endl;
+}
+
+int main() {
+    testServiceContext(1, {});
+    testServiceContext(3, {});
+    testServiceContext(2, {0, 0});
+    testServiceContext(2, {}, 1000);
+    testBusyPoll();
+    testPinSingleIoContext();
+    testIoBackend();
+    testStopWhileStarting();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
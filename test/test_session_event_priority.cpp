@@ -0,0 +1,125 @@
+/**
+ * @file test_session_event_priority.cpp
+ * @brief Tests unitaires pour la voie de priorité dans laquelle la session distribue chaque événement
+ *
+ * Teste les fonctionnalités principales :
+ * - Sans voies de priorité, les événements sont traités dans l'ordre où ils arrivent
+ * - Avec voies de priorité, les événements d'un abonnement de gestion des ordres, y compris son statut, passent avant les données de marché et restent dans
+ *   leur ordre
+ */
+
+#define CCAPI_EXPOSE_INTERNAL
+#include "../include/ccapi_cpp/ccapi_session.h"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Retient l'ordre des événements traités, le premier bloque le thread du distributeur jusqu'à ce que tous les autres soient en file
+ */
+class RecordingEventHandler : public EventHandler {
+ public:
+    bool processEvent(const Event& event, Session* sessionPtr) override {
+        const auto& message = event.getMessageList().front();
+        if (message.getCorrelationIdList().front() == "gate") {
+            this->isGateEntered = true;
+            while (!this->isGateOpen) {
+                std::this_thread::yield();
+            }
+        } else {
+            this->order.push_back(message.getCorrelationIdList().front() + ":" + Message::typeToString(message.getType()));
+        }
+        ++this->numEvent;
+        return true;
+    }
+    std::atomic<bool> isGateEntered{};
+    std::atomic<bool> isGateOpen{};
+    std::atomic<int> numEvent{};
+    std::vector<std::string> order;
+};
+
+/**
+ * @brief Crée un événement d'un seul message pour correlationId
+ */
+Event createEvent(Event::Type eventType, Message::Type messageType, const std::string& correlationId) {
+    Event event;
+    event.setType(eventType);
+    Message message;
+    message.setType(messageType);
+    message.setCorrelationIdList({correlationId});
+    event.addMessage(message);
+    return event;
+}
+
+/**
+ * @brief Met en file des données de marché puis le démarrage et une mise à jour d'un abonnement de gestion des ordres pendant que le distributeur est bloqué
+ *
+ * @return L'ordre dans lequel ils ont été traités
+ */
+std::vector<std::string> dispatch(bool enableEventPriorityLanes) {
+    SessionOptions sessionOptions;
+    sessionOptions.enableEventPriorityLanes = enableEventPriorityLanes;
+    RecordingEventHandler eventHandler;
+    Session session(sessionOptions, SessionConfigs(), &eventHandler);
+    if (enableEventPriorityLanes) {
+        // what Session::subscribe records for an execution-management subscription
+        session.executionManagementCorrelationIdSet.insert("em");
+    }
+    Event event = createEvent(Event::Type::SUBSCRIPTION_DATA, Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH, "gate");
+    session.onEvent(event, nullptr);
+    while (!eventHandler.isGateEntered) {
+        std::this_thread::yield();
+    }
+    event = createEvent(Event::Type::SUBSCRIPTION_DATA, Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH, "md");
+    session.onEvent(event, nullptr);
+    event = createEvent(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_STARTED, "em");
+    session.onEvent(event, nullptr);
+    event = createEvent(Event::Type::SUBSCRIPTION_DATA, Message::Type::EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE, "em");
+    session.onEvent(event, nullptr);
+    event = createEvent(Event::Type::SUBSCRIPTION_DATA, Message::Type::MARKET_DATA_EVENTS_TRADE, "md");
+    session.onEvent(event, nullptr);
+    eventHandler.isGateOpen = true;
+    while (eventHandler.numEvent < 5) {
+        std::this_thread::yield();
+    }
+    session.stop();
+    return eventHandler.order;
+}
+
+/**
+ * @brief Vérifie que par défaut les voies de priorité sont désactivées et que l'ordre d'arrivée est conservé
+ */
+void testFifo() {
+    std::vector<std::string> expected = {"md:MARKET_DATA_EVENTS_MARKET_DEPTH", "em:SUBSCRIPTION_STARTED", "em:EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE",
+                                         "md:MARKET_DATA_EVENTS_TRADE"};
+    assert(dispatch(false) == expected);
+    assert(!SessionOptions().enableEventPriorityLanes);
+    assert(SessionOptions().eventDispatcherHighPriorityWeight > 0);
+    std::cout << "Test fifo passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie que le statut d'un abonnement de gestion des ordres est traité avant ses mises à jour, et les deux avant les données de marché
+ */
+void testPriorityLanes() {
+    std::vector<std::string> expected = {"em:SUBSCRIPTION_STARTED", "em:EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE", "md:MARKET_DATA_EVENTS_MARKET_DEPTH",
+                                         "md:MARKET_DATA_EVENTS_TRADE"};
+    assert(dispatch(true) == expected);
+    std::cout << "Test priority lanes passed!" << std::endl;
+}
+
+int main() {
+    testFifo();
+    testPriorityLanes();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_small_order_book.cpp
+ * @brief Tests unitaires pour le carnet d'ordres à capacité fixe SmallOrderBook
+ *
+ * Teste les fonctionnalités principales :
+ * - Ordre d'itération identique à std::map<Decimal, std::string>
+ * - Remplacement complet du carnet à chaque message
+ * - Abandon des pires niveaux au-delà de la capacité
+ */
+
+#include "../include/ccapi_cpp/ccapi_small_order_book.h"
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Vérifie que le carnet et la référence contiennent les mêmes niveaux dans le même ordre
+ */
+void assertSame(const SmallOrderBook& book, const std::map<Decimal, std::string>& reference) {
+    assert(book.size() == reference.size());
+    auto it = book.begin();
+    for (const auto& x : reference) {
+        assert(it != book.end());
+        assert(it->first == x.first && it->second == x.second);
+        ++it;
+    }
+    assert(it == book.end());
+    auto rit = book.rbegin();
+    for (auto x = reference.rbegin(); x != reference.rend(); ++x) {
+        assert(rit->first == x->first && rit->second == x->second);
+        ++rit;
+    }
+    assert(rit == book.rend());
+}
+
+/**
+ * @brief Teste les opérations de base sur un côté acheteur et vendeur
+ */
+void testBasic() {
+    SmallOrderBook bid(true);
+    bid.update("100", "1");
+    bid.update("99.5", "2");
+    bid.update("101", "3");
+    assert(bid.rbegin()->first == Decimal("101") && bid.rbegin()->second == "3");
+    assert(bid.begin()->first == Decimal("99.5"));
+    bid.update("100", "4");
+    bid.update("101", "0.000");
+    assert(bid.size() == 2 && bid.rbegin()->first == Decimal("100") && bid.rbegin()->second == "4");
+    assert(bid.toString() == "{99.5=2, 100=4}");
+    assert(lastNToString(bid, 1) == "{100=4}");
+    SmallOrderBook ask(false);
+    ask.update("0.0125", "6", true);
+    ask.update("0.0120", "5", true);
+    assert(ask.begin()->first.toString() == "0.0120");
+    assert(firstNToString(ask, 2) == "{0.0120=5, 0.0125=6}");
+    ask.keepBestN(1);
+    assert(ask.size() == 1 && ask.begin()->second == "5");
+    ask.clear();
+    assert(ask.empty() && ask.begin() == ask.end());
+    std::cout << "Test basic passed!" << std::endl;
+}
+
+/**
+ * @brief Teste le remplissage au-delà de la capacité
+ *
+ * Vérifie :
+ * - Que seuls les meilleurs niveaux sont conservés
+ * - Qu'un niveau pire que tous les niveaux conservés est ignoré
+ */
+void testCapacity() {
+    SmallOrderBook ask(false);
+    for (size_t i = 0; i < SmallOrderBook::CAPACITY + 10; ++i) {
+        ask.update(std::to_string(1000 + 2 * i), "1");
+    }
+    assert(ask.size() == SmallOrderBook::CAPACITY);
+    assert(ask.rbegin()->first == Decimal(std::to_string(1000 + 2 * (SmallOrderBook::CAPACITY - 1))));
+    ask.update("999", "7");
+    assert(ask.size() == SmallOrderBook::CAPACITY && ask.begin()->second == "7");
+    assert(ask.rbegin()->first == Decimal(std::to_string(1000 + 2 * (SmallOrderBook::CAPACITY - 2))));
+    std::cout << "Test capacity passed!" << std::endl;
+}
+
+/**
+ * @brief Compare le carnet à une référence std::map sur des remplacements et des mises à jour aléatoires
+ */
+void testRandomAgainstMap() {
+    for (bool isBid : {true, false}) {
+        std::mt19937 generator(isBid ? 1 : 2);
+        SmallOrderBook book(isBid);
+        std::map<Decimal, std::string> reference;
+        for (int i = 0; i < 2000; ++i) {
+            if (i % 10 == 0) {
+                book.clear();
+                reference.clear();
+            }
+            int numLevel = static_cast<int>(generator() % 6);
+            for (int j = 0; j < numLevel; ++j) {
+                int tick = 1000 + static_cast<int>(generator() % 40);
+                std::string price = std::to_string(tick / 10) + "." + std::to_string(tick % 10);
+                std::string size = generator() % 4 == 0 ? "0" : std::to_string(generator() % 100 + 1);
+                book.update(price, size);
+                if (SmallOrderBook::isZeroSize(size)) {
+                    reference.erase(Decimal(price));
+                } else {
+                    reference[Decimal(price)] = size;
+                }
+            }
+            assertSame(book, reference);
+        }
+    }
+    std::cout << "Test random against map passed!" << std::endl;
+}
+
+/**
+ * @brief Point d'entrée des tests
+ *
+ * @return 0 si tous les tests passent, 1 en cas d'erreur
+ */
+int main() {
+    try {
+        testBasic();
+        testCapacity();
+        testRandomAgainstMap();
+        std::cout << "All tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
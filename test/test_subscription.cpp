@@ -0,0 +1,94 @@
+/**
+ * @file test_subscription.cpp
+ * @brief Tests unitaires pour les options typées de Subscription
+ *
+ * Teste les fonctionnalités principales :
+ * - Valeurs par défaut identiques aux macros de ccapi_macro.h
+ * - Analyse des options fournies sous forme de chaîne
+ * - Rejet des valeurs invalides dès la construction
+ */
+
+#include "../include/ccapi_cpp/ccapi_subscription.h"
+#include <cassert>
+#include <iostream>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+
+/**
+ * @brief Vérifie les valeurs par défaut
+ */
+void testDefault() {
+    Subscription subscription("okx", "BTC-USDT", CCAPI_MARKET_DEPTH);
+    const auto& typedOptions = subscription.getTypedOptions();
+    assert(typedOptions.marketDepthMax == std::stoi(CCAPI_MARKET_DEPTH_MAX_DEFAULT));
+    assert(typedOptions.conflateIntervalMilliseconds == 0 && !typedOptions.shouldConflate());
+    assert(typedOptions.conflateGracePeriodMilliseconds == -1 && !typedOptions.hasConflateGracePeriod());
+    assert(!typedOptions.marketDepthReturnUpdate);
+    assert(typedOptions.fetchMarketDepthInitialSnapshotDelayMilliseconds == 0);
+    assert(typedOptions.candlestickIntervalSeconds == std::stoi(CCAPI_CANDLESTICK_INTERVAL_SECONDS_DEFAULT));
+    std::cout << "Test default passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie l'analyse des options fournies
+ *
+ * Vérifie :
+ * - Que chaque option connue est convertie dans son champ typé
+ * - Que la map de chaînes reste disponible pour l'affichage
+ */
+void testParse() {
+    Subscription subscription("okx", "BTC-USDT", CCAPI_MARKET_DEPTH,
+                              std::string(CCAPI_MARKET_DEPTH_MAX) + "=10&" + CCAPI_CONFLATE_INTERVAL_MILLISECONDS + "=100&" +
+                                  CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS + "=0&" + CCAPI_MARKET_DEPTH_RETURN_UPDATE + "=" +
+                                  CCAPI_MARKET_DEPTH_RETURN_UPDATE_ENABLE + "&" + CCAPI_CANDLESTICK_INTERVAL_SECONDS + "=300");
+    const auto& typedOptions = subscription.getTypedOptions();
+    assert(typedOptions.marketDepthMax == 10);
+    assert(typedOptions.conflateIntervalMilliseconds == 100 && typedOptions.shouldConflate());
+    assert(typedOptions.conflateGracePeriodMilliseconds == 0 && typedOptions.hasConflateGracePeriod());
+    assert(typedOptions.marketDepthReturnUpdate);
+    assert(typedOptions.candlestickIntervalSeconds == 300);
+    assert(subscription.getOptionMap().at(CCAPI_MARKET_DEPTH_MAX) == "10");
+    std::cout << "Test parse passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie que les valeurs invalides sont rejetées
+ */
+void testInvalid() {
+    for (const std::string& options : {std::string(CCAPI_MARKET_DEPTH_MAX) + "=abc", std::string(CCAPI_MARKET_DEPTH_MAX) + "=0",
+                                       std::string(CCAPI_MARKET_DEPTH_MAX) + "=5x", std::string(CCAPI_CONFLATE_INTERVAL_MILLISECONDS) + "=-5",
+                                       std::string(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS) + "=-2"}) {
+        bool thrown = false;
+        try {
+            Subscription subscription("okx", "BTC-USDT", CCAPI_MARKET_DEPTH, options);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    Subscription subscription("okx", "", CCAPI_GENERIC_PUBLIC_SUBSCRIPTION, "anything");
+    assert(subscription.getRawOptions() == "anything");
+    std::cout << "Test invalid passed!" << std::endl;
+}
+
+/**
+ * @brief Point d'entrée des tests
+ *
+ * @return 0 si tous les tests passent, 1 en cas d'erreur
+ */
+int main() {
+    try {
+        testDefault();
+        testParse();
+        testInvalid();
+        std::cout << "All tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
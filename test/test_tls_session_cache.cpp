@@ -0,0 +1,128 @@
+/**
+ * @file test_tls_session_cache.cpp
+ * @brief Tests unitaires pour le cache de sessions TLS
+ *
+ * Un serveur TLS local, avec un certificat auto-signé généré au démarrage, accepte des connexions successives. Teste les fonctionnalités principales :
+ * - Première poignée de main complète, puis reprise de la session mise en cache pour les suivantes (TLS 1.2 et TLS 1.3)
+ * - Poignée de main complète pour un hôte sans session en cache
+ * - Partage du cache entre les io_context d'un ServiceContext
+ */
+
+#include "boost/asio.hpp"
+#include "boost/asio/ssl.hpp"
+#include "../include/ccapi_cpp/service/ccapi_service_context.h"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // Nécessaire pour l'initialisation du logger
+}
+
+using namespace ccapi;
+using tcp = boost::asio::ip::tcp;
+namespace ssl = boost::asio::ssl;
+
+/**
+ * @brief Installe sur le contexte serveur une clé EC P-256 et un certificat auto-signé pour localhost
+ */
+void useSelfSignedCertificate(ssl::context& serverSslContext) {
+    EVP_PKEY* pkey = nullptr;
+    EVP_PKEY_CTX* pkeyCtx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    assert(pkeyCtx && EVP_PKEY_keygen_init(pkeyCtx) == 1);
+    assert(EVP_PKEY_CTX_set_ec_paramgen_curve_nid(pkeyCtx, NID_X9_62_prime256v1) == 1);
+    assert(EVP_PKEY_keygen(pkeyCtx, &pkey) == 1);
+    EVP_PKEY_CTX_free(pkeyCtx);
+    X509* x509 = X509_new();
+    X509_set_version(x509, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(x509), 1);
+    X509_gmtime_adj(X509_getm_notBefore(x509), 0);
+    X509_gmtime_adj(X509_getm_notAfter(x509), 3600);
+    X509_set_pubkey(x509, pkey);
+    X509_NAME* name = X509_get_subject_name(x509);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(x509, name);
+    assert(X509_sign(x509, pkey, EVP_sha256()) > 0);
+    assert(SSL_CTX_use_certificate(serverSslContext.native_handle(), x509) == 1);
+    assert(SSL_CTX_use_PrivateKey(serverSslContext.native_handle(), pkey) == 1);
+    X509_free(x509);
+    EVP_PKEY_free(pkey);
+}
+
+/**
+ * @brief Accepte numConnection connexions l'une après l'autre : poignée de main, envoi de deux octets, puis attente de la fermeture par le client
+ */
+void serve(tcp::acceptor& acceptor, ssl::context& serverSslContext, int numConnection) {
+    boost::asio::io_context ioContext;
+    for (int i = 0; i < numConnection; ++i) {
+        ssl::stream<tcp::socket> stream(ioContext, serverSslContext);
+        acceptor.accept(stream.next_layer());
+        boost::system::error_code ec;
+        stream.handshake(ssl::stream_base::server, ec);
+        if (ec) {
+            continue;
+        }
+        boost::asio::write(stream, boost::asio::buffer("ok", 2), ec);
+        char c;
+        stream.read_some(boost::asio::buffer(&c, 1), ec);
+    }
+}
+
+/**
+ * @brief Ouvre une connexion vers le serveur local avec SNI host, en proposant la session en cache de host, et renvoie si la session a été reprise
+ *
+ * Les deux octets envoyés par le serveur sont lus pour que le client reçoive aussi les tickets de session de TLS 1.3, envoyés après la poignée de main.
+ */
+bool connect(ServiceContext& serviceContext, unsigned short port, const std::string& host) {
+    ssl::stream<tcp::socket> stream(*serviceContext.ioContextPtr, *serviceContext.sslContextPtr);
+    assert(SSL_set_tlsext_host_name(stream.native_handle(), host.c_str()) == 1);
+    serviceContext.tlsSessionCachePtr->apply(stream.native_handle(), host);
+    stream.next_layer().connect(tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), port));
+    stream.handshake(ssl::stream_base::client);
+    serviceContext.tlsSessionCachePtr->onHandshake(stream.native_handle());
+    bool isResumed = SSL_session_reused(stream.native_handle()) == 1;
+    char data[2];
+    boost::asio::read(stream, boost::asio::buffer(data, sizeof(data)));
+    stream.next_layer().close();
+    return isResumed;
+}
+
+/**
+ * @brief Vérifie les poignées de main complètes et reprises comptées par le cache pour une version maximale de TLS donnée du serveur
+ */
+void testResumption(int maxProtoVersion, const std::string& name) {
+    ssl::context serverSslContext(ssl::context::tls_server);
+    useSelfSignedCertificate(serverSslContext);
+    SSL_CTX_set_max_proto_version(serverSslContext.native_handle(), maxProtoVersion);
+    boost::asio::io_context acceptorIoContext;
+    tcp::acceptor acceptor(acceptorIoContext, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0));
+    unsigned short port = acceptor.local_endpoint().port();
+    const int numConnection = 5;
+    std::thread serverThread([&] { serve(acceptor, serverSslContext, numConnection); });
+    ServiceContext serviceContext(2, {});
+    ServiceContext* otherServiceContextPtr = serviceContext.getServiceContextForService();
+    otherServiceContextPtr = serviceContext.getServiceContextForService();
+    assert(otherServiceContextPtr != &serviceContext);
+    assert(!connect(serviceContext, port, "localhost"));
+    assert(serviceContext.tlsSessionCachePtr->size() == 1);
+    assert(connect(serviceContext, port, "localhost"));
+    assert(connect(*otherServiceContextPtr, port, "localhost"));
+    assert(!connect(serviceContext, port, "127.0.0.1"));
+    serviceContext.tlsSessionCachePtr->erase("localhost");
+    assert(!connect(serviceContext, port, "localhost"));
+    serverThread.join();
+    TlsSessionCache::Metrics metrics = serviceContext.tlsSessionCachePtr->getMetrics();
+    assert(metrics.numFullHandshake == 3);
+    assert(metrics.numResumedHandshake == 2);
+    assert(metrics.numSessionStored >= metrics.numFullHandshake);
+    assert(serviceContext.tlsSessionCachePtr->size() == 2);
+    std::cout << "Test resumption with " << name << " passed! " << metrics.toString() << std::endl;
+}
+
+int main() {
+    testResumption(TLS1_2_VERSION, "TLS 1.2");
+    testResumption(TLS1_3_VERSION, "TLS 1.3");
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test_util_conversion.cpp
+ * @brief Tests unitaires pour les conversions de nombres et d'horodatages sans allocation
+ *
+ * Teste les fonctionnalités principales :
+ * - Analyse des entiers par std::from_chars et ses erreurs
+ * - Normalisation des décimaux en vue et dans un tampon fourni
+ * - Analyse SWAR des horodatages en millisecondes
+ * - Formatage ISO-8601 mis en cache à la seconde
+ */
+
+#include "../include/ccapi_cpp/ccapi_util_private.h"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace ccapi;
+
+/**
+ * @brief Vérifie l'analyse des entiers et des sommes de contrôle signées
+ */
+void testParseInteger() {
+    assert(UtilString::parseInteger<int32_t>("-855196043") == -855196043);
+    assert(UtilString::parseInteger<long long>("1700000000123") == 1700000000123LL);
+    assert(UtilString::parseInteger<int>("42abc") == 42);
+    bool thrown = false;
+    try {
+        UtilString::parseInteger<int>("abc");
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        UtilString::parseInteger<int32_t>("99999999999");
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Test parse integer passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie que la normalisation des décimaux est identique à l'ancienne version
+ */
+void testNormalizeDecimalString() {
+    for (std::string input : {"42000.10", "0.00100000", "1.000", "100", "0", "0.0", "12.5"}) {
+        std::string expected = UtilString::normalizeDecimalString(input);
+        assert(UtilString::normalizeDecimalStringView(input) == expected);
+        std::string output = "previous content";
+        UtilString::normalizeDecimalStringTo(input, output);
+        assert(output == expected);
+    }
+    assert(UtilString::normalizeDecimalStringView("42000.10") == "42000.1");
+    assert(UtilString::normalizeDecimalStringView("1.000") == "1");
+    std::cout << "Test normalize decimal string passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie l'analyse SWAR contre std::stoll
+ *
+ * Vérifie :
+ * - Des horodatages aléatoires de 1 à 16 chiffres
+ * - Les entrées qui ne sont pas uniquement des chiffres
+ */
+void testParseMilliseconds() {
+    assert(UtilString::parseEightDigits("12345678") == 12345678);
+    assert(UtilString::parseEightDigits("00000000") == 0);
+    assert(UtilString::parseEightDigits("1234567:") == -1);
+    assert(UtilString::parseEightDigits("123 5678") == -1);
+    assert(UtilTime::parseMilliseconds("1700000000123") == 1700000000123LL);
+    assert(UtilTime::parseMilliseconds("-1700000000123") == -1700000000123LL);
+    assert(UtilTime::parseMilliseconds("0") == 0);
+    assert(UtilTime::makeTimePointFromMilliseconds(std::string_view("1700000000123")) == UtilTime::makeTimePointFromMilliseconds(1700000000123LL));
+    std::mt19937_64 rng(42);
+    for (int iteration = 0; iteration < 100000; ++iteration) {
+        std::string input = std::to_string(rng() % 10000000000000000ULL);
+        assert(UtilTime::parseMilliseconds(input) == std::stoll(input));
+    }
+    std::cout << "Test parse milliseconds passed!" << std::endl;
+}
+
+/**
+ * @brief Vérifie que le formatage mis en cache est identique à UtilTime::getISOTimestamp
+ *
+ * Vérifie :
+ * - Plusieurs instants dans la même seconde puis dans les secondes suivantes
+ * - Les précisions millisecondes, microsecondes, nanosecondes et secondes
+ */
+void testIsoTimestampFormatter() {
+    IsoTimestampFormatter<std::chrono::milliseconds> millisecondFormatter;
+    IsoTimestampFormatter<std::chrono::microseconds> microsecondFormatter;
+    IsoTimestampFormatter<> nanosecondFormatter;
+    IsoTimestampFormatter<std::chrono::seconds> secondFormatter;
+    TimePoint tp = UtilTime::makeTimePointFromMilliseconds(1695190491421LL) + std::chrono::nanoseconds(339);
+    assert(millisecondFormatter.format(tp) == "2023-09-20T06:14:51.421Z");
+    std::mt19937_64 rng(42);
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+        tp += std::chrono::nanoseconds(rng() % 300000000);
+        assert(millisecondFormatter.format(tp) == UtilTime::getISOTimestamp<std::chrono::milliseconds>(tp));
+        assert(microsecondFormatter.format(tp) == UtilTime::getISOTimestamp<std::chrono::microseconds>(tp));
+        assert(nanosecondFormatter.format(tp) == UtilTime::getISOTimestamp(tp));
+        assert(secondFormatter.format(tp) == UtilTime::getISOTimestamp<std::chrono::seconds>(tp));
+    }
+    std::cout << "Test iso timestamp formatter passed!" << std::endl;
+}
+
+int main() {
+    testParseInteger();
+    testNormalizeDecimalString();
+    testParseMilliseconds();
+    testIsoTimestampFormatter();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}